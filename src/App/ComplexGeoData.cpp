@@ -694,6 +694,7 @@ void ComplexGeoData::setMappedChildElements(
 
 std::vector<Data::ElementMap::MappedChildElements> ComplexGeoData::getMappedChildElements() const
 {
+    flushElementMap();
     if (!_elementMap) {
         return {};
     }
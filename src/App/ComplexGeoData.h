@@ -316,6 +316,7 @@ public:
                            MappedName* original = nullptr,
                            std::vector<MappedName>* history = nullptr) const
     {
+        flushElementMap();
         if (_elementMap != nullptr) {
             return _elementMap->getElementHistory(name, Tag, original, history);
         }
@@ -369,6 +370,7 @@ public:
      */
     void traceElement(const MappedName& name, TraceCallback cb) const
     {
+        flushElementMap();
         _elementMap->traceElement(name, Tag, std::move(cb));
     }
 
@@ -886,6 +886,24 @@ Document::Document(const char* documentName)
                       0,
                       PropertyType(Prop_Hidden),
                       "Whether to use hasher on topological naming");
+    ADD_PROPERTY_TYPE(SaveBinaryBrep,
+                      (false),
+                      0,
+                      PropertyType(Prop_None),
+                      "Whether to save shapes in binary format, which is larger\n"
+                      "but much faster to save and load than the text format");
+    ADD_PROPERTY_TYPE(SaveCompactMesh,
+                      (false),
+                      0,
+                      PropertyType(Prop_None),
+                      "Whether to save meshes in a compact encoding, which is smaller\n"
+                      "and faster to load than the default format");
+    ADD_PROPERTY_TYPE(CompactMeshQuantization,
+                      (0L),
+                      0,
+                      PropertyType(Prop_None),
+                      "Bits per coordinate of compactly saved meshes in the range [8, 24],\n"
+                      "0 keeps the exact coordinates");
 
     // this creates and sets 'TransientDir' in onChanged()
     ADD_PROPERTY_TYPE(TransientDir,
@@ -969,6 +987,7 @@ std::string Document::getTransientDirectoryName(const std::string& uuid,
 void Document::Save(Base::Writer& writer) const
 {
     d->hashers.clear();
+    d->sharedFiles.clear();
     addStringHasher(d->Hasher);
 
     writer.Stream() << R"(<Document SchemaVersion="4" ProgramVersion=")"
@@ -999,6 +1018,7 @@ void Document::Save(Base::Writer& writer) const
 void Document::Restore(Base::XMLReader& reader)
 {
     d->hashers.clear();
+    d->sharedFileOwners.clear();
     d->touchedObjs.clear();
     addStringHasher(d->Hasher);
     setStatus(Document::PartialDoc, false);
@@ -1113,6 +1133,34 @@ std::pair<bool, int> Document::addStringHasher(const StringHasherRef& hasher) co
     return std::make_pair(ret.second, ret.first->second);
 }
 
+std::string Document::getSharedFile(const std::string& key) const
+{
+    auto it = d->sharedFiles.find(key);
+    if (it == d->sharedFiles.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+void Document::addSharedFile(const std::string& key, const std::string& file) const
+{
+    d->sharedFiles.emplace(key, file);
+}
+
+void Document::setSharedFileOwner(const std::string& file, Base::Persistence* owner) const
+{
+    d->sharedFileOwners[file] = owner;
+}
+
+Base::Persistence* Document::getSharedFileOwner(const std::string& file) const
+{
+    auto it = d->sharedFileOwners.find(file);
+    if (it == d->sharedFileOwners.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
 StringHasherRef Document::getStringHasher(const int idx) const
 {
     StringHasherRef hasher;
@@ -1177,6 +1225,7 @@ void Document::exportObjects(const std::vector<DocumentObject*>& obj, std::ostre
 
     DocumentExporting exporting(obj);
     d->hashers.clear();
+    d->sharedFiles.clear();
 
     if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
         for (auto o : obj) {
@@ -1217,6 +1266,7 @@ void Document::exportObjects(const std::vector<DocumentObject*>& obj, std::ostre
     // write additional files
     writer.writeFiles();
     d->hashers.clear();
+    d->sharedFiles.clear();
 }
 
 constexpr auto fcAttrDependencies {"Dependencies"};
@@ -1563,6 +1613,7 @@ void Document::addRecomputeObject(DocumentObject* obj) // NOLINT
 std::vector<DocumentObject*> Document::importObjects(Base::XMLReader& reader)
 {
     d->hashers.clear();
+    d->sharedFileOwners.clear();
     Base::FlagToggler<> flag(globalIsRestoring, false);
     Base::ObjectStatusLocker<Status, Document> restoreBit(Status::Restoring, this);
     Base::ObjectStatusLocker<Status, Document> restoreBit2(Status::Importing, this);
@@ -2108,7 +2159,7 @@ bool Document::saveToFile(const char* filename) const
         writer.setLevel(compression);
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false)) {
+        if (hGrp->GetBool("SaveBinaryBrep", false) || SaveBinaryBrep.getValue()) {
             writer.setMode("BinaryBrep");
         }
 
@@ -2124,6 +2175,7 @@ bool Document::saveToFile(const char* filename) const
 
         // write additional files
         writer.writeFiles();
+        d->sharedFiles.clear();
         if (writer.hasErrors()) {
             // retrieve Writer error strings
             std::stringstream message;
@@ -2339,6 +2391,8 @@ bool Document::afterRestore(const std::vector<DocumentObject*>& objArray, bool c
             }
         }
     }
+    // the shared files are only referenced from within Property::afterRestore()
+    d->sharedFileOwners.clear();
 
     if (checkPartial && !d->touchedObjs.empty()) {
         // partial document touched, signal full reload
@@ -3004,9 +3058,10 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                 if (obj->isTouched() || doRecompute) {
                     signalRecomputedObject(*obj);
                     obj->purgeTouched();
-                    // set all dependent object touched to force recompute
+                    // set all dependent object touched to force recompute, but
+                    // let them reuse a cached result if their input is unchanged
                     for (auto inObjIt : obj->getInList()) {
-                        inObjIt->enforceRecompute();
+                        inObjIt->touch();
                     }
                 }
                 if (seq) {
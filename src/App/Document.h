@@ -156,6 +156,12 @@ public:
     PropertyBool ShowHidden;
     /// Whether to use hasher on topological naming
     PropertyBool UseHasher;
+    /// Whether to save shapes in binary format, in addition to the SaveBinaryBrep preference
+    PropertyBool SaveBinaryBrep;
+    /// Whether to save meshes compactly, in addition to the CompactEncoding preference
+    PropertyBool SaveCompactMesh;
+    /// Bits per coordinate of meshes saved by SaveCompactMesh, 0 keeps the exact values
+    PropertyInteger CompactMeshQuantization;
     //@}
 
     /** @name Signals of the document */
@@ -595,6 +601,41 @@ public:
      */
     StringHasherRef getStringHasher(int index = -1) const;
 
+    /** Called by a property during save to look up a file with the same content
+     *
+     * @param key: identifies the content of the file, e.g. a shape
+     * @return Returns the name of the file that has been added with
+     * addSharedFile() for the same key during this save, or an empty string.
+     *
+     * This allows several properties holding the same data to store it only
+     * once in the archive. A property that gets a file name here must not add
+     * its own file but save a reference to the returned file.
+     */
+    std::string getSharedFile(const std::string& key) const;
+
+    /** Called by a property during save to let other properties reference its file
+     *
+     * @param key: identifies the content of the file
+     * @param file: the file name returned by Base::Writer::addFile()
+     */
+    void addSharedFile(const std::string& key, const std::string& file) const;
+
+    /** Called by a property during restore if it restores a file that may be
+     * referenced by other properties
+     *
+     * @param file: the file name as read from the document
+     * @param owner: the object restoring the file
+     */
+    void setSharedFileOwner(const std::string& file, Base::Persistence* owner) const;
+
+    /** Called by a property in afterRestore() to get the owner of a referenced file
+     *
+     * @param file: the file name as read from the document
+     * @return Returns the object which has restored the file or null if the
+     * file is not restored, e.g. because its owner is not loaded.
+     */
+    Base::Persistence* getSharedFileOwner(const std::string& file) const;
+
     /** Return the links to a given object
      *
      * @param links: holds the links found
@@ -259,10 +259,12 @@ bool DocumentObject::isTouched() const
 /**
  * @brief Enforces this document object to be recomputed.
  * This can be useful to recompute the feature without
- * having to change one of its input properties.
+ * having to change one of its input properties. Unlike touch() it also
+ * bypasses the result cache of features that reuse an up-to-date result.
  */
 void DocumentObject::enforceRecompute()
 {
+    StatusBits.set(ObjectStatus::ForceRecompute);
     touch(false);
 }
 
@@ -75,6 +75,7 @@ enum ObjectStatus
     RecomputeExtension = 19,        // mark the object to recompute its extensions
     TouchOnColorChange = 20,        // inform view provider touch object on color change
     Freeze = 21,                    // do not recompute ever
+    ForceRecompute = 22,            // set by enforceRecompute(), bypasses result caches
 };
 // clang-format on
 
@@ -186,6 +187,7 @@ public:
     {
         StatusBits.reset(ObjectStatus::Touch);
         StatusBits.reset(ObjectStatus::Enforce);
+        StatusBits.reset(ObjectStatus::ForceRecompute);
         setPropertyStatus(0, false);
     }
     /// set this feature to error
@@ -93,6 +93,8 @@ struct DocumentP
     unsigned int UndoMaxStackSize {20};
     std::string programVersion;
     mutable HasherMap hashers;
+    mutable std::map<std::string, std::string> sharedFiles;
+    mutable std::map<std::string, Base::Persistence*> sharedFileOwners;
     std::multimap<const App::DocumentObject*, std::unique_ptr<App::DocumentObjectExecReturn>>
         _RecomputeLog;
 
@@ -60,6 +60,7 @@ PyMOD_INIT_FUNC(Inspection)
     Base::Console().log("Loading Inspection module... done\n");
     // clang-format off
     Inspection::PropertyDistanceList    ::init();
+    Inspection::PropertyDistanceField   ::init();
     Inspection::Feature                 ::init();
     Inspection::Group                   ::init();
     // clang-format on
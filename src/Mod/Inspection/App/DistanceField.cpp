@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <unordered_set>
+
+#include <QtConcurrentMap>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+
+#include "DistanceField.h"
+
+
+using namespace Inspection;
+
+namespace
+{
+// number of bits per axis of a block key
+constexpr int keyBits = 21;
+constexpr uint64_t keyMask = (uint64_t(1) << keyBits) - 1;
+
+// the number of bytes left in the stream or -1 if it cannot be determined
+std::streamoff remainingBytes(std::istream& in)
+{
+    std::streampos pos = in.tellg();
+    if (pos < 0) {
+        in.clear();
+        return -1;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(pos);
+    if (end < 0 || !in) {
+        in.clear();
+        in.seekg(pos);
+        return -1;
+    }
+    return end - pos;
+}
+}  // namespace
+
+DistanceField::DistanceField() = default;
+
+uint64_t DistanceField::blockKey(uint64_t x, uint64_t y, uint64_t z)
+{
+    return x | (y << keyBits) | (z << (2 * keyBits));
+}
+
+void DistanceField::clear()
+{
+    origin = Base::Vector3f();
+    spacing = 0.0F;
+    band = 0.0F;
+    key = 0;
+    blocks.clear();
+    values.clear();
+}
+
+bool DistanceField::isEmpty() const
+{
+    return blocks.empty();
+}
+
+std::size_t DistanceField::countNodes() const
+{
+    return values.size();
+}
+
+bool DistanceField::collectBlocks(const std::vector<Base::BoundBox3f>& seeds,
+                                  std::vector<uint64_t>& keys)
+{
+    const float blockLength = spacing * float(cellsPerBlock);
+    const std::size_t maxBlocks = maxNodes / nodesPerBlock;
+    auto toBlock = [&](float value, float min) {
+        return uint64_t(std::max((value - min) / blockLength, 0.0F));
+    };
+
+    std::unordered_set<uint64_t> keySet;
+    for (const auto& it : seeds) {
+        uint64_t x1 = toBlock(it.MinX - band, origin.x);
+        uint64_t y1 = toBlock(it.MinY - band, origin.y);
+        uint64_t z1 = toBlock(it.MinZ - band, origin.z);
+        uint64_t x2 = toBlock(it.MaxX + band, origin.x);
+        uint64_t y2 = toBlock(it.MaxY + band, origin.y);
+        uint64_t z2 = toBlock(it.MaxZ + band, origin.z);
+        if (std::max({x2, y2, z2}) > keyMask
+            || (x2 - x1 + 1) * (y2 - y1 + 1) * (z2 - z1 + 1) > maxBlocks) {
+            return false;
+        }
+        for (uint64_t z = z1; z <= z2; z++) {
+            for (uint64_t y = y1; y <= y2; y++) {
+                for (uint64_t x = x1; x <= x2; x++) {
+                    keySet.insert(blockKey(x, y, z));
+                }
+            }
+        }
+        if (keySet.size() > maxBlocks) {
+            return false;
+        }
+    }
+
+    keys.assign(keySet.begin(), keySet.end());
+    std::sort(keys.begin(), keys.end());
+    return true;
+}
+
+void DistanceField::build(const std::vector<Base::BoundBox3f>& seeds,
+                          float gridSpacing,
+                          float bandWidth,
+                          const std::function<float(const Base::Vector3f&)>& distance)
+{
+    clear();
+    if (seeds.empty()) {
+        return;
+    }
+    if (!(gridSpacing > 0.0F) || !(bandWidth > 0.0F)) {
+        throw Base::ValueError("Spacing and band of the distance field must be positive");
+    }
+
+    Base::BoundBox3f box;
+    for (const auto& it : seeds) {
+        box.Add(it);
+    }
+
+    // a coarser grid is used if the band around the geometry needs too many nodes
+    std::vector<uint64_t> keys;
+    spacing = gridSpacing;
+    for (;;) {
+        band = std::max(bandWidth, spacing);
+        origin.Set(box.MinX - band, box.MinY - band, box.MinZ - band);
+        if (collectBlocks(seeds, keys)) {
+            break;
+        }
+        spacing *= 2.0F;
+    }
+
+    blocks.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        blocks[keys[i]] = static_cast<uint32_t>(i);
+    }
+    values.resize(keys.size() * nodesPerBlock);
+
+    std::vector<std::size_t> indices(keys.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&](std::size_t index) {
+        uint64_t code = keys[index];
+        auto x0 = int((code & keyMask) * cellsPerBlock);
+        auto y0 = int(((code >> keyBits) & keyMask) * cellsPerBlock);
+        auto z0 = int(((code >> (2 * keyBits)) & keyMask) * cellsPerBlock);
+        float* node = values.data() + index * nodesPerBlock;
+        for (int z = 0; z < nodesPerAxis; z++) {
+            for (int y = 0; y < nodesPerAxis; y++) {
+                for (int x = 0; x < nodesPerAxis; x++) {
+                    Base::Vector3f pnt(origin.x + float(x0 + x) * spacing,
+                                       origin.y + float(y0 + y) * spacing,
+                                       origin.z + float(z0 + z) * spacing);
+                    float dist = distance(pnt);
+                    *node++ = std::fabs(dist) <= band
+                        ? dist
+                        : std::numeric_limits<float>::quiet_NaN();
+                }
+            }
+        }
+    });
+}
+
+bool DistanceField::getDistance(const Base::Vector3f& pnt, float& dist) const
+{
+    if (blocks.empty()) {
+        return false;
+    }
+
+    float fx = (pnt.x - origin.x) / spacing;
+    float fy = (pnt.y - origin.y) / spacing;
+    float fz = (pnt.z - origin.z) / spacing;
+    // the negated test also rejects NaN coordinates
+    const float maxCell = float(keyMask * cellsPerBlock);
+    if (!(fx >= 0.0F && fy >= 0.0F && fz >= 0.0F && fx < maxCell && fy < maxCell
+          && fz < maxCell)) {
+        return false;
+    }
+
+    auto cx = uint64_t(fx);
+    auto cy = uint64_t(fy);
+    auto cz = uint64_t(fz);
+    auto it = blocks.find(blockKey(cx / cellsPerBlock, cy / cellsPerBlock, cz / cellsPerBlock));
+    if (it == blocks.end()) {
+        return false;
+    }
+
+    std::size_t lx = cx % cellsPerBlock;
+    std::size_t ly = cy % cellsPerBlock;
+    std::size_t lz = cz % cellsPerBlock;
+    const float* node = values.data() + std::size_t(it->second) * nodesPerBlock
+        + (lz * nodesPerAxis + ly) * nodesPerAxis + lx;
+    constexpr std::size_t dy = nodesPerAxis;
+    constexpr std::size_t dz = nodesPerAxis * nodesPerAxis;
+    float v000 = node[0];
+    float v100 = node[1];
+    float v010 = node[dy];
+    float v110 = node[dy + 1];
+    float v001 = node[dz];
+    float v101 = node[dz + 1];
+    float v011 = node[dz + dy];
+    float v111 = node[dz + dy + 1];
+    // NaN marks nodes outside the band
+    if (std::isnan(v000 + v100 + v010 + v110 + v001 + v101 + v011 + v111)) {
+        return false;
+    }
+    // Close to the geometry the distance isn't smooth: unsigned distances have a kink on it and
+    // the sign of open meshes flips beyond their borders. Interpolating there may be off by up
+    // to a grid spacing, so such cells are left to the exact search.
+    auto [vmin, vmax] = std::minmax({v000, v100, v010, v110, v001, v101, v011, v111});
+    const float nearLimit = spacing * std::numbers::sqrt3_v<float>;
+    if (vmin < nearLimit && vmax > -nearLimit) {
+        return false;
+    }
+
+    float tx = fx - float(cx);
+    float ty = fy - float(cy);
+    float tz = fz - float(cz);
+    float v00 = v000 + tx * (v100 - v000);
+    float v10 = v010 + tx * (v110 - v010);
+    float v01 = v001 + tx * (v101 - v001);
+    float v11 = v011 + tx * (v111 - v011);
+    float v0 = v00 + ty * (v10 - v00);
+    float v1 = v01 + ty * (v11 - v01);
+    dist = v0 + tz * (v1 - v0);
+    return true;
+}
+
+void DistanceField::save(Base::OutputStream& str) const
+{
+    str << origin.x << origin.y << origin.z << spacing << band << key;
+    std::vector<uint64_t> keys(blocks.size());
+    for (const auto& it : blocks) {
+        keys[it.second] = it.first;
+    }
+    str << static_cast<uint32_t>(keys.size());
+    for (uint64_t it : keys) {
+        str << it;
+    }
+    for (float it : values) {
+        str << it;
+    }
+}
+
+void DistanceField::restore(Base::InputStream& str, std::istream& in)
+{
+    clear();
+    try {
+        uint32_t count = 0;
+        str >> origin.x >> origin.y >> origin.z >> spacing >> band >> key >> count;
+        if (!in || (count > 0 && !(spacing > 0.0F && std::isfinite(spacing)))) {
+            throw Base::FileException("Failed to read distance field");
+        }
+        std::streamoff left = remainingBytes(in);
+        uint64_t size = uint64_t(count) * (sizeof(uint64_t) + nodesPerBlock * sizeof(float));
+        if (left >= 0 && size > static_cast<uint64_t>(left)) {
+            throw Base::FileException("Failed to read distance field");
+        }
+
+        // read block by block so that a corrupt count of a stream of unknown size fails at its
+        // end instead of triggering a huge allocation
+        std::vector<uint64_t> keys;
+        for (uint32_t i = 0; i < count && in; i++) {
+            uint64_t it {};
+            str >> it;
+            keys.push_back(it);
+        }
+        for (uint32_t i = 0; i < count && in; i++) {
+            std::size_t offset = values.size();
+            values.resize(offset + nodesPerBlock);
+            for (std::size_t j = offset; j < values.size(); j++) {
+                str >> values[j];
+            }
+        }
+        if (!in) {
+            throw Base::FileException("Failed to read distance field");
+        }
+
+        blocks.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            blocks[keys[i]] = static_cast<uint32_t>(i);
+        }
+    }
+    catch (const Base::FileException&) {
+        clear();
+        throw;
+    }
+    catch (const std::exception&) {
+        // std::bad_alloc or std::length_error
+        clear();
+        throw Base::FileException("Failed to read distance field");
+    }
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef INSPECTION_DISTANCEFIELD_H
+#define INSPECTION_DISTANCEFIELD_H
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Inspection/InspectionGlobal.h>
+
+namespace Base
+{
+class InputStream;
+class OutputStream;
+}  // namespace Base
+
+namespace Inspection
+{
+
+/** Sparse narrow-band distance field.
+ * The distances are sampled on the nodes of a regular grid but only in the blocks of 8x8x8 cells
+ * that lie within the band around the geometry. Each block holds its 9x9x9 nodes, so a lookup
+ * needs a single hash access and the distance of a point is interpolated trilinearly from the
+ * eight nodes of its cell. Nodes whose distance exceeds the band are marked as invalid, for points
+ * in cells with such nodes or in cells next to the geometry getDistance() fails and the caller
+ * has to compute the exact distance.
+ *
+ * A built field is read-only and can be queried from several threads at the same time.
+ */
+class InspectionExport DistanceField
+{
+public:
+    /// The maximum number of nodes, the grid spacing is increased until the field fits.
+    static constexpr std::size_t maxNodes = std::size_t(1) << 25;
+
+    DistanceField();
+
+    /** Samples \a distance on all nodes within the distance \a bandWidth of the bounding boxes
+     * \a seeds of the geometry. The nodes are computed on several threads, so \a distance must be
+     * thread-safe.
+     */
+    void build(const std::vector<Base::BoundBox3f>& seeds,
+               float gridSpacing,
+               float bandWidth,
+               const std::function<float(const Base::Vector3f&)>& distance);
+    void clear();
+    bool isEmpty() const;
+    /// Returns the number of nodes that are stored.
+    std::size_t countNodes() const;
+    float getSpacing() const
+    {
+        return spacing;
+    }
+    float getBand() const
+    {
+        return band;
+    }
+    /** The key identifies the geometry the field was built for. It is stored with the field so
+     * that it can be checked after restoring whether the field is still valid. */
+    void setKey(uint64_t value)
+    {
+        key = value;
+    }
+    uint64_t getKey() const
+    {
+        return key;
+    }
+
+    /** Interpolates the distance at \a pnt. Returns false if \a pnt is outside the band, or if
+     * a node of its cell is closer to the geometry than the length of a cell diagonal or on the
+     * other side of it, because the distance may not be smooth there. */
+    bool getDistance(const Base::Vector3f& pnt, float& dist) const;
+
+    void save(Base::OutputStream&) const;
+    /** Restores the field from \a str, which reads from \a in. The number of blocks is checked
+     * against the size of the stream. Throws a Base::FileException and leaves the field empty if
+     * the data is invalid.
+     */
+    void restore(Base::InputStream& str, std::istream& in);
+
+private:
+    static constexpr int cellsPerBlock = 8;
+    static constexpr int nodesPerAxis = cellsPerBlock + 1;
+    static constexpr int nodesPerBlock = nodesPerAxis * nodesPerAxis * nodesPerAxis;
+
+    static uint64_t blockKey(uint64_t x, uint64_t y, uint64_t z);
+    bool collectBlocks(const std::vector<Base::BoundBox3f>& seeds, std::vector<uint64_t>& keys);
+
+private:
+    Base::Vector3f origin;
+    float spacing {0.0F};
+    float band {0.0F};
+    uint64_t key {0};
+    std::unordered_map<uint64_t, uint32_t> blocks;
+    std::vector<float> values;
+};
+
+}  // namespace Inspection
+
+
+#endif  // INSPECTION_DISTANCEFIELD_H
@@ -24,16 +24,35 @@
 
 #ifndef _PreComp_
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <list>
 #include <numeric>
 #include <limits>
+#include <unordered_map>
 
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <Standard_Failure.hxx>
 #include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 
 #include <QEventLoop>
 #include <QFuture>
@@ -47,20 +66,154 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
+#include <Mod/Points/App/KDTree.h>
 
+#include "DistanceField.h"
 #include "InspectionFeature.h"
 
 
 using namespace Inspection;
 namespace sp = std::placeholders;
 
+namespace
+{
+void hashCombine(uint64_t& key, float value)
+{
+    uint32_t bits {};
+    std::memcpy(&bits, &value, sizeof(bits));
+    key ^= bits + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+}
+
+void hashCombine(uint64_t& key, uint64_t value)
+{
+    key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+}
+
+void hashCombine(uint64_t& key, const Base::Matrix4D& mat)
+{
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            hashCombine(key, float(mat[i][j]));
+        }
+    }
+}
+
+// hashes the points and facets of the mesh without building the seeds of the field
+void hashFieldNominal(const Mesh::MeshObject& mesh, uint64_t& key)
+{
+    const MeshCore::MeshKernel& kernel = mesh.getKernel();
+    hashCombine(key, uint64_t(kernel.CountPoints()));
+    hashCombine(key, uint64_t(kernel.CountFacets()));
+    hashCombine(key, mesh.getTransform());
+    for (const auto& pnt : kernel.GetPoints()) {
+        hashCombine(key, pnt.x);
+        hashCombine(key, pnt.y);
+        hashCombine(key, pnt.z);
+    }
+    for (const auto& facet : kernel.GetFacets()) {
+        for (auto index : facet._aulPoints) {
+            hashCombine(key, uint64_t(index));
+        }
+    }
+}
+
+// hashes the size, the bounds and a sample of the points of the cloud, so that a cloud that is
+// paged from disk doesn't have to be read completely
+void hashFieldNominal(const Points::PointSource& source,
+                      const Base::Matrix4D& mat,
+                      uint64_t& key)
+{
+    Base::BoundBox3f bounds = source.getPointBounds();
+    hashCombine(key, uint64_t(source.countPoints()));
+    hashCombine(key, mat);
+    hashCombine(key, bounds.MinX);
+    hashCombine(key, bounds.MinY);
+    hashCombine(key, bounds.MinZ);
+    hashCombine(key, bounds.MaxX);
+    hashCombine(key, bounds.MaxY);
+    hashCombine(key, bounds.MaxZ);
+    std::vector<Base::Vector3f> points;
+    source.getLevelOfDetail(bounds, 4096, points);
+    for (const auto& pnt : points) {
+        hashCombine(key, pnt.x);
+        hashCombine(key, pnt.y);
+        hashCombine(key, pnt.z);
+    }
+}
+
+// adds the bounding boxes of the facets as seeds of a distance field
+void addFieldSeeds(const Mesh::MeshObject& mesh, std::vector<Base::BoundBox3f>& seeds)
+{
+    MeshCore::MeshFacetIterator it(mesh.getKernel());
+    it.Transform(mesh.getTransform());
+    for (it.Init(); it.More(); it.Next()) {
+        seeds.push_back(it->GetBoundBox());
+    }
+}
+
+// adds the transformed points as seeds of a distance field, the points that fall into the same
+// cell of size \a cellSize share one seed and are read tile by tile from the source
+void addFieldSeeds(const Points::PointSource& source,
+                   const Base::Matrix4D& mat,
+                   float cellSize,
+                   std::vector<Base::BoundBox3f>& seeds)
+{
+    Base::BoundBox3f bounds = source.getPointBounds();
+    if (!bounds.IsValid() || !(cellSize > 0.0F)) {
+        return;
+    }
+
+    // a tile has 64 cells per axis, and the last tiles end at the bounds
+    const float tileSize = 64.0F * cellSize;
+    auto numTiles = [tileSize](float length) {
+        return std::max(1, int(std::ceil(length / tileSize)));
+    };
+    auto upper = [tileSize](float minimum, float maximum, int index, int num) {
+        return index + 1 == num ? maximum : minimum + float(index + 1) * tileSize;
+    };
+    int nx = numTiles(bounds.LengthX());
+    int ny = numTiles(bounds.LengthY());
+    int nz = numTiles(bounds.LengthZ());
+
+    std::vector<Base::Vector3f> points;
+    std::unordered_map<uint64_t, Base::BoundBox3f> cells;
+    for (int z = 0; z < nz; z++) {
+        for (int y = 0; y < ny; y++) {
+            for (int x = 0; x < nx; x++) {
+                Base::BoundBox3f tile(bounds.MinX + float(x) * tileSize,
+                                      bounds.MinY + float(y) * tileSize,
+                                      bounds.MinZ + float(z) * tileSize,
+                                      upper(bounds.MinX, bounds.MaxX, x, nx),
+                                      upper(bounds.MinY, bounds.MaxY, y, ny),
+                                      upper(bounds.MinZ, bounds.MaxZ, z, nz));
+                points.clear();
+                cells.clear();
+                source.getPointsInBox(tile, points);
+                for (auto pnt : points) {
+                    // the cell is computed in the tile, so points on a tile border may be
+                    // added twice, which doesn't change the field
+                    auto cx = uint64_t(std::clamp((pnt.x - tile.MinX) / cellSize, 0.0F, 63.0F));
+                    auto cy = uint64_t(std::clamp((pnt.y - tile.MinY) / cellSize, 0.0F, 63.0F));
+                    auto cz = uint64_t(std::clamp((pnt.z - tile.MinZ) / cellSize, 0.0F, 63.0F));
+                    mat.multVec(pnt, pnt);
+                    cells[cx | (cy << 6) | (cz << 12)].Add(pnt);
+                }
+                for (const auto& it : cells) {
+                    seeds.push_back(it.second);
+                }
+            }
+        }
+    }
+}
+}  // namespace
+
 InspectActualMesh::InspectActualMesh(const Mesh::MeshObject& rMesh)
     : _mesh(rMesh.getKernel())
 {
@@ -200,7 +353,8 @@ protected:
         assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
     }
 
-    void AddFacet(const MeshCore::MeshGeomFacet& rclFacet, unsigned long ulFacetIndex)
+    void FacetCells(const MeshCore::MeshGeomFacet& rclFacet,
+                    std::vector<unsigned long>& raulCells) const
     {
         unsigned long ulX1;
         unsigned long ulY1;
@@ -223,21 +377,19 @@ protected:
                 for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
                     for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                         if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                            raulCells.push_back(CellIndex(ulX, ulY, ulZ));
                         }
                     }
                 }
             }
         }
         else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+            raulCells.push_back(CellIndex(ulX1, ulY1, ulZ1));
         }
     }
 
     void InitGrid() override
     {
-        unsigned long i, j;
-
         Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
         float fLengthX = clBBMesh.LengthX();
@@ -253,14 +405,7 @@ protected:
         _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
         _fMinZ = clBBMesh.MinZ - 0.5f;
 
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
+        ResetCells();
     }
 
     void RebuildGrid() override
@@ -268,12 +413,12 @@ protected:
         _ulCtElements = _pclMesh->CountFacets();
         InitGrid();
 
-        unsigned long i = 0;
-        MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-        clFIter.Transform(_transform);
-        for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-            AddFacet(*clFIter, i++);
-        }
+        BuildCells(_ulCtElements,
+                   [this](MeshCore::ElementIndex index, std::vector<unsigned long>& cells) {
+                       MeshCore::MeshGeomFacet facet = _pclMesh->GetFacet(index);
+                       facet.Transform(_transform);
+                       FacetCells(facet, cells);
+                   });
     }
 
 private:
@@ -437,37 +582,186 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
+/** Splits the bounding box of a point source into a grid of tiles whose size is at least twice
+ * the search radius, so that a search has to look into at most eight tiles. The points of a tile
+ * are read from the source when the tile is searched the first time and the k-d trees of the
+ * least recently used tiles are dropped when the cache gets too large.
+ */
+class InspectNominalPoints::Tiles
+{
+public:
+    /// The maximum number of points that are kept in the trees of the tiles.
+    static constexpr std::size_t maxCachedPoints = std::size_t(1) << 23;
+
+    Tiles(const Points::PointSource& source, const Base::Matrix4D& mat, float radius)
+        : source(source)
+        , placement(mat)
+        , inverse(mat)
+        , bounds(source.getPointBounds())
+        , radius(radius)
+    {
+        inverse.inverseOrthogonal();
+        // the number of tiles per axis is limited so that a tile doesn't get too small
+        float length = std::max({bounds.LengthX(), bounds.LengthY(), bounds.LengthZ()});
+        tileSize = std::max({2.0F * radius, length / 1024.0F, std::numeric_limits<float>::min()});
+        count[0] = std::max(1, int(std::ceil(bounds.LengthX() / tileSize)));
+        count[1] = std::max(1, int(std::ceil(bounds.LengthY() / tileSize)));
+        count[2] = std::max(1, int(std::ceil(bounds.LengthZ() / tileSize)));
+    }
+
+    float getDistance(const Base::Vector3f& point) const
+    {
+        float fMinDist = std::numeric_limits<float>::max();
+        if (!bounds.IsValid()) {
+            return fMinDist;
+        }
+
+        Base::Vector3f local = point;
+        inverse.multVec(local, local);
+        const float minimum[3] = {bounds.MinX, bounds.MinY, bounds.MinZ};
+        const float coord[3] = {local.x, local.y, local.z};
+        int first[3] {};
+        int last[3] {};
+        for (int i = 0; i < 3; i++) {
+            float lower = std::floor((coord[i] - radius - minimum[i]) / tileSize);
+            float upper = std::floor((coord[i] + radius - minimum[i]) / tileSize);
+            // the negated test also rejects NaN coordinates
+            if (!(upper >= 0.0F && lower < float(count[i]))) {
+                return fMinDist;
+            }
+            first[i] = std::max(0, int(lower));
+            last[i] = std::min(count[i] - 1, int(upper));
+        }
+
+        for (int z = first[2]; z <= last[2]; z++) {
+            for (int y = first[1]; y <= last[1]; y++) {
+                for (int x = first[0]; x <= last[0]; x++) {
+                    std::shared_ptr<const Points::PointsKDTree> tree = getTree(x, y, z);
+                    float fDist = std::numeric_limits<float>::max();
+                    if (tree && tree->findNearest(point, fDist) != Points::PointsKDTree::npos) {
+                        fMinDist = std::min(fMinDist, fDist);
+                    }
+                }
+            }
+        }
+        return fMinDist;
+    }
+
+private:
+    std::shared_ptr<const Points::PointsKDTree> getTree(int x, int y, int z) const
+    {
+        uint64_t key = uint64_t(x) | (uint64_t(y) << 21) | (uint64_t(z) << 42);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(key);
+            if (it != cache.end()) {
+                lru.splice(lru.begin(), lru, it->second.lru);
+                return it->second.tree;
+            }
+        }
+
+        // read the tile without holding the lock, so that other threads can search their tiles
+        // the last tiles end at the bounds to not lose points to rounding
+        auto upper = [this](float minimum, float maximum, int index, int num) {
+            return index + 1 == num ? maximum : minimum + float(index + 1) * tileSize;
+        };
+        Base::BoundBox3f box(bounds.MinX + float(x) * tileSize,
+                             bounds.MinY + float(y) * tileSize,
+                             bounds.MinZ + float(z) * tileSize,
+                             upper(bounds.MinX, bounds.MaxX, x, count[0]),
+                             upper(bounds.MinY, bounds.MaxY, y, count[1]),
+                             upper(bounds.MinZ, bounds.MaxZ, z, count[2]));
+        std::vector<Base::Vector3f> points;
+        source.getPointsInBox(box, points);
+        std::shared_ptr<const Points::PointsKDTree> tree;
+        if (!points.empty()) {
+            for (auto& it : points) {
+                placement.multVec(it, it);
+            }
+            tree = std::make_shared<Points::PointsKDTree>(points);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            // another thread has read the tile in the meantime
+            return it->second.tree;
+        }
+        lru.push_front(key);
+        cache[key] = CacheEntry {tree, lru.begin()};
+        cachedPoints += points.size();
+
+        // keep at least the tile that has just been read
+        while (cachedPoints > maxCachedPoints && lru.size() > 1) {
+            auto last = cache.find(lru.back());
+            if (last->second.tree) {
+                cachedPoints -= last->second.tree->size();
+            }
+            cache.erase(last);
+            lru.pop_back();
+        }
+        return tree;
+    }
+
+private:
+    struct CacheEntry
+    {
+        std::shared_ptr<const Points::PointsKDTree> tree;
+        std::list<uint64_t>::iterator lru;
+    };
+
+    const Points::PointSource& source;
+    Base::Matrix4D placement;
+    Base::Matrix4D inverse;
+    Base::BoundBox3f bounds;
+    float radius;
+    float tileSize {0.0F};
+    int count[3] {1, 1, 1};
+
+    mutable std::mutex mutex;
+    mutable std::list<uint64_t> lru;
+    mutable std::unordered_map<uint64_t, CacheEntry> cache;
+    mutable std::size_t cachedPoints {0};
+};
+
 InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
-    : _rKernel(Kernel)
 {
-    int uGridPerAxis = 50;  // totally 125.000 grid elements
-    this->_pGrid = new Points::PointsGrid(Kernel, uGridPerAxis);
+    this->_pTree = new Points::PointsKDTree(Kernel);
+}
+
+InspectNominalPoints::InspectNominalPoints(const Points::PointSource& source,
+                                           const Base::Matrix4D& mat,
+                                           float offset)
+{
+    if (offset > 0.0F) {
+        _tiles = std::make_unique<Tiles>(source, mat, offset);
+        return;
+    }
+
+    std::vector<Base::Vector3f> points;
+    source.getPointsInBox(source.getPointBounds(), points);
+    if (mat != Base::Matrix4D()) {
+        for (auto& it : points) {
+            mat.multVec(it, it);
+        }
+    }
+    this->_pTree = new Points::PointsKDTree(points);
 }
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pTree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    // TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x, y, z;
-    Base::Vector3d pointd(point.x, point.y, point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x, y, z, indices);
-
-    double fMinDist = std::numeric_limits<double>::max();
-    for (unsigned long it : indices) {
-        Base::Vector3d pt = _rKernel.getPoint(it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
+    if (_tiles) {
+        return _tiles->getDistance(point);
     }
 
-    return (float)fMinDist;
+    float fMinDist = std::numeric_limits<float>::max();
+    _pTree->findNearest(point, fMinDist);
+    return fMinDist;
 }
 
 // ----------------------------------------------------------------
@@ -556,6 +850,359 @@ bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
 
 // ----------------------------------------------------------------
 
+class InspectNominalFastShape::Private
+{
+public:
+    struct Face
+    {
+        TopoDS_Face face;
+        Handle(Geom_Surface) surface;
+        gp_Trsf toSurface;
+        bool reversed {false};
+        bool hasUV {false};
+        double umin {0.0};
+        double umax {0.0};
+        double vmin {0.0};
+        double vmax {0.0};
+    };
+
+    bool projectOnFace(const Face& face,
+                       MeshCore::FacetIndex facet,
+                       const Base::Vector3f& onFacet,
+                       const gp_Pnt& pnt,
+                       double& dist,
+                       bool& below) const;
+    bool distanceToFace(const Face& face,
+                        const gp_Pnt& pnt,
+                        double& dist,
+                        bool& inFace,
+                        bool& below) const;
+    bool isInsideSolid(const gp_Pnt& pnt) const;
+
+    TopoDS_Shape shape;
+    bool isSolid {false};
+    double deflection {0.0};
+    std::vector<Face> faces;
+    std::vector<std::size_t> facetToFace;
+    std::vector<gp_Pnt2d> uvNodes;
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshFacetBVH bvh;
+};
+
+bool InspectNominalFastShape::Private::projectOnFace(const Face& face,
+                                                     MeshCore::FacetIndex facet,
+                                                     const Base::Vector3f& onFacet,
+                                                     const gp_Pnt& pnt,
+                                                     double& dist,
+                                                     bool& below) const
+{
+    if (!face.hasUV) {
+        return false;
+    }
+
+    // if the nearest point of the triangle is on the border of the face the nearest point of
+    // the face may be on one of its edges
+    const MeshCore::MeshFacet& rFacet = mesh.GetFacets()[facet];
+    std::array<float, 3> weights {};
+    if (!mesh.GetFacet(facet).Weights(onFacet, weights[0], weights[1], weights[2])) {
+        return false;
+    }
+    const float eps = 1e-4F;
+    for (unsigned short side = 0; side < 3; side++) {
+        if (!rFacet.HasNeighbour(side) && weights[(side + 2) % 3] < eps) {
+            return false;
+        }
+    }
+
+    double u = 0.0;
+    double v = 0.0;
+    for (int i = 0; i < 3; i++) {
+        const gp_Pnt2d& uv = uvNodes[rFacet._aulPoints[i]];
+        u += weights[i] * uv.X();
+        v += weights[i] * uv.Y();
+    }
+
+    // Newton iteration for the minimum of the squared distance, if the Hessian isn't positive
+    // definite fall back to a Gauss-Newton step
+    gp_Pnt local = pnt.Transformed(face.toSurface);
+    gp_Pnt surf;
+    gp_Vec du, dv, duu, dvv, duv;
+    bool converged = false;
+    for (int iter = 0; iter < 20 && !converged; iter++) {
+        face.surface->D2(u, v, surf, du, dv, duu, dvv, duv);
+        gp_Vec diff(local, surf);
+        double g1 = diff.Dot(du);
+        double g2 = diff.Dot(dv);
+        double h11 = du.Dot(du) + diff.Dot(duu);
+        double h12 = du.Dot(dv) + diff.Dot(duv);
+        double h22 = dv.Dot(dv) + diff.Dot(dvv);
+        double det = h11 * h22 - h12 * h12;
+        if (h11 <= 0.0 || det <= 0.0) {
+            h11 = du.Dot(du);
+            h12 = du.Dot(dv);
+            h22 = dv.Dot(dv);
+            det = h11 * h22 - h12 * h12;
+            if (det <= 0.0) {
+                return false;
+            }
+        }
+
+        double stepU = (h12 * g2 - h22 * g1) / det;
+        double stepV = (h12 * g1 - h11 * g2) / det;
+        u += stepU;
+        v += stepV;
+        if (u < face.umin - Precision::PConfusion() || u > face.umax + Precision::PConfusion()
+            || v < face.vmin - Precision::PConfusion() || v > face.vmax + Precision::PConfusion()) {
+            return false;
+        }
+        converged = (du * stepU + dv * stepV).Magnitude() < 0.01 * Precision::Confusion();
+    }
+
+    if (!converged) {
+        return false;
+    }
+
+    face.surface->D1(u, v, surf, du, dv);
+    gp_Vec normal = du.Crossed(dv);
+    if (face.reversed) {
+        normal.Reverse();
+    }
+    gp_Vec diff(surf, local);
+    dist = diff.Magnitude();
+    below = diff.Dot(normal) < 0.0;
+    return true;
+}
+
+bool InspectNominalFastShape::Private::distanceToFace(const Face& face,
+                                                      const gp_Pnt& pnt,
+                                                      double& dist,
+                                                      bool& inFace,
+                                                      bool& below) const
+{
+    BRepBuilderAPI_MakeVertex mkVert(pnt);
+    BRepExtrema_DistShapeShape distss(mkVert.Vertex(), face.face);
+    if (!distss.IsDone() || distss.NbSolution() == 0) {
+        return false;
+    }
+
+    dist = distss.Value();
+    inFace = distss.SupportTypeShape2(1) == BRepExtrema_IsInFace;
+    below = false;
+    if (inFace) {
+        Standard_Real u {};
+        Standard_Real v {};
+        distss.ParOnFaceS2(1, u, v);
+        BRepGProp_Face props(face.face);
+        gp_Vec normal;
+        gp_Pnt center;
+        props.Normal(u, v, center, normal);
+        below = normal.Dot(gp_Vec(center, pnt)) < 0.0;
+    }
+    return true;
+}
+
+bool InspectNominalFastShape::Private::isInsideSolid(const gp_Pnt& pnt) const
+{
+    const Standard_Real tol = 0.001;
+    BRepClass3d_SolidClassifier classifier(shape);
+    classifier.Perform(pnt, tol);
+    return (classifier.State() == TopAbs_IN);
+}
+
+InspectNominalFastShape::InspectNominalFastShape(const TopoDS_Shape& shape,
+                                                 float /*offset*/,
+                                                 double deflection)
+    : d(new Private)
+{
+    d->deflection = deflection;
+    d->isSolid = !shape.IsNull() && shape.ShapeType() == TopAbs_SOLID;
+    if (shape.IsNull()) {
+        return;
+    }
+
+    // tessellate a copy so that the triangulation of the nominal itself stays untouched
+    d->shape = BRepBuilderAPI_Copy(shape).Shape();
+    BRepMesh_IncrementalMesh mkMesh(d->shape, deflection);
+
+    // every face gets its own points so that the edges of a face are open edges of the mesh
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    TopTools_IndexedMapOfShape mapOfFaces;
+    TopExp::MapShapes(d->shape, TopAbs_FACE, mapOfFaces);
+    for (int index = 1; index <= mapOfFaces.Extent(); index++) {
+        Private::Face face;
+        face.face = TopoDS::Face(mapOfFaces(index));
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) tria = BRep_Tool::Triangulation(face.face, loc);
+        if (tria.IsNull()) {
+            continue;
+        }
+
+        TopLoc_Location surfLoc;
+        face.surface = BRep_Tool::Surface(face.face, surfLoc);
+        if (face.surface.IsNull()) {
+            continue;
+        }
+        face.toSurface = surfLoc.Transformation().Inverted();
+        face.reversed = face.face.Orientation() == TopAbs_REVERSED;
+        face.hasUV = tria->HasUVNodes();
+        BRepTools::UVBounds(face.face, face.umin, face.umax, face.vmin, face.vmax);
+
+        gp_Trsf trsf = loc.Transformation();
+        auto offset = static_cast<MeshCore::PointIndex>(points.size());
+        for (int i = 1; i <= tria->NbNodes(); i++) {
+            gp_Pnt pnt = tria->Node(i).Transformed(trsf);
+            points.push_back(Base::Vector3f(float(pnt.X()), float(pnt.Y()), float(pnt.Z())));
+            d->uvNodes.push_back(face.hasUV ? tria->UVNode(i) : gp_Pnt2d());
+        }
+        for (int i = 1; i <= tria->NbTriangles(); i++) {
+            Standard_Integer n1 {}, n2 {}, n3 {};
+            tria->Triangle(i).Get(n1, n2, n3);
+            facets.push_back(
+                MeshCore::MeshFacet(offset + n1 - 1, offset + n2 - 1, offset + n3 - 1));
+            d->facetToFace.push_back(d->faces.size());
+        }
+        d->faces.push_back(face);
+    }
+
+    d->mesh.Adopt(points, facets, true);
+    d->bvh.Attach(d->mesh);
+}
+
+InspectNominalFastShape::~InspectNominalFastShape() = default;
+
+float InspectNominalFastShape::getDistance(const Base::Vector3f& point) const
+{
+    Base::Vector3f onFacet;
+    float facetDist {};
+    MeshCore::FacetIndex nearest = d->bvh.SearchNearestFromPoint(point,
+                                                                 std::numeric_limits<float>::max(),
+                                                                 onFacet,
+                                                                 facetDist);
+    if (nearest == MeshCore::FACET_INDEX_MAX) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // The triangles deviate by at most the deflection from the faces, so only faces with a
+    // triangle in this range can hold the nearest point. Keep the nearest triangle of each face.
+    struct Candidate
+    {
+        std::size_t face;
+        MeshCore::FacetIndex facet;
+        Base::Vector3f onFacet;
+        float dist;
+    };
+    float range = facetDist + 2.0F * static_cast<float>(d->deflection);
+    Base::BoundBox3f box(point.x - range,
+                         point.y - range,
+                         point.z - range,
+                         point.x + range,
+                         point.y + range,
+                         point.z + range);
+    std::vector<MeshCore::FacetIndex> facets;
+    d->bvh.Inside(box, facets);
+
+    std::vector<Candidate> candidates;
+    for (auto facet : facets) {
+        Base::Vector3f pnt;
+        float dist = d->mesh.GetFacet(facet).DistanceToPoint(point, pnt);
+        if (dist > range) {
+            continue;
+        }
+        std::size_t face = d->facetToFace[facet];
+        auto it = std::find_if(candidates.begin(), candidates.end(), [face](const Candidate& c) {
+            return c.face == face;
+        });
+        if (it == candidates.end()) {
+            candidates.push_back({face, facet, pnt, dist});
+        }
+        else if (dist < it->dist) {
+            *it = {face, facet, pnt, dist};
+        }
+    }
+
+    gp_Pnt pnt3d(point.x, point.y, point.z);
+    double minDist = std::numeric_limits<double>::max();
+    bool below = false;
+    bool inFace = true;
+    for (const auto& it : candidates) {
+        const Private::Face& face = d->faces[it.face];
+        double dist {};
+        bool faceBelow = false;
+        bool interior = true;
+        bool projected = false;
+        try {
+            projected = d->projectOnFace(face, it.facet, it.onFacet, pnt3d, dist, faceBelow);
+        }
+        catch (const Standard_Failure&) {
+            // e.g. undefined derivatives of the surface
+        }
+        if (!projected && !d->distanceToFace(face, pnt3d, dist, interior, faceBelow)) {
+            continue;
+        }
+        if (dist < minDist) {
+            minDist = dist;
+            below = faceBelow;
+            inFace = interior;
+        }
+    }
+
+    if (minDist == std::numeric_limits<double>::max()) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // the nearest point is on an edge or vertex of the solid
+    if (d->isSolid && !inFace) {
+        below = d->isInsideSolid(pnt3d);
+    }
+
+    auto fMinDist = static_cast<float>(minDist);
+    return below ? -fMinDist : fMinDist;
+}
+
+// ----------------------------------------------------------------
+
+InspectNominalField::InspectNominalField(std::vector<Factory> factories)
+    : _factories(std::move(factories))
+{}
+
+InspectNominalField::~InspectNominalField() = default;
+
+void InspectNominalField::setField(std::shared_ptr<const DistanceField> field)
+{
+    _field = std::move(field);
+}
+
+float InspectNominalField::getDistance(const Base::Vector3f& point) const
+{
+    float fDist {};
+    if (_field && _field->getDistance(point, fDist)) {
+        return fDist;
+    }
+    return getExactDistance(point);
+}
+
+float InspectNominalField::getExactDistance(const Base::Vector3f& point) const
+{
+    // getDistance() is called from several threads
+    std::call_once(_created, [this]() {
+        for (const auto& factory : _factories) {
+            _nominals.push_back(factory());
+        }
+    });
+
+    float fMinDist = std::numeric_limits<float>::max();
+    for (const auto& it : _nominals) {
+        float fDist = it->getDistance(point);
+        if (fabs(fDist) < fabs(fMinDist)) {
+            fMinDist = fDist;
+        }
+    }
+    return fMinDist;
+}
+
+// ----------------------------------------------------------------
+
 TYPESYSTEM_SOURCE(Inspection::PropertyDistanceList, App::PropertyLists)
 
 PropertyDistanceList::PropertyDistanceList() = default;
@@ -697,6 +1344,90 @@ unsigned int PropertyDistanceList::getMemSize() const
 
 // ----------------------------------------------------------------
 
+TYPESYSTEM_SOURCE(Inspection::PropertyDistanceField, App::Property)
+
+PropertyDistanceField::PropertyDistanceField() = default;
+
+PropertyDistanceField::~PropertyDistanceField() = default;
+
+void PropertyDistanceField::setValue(std::shared_ptr<const DistanceField> field)
+{
+    aboutToSetValue();
+    _field = std::move(field);
+    hasSetValue();
+}
+
+void PropertyDistanceField::Save(Base::Writer& writer) const
+{
+    // the field is a cache and therefore never written as XML
+    if (!_field || _field->isEmpty() || writer.isForceXML()) {
+        writer.Stream() << writer.ind() << "<DistanceField file=\"\"/>" << std::endl;
+    }
+    else {
+        writer.Stream() << writer.ind() << "<DistanceField file=\""
+                        << writer.addFile(getName(), this) << "\"/>" << std::endl;
+    }
+}
+
+void PropertyDistanceField::Restore(Base::XMLReader& reader)
+{
+    reader.readElement("DistanceField");
+    std::string file(reader.getAttribute<const char*>("file"));
+
+    if (!file.empty()) {
+        // initiate a file read
+        reader.addFile(file.c_str(), this);
+    }
+}
+
+void PropertyDistanceField::SaveDocFile(Base::Writer& writer) const
+{
+    if (_field) {
+        Base::OutputStream str(writer.Stream());
+        _field->save(str);
+    }
+}
+
+void PropertyDistanceField::RestoreDocFile(Base::Reader& reader)
+{
+    auto field = std::make_shared<DistanceField>();
+    try {
+        Base::InputStream str(reader);
+        field->restore(str, reader);
+    }
+    catch (const Base::Exception& e) {
+        // the field will be rebuilt on the next recompute
+        Base::Console().warning("%s\n", e.what());
+        field->clear();
+    }
+    catch (const std::exception&) {
+        Base::Console().warning("Failed to read distance field\n");
+        field->clear();
+    }
+    setValue(field);
+}
+
+App::Property* PropertyDistanceField::Copy() const
+{
+    PropertyDistanceField* p = new PropertyDistanceField();
+    p->_field = _field;
+    return p;
+}
+
+void PropertyDistanceField::Paste(const App::Property& from)
+{
+    aboutToSetValue();
+    _field = dynamic_cast<const PropertyDistanceField&>(from)._field;
+    hasSetValue();
+}
+
+unsigned int PropertyDistanceField::getMemSize() const
+{
+    return _field ? static_cast<unsigned int>(_field->countNodes() * sizeof(float)) : 0;
+}
+
+// ----------------------------------------------------------------
+
 namespace Inspection
 {
 // helper class to use Qt's concurrent framework
@@ -770,6 +1501,30 @@ Feature::Feature()
     ADD_PROPERTY(Actual, (nullptr));
     ADD_PROPERTY(Nominals, (nullptr));
     ADD_PROPERTY(Distances, (0.0));
+    ADD_PROPERTY_TYPE(UseDistanceField,
+                      (false),
+                      "Base",
+                      App::Prop_None,
+                      "Keep a distance field of the mesh and point nominals to speed up repeated "
+                      "inspections");
+    ADD_PROPERTY_TYPE(DistanceFieldCache,
+                      (),
+                      "Base",
+                      App::PropertyType(App::Prop_Output | App::Prop_Hidden),
+                      "Distance field of the mesh and point nominals");
+    ADD_PROPERTY_TYPE(UseShapeTessellation,
+                      (false),
+                      "Base",
+                      App::Prop_None,
+                      "Search the nearest faces of shape nominals with a tessellation and "
+                      "inspect on several threads. This is faster than the exact distance "
+                      "computation but may fail to find the nearest face on coarse tessellations");
+    ADD_PROPERTY_TYPE(Deflection,
+                      (0.0),
+                      "Base",
+                      App::Prop_None,
+                      "Deflection used to tessellate shape nominals if UseShapeTessellation is "
+                      "set. If zero a thousandth of the diagonal of their bounding box is used");
 }
 
 Feature::~Feature() = default;
@@ -788,6 +1543,15 @@ short Feature::mustExecute() const
     if (Nominals.isTouched()) {
         return 1;
     }
+    if (UseDistanceField.isTouched()) {
+        return 1;
+    }
+    if (UseShapeTessellation.isTouched()) {
+        return 1;
+    }
+    if (Deflection.isTouched()) {
+        return 1;
+    }
     return 0;
 }
 
@@ -820,22 +1584,66 @@ App::DocumentObjectExecReturn* Feature::execute()
 
     // clang-format off
     // get a list of nominals
+    // meshes and points can be sampled into a distance field that is kept with the feature
+    bool useField = UseDistanceField.getValue() && this->SearchRadius.getValue() > 0;
+    std::vector<std::function<void(std::vector<Base::BoundBox3f>&)>> seedSources;
+    uint64_t key = 0;
     std::vector<InspectNominalGeometry*> inspectNominal;
+    std::vector<InspectNominalField::Factory> fieldNominal;
+    float radius = this->SearchRadius.getValue();
+    // cells close to the geometry fall back to the exact search, so the spacing of the field must
+    // be small compared to the search radius to leave enough cells to the field
+    float spacing = radius / 16.0F;
     const std::vector<App::DocumentObject*>& nominals = Nominals.getValues();
     for (auto it : nominals) {
         InspectNominalGeometry* nominal = nullptr;
         if (it->isDerivedFrom<Mesh::Feature>()) {
             Mesh::Feature* mesh = static_cast<Mesh::Feature*>(it);
-            nominal = new InspectNominalMesh(mesh->Mesh.getValue(), this->SearchRadius.getValue());
+            if (useField) {
+                const Mesh::MeshObject& kernel = mesh->Mesh.getValue();
+                hashFieldNominal(kernel, key);
+                seedSources.emplace_back([&kernel](std::vector<Base::BoundBox3f>& seeds) {
+                    addFieldSeeds(kernel, seeds);
+                });
+                fieldNominal.emplace_back([&kernel, radius]() {
+                    return std::make_unique<InspectNominalMesh>(kernel, radius);
+                });
+                continue;
+            }
+            nominal = new InspectNominalMesh(mesh->Mesh.getValue(), radius);
         }
         else if (it->isDerivedFrom<Points::Feature>()) {
             Points::Feature* pts = static_cast<Points::Feature*>(it);
-            nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
+            const Points::PointSource& source = pts->getPointSource();
+            Base::Matrix4D mat = pts->Placement.getValue().toMatrix();
+            if (useField) {
+                hashFieldNominal(source, mat, key);
+                seedSources.emplace_back(
+                    [&source, mat, spacing](std::vector<Base::BoundBox3f>& seeds) {
+                        addFieldSeeds(source, mat, spacing, seeds);
+                    });
+                fieldNominal.emplace_back([&source, mat, radius]() {
+                    return std::make_unique<InspectNominalPoints>(source, mat, radius);
+                });
+                continue;
+            }
+            nominal = new InspectNominalPoints(source, mat, radius);
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            if (!UseShapeTessellation.getValue()) {
+                useMultithreading = false;
+                nominal = new InspectNominalShape(part->Shape.getValue(), radius);
+            }
+            else {
+                const Part::TopoShape& shape = part->Shape.getShape();
+                double deflection = Deflection.getValue();
+                if (deflection <= 0.0) {
+                    deflection = shape.getBoundBox().CalcDiagonalLength() * 0.001;
+                }
+                deflection = std::max(deflection, Precision::Confusion());
+                nominal = new InspectNominalFastShape(shape.getShape(), radius, deflection);
+            }
         }
 
         if (nominal) {
@@ -844,6 +1652,32 @@ App::DocumentObjectExecReturn* Feature::execute()
     }
     // clang-format on
 
+    if (!fieldNominal.empty()) {
+        hashCombine(key, radius);
+        auto fieldNominals = new InspectNominalField(std::move(fieldNominal));
+        std::shared_ptr<const DistanceField> field = DistanceFieldCache.getValue();
+        if (!field || field->getKey() != key) {
+            // the seeds are only collected if the field must be rebuilt
+            std::vector<Base::BoundBox3f> seeds;
+            for (const auto& addSeeds : seedSources) {
+                addSeeds(seeds);
+            }
+            auto newField = std::make_shared<DistanceField>();
+            auto distance = [fieldNominals](const Base::Vector3f& pnt) {
+                return fieldNominals->getExactDistance(pnt);
+            };
+            newField->build(seeds, spacing, radius, distance);
+            newField->setKey(key);
+            DistanceFieldCache.setValue(newField);
+            field = newField;
+        }
+        fieldNominals->setField(field);
+        inspectNominal.push_back(fieldNominals);
+    }
+    else if (DistanceFieldCache.getValue()) {
+        DistanceFieldCache.setValue(nullptr);
+    }
+
 #if 0
 #if 1  // test with some huge data sets
     std::vector<unsigned long> index(actual->countPoints());
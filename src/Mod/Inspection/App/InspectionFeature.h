@@ -23,6 +23,10 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -46,7 +50,7 @@ class MeshObject;
 }
 namespace Points
 {
-class PointsGrid;
+class PointsKDTree;
 }
 namespace Part
 {
@@ -56,6 +60,8 @@ class TopoShape;
 namespace Inspection
 {
 
+class DistanceField;
+
 /** Delivers the number of points to be checked and returns the appropriate point to an index. */
 class InspectionExport InspectActualGeometry
 {
@@ -151,12 +157,20 @@ class InspectionExport InspectNominalPoints: public InspectNominalGeometry
 {
 public:
     InspectNominalPoints(const Points::PointKernel&, float offset);
+    /** Uses the points of \a source transformed with the rigid transformation \a mat. If
+     * \a offset is positive the points are read tile by tile when they are needed and only
+     * distances up to \a offset are exact, a larger distance is only known to be larger.
+     */
+    InspectNominalPoints(const Points::PointSource& source,
+                         const Base::Matrix4D& mat,
+                         float offset);
     ~InspectNominalPoints() override;
     float getDistance(const Base::Vector3f&) const override;
 
 private:
-    const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    class Tiles;
+    Points::PointsKDTree* _pTree {nullptr};
+    std::unique_ptr<Tiles> _tiles;
 };
 
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
@@ -176,6 +190,48 @@ private:
     bool isSolid {false};
 };
 
+/** Calculates the distance to a shape much faster than InspectNominalShape.
+ * The shape is tessellated once with the given deflection and a bounding volume hierarchy over
+ * the triangles yields the faces that may hold the nearest point. The point is then projected
+ * onto the surfaces of these faces, starting at the parameters of the nearest triangle. Only if
+ * the nearest point lies on the boundary of a face the exact distance to this face is computed.
+ * Unlike InspectNominalShape this class can be used from several threads at the same time.
+ */
+class InspectionExport InspectNominalFastShape: public InspectNominalGeometry
+{
+public:
+    InspectNominalFastShape(const TopoDS_Shape&, float offset, double deflection);
+    ~InspectNominalFastShape() override;
+    float getDistance(const Base::Vector3f&) const override;
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+/** Looks up the distance of points within the band of a precomputed distance field.
+ * For all other points the smallest distance to the nominals is computed. The nominals are only
+ * created when they are needed for the first time, because their search structures are expensive.
+ */
+class InspectionExport InspectNominalField: public InspectNominalGeometry
+{
+public:
+    using Factory = std::function<std::unique_ptr<InspectNominalGeometry>()>;
+
+    explicit InspectNominalField(std::vector<Factory> factories);
+    ~InspectNominalField() override;
+    void setField(std::shared_ptr<const DistanceField> field);
+    float getDistance(const Base::Vector3f&) const override;
+    /// Returns the smallest distance to the nominals without using the field.
+    float getExactDistance(const Base::Vector3f&) const;
+
+private:
+    std::shared_ptr<const DistanceField> _field;
+    std::vector<Factory> _factories;
+    mutable std::vector<std::unique_ptr<InspectNominalGeometry>> _nominals;
+    mutable std::once_flag _created;
+};
+
 class InspectionExport PropertyDistanceList: public App::PropertyLists
 {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -234,6 +290,35 @@ private:
     std::vector<float> _lValueList;
 };
 
+/** Stores a distance field with the document. */
+class InspectionExport PropertyDistanceField: public App::Property
+{
+    TYPESYSTEM_HEADER_WITH_OVERRIDE();
+
+public:
+    PropertyDistanceField();
+    ~PropertyDistanceField() override;
+
+    void setValue(std::shared_ptr<const DistanceField>);
+    const std::shared_ptr<const DistanceField>& getValue() const
+    {
+        return _field;
+    }
+
+    void Save(Base::Writer& writer) const override;
+    void Restore(Base::XMLReader& reader) override;
+
+    void SaveDocFile(Base::Writer& writer) const override;
+    void RestoreDocFile(Base::Reader& reader) override;
+
+    Property* Copy() const override;
+    void Paste(const Property& from) override;
+    unsigned int getMemSize() const override;
+
+private:
+    std::shared_ptr<const DistanceField> _field;
+};
+
 // ----------------------------------------------------------------
 
 /** The inspection feature.
@@ -255,6 +340,10 @@ public:
     App::PropertyLink Actual;
     App::PropertyLinkList Nominals;
     PropertyDistanceList Distances;
+    App::PropertyBool UseDistanceField;
+    PropertyDistanceField DistanceFieldCache;
+    App::PropertyBool UseShapeTessellation;
+    App::PropertyFloat Deflection;
     //@}
 
     /** @name Actions */
@@ -46,6 +46,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -99,6 +100,19 @@ public:
                            const MeshFacetGrid& rclGrid,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method is optimized by using a bounding volume hierarchy which,
+     * unlike a grid, adapts to meshes with uneven facet density.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclTree,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the nearest facet to the ray defined by
      * (\a rclPt, \a rclDir).
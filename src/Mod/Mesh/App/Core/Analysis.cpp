@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#endif
+
+#include "Analysis.h"
+#include "BVH.h"
+#include "Degeneration.h"
+#include "Evaluation.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+bool MeshAnalysis::Report::IsEmpty() const
+{
+    return orientation.empty() && nonManifolds.empty() && nonManifoldPoints.empty()
+        && invalidFacets.empty() && invalidPoints.empty() && degenerations.empty()
+        && duplicatedFacets.empty() && duplicatedPoints.empty() && selfIntersections.empty()
+        && folds.empty() && pointsOnEdge.empty();
+}
+
+MeshAnalysis::MeshAnalysis(const MeshKernel& mesh)
+    : _rclMesh(mesh)
+    , _fEpsilon(0.0F)
+{}
+
+MeshAnalysis::Report MeshAnalysis::Evaluate(int checks) const
+{
+    Report report;
+
+    if (checks & Orientation) {
+        MeshEvalOrientation eval(_rclMesh);
+        report.orientation = eval.GetIndices();
+    }
+
+    if (checks & NonManifolds) {
+        MeshEvalTopology eval(_rclMesh);
+        if (!eval.Evaluate()) {
+            report.nonManifolds = eval.GetIndices();
+        }
+    }
+
+    if (checks & NonManifoldPoints) {
+        MeshEvalPointManifolds eval(_rclMesh);
+        if (!eval.Evaluate()) {
+            report.nonManifoldPoints = eval.GetIndices();
+        }
+    }
+
+    if (checks & Indices) {
+        MeshEvalRangeFacet rf(_rclMesh);
+        MeshEvalRangePoint rp(_rclMesh);
+        MeshEvalCorruptedFacets cf(_rclMesh);
+        MeshEvalNeighbourhood nb(_rclMesh);
+        // the other checks rely on valid point indices
+        if (!rp.Evaluate()) {
+            report.invalidPoints = rp.GetIndices();
+        }
+        if (!rf.Evaluate()) {
+            report.invalidFacets = rf.GetIndices();
+        }
+        else if (report.invalidPoints.empty()) {
+            if (!cf.Evaluate()) {
+                report.invalidFacets = cf.GetIndices();
+            }
+            if (!nb.Evaluate()) {
+                std::vector<FacetIndex> inds = nb.GetIndices();
+                report.invalidFacets.insert(report.invalidFacets.end(), inds.begin(), inds.end());
+            }
+            std::sort(report.invalidFacets.begin(), report.invalidFacets.end());
+            report.invalidFacets.erase(
+                std::unique(report.invalidFacets.begin(), report.invalidFacets.end()),
+                report.invalidFacets.end());
+        }
+    }
+
+    if (checks & Degenerations) {
+        MeshEvalDegeneratedFacets eval(_rclMesh, _fEpsilon);
+        report.degenerations = eval.GetIndices();
+    }
+
+    if (checks & DuplicatedFacets) {
+        MeshEvalDuplicateFacets eval(_rclMesh);
+        report.duplicatedFacets = eval.GetIndices();
+    }
+
+    if (checks & DuplicatedPoints) {
+        MeshEvalDuplicatePoints eval(_rclMesh);
+        if (!eval.Evaluate()) {
+            report.duplicatedPoints = eval.GetIndices();
+        }
+    }
+
+    if (checks & Folds) {
+        MeshEvalFoldsOnSurface s_eval(_rclMesh);
+        MeshEvalFoldsOnBoundary b_eval(_rclMesh);
+        MeshEvalFoldOversOnSurface f_eval(_rclMesh);
+        s_eval.Evaluate();
+        b_eval.Evaluate();
+        f_eval.Evaluate();
+
+        std::vector<FacetIndex>& inds = report.folds;
+        inds = f_eval.GetIndices();
+        std::vector<FacetIndex> inds1 = s_eval.GetIndices();
+        std::vector<FacetIndex> inds2 = b_eval.GetIndices();
+        inds.insert(inds.end(), inds1.begin(), inds1.end());
+        inds.insert(inds.end(), inds2.begin(), inds2.end());
+        std::sort(inds.begin(), inds.end());
+        inds.erase(std::unique(inds.begin(), inds.end()), inds.end());
+    }
+
+    // the geometric checks share one BVH
+    if (checks & (SelfIntersections | PointsOnEdge)) {
+        MeshFacetBVH tree(_rclMesh);
+        if (checks & SelfIntersections) {
+            MeshEvalSelfIntersection eval(_rclMesh, tree);
+            eval.GetIntersections(report.selfIntersections);
+        }
+        if (checks & PointsOnEdge) {
+            MeshEvalPointOnEdge eval(_rclMesh, tree);
+            if (!eval.Evaluate()) {
+                report.pointsOnEdge = eval.GetPointIndices();
+            }
+        }
+    }
+
+    return report;
+}
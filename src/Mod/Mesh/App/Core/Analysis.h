@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_ANALYSIS_H
+#define MESH_ANALYSIS_H
+
+#include <utility>
+#include <vector>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshAnalysis class runs a selection of the MeshEval* checks on a mesh and collects
+ * the found defects in one report. The bounding volume hierarchy needed by the geometric
+ * checks is built only once and shared between them, and these checks run in several threads.
+ */
+class MeshExport MeshAnalysis
+{
+public:
+    enum Check
+    {
+        Orientation = 1 << 0,
+        NonManifolds = 1 << 1,
+        NonManifoldPoints = 1 << 2,
+        Indices = 1 << 3,
+        Degenerations = 1 << 4,
+        DuplicatedFacets = 1 << 5,
+        DuplicatedPoints = 1 << 6,
+        SelfIntersections = 1 << 7,
+        Folds = 1 << 8,
+        PointsOnEdge = 1 << 9,
+        All = (1 << 10) - 1
+    };
+
+    struct Report
+    {
+        /// Facets with a wrong orientation
+        std::vector<FacetIndex> orientation;
+        /// Facet pairs with non-manifold edges
+        std::vector<std::pair<FacetIndex, FacetIndex>> nonManifolds;
+        /// Non-manifold points
+        std::vector<PointIndex> nonManifoldPoints;
+        /// Facets with invalid point or neighbour indices
+        std::vector<FacetIndex> invalidFacets;
+        /// Invalid point indices
+        std::vector<PointIndex> invalidPoints;
+        /// Degenerated facets
+        std::vector<FacetIndex> degenerations;
+        /// Duplicated facets
+        std::vector<FacetIndex> duplicatedFacets;
+        /// Duplicated points
+        std::vector<PointIndex> duplicatedPoints;
+        /// Pairs of self-intersecting facets
+        std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
+        /// Folded facets
+        std::vector<FacetIndex> folds;
+        /// Points that lie on an edge of a facet
+        std::vector<PointIndex> pointsOnEdge;
+
+        /// Returns true if no defect was found
+        bool IsEmpty() const;
+    };
+
+    explicit MeshAnalysis(const MeshKernel& mesh);
+
+    /// Sets the tolerance used to check for degenerated facets
+    void SetEpsilon(float eps)
+    {
+        _fEpsilon = eps;
+    }
+    /// Runs the checks given by the bit mask \a checks and returns the defects
+    Report Evaluate(int checks = All) const;
+
+private:
+    const MeshKernel& _rclMesh;
+    float _fEpsilon;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_ANALYSIS_H
@@ -0,0 +1,596 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#endif
+
+#include "BVH.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// Maximum number of triangles stored in one leaf
+constexpr uint32_t MaxLeafSize = 4;
+// Leaves are forced beyond this number of triangles only if splitting does not pay off
+constexpr uint32_t MaxLeafSizeSAH = 16;
+// Limits the recursion depth and the size of the traversal stack
+constexpr int MaxDepth = 60;
+constexpr int StackSize = 2 * MaxDepth + 4;
+// Number of bins per axis used to evaluate the surface area heuristic
+constexpr int NumBins = 16;
+// Relative cost of a node traversal compared to a triangle test
+constexpr float TraversalCost = 1.0F;
+
+float HalfArea(const Base::BoundBox3f& box)
+{
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return dx * dy + dy * dz + dz * dx;
+}
+}  // namespace
+
+struct MeshFacetBVH::BuildItem
+{
+    Base::BoundBox3f box;
+    Base::Vector3f center;
+    FacetIndex index;
+};
+
+MeshFacetBVH::MeshFacetBVH() = default;
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM)
+    : _pclMesh(&rclM)
+{
+    Rebuild();
+}
+
+void MeshFacetBVH::Attach(const MeshKernel& rclM)
+{
+    _pclMesh = &rclM;
+    Rebuild();
+}
+
+void MeshFacetBVH::Clear()
+{
+    _aclNodes.clear();
+    _aclTriangles.clear();
+    _aulIndices.clear();
+    _ulCtElements = 0;
+}
+
+void MeshFacetBVH::Validate()
+{
+    if (_pclMesh && _pclMesh->CountFacets() != _ulCtElements) {
+        Rebuild();
+    }
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    Clear();
+    if (!_pclMesh) {
+        return;
+    }
+
+    const MeshPointArray& points = _pclMesh->GetPoints();
+    const MeshFacetArray& facets = _pclMesh->GetFacets();
+    _ulCtElements = facets.size();
+    if (facets.empty()) {
+        return;
+    }
+
+    std::vector<BuildItem> items;
+    items.reserve(facets.size());
+    FacetIndex index = 0;
+    for (const auto& facet : facets) {
+        BuildItem item;
+        item.box.Add(points[facet._aulPoints[0]]);
+        item.box.Add(points[facet._aulPoints[1]]);
+        item.box.Add(points[facet._aulPoints[2]]);
+        item.center = item.box.GetCenter();
+        item.index = index++;
+        items.push_back(item);
+    }
+
+    _aclNodes.reserve(2 * facets.size() / MaxLeafSize + 1);
+    BuildNode(items, 0, static_cast<uint32_t>(items.size()), 0);
+
+    // store the triangles in leaf order so that a leaf accesses a contiguous range
+    _aclTriangles.reserve(items.size());
+    _aulIndices.reserve(items.size());
+    for (const auto& item : items) {
+        const MeshFacet& facet = facets[item.index];
+        const Base::Vector3f& p0 = points[facet._aulPoints[0]];
+        const Base::Vector3f& p1 = points[facet._aulPoints[1]];
+        const Base::Vector3f& p2 = points[facet._aulPoints[2]];
+        _aclTriangles.push_back({p0, p1 - p0, p2 - p0});
+        _aulIndices.push_back(item.index);
+    }
+}
+
+uint32_t
+MeshFacetBVH::BuildNode(std::vector<BuildItem>& items, uint32_t first, uint32_t last, int depth)
+{
+    auto nodeIndex = static_cast<uint32_t>(_aclNodes.size());
+    _aclNodes.emplace_back();
+
+    Base::BoundBox3f bounds;
+    Base::BoundBox3f centers;
+    for (uint32_t i = first; i < last; i++) {
+        bounds.Add(items[i].box);
+        centers.Add(items[i].center);
+    }
+
+    {
+        Node& node = _aclNodes[nodeIndex];
+        node.bmin[0] = bounds.MinX;
+        node.bmin[1] = bounds.MinY;
+        node.bmin[2] = bounds.MinZ;
+        node.bmax[0] = bounds.MaxX;
+        node.bmax[1] = bounds.MaxY;
+        node.bmax[2] = bounds.MaxZ;
+    }
+
+    uint32_t count = last - first;
+    if (count <= MaxLeafSize || depth >= MaxDepth) {
+        _aclNodes[nodeIndex].offset = first;
+        _aclNodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    // evaluate the surface area heuristic with binning on all three axes
+    const std::array<float, 3> cmin = {centers.MinX, centers.MinY, centers.MinZ};
+    const std::array<float, 3> cmax = {centers.MaxX, centers.MaxY, centers.MaxZ};
+
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    int bestSplit = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float extent = cmax[axis] - cmin[axis];
+        if (extent <= 0.0F) {
+            continue;
+        }
+
+        std::array<Base::BoundBox3f, NumBins> binBoxes;
+        std::array<uint32_t, NumBins> binCounts {};
+        float scale = float(NumBins) / extent;
+        for (uint32_t i = first; i < last; i++) {
+            const Base::Vector3f& c = items[i].center;
+            float value = axis == 0 ? c.x : (axis == 1 ? c.y : c.z);
+            int bin = std::min(static_cast<int>((value - cmin[axis]) * scale), NumBins - 1);
+            binCounts[bin]++;
+            binBoxes[bin].Add(items[i].box);
+        }
+
+        // sweep from the right to get the area and count of all right partitions
+        std::array<float, NumBins> rightArea {};
+        std::array<uint32_t, NumBins> rightCount {};
+        Base::BoundBox3f box;
+        uint32_t num = 0;
+        for (int i = NumBins - 1; i > 0; i--) {
+            box.Add(binBoxes[i]);
+            num += binCounts[i];
+            rightArea[i] = num > 0 ? HalfArea(box) : 0.0F;
+            rightCount[i] = num;
+        }
+
+        box = Base::BoundBox3f();
+        num = 0;
+        for (int i = 0; i < NumBins - 1; i++) {
+            box.Add(binBoxes[i]);
+            num += binCounts[i];
+            if (num == 0 || rightCount[i + 1] == 0) {
+                continue;
+            }
+            float cost = HalfArea(box) * float(num) + rightArea[i + 1] * float(rightCount[i + 1]);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i + 1;
+            }
+        }
+    }
+
+    float leafCost = HalfArea(bounds) * float(count);
+    float splitCost = HalfArea(bounds) * TraversalCost + bestCost;
+    if (bestAxis < 0 || (splitCost >= leafCost && count <= MaxLeafSizeSAH)) {
+        if (bestAxis < 0 && count > MaxLeafSizeSAH) {
+            // all centers coincide, split by count to keep the leaves small
+            bestAxis = 0;
+            bestSplit = -1;
+        }
+        else {
+            _aclNodes[nodeIndex].offset = first;
+            _aclNodes[nodeIndex].count = count;
+            return nodeIndex;
+        }
+    }
+
+    auto it1 = items.begin() + first;
+    auto it2 = items.begin() + last;
+    auto mid = it1;
+    if (bestSplit >= 0) {
+        float extent = cmax[bestAxis] - cmin[bestAxis];
+        float scale = float(NumBins) / extent;
+        float base = cmin[bestAxis];
+        int axis = bestAxis;
+        int split = bestSplit;
+        mid = std::partition(it1, it2, [=](const BuildItem& item) {
+            const Base::Vector3f& c = item.center;
+            float value = axis == 0 ? c.x : (axis == 1 ? c.y : c.z);
+            int bin = std::min(static_cast<int>((value - base) * scale), NumBins - 1);
+            return bin < split;
+        });
+    }
+
+    if (mid == it1 || mid == it2) {
+        mid = it1 + count / 2;
+        std::nth_element(it1, mid, it2, [=](const BuildItem& a, const BuildItem& b) {
+            return a.index < b.index;
+        });
+    }
+
+    auto split = static_cast<uint32_t>(mid - items.begin());
+    BuildNode(items, first, split, depth + 1);
+    uint32_t right = BuildNode(items, split, last, depth + 1);
+
+    Node& node = _aclNodes[nodeIndex];
+    node.offset = right;
+    node.count = 0;
+    return nodeIndex;
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (_aclNodes.empty()) {
+        return Base::BoundBox3f();
+    }
+
+    const Node& root = _aclNodes.front();
+    return Base::BoundBox3f(root.bmin[0],
+                            root.bmin[1],
+                            root.bmin[2],
+                            root.bmax[0],
+                            root.bmax[1],
+                            root.bmax[2]);
+}
+
+bool MeshFacetBVH::Verify() const
+{
+    if (!_pclMesh) {
+        return false;
+    }
+    if (_aclNodes.empty()) {
+        return _pclMesh->CountFacets() == 0;
+    }
+    if (_aulIndices.size() != _pclMesh->CountFacets()) {
+        return false;
+    }
+
+    std::vector<bool> used(_aulIndices.size(), false);
+    for (std::size_t i = 0; i < _aclNodes.size(); i++) {
+        const Node& node = _aclNodes[i];
+        Base::BoundBox3f box(node.bmin[0],
+                             node.bmin[1],
+                             node.bmin[2],
+                             node.bmax[0],
+                             node.bmax[1],
+                             node.bmax[2]);
+        if (node.count == 0) {
+            if (node.offset <= i + 1 || node.offset >= _aclNodes.size()) {
+                return false;
+            }
+            continue;
+        }
+
+        if (std::size_t(node.offset) + node.count > _aclTriangles.size()) {
+            return false;
+        }
+        for (uint32_t j = node.offset; j < node.offset + node.count; j++) {
+            const Triangle& tria = _aclTriangles[j];
+            if (!box.IsInBox(tria.p0) || !box.IsInBox(tria.p0 + tria.e1)
+                || !box.IsInBox(tria.p0 + tria.e2)) {
+                return false;
+            }
+            FacetIndex index = _aulIndices[j];
+            if (index >= used.size() || used[index]) {
+                return false;
+            }
+            used[index] = true;
+        }
+    }
+
+    return std::find(used.begin(), used.end(), false) == used.end();
+}
+
+bool MeshFacetBVH::IntersectBox(const Node& node,
+                                const Base::Vector3f& org,
+                                const Base::Vector3f& invDir,
+                                float tmax,
+                                float& tnear)
+{
+    // slab test, fmin/fmax ignore the NaN that results from 0 * inf
+    float tx1 = (node.bmin[0] - org.x) * invDir.x;
+    float tx2 = (node.bmax[0] - org.x) * invDir.x;
+    float ty1 = (node.bmin[1] - org.y) * invDir.y;
+    float ty2 = (node.bmax[1] - org.y) * invDir.y;
+    float tz1 = (node.bmin[2] - org.z) * invDir.z;
+    float tz2 = (node.bmax[2] - org.z) * invDir.z;
+
+    float t0 = std::fmax(std::fmax(std::fmin(tx1, tx2), std::fmin(ty1, ty2)), std::fmin(tz1, tz2));
+    float t1 = std::fmin(std::fmin(std::fmax(tx1, tx2), std::fmax(ty1, ty2)), std::fmax(tz1, tz2));
+
+    t0 = std::fmax(t0, 0.0F);
+    t1 = std::fmin(t1, tmax);
+    tnear = t0;
+    return t0 <= t1;
+}
+
+bool MeshFacetBVH::IntersectTriangle(const Triangle& tria,
+                                     const Base::Vector3f& org,
+                                     const Base::Vector3f& dir,
+                                     float& tHit)
+{
+    // Moeller-Trumbore
+    Base::Vector3f pvec = dir % tria.e2;
+    float det = tria.e1 * pvec;
+    if (det == 0.0F) {
+        return false;
+    }
+
+    float invDet = 1.0F / det;
+    Base::Vector3f tvec = org - tria.p0;
+    float u = (tvec * pvec) * invDet;
+    if (u < 0.0F || u > 1.0F) {
+        return false;
+    }
+
+    Base::Vector3f qvec = tvec % tria.e1;
+    float v = (dir * qvec) * invDet;
+    if (v < 0.0F || u + v > 1.0F) {
+        return false;
+    }
+
+    float t = (tria.e2 * qvec) * invDet;
+    if (t < 0.0F) {
+        return false;
+    }
+
+    tHit = t;
+    return true;
+}
+
+float MeshFacetBVH::DistanceToBoxP2(const Node& node, const Base::Vector3f& pnt)
+{
+    float dx = std::max({node.bmin[0] - pnt.x, 0.0F, pnt.x - node.bmax[0]});
+    float dy = std::max({node.bmin[1] - pnt.y, 0.0F, pnt.y - node.bmax[1]});
+    float dz = std::max({node.bmin[2] - pnt.z, 0.0F, pnt.z - node.bmax[2]});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet,
+                                     float fMaxDist) const
+{
+    if (_aclNodes.empty()) {
+        return false;
+    }
+
+    Base::Vector3f dir(rclDir);
+    dir.Normalize();
+    if (dir.IsNull()) {
+        return false;
+    }
+
+    const float inf = std::numeric_limits<float>::infinity();
+    Base::Vector3f invDir(dir.x != 0.0F ? 1.0F / dir.x : inf,
+                          dir.y != 0.0F ? 1.0F / dir.y : inf,
+                          dir.z != 0.0F ? 1.0F / dir.z : inf);
+
+    float best = fMaxDist;
+    uint32_t hit = std::numeric_limits<uint32_t>::max();
+
+    std::array<uint32_t, StackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        uint32_t index = stack[--top];
+        const Node& node = _aclNodes[index];
+        float tnear {};
+        if (!IntersectBox(node, rclPt, invDir, best, tnear)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                float t {};
+                if (IntersectTriangle(_aclTriangles[i], rclPt, dir, t) && t <= best) {
+                    best = t;
+                    hit = i;
+                }
+            }
+            continue;
+        }
+
+        // push the farther child first so that the nearer one is processed next
+        uint32_t left = index + 1;
+        uint32_t right = node.offset;
+        float tl {};
+        float tr {};
+        bool hitL = IntersectBox(_aclNodes[left], rclPt, invDir, best, tl);
+        bool hitR = IntersectBox(_aclNodes[right], rclPt, invDir, best, tr);
+        if (hitL && hitR) {
+            if (tl > tr) {
+                std::swap(left, right);
+            }
+            stack[top++] = right;
+            stack[top++] = left;
+        }
+        else if (hitL) {
+            stack[top++] = left;
+        }
+        else if (hitR) {
+            stack[top++] = right;
+        }
+    }
+
+    if (hit == std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    rclRes = rclPt + best * dir;
+    rulFacet = _aulIndices[hit];
+    return true;
+}
+
+FacetIndex MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& rclPt, float fMaxDist) const
+{
+    Base::Vector3f res;
+    float dist {};
+    return SearchNearestFromPoint(rclPt, fMaxDist, res, dist);
+}
+
+FacetIndex MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& rclPt,
+                                                float fMaxDist,
+                                                Base::Vector3f& rclRes,
+                                                float& rfDist) const
+{
+    if (_aclNodes.empty()) {
+        return FACET_INDEX_MAX;
+    }
+
+    float bestDist = fMaxDist;
+    float bestDist2 = fMaxDist < std::sqrt(std::numeric_limits<float>::max())
+        ? fMaxDist * fMaxDist
+        : std::numeric_limits<float>::max();
+    FacetIndex hit = FACET_INDEX_MAX;
+
+    std::array<uint32_t, StackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        uint32_t index = stack[--top];
+        const Node& node = _aclNodes[index];
+        if (DistanceToBoxP2(node, rclPt) > bestDist2) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = _aclTriangles[i];
+                MeshGeomFacet facet(tria.p0, tria.p0 + tria.e1, tria.p0 + tria.e2);
+                Base::Vector3f res;
+                float dist = facet.DistanceToPoint(rclPt, res);
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    bestDist2 = dist * dist;
+                    rclRes = res;
+                    hit = _aulIndices[i];
+                }
+            }
+            continue;
+        }
+
+        uint32_t left = index + 1;
+        uint32_t right = node.offset;
+        float dl = DistanceToBoxP2(_aclNodes[left], rclPt);
+        float dr = DistanceToBoxP2(_aclNodes[right], rclPt);
+        if (dl > dr) {
+            std::swap(left, right);
+            std::swap(dl, dr);
+        }
+        if (dr <= bestDist2) {
+            stack[top++] = right;
+        }
+        if (dl <= bestDist2) {
+            stack[top++] = left;
+        }
+    }
+
+    if (hit != FACET_INDEX_MAX) {
+        rfDist = bestDist;
+    }
+    return hit;
+}
+
+unsigned long MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB,
+                                   std::vector<FacetIndex>& raulElements) const
+{
+    if (_aclNodes.empty()) {
+        return 0;
+    }
+
+    std::size_t start = raulElements.size();
+    std::array<uint32_t, StackSize> stack {};
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        uint32_t index = stack[--top];
+        const Node& node = _aclNodes[index];
+        Base::BoundBox3f box(node.bmin[0],
+                             node.bmin[1],
+                             node.bmin[2],
+                             node.bmax[0],
+                             node.bmax[1],
+                             node.bmax[2]);
+        if (!box.Intersect(rclBB)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = _aclTriangles[i];
+                Base::BoundBox3f triaBox;
+                triaBox.Add(tria.p0);
+                triaBox.Add(tria.p0 + tria.e1);
+                triaBox.Add(tria.p0 + tria.e2);
+                if (triaBox.Intersect(rclBB)) {
+                    raulElements.push_back(_aulIndices[i]);
+                }
+            }
+        }
+        else {
+            stack[top++] = node.offset;
+            stack[top++] = index + 1;
+        }
+    }
+
+    return static_cast<unsigned long>(raulElements.size() - start);
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ * It is built with the surface area heuristic (SAH) and stored as a flat array of nodes
+ * in depth-first order, so that a node's left child always directly follows its parent.
+ *
+ * Unlike MeshFacetGrid the subdivision adapts to the facet distribution, which keeps ray
+ * casting and nearest-facet queries fast on meshes with very uneven triangle density
+ * (e.g. scans with dense features next to large flat areas) while using much less memory.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /** @name Construction */
+    //@{
+    /// Construction
+    MeshFacetBVH();
+    /// Construction
+    explicit MeshFacetBVH(const MeshKernel& rclM);
+    MeshFacetBVH(const MeshFacetBVH&) = default;
+    MeshFacetBVH(MeshFacetBVH&&) = default;
+    /// Destruction
+    ~MeshFacetBVH() = default;
+    MeshFacetBVH& operator=(const MeshFacetBVH&) = default;
+    MeshFacetBVH& operator=(MeshFacetBVH&&) = default;
+    //@}
+
+    /** Attaches the mesh kernel to this tree and rebuilds it. */
+    void Attach(const MeshKernel& rclM);
+    /** Rebuilds the tree from the attached mesh. */
+    void Rebuild();
+    /** Removes all nodes. */
+    void Clear();
+    /** Rebuilds the tree if the number of facets of the attached mesh has changed. */
+    void Validate();
+    /** Returns true if the tree holds no facets. */
+    bool IsEmpty() const
+    {
+        return _aclNodes.empty();
+    }
+    /** Returns the number of nodes of the tree. */
+    unsigned long CountNodes() const
+    {
+        return static_cast<unsigned long>(_aclNodes.size());
+    }
+    /** Returns the bounding box of all facets. */
+    Base::BoundBox3f GetBoundBox() const;
+    /** Verifies the tree structure and returns false if inconsistencies are found. */
+    bool Verify() const;
+
+    /** @name Search */
+    //@{
+    /** Searches for the first facet hit by the ray defined by (\a rclPt, \a rclDir).
+     * Only intersections in direction of \a rclDir and not farther than \a fMaxDist from
+     * \a rclPt are taken into account. If a facet is found its index is set to \a rulFacet,
+     * the intersection point to \a rclRes and true is returned.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet,
+                           float fMaxDist = std::numeric_limits<float>::max()) const;
+    /** Searches for the nearest facet from a point. If no facet lies within the distance
+     * \a fMaxDist FACET_INDEX_MAX is returned.
+     */
+    FacetIndex
+    SearchNearestFromPoint(const Base::Vector3f& rclPt,
+                           float fMaxDist = std::numeric_limits<float>::max()) const;
+    /** Searches for the nearest facet from a point. \a rclRes is set to the nearest point on
+     * the facet and \a rfDist to its distance. If no facet lies within the distance
+     * \a fMaxDist FACET_INDEX_MAX is returned.
+     */
+    FacetIndex SearchNearestFromPoint(const Base::Vector3f& rclPt,
+                                      float fMaxDist,
+                                      Base::Vector3f& rclRes,
+                                      float& rfDist) const;
+    /** Searches for facets whose bounding boxes intersect with \a rclBB. */
+    unsigned long Inside(const Base::BoundBox3f& rclBB,
+                         std::vector<FacetIndex>& raulElements) const;
+    //@}
+
+private:
+    struct Node
+    {
+        // NOLINTBEGIN
+        float bmin[3];
+        float bmax[3];
+        /** For leaves the first triangle, otherwise the index of the right child. */
+        uint32_t offset;
+        /** Number of triangles, zero for inner nodes. */
+        uint32_t count;
+        // NOLINTEND
+    };
+
+    struct Triangle
+    {
+        Base::Vector3f p0;
+        Base::Vector3f e1;
+        Base::Vector3f e2;
+    };
+
+    struct BuildItem;
+    uint32_t BuildNode(std::vector<BuildItem>& items, uint32_t first, uint32_t last, int depth);
+
+    static bool IntersectBox(const Node& node,
+                             const Base::Vector3f& org,
+                             const Base::Vector3f& invDir,
+                             float tmax,
+                             float& tnear);
+    static bool IntersectTriangle(const Triangle& tria,
+                                  const Base::Vector3f& org,
+                                  const Base::Vector3f& dir,
+                                  float& tHit);
+    static float DistanceToBoxP2(const Node& node, const Base::Vector3f& pnt);
+
+private:
+    std::vector<Node> _aclNodes;         /**< Nodes in depth-first order. */
+    std::vector<Triangle> _aclTriangles; /**< Triangles in leaf order. */
+    std::vector<FacetIndex> _aulIndices; /**< Facet index of each triangle. */
+    const MeshKernel* _pclMesh {nullptr};
+    unsigned long _ulCtElements {0};
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_BVH_H
@@ -368,7 +368,7 @@ void MeshFastBuilder::Finish()
     }
 
     // std::sort(verts.begin(), verts.end());
-    int threads = int(std::thread::hardware_concurrency());
+    int threads = MeshCore::count_threads(verts.size());
     MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
 
     QVector<FacetIndex> indices(ulCtPts);
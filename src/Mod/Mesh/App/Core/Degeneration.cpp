@@ -25,13 +25,15 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <queue>
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include "BVH.h"
 #include "Degeneration.h"
-#include "Grid.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 #include "Triangulation.h"
@@ -1224,11 +1226,18 @@ bool MeshFixCorruptedFacets::Fixup()
 
 bool MeshEvalPointOnEdge::Evaluate()
 {
-    MeshFacetGrid facetGrid(_rclMesh);
+    std::unique_ptr<MeshFacetBVH> ownTree;
+    const MeshFacetBVH* tree = _tree;
+    if (!tree) {
+        ownTree = std::make_unique<MeshFacetBVH>(_rclMesh);
+        tree = ownTree.get();
+    }
+
+    const float tolerance = 0.001F;
     const MeshPointArray& points = _rclMesh.GetPoints();
     const MeshFacetArray& facets = _rclMesh.GetFacets();
 
-    auto IsPointOnEdge = [&points](PointIndex idx, const MeshFacet& facet) {
+    auto IsPointOnEdge = [&points, tolerance](PointIndex idx, const MeshFacet& facet) {
         // point must not be a corner of the facet
         if (!facet.HasPoint(idx)) {
             for (int i = 0; i < 3; i++) {
@@ -1237,7 +1246,7 @@ bool MeshEvalPointOnEdge::Evaluate()
                 edge._aclPoints[1] = points[facet._aulPoints[(i + 1) % 3]];
 
                 if (edge.GetBoundBox().IsInBox(points[idx])) {
-                    if (edge.IsPointOf(points[idx], 0.001F)) {
+                    if (edge.IsPointOf(points[idx], tolerance)) {
                         return true;
                     }
                 }
@@ -1246,20 +1255,36 @@ bool MeshEvalPointOnEdge::Evaluate()
         return false;
     };
 
-    PointIndex maxPoints = _rclMesh.CountPoints();
-    for (PointIndex i = 0; i < maxPoints; i++) {
+    // Each thread checks a block of points, the results are merged in order of the points
+    using Result = std::pair<std::vector<PointIndex>, std::vector<FacetIndex>>;
+    int threads = MeshCore::count_threads(points.size());
+    std::vector<Result> blocks(threads);
+    auto check = [&](std::size_t block, std::size_t first, std::size_t last) {
         std::vector<FacetIndex> elements;
-        facetGrid.GetElements(points[i], elements);
-
-        for (const auto& it : elements) {
-            const MeshFacet& face = facets[it];
-            if (IsPointOnEdge(i, face)) {
-                pointsIndices.push_back(i);
-                if (face.HasOpenEdge()) {
-                    facetsIndices.push_back(it);
+        for (std::size_t i = first; i < last; i++) {
+            Base::BoundBox3f box;
+            box.Add(points[i]);
+            box.Enlarge(tolerance);
+            elements.clear();
+            tree->Inside(box, elements);
+            std::sort(elements.begin(), elements.end());
+
+            for (const auto& it : elements) {
+                const MeshFacet& face = facets[it];
+                if (IsPointOnEdge(i, face)) {
+                    blocks[block].first.push_back(i);
+                    if (face.HasOpenEdge()) {
+                        blocks[block].second.push_back(it);
+                    }
                 }
             }
         }
+    };
+    MeshCore::parallel_blocks(points.size(), threads, check);
+
+    for (const auto& it : blocks) {
+        pointsIndices.insert(pointsIndices.end(), it.first.begin(), it.first.end());
+        facetsIndices.insert(facetsIndices.end(), it.second.begin(), it.second.end());
     }
     return pointsIndices.empty();
 }
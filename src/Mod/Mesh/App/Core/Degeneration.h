@@ -730,6 +730,7 @@ public:
 
 /**
  * The MeshEvalPointOnEdge class searches for points that lie on or close to an edge of a triangle.
+ * The points are checked in several threads.
  * @see MeshFixPointOnEdge
  * @author Werner Mayer
  */
@@ -742,6 +743,13 @@ public:
     explicit MeshEvalPointOnEdge(const MeshKernel& rclM)
         : MeshEvaluation(rclM)
     {}
+    /**
+     * Construction. Uses the BVH \a tree of the mesh instead of building an own one.
+     */
+    MeshEvalPointOnEdge(const MeshKernel& rclM, const MeshFacetBVH& tree)
+        : MeshEvaluation(rclM)
+        , _tree(&tree)
+    {}
     /**
      * Searches for points that lie on edge of triangle.
      */
@@ -756,6 +764,7 @@ public:
     std::vector<FacetIndex> GetFacetIndices() const;
 
 private:
+    const MeshFacetBVH* _tree {nullptr};
     std::vector<PointIndex> pointsIndices;
     std::vector<FacetIndex> facetsIndices;
 };
@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 #endif
 
@@ -32,6 +34,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Evaluation.h"
 #include "Functional.h"
 #include "Grid.h"
@@ -599,79 +602,9 @@ bool MeshFixSingleFacet::Fixup()
 
 bool MeshEvalSelfIntersection::Evaluate()
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersection;
+    FindIntersections(true, intersection);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -702,76 +635,80 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    FindIntersections(false, intersection);
+}
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+void MeshEvalSelfIntersection::FindIntersections(
+    bool onlyFirst,
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
+{
+    std::unique_ptr<MeshFacetBVH> ownTree;
+    const MeshFacetBVH* tree = _tree;
+    if (!tree) {
+        ownTree = std::make_unique<MeshFacetBVH>(_rclMesh);
+        tree = ownTree.get();
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    // If the facets share a common vertex we do not check for self-intersections
+    // because they could but usually do not intersect each other and the algorithm
+    // below would detect false-positives, otherwise
+    auto shareVertex = [](const MeshFacet& rface1, const MeshFacet& rface2) {
+        return rface2.HasPoint(rface1._aulPoints[0]) || rface2.HasPoint(rface1._aulPoints[1])
+            || rface2.HasPoint(rface1._aulPoints[2]);
+    };
 
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
+    // Each thread checks a block of facets against all facets with a higher index that are
+    // found by the BVH. Only the calling thread reports progress and handles a user abort.
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    int threads = MeshCore::count_threads(rFaces.size());
+    std::vector<std::vector<std::pair<FacetIndex, FacetIndex>>> blocks(threads);
+    std::atomic<bool> stop {false};
+    auto check = [&](std::size_t block, std::size_t first, std::size_t last) {
+        std::unique_ptr<Base::SequencerLauncher> seq;
+        if (block == 0) {
+            seq = std::make_unique<Base::SequencerLauncher>("Checking for self-intersections...",
+                                                            last - first);
         }
 
-        MeshGeomFacet facet1, facet2;
+        std::vector<FacetIndex> candidates;
         Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+        try {
+            for (std::size_t i = first; i < last && !stop; i++) {
+                if (seq) {
+                    seq->next(true);
                 }
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
+                const MeshFacet& rface1 = rFaces[i];
+                MeshGeomFacet facet1 = _rclMesh.GetFacet(rface1);
+                candidates.clear();
+                tree->Inside(facet1.GetBoundBox(), candidates);
+                std::sort(candidates.begin(), candidates.end());
+                for (FacetIndex j : candidates) {
+                    const MeshFacet& rface2 = rFaces[j];
+                    if (j <= i || shareVertex(rface1, rface2)) {
+                        continue;
+                    }
+
+                    MeshGeomFacet facet2 = _rclMesh.GetFacet(rface2);
+                    if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                        blocks[block].emplace_back(i, j);
+                        if (onlyFirst) {
+                            stop = true;
+                            return;
+                        }
                     }
                 }
             }
         }
+        catch (...) {
+            stop = true;
+            throw;
+        }
+    };
+    MeshCore::parallel_blocks(rFaces.size(), threads, check);
+
+    for (const auto& it : blocks) {
+        intersection.insert(intersection.end(), it.begin(), it.end());
     }
 }
 
@@ -985,7 +922,7 @@ void MeshKernel::RebuildNeighbours(FacetIndex index)
 
     // sort the edges
     // std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = int(std::thread::hardware_concurrency());
+    int threads = MeshCore::count_threads(edges.size());
     MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
@@ -33,6 +33,8 @@
 namespace MeshCore
 {
 
+class MeshFacetBVH;
+
 /**
  * The MeshEvaluation class checks the mesh kernel for correctness with respect to a
  * certain criterion, such as manifoldness, self-intersections, etc.
@@ -322,6 +324,7 @@ private:
 
 /**
  * The MeshEvalSelfIntersection class checks the mesh for self intersection.
+ * The facet pairs are tested in several threads.
  * @author Werner Mayer
  */
 class MeshExport MeshEvalSelfIntersection: public MeshEvaluation
@@ -330,13 +333,25 @@ public:
     explicit MeshEvalSelfIntersection(const MeshKernel& rclB)
         : MeshEvaluation(rclB)
     {}
+    /// Uses the BVH \a tree of the mesh instead of building an own one
+    MeshEvalSelfIntersection(const MeshKernel& rclB, const MeshFacetBVH& tree)
+        : MeshEvaluation(rclB)
+        , _tree(&tree)
+    {}
     /// Evaluate the mesh and return if true if there are self intersections
     bool Evaluate() override;
     /// collect all intersection lines
     void GetIntersections(const std::vector<std::pair<FacetIndex, FacetIndex>>&,
                           std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&) const;
-    /// collect the index of all facets with self intersections
+    /// collect the index of all facets with self intersections, sorted and without duplicates
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+
+private:
+    void FindIntersections(bool onlyFirst,
+                           std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const;
+
+private:
+    const MeshFacetBVH* _tree {nullptr};
 };
 
 /**
@@ -25,6 +25,8 @@
 
 #include <algorithm>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -62,6 +64,45 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Returns the number of threads to process \a count elements concurrently. It's at most the
+ * number of hardware threads and every thread gets at least \a minBlockSize elements.
+ */
+inline int count_threads(std::size_t count, std::size_t minBlockSize = 1)
+{
+    int threads = std::max(int(std::thread::hardware_concurrency()), 1);
+    return static_cast<int>(std::min<std::size_t>(threads, count / minBlockSize + 1));
+}
+
+/**
+ * Splits the index range [0, count) into at most \a threads contiguous blocks and calls
+ * \a func(block, first, last) for each of them concurrently. Blocks are numbered in
+ * ascending order of their ranges.
+ */
+template<class Func>
+static void parallel_blocks(std::size_t count, int threads, Func func)
+{
+    std::size_t blocks = std::min<std::size_t>(std::max(threads, 1), count);
+    if (blocks < 2) {
+        func(std::size_t(0), std::size_t(0), count);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(blocks - 1);
+    std::size_t step = count / blocks;
+    for (std::size_t block = 1; block < blocks; block++) {
+        std::size_t first = block * step;
+        std::size_t last = (block + 1 == blocks) ? count : first + step;
+        futures.push_back(std::async(std::launch::async, func, block, first, last));
+    }
+
+    func(std::size_t(0), std::size_t(0), step);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
@@ -29,6 +29,7 @@
 #endif
 
 #include "Algorithm.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -72,10 +73,64 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulOffsets.clear();
+    _aulIndices.clear();
     _pclMesh = nullptr;
 }
 
+void MeshGrid::ResetCells()
+{
+    _aulOffsets.assign(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+    _aulIndices.clear();
+}
+
+void MeshGrid::BuildCells(unsigned long ulCtElements, const CellCollector& collector)
+{
+    // Below this number of elements per thread it's not worth to start threads
+    const unsigned long ulMinBlockSize = 10000;
+
+    // First pass: collect the (grid element, element) pairs in blocks. As the blocks cover
+    // ascending ranges of elements the pairs are ordered by the element index.
+    int threads = MeshCore::count_threads(ulCtElements, ulMinBlockSize);
+    using CellEntry = std::pair<unsigned long, ElementIndex>;
+    std::vector<std::vector<CellEntry>> blocks(threads);
+    auto collect = [&collector, &blocks](std::size_t block, std::size_t first, std::size_t last) {
+        std::vector<CellEntry>& entries = blocks[block];
+        entries.reserve(last - first);
+        std::vector<unsigned long> cells;
+        for (std::size_t i = first; i < last; i++) {
+            cells.clear();
+            collector(i, cells);
+            for (unsigned long cell : cells) {
+                entries.emplace_back(cell, i);
+            }
+        }
+    };
+    MeshCore::parallel_blocks(ulCtElements, threads, collect);
+
+    // Second pass: counting sort of the entries into one flat array
+    ResetCells();
+    std::size_t ulCtEntries = 0;
+    for (const auto& entries : blocks) {
+        for (const auto& entry : entries) {
+            _aulOffsets[entry.first + 1]++;
+        }
+        ulCtEntries += entries.size();
+    }
+    for (std::size_t i = 1; i < _aulOffsets.size(); i++) {
+        _aulOffsets[i] += _aulOffsets[i - 1];
+    }
+
+    _aulIndices.resize(ulCtEntries);
+    std::vector<ElementIndex> fill(_aulOffsets.begin(), _aulOffsets.end() - 1);
+    for (auto& entries : blocks) {
+        for (const auto& entry : entries) {
+            _aulIndices[fill[entry.first]++] = entry.second;
+        }
+        entries = std::vector<CellEntry>();
+    }
+}
+
 void MeshGrid::Rebuild(unsigned long ulX, unsigned long ulY, unsigned long ulZ)
 {
     _ulCtGridsX = ulX;
@@ -130,14 +185,7 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
-        }
-    }
+    ResetCells();
 }
 
 unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
@@ -160,9 +208,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(raulElements.end(),
-                                    _aulGrid[i][j][k].begin(),
-                                    _aulGrid[i][j][k].end());
+                CellRange cell = GetCell(i, j, k);
+                raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             }
         }
     }
@@ -202,9 +249,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(raulElements.end(),
-                                        _aulGrid[i][j][k].begin(),
-                                        _aulGrid[i][j][k].end());
+                    CellRange cell = GetCell(i, j, k);
+                    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
                 }
             }
         }
@@ -239,7 +285,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                CellRange cell = GetCell(i, j, k);
+                raulElements.insert(cell.begin(), cell.end());
             }
         }
     }
@@ -463,7 +510,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            CellRange cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -475,7 +523,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            CellRange cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -487,7 +536,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            CellRange cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY++;
@@ -499,7 +549,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            CellRange cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY--;
@@ -511,7 +562,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            CellRange cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ++;
@@ -523,7 +575,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            CellRange cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ--;
@@ -611,10 +664,10 @@ unsigned long MeshGrid::GetElements(unsigned long ulX,
                                     unsigned long ulZ,
                                     std::set<ElementIndex>& raclInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    if (!rclSet.empty()) {
-        raclInd.insert(rclSet.begin(), rclSet.end());
-        return rclSet.size();
+    CellRange cell = GetCell(ulX, ulY, ulZ);
+    if (!cell.empty()) {
+        raclInd.insert(cell.begin(), cell.end());
+        return cell.size();
     }
 
     return 0;
@@ -630,9 +683,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f& rclPoint,
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    CellRange cell = GetCell(ulX, ulY, ulZ);
+    aulFacets.assign(cell.begin(), cell.end());
     return aulFacets.size();
 }
 
@@ -642,7 +694,7 @@ MeshGrid::GetIndexToPosition(unsigned long ulX, unsigned long ulY, unsigned long
     if (!CheckPos(ulX, ulY, ulZ)) {
         return std::numeric_limits<unsigned long>::max();
     }
-    return (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX;
+    return CellIndex(ulX, ulY, ulZ);
 }
 
 bool MeshGrid::GetPositionToIndex(unsigned long id,
@@ -749,13 +801,9 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
-    }
+    BuildCells(_ulCtElements, [this](ElementIndex index, std::vector<unsigned long>& cells) {
+        FacetCells(_pclMesh->GetFacet(index), cells);
+    });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -986,8 +1034,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX,
                                              float& rfMinDist,
                                              ElementIndex& rulFacetInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    for (ElementIndex pI : rclSet) {
+    for (ElementIndex pI : GetCell(ulX, ulY, ulZ)) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
             rfMinDist = fDist;
@@ -1030,15 +1077,14 @@ MeshPointGrid::MeshPointGrid(const MeshKernel& rclM, float fGridLen)
             std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon)
+void MeshPointGrid::PointCells(const MeshPoint& rclPt, std::vector<unsigned long>& raulCells) const
 {
-    (void)fEpsilon;
     unsigned long ulX {};
     unsigned long ulY {};
     unsigned long ulZ {};
     Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
     if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+        raulCells.push_back(CellIndex(ulX, ulY, ulZ));
     }
 }
 
@@ -1095,13 +1141,11 @@ void MeshPointGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-
-    MeshPointIterator cPIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
-        AddPoint(*cPIter, i++);
-    }
+    const MeshPointArray& points = _pclMesh->GetPoints();
+    BuildCells(_ulCtElements,
+               [this, &points](ElementIndex index, std::vector<unsigned long>& cells) {
+                   PointCells(points[index], cells);
+               });
 }
 
 void MeshPointGrid::Pos(const Base::Vector3f& rclPoint,
@@ -1166,9 +1210,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::CellRange cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1183,9 +1226,9 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(raulElements.end(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+            MeshGrid::CellRange cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+
+            raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             _bValidRay = true;
         }
     }
@@ -1249,9 +1292,8 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::CellRange cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     else {
         _bValidRay = false;  // Beam leaked
@@ -23,8 +23,10 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <functional>
 #include <limits>
 #include <set>
+#include <vector>
 
 #include <Base/BoundBox.h>
 
@@ -52,9 +54,46 @@ static constexpr float MESHGRID_BBOX_EXTENSION = 10.0F;
  *
  * Grids can be used within algorithms to avoid to iterate through all elements,
  * so grids can speed up algorithms dramatically.
+ *
+ * The element indices of all grid elements are kept in one flat array that is
+ * built with a counting sort, the indices of each grid element are sorted in
+ * ascending order and don't contain duplicates.
  */
 class MeshExport MeshGrid
 {
+public:
+    /**
+     * Read-only view on the element indices of one grid element.
+     */
+    class CellRange
+    {
+    public:
+        CellRange(const ElementIndex* first, const ElementIndex* last)
+            : _first(first)
+            , _last(last)
+        {}
+        const ElementIndex* begin() const
+        {
+            return _first;
+        }
+        const ElementIndex* end() const
+        {
+            return _last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_last - _first);
+        }
+        bool empty() const
+        {
+            return _first == _last;
+        }
+
+    private:
+        const ElementIndex* _first;
+        const ElementIndex* _last;
+    };
+
 protected:
     /** @name Construction */
     //@{
@@ -104,6 +143,8 @@ public:
     /** @name Getters */
     //@{
     /** Returns the indices of the elements in the given grid. */
+    inline CellRange GetCell(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
+    /** Returns the indices of the elements in the given grid. */
     unsigned long GetElements(unsigned long ulX,
                               unsigned long ulY,
                               unsigned long ulZ,
@@ -152,7 +193,7 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        return static_cast<unsigned long>(GetCell(ulX, ulY, ulZ).size());
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -193,12 +234,26 @@ protected:
     virtual void RebuildGrid() = 0;
     /** Returns the number of stored elements. Must be implemented in sub-classes. */
     virtual unsigned long HasElements() const = 0;
+    /** Sets all grid elements of the current resolution to empty. */
+    void ResetCells();
+    /** Returns the linear index of a grid element as used by the flat data structure. */
+    unsigned long CellIndex(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX;
+    }
+    /** Collects the linear indices of all grid elements an element belongs to. */
+    using CellCollector = std::function<void(ElementIndex, std::vector<unsigned long>&)>;
+    /** Fills the grid with the elements 0 to \a ulCtElements - 1 whose grid elements are
+     * determined by \a collector. The elements are processed in blocks on several threads
+     * so \a collector must be thread-safe.
+     */
+    void BuildCells(unsigned long ulCtElements, const CellCollector& collector);
 
 protected:
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>>
-        _aulGrid;                /**< Grid data structure. */
-    const MeshKernel* _pclMesh;  /**< The mesh kernel. */
+    std::vector<ElementIndex> _aulOffsets; /**< Start of each grid element in _aulIndices. */
+    std::vector<ElementIndex> _aulIndices; /**< Element indices of all grid elements. */
+    const MeshKernel* _pclMesh;            /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
     unsigned long _ulCtGridsY;   /**< Number of grid elements in z. */
@@ -285,11 +340,9 @@ protected:
                              unsigned long& rulX,
                              unsigned long& rulY,
                              unsigned long& rulZ) const;
-    /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a
-     * ulFacetIndex the corresponding index in the mesh kernel. The facet is added to each grid
-     * element that intersects the facet. */
-    inline void
-    AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Collects the linear indices of all grid elements that intersect the facet \a rclFacet. */
+    inline void FacetCells(const MeshGeomFacet& rclFacet,
+                           std::vector<unsigned long>& raulCells) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -337,9 +390,8 @@ public:
     bool Verify() const override;
 
 protected:
-    /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a
-     * ulPtIndex the corresponding index in the mesh kernel. */
-    void AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0F);
+    /** Collects the linear index of the grid element the point \a rclPt lies in. */
+    void PointCells(const MeshPoint& rclPt, std::vector<unsigned long>& raulCells) const;
     /** Returns the grid numbers to the given point \a rclPoint. */
     void Pos(const Base::Vector3f& rclPoint,
              unsigned long& rulX,
@@ -371,9 +423,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGrid::CellRange cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -509,6 +560,14 @@ inline bool MeshGrid::CheckPos(unsigned long ulX, unsigned long ulY, unsigned lo
     return ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ));
 }
 
+inline MeshGrid::CellRange
+MeshGrid::GetCell(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+{
+    unsigned long ulCell = CellIndex(ulX, ulY, ulZ);
+    const ElementIndex* data = _aulIndices.data();
+    return {data + _aulOffsets[ulCell], data + _aulOffsets[ulCell + 1]};
+}
+
 // --------------------------------------------------------------
 
 inline void MeshFacetGrid::Pos(const Base::Vector3f& rclPoint,
@@ -561,14 +620,9 @@ inline void MeshFacetGrid::PosWithCheck(const Base::Vector3f& rclPoint,
     assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
-                                    ElementIndex ulFacetIndex,
-                                    float /*fEpsilon*/)
+inline void MeshFacetGrid::FacetCells(const MeshGeomFacet& rclFacet,
+                                      std::vector<unsigned long>& raulCells) const
 {
-    unsigned long ulX {};
-    unsigned long ulY {};
-    unsigned long ulZ {};
-
     unsigned long ulX1 {};
     unsigned long ulY1 {};
     unsigned long ulZ1 {};
@@ -582,37 +636,23 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
     clBB.Add(rclFacet._aclPoints[1]);
     clBB.Add(rclFacet._aclPoints[2]);
 
-    // float fDiagonalLength = clBB.CalcDiagonalLength();
-
-    // clBB.Enlarge(fEpsilon*fDiagonalLength);
-
     Pos(Base::Vector3f(clBB.MinX, clBB.MinY, clBB.MinZ), ulX1, ulY1, ulZ1);
     Pos(Base::Vector3f(clBB.MaxX, clBB.MaxY, clBB.MaxZ), ulX2, ulY2, ulZ2);
 
-    /*
-    if (ulX1 > 0) ulX1--;
-    if (ulY1 > 0) ulY1--;
-    if (ulZ1 > 0) ulZ1--;
-
-    if (ulX2 < (_ulCtGridsX-1)) ulX2++;
-    if (ulY2 < (_ulCtGridsY-1)) ulY2++;
-    if (ulZ2 < (_ulCtGridsZ-1)) ulZ2++;
-    */
-
     // falls Facet ueber mehrere BB reicht
     if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2)) {
-        for (ulX = ulX1; ulX <= ulX2; ulX++) {
-            for (ulY = ulY1; ulY <= ulY2; ulY++) {
-                for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
+        for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
+            for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
+                for (unsigned long ulX = ulX1; ulX <= ulX2; ulX++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        raulCells.push_back(CellIndex(ulX, ulY, ulZ));
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        raulCells.push_back(CellIndex(ulX1, ulY1, ulZ1));
     }
 }
 
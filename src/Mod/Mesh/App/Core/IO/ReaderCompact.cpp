@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <vector>
+#endif
+
+#include "Core/MeshKernel.h"
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+
+#include "ReaderCompact.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+class VarintBuffer
+{
+public:
+    VarintBuffer(Base::InputStream& str, std::istream& in)
+    {
+        uint32_t size {};
+        str >> size;
+        if (!in) {
+            throw Base::BadFormatError("Reading from stream failed");
+        }
+        // read in chunks so that a corrupt size cannot trigger a huge allocation
+        const std::size_t chunk = 1 << 24;
+        while (data.size() < size) {
+            std::size_t count = std::min<std::size_t>(chunk, size - data.size());
+            std::size_t offset = data.size();
+            data.resize(offset + count);
+            in.read(data.data() + offset, static_cast<std::streamsize>(count));
+            if (!in) {
+                throw Base::BadFormatError("Reading from stream failed");
+            }
+        }
+    }
+
+    uint64_t next()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= data.size()) {
+                throw Base::BadFormatError("Invalid data structure");
+            }
+            auto byte = static_cast<unsigned char>(data[pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    int64_t nextSigned()
+    {
+        uint64_t value = next();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    std::size_t size() const
+    {
+        return data.size();
+    }
+
+    bool atEnd() const
+    {
+        return pos == data.size();
+    }
+
+private:
+    std::vector<char> data;
+    std::size_t pos {0};
+};
+
+}  // namespace
+
+ReaderCompact::ReaderCompact(MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void ReaderCompact::Load(Base::InputStream& str, std::istream& in)
+{
+    uint32_t bits {}, uCtPts {}, uCtFts {};
+    str >> bits >> uCtPts >> uCtFts;
+    if (!in || bits > 24 || (bits > 0 && bits < 8)) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    float minv[3] = {0.0F, 0.0F, 0.0F};
+    float step[3] = {0.0F, 0.0F, 0.0F};
+    if (bits > 0) {
+        str >> minv[0] >> minv[1] >> minv[2];
+        str >> step[0] >> step[1] >> step[2];
+    }
+
+    MeshPointArray pointArray;
+    VarintBuffer pointData(str, in);
+    // every point needs at least three bytes
+    if (pointData.size() < 3ULL * uCtPts) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+    pointArray.resize(uCtPts);
+    if (bits == 0) {
+        uint32_t prev[3] = {0, 0, 0};
+        for (auto& pnt : pointArray) {
+            for (int i = 0; i < 3; i++) {
+                prev[i] ^= static_cast<uint32_t>(pointData.next());
+                float value {};
+                std::memcpy(&value, &prev[i], sizeof(value));
+                pnt[i] = value;
+            }
+        }
+    }
+    else {
+        int64_t prev[3] = {0, 0, 0};
+        for (auto& pnt : pointArray) {
+            for (int i = 0; i < 3; i++) {
+                prev[i] += pointData.nextSigned();
+                pnt[i] = minv[i] + static_cast<float>(prev[i]) * step[i];
+            }
+        }
+    }
+    if (!pointData.atEnd()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    MeshFacetArray facetArray;
+    VarintBuffer facetData(str, in);
+    if (facetData.size() < 3ULL * uCtFts) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+    facetArray.resize(uCtFts);
+    int64_t prev = 0;
+    for (auto& facet : facetArray) {
+        int64_t p0 = prev + facetData.nextSigned();
+        int64_t p1 = p0 + facetData.nextSigned();
+        int64_t p2 = p0 + facetData.nextSigned();
+        // make sure to have valid indices
+        if (p0 < 0 || p0 >= uCtPts || p1 < 0 || p1 >= uCtPts || p2 < 0 || p2 >= uCtPts) {
+            throw Base::BadFormatError("Invalid data structure");
+        }
+        facet._aulPoints[0] = static_cast<PointIndex>(p0);
+        facet._aulPoints[1] = static_cast<PointIndex>(p1);
+        facet._aulPoints[2] = static_cast<PointIndex>(p2);
+        prev = p0;
+    }
+    if (!facetData.atEnd()) {
+        throw Base::BadFormatError("Invalid data structure");
+    }
+
+    _kernel.Adopt(pointArray, facetArray, true);
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_IO_READER_COMPACT_H
+#define MESH_IO_READER_COMPACT_H
+
+#include <iosfwd>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace Base
+{
+class InputStream;
+}
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** Loads a mesh kernel saved with WriterCompact. */
+class MeshExport ReaderCompact
+{
+public:
+    /*!
+     * \brief ReaderCompact
+     */
+    explicit ReaderCompact(MeshKernel& kernel);
+    /*!
+     * \brief Load the data that follows the magic number and the version tag.
+     * \a str must read from \a in and have the byte order of the header already set up.
+     * The neighbourhood of the facets is rebuilt afterwards.
+     * \throws Base::BadFormatError if the data is corrupt
+     */
+    void Load(Base::InputStream& str, std::istream& in);
+
+private:
+    MeshKernel& _kernel;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_COMPACT_H
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <vector>
+#endif
+
+#include "Core/MeshKernel.h"
+#include <Base/Stream.h>
+
+#include "WriterCompact.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+void writeVarint(std::vector<char>& buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<char>(value));
+}
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits {};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+}  // namespace
+
+WriterCompact::WriterCompact(const MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void WriterCompact::SetQuantization(int bits)
+{
+    _bits = bits <= 0 ? 0 : std::clamp(bits, 8, 24);
+}
+
+bool WriterCompact::Save(std::ostream& out) const
+{
+    if (!out || out.bad()) {
+        return false;
+    }
+
+    const MeshPointArray& points = _kernel.GetPoints();
+    const MeshFacetArray& facets = _kernel.GetFacets();
+
+    Base::OutputStream str(out);
+    str << static_cast<uint32_t>(0xA0B0C0D0);
+    str << Version;
+    str << static_cast<uint32_t>(_bits);
+    str << static_cast<uint32_t>(points.size()) << static_cast<uint32_t>(facets.size());
+
+    // Each coordinate is written as the difference to the same coordinate of the previous point.
+    // Exact floats are differenced by XOR of their bit patterns, quantized values by subtraction.
+    std::vector<char> buf;
+    buf.reserve(points.size() * 6);
+    if (_bits == 0) {
+        uint32_t prev[3] = {0, 0, 0};
+        for (const auto& pnt : points) {
+            for (int i = 0; i < 3; i++) {
+                uint32_t bits = floatBits(pnt[i]);
+                writeVarint(buf, bits ^ prev[i]);
+                prev[i] = bits;
+            }
+        }
+    }
+    else {
+        Base::BoundBox3f box = _kernel.GetBoundBox();
+        if (points.empty()) {
+            box = Base::BoundBox3f(0, 0, 0, 0, 0, 0);
+        }
+        const double range = static_cast<double>((1U << _bits) - 1);
+        float minv[3] = {box.MinX, box.MinY, box.MinZ};
+        float step[3] = {
+            static_cast<float>(static_cast<double>(box.LengthX()) / range),
+            static_cast<float>(static_cast<double>(box.LengthY()) / range),
+            static_cast<float>(static_cast<double>(box.LengthZ()) / range),
+        };
+        for (int i = 0; i < 3; i++) {
+            str << minv[i];
+        }
+        for (int i = 0; i < 3; i++) {
+            str << step[i];
+        }
+
+        int64_t prev[3] = {0, 0, 0};
+        for (const auto& pnt : points) {
+            for (int i = 0; i < 3; i++) {
+                int64_t val = 0;
+                if (step[i] > 0.0F) {
+                    double q = (static_cast<double>(pnt[i]) - minv[i]) / step[i];
+                    val = static_cast<int64_t>(std::clamp(std::round(q), 0.0, range));
+                }
+                writeVarint(buf, zigzag(val - prev[i]));
+                prev[i] = val;
+            }
+        }
+    }
+
+    str << static_cast<uint32_t>(buf.size());
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+
+    // Facets of a mesh mostly reference nearby points: the first index is written relative to
+    // the first index of the previous facet and the two others relative to the first one.
+    buf.clear();
+    buf.reserve(facets.size() * 4);
+    int64_t prev = 0;
+    for (const auto& facet : facets) {
+        int64_t p0 = facet._aulPoints[0];
+        int64_t p1 = facet._aulPoints[1];
+        int64_t p2 = facet._aulPoints[2];
+        writeVarint(buf, zigzag(p0 - prev));
+        writeVarint(buf, zigzag(p1 - p0));
+        writeVarint(buf, zigzag(p2 - p0));
+        prev = p0;
+    }
+
+    str << static_cast<uint32_t>(buf.size());
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+
+    return out.good();
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_IO_WRITER_COMPACT_H
+#define MESH_IO_WRITER_COMPACT_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/** Saves the mesh kernel in the compact binary encoding.
+ * The compact encoding is a variant of the format written by MeshKernel::Write() that is tagged
+ * with its own version number so that MeshKernel::Read() can load both. Point coordinates are
+ * either kept as exact floats or quantized to a fixed grid over the bounding box, and the facet
+ * indices are written as variable-length deltas. The neighbourhood of the facets is not stored
+ * but rebuilt when loading.
+ */
+class MeshExport WriterCompact
+{
+public:
+    /// Version tag of the compact encoding
+    static constexpr uint32_t Version = 0x020000;
+
+    /*!
+     * \brief WriterCompact
+     */
+    explicit WriterCompact(const MeshKernel& kernel);
+    /*!
+     * \brief Set the number of bits per coordinate. 0 keeps the exact float values, otherwise
+     * the value is clamped to the range [8, 24]. The maximum error of a quantized coordinate
+     * is half the extent of the bounding box divided by 2^bits - 1.
+     */
+    void SetQuantization(int bits);
+    int GetQuantization() const
+    {
+        return _bits;
+    }
+    /*!
+     * \brief Save the mesh to a stream.
+     * \return true if the data could be written successfully, false otherwise.
+     */
+    bool Save(std::ostream&) const;
+
+private:
+    const MeshKernel& _kernel;
+    int _bits {0};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_WRITER_COMPACT_H
@@ -38,6 +38,8 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "IO/ReaderCompact.h"
+#include "IO/WriterCompact.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -934,8 +936,9 @@ void MeshKernel::Read(std::istream& rclIn)
     Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff;  // value to mark an open edge
 
-    // is it the new or old format?
+    // is it the compact, new or old format?
     bool new_format = false;
+    bool compact_format = false;
     if (magic == 0xA0B0C0D0 && version == 0x010000) {
         new_format = true;
     }
@@ -943,8 +946,28 @@ void MeshKernel::Read(std::istream& rclIn)
         new_format = true;
         str.setByteOrder(Base::Stream::BigEndian);
     }
+    else if (magic == 0xA0B0C0D0 && version == WriterCompact::Version) {
+        compact_format = true;
+    }
+    else if (swap_magic == 0xA0B0C0D0 && swap_version == WriterCompact::Version) {
+        compact_format = true;
+        str.setByteOrder(Base::Stream::BigEndian);
+    }
 
-    if (new_format) {
+    if (compact_format) {
+        try {
+            ReaderCompact reader(*this);
+            reader.Load(str, rclIn);
+        }
+        catch (const Base::BadFormatError&) {
+            throw;
+        }
+        catch (std::exception&) {
+            // Special handling of std::length_error
+            throw Base::BadFormatError("Reading from stream failed");
+        }
+    }
+    else if (new_format) {
         char szInfo[256];
         rclIn.read(szInfo, 256);
 
@@ -23,17 +23,22 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <array>
+#include <cmath>
 #include <fstream>
 #include <ios>
+#include <limits>
 #endif
 
 #include <Base/Builder3D.h>
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
+#include "BVH.h"
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "SetOperations.h"
@@ -174,6 +179,11 @@ void SetOperations::Do()
 void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
                         std::set<FacetIndex>& facetsCuttingEdge1)
 {
+    if (_engine == Engine::BVH) {
+        CutBVH(facetsCuttingEdge0, facetsCuttingEdge1);
+        return;
+    }
+
     MeshFacetGrid grid1(_cutMesh0, 20);
     MeshFacetGrid grid2(_cutMesh1, 20);
 
@@ -205,80 +215,14 @@ void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
 
                                 int isect = f1.IntersectWithFacet(f2, p0, p1);
                                 if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0 =
-                                            _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1 =
-                                            _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit =
-                                            _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
+                                    AddCutLine(fidx1,
+                                               f1,
+                                               fidx2,
+                                               f2,
+                                               p0,
+                                               p1,
+                                               facetsCuttingEdge0,
+                                               facetsCuttingEdge1);
                                 }
                             }
                         }
@@ -289,109 +233,299 @@ void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0,
     }
 }
 
-void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+void SetOperations::CutBVH(std::set<FacetIndex>& facetsCuttingEdge0,
+                           std::set<FacetIndex>& facetsCuttingEdge1)
 {
-    // Triangulate Mesh
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>::iterator it1;
-    for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1) {
-        std::vector<Vector3f> points;
-        std::set<MeshPoint> pointsSet;
+    struct CutLine
+    {
+        FacetIndex f1, f2;
+        MeshPoint p0, p1;
+    };
+
+    // Broad phase: the facets of the second mesh whose bounding boxes overlap the bounding box
+    // of a facet of the first mesh. Narrow phase: the facet-facet intersection with a
+    // scale-independent tolerance. Each block of facets of the first mesh is handled by its
+    // own thread.
+    MeshFacetBVH tree(_cutMesh1);
+    std::size_t numFacets = _cutMesh0.CountFacets();
+    int threads = CountThreads(numFacets);
+    std::vector<std::vector<CutLine>> blocks(threads);
+    auto intersect = [this, &tree, &blocks](std::size_t block,
+                                            std::size_t first,
+                                            std::size_t last) {
+        std::vector<FacetIndex> candidates;
+        for (std::size_t i = first; i < last; i++) {
+            MeshGeomFacet f1 = _cutMesh0.GetFacet(i);
+            candidates.clear();
+            tree.Inside(f1.GetBoundBox(), candidates);
+            for (FacetIndex j : candidates) {
+                MeshGeomFacet f2 = _cutMesh1.GetFacet(j);
+                MeshPoint p0, p1;
+                if (IntersectFacets(f1, f2, p0, p1) > 0) {
+                    blocks[block].push_back({i, j, p0, p1});
+                }
+            }
+        }
+    };
+    MeshCore::parallel_blocks(numFacets, threads, intersect);
+
+    // The blocks are merged in order of the facet indices so that the result doesn't depend
+    // on the number of threads
+    for (const auto& lines : blocks) {
+        for (const auto& line : lines) {
+            AddCutLine(line.f1,
+                       _cutMesh0.GetFacet(line.f1),
+                       line.f2,
+                       _cutMesh1.GetFacet(line.f2),
+                       line.p0,
+                       line.p1,
+                       facetsCuttingEdge0,
+                       facetsCuttingEdge1);
+        }
+    }
+}
+
+void SetOperations::Orientation(const MeshGeomFacet& plane,
+                                const MeshGeomFacet& facet,
+                                double dist[3])
+{
+    // Orientation of the corners of 'facet' with respect to the plane of 'plane', computed in
+    // double precision. If a value doesn't exceed a conservative bound of its rounding error
+    // its sign is uncertain and the corner is considered to lie on the plane.
+    const Base::Vector3f& base = plane._aclPoints[0];
+    Base::Vector3d u(double(plane._aclPoints[1].x) - double(base.x),
+                     double(plane._aclPoints[1].y) - double(base.y),
+                     double(plane._aclPoints[1].z) - double(base.z));
+    Base::Vector3d v(double(plane._aclPoints[2].x) - double(base.x),
+                     double(plane._aclPoints[2].y) - double(base.y),
+                     double(plane._aclPoints[2].z) - double(base.z));
+    Base::Vector3d normal = u % v;
+    Base::Vector3d absNormal(std::fabs(u.y * v.z) + std::fabs(u.z * v.y),
+                             std::fabs(u.z * v.x) + std::fabs(u.x * v.z),
+                             std::fabs(u.x * v.y) + std::fabs(u.y * v.x));
+
+    const double eps = 8.0 * std::numeric_limits<double>::epsilon();
+    for (int i = 0; i < 3; i++) {
+        const Base::Vector3f& pnt = facet._aclPoints[i];
+        Base::Vector3d dir(double(pnt.x) - double(base.x),
+                           double(pnt.y) - double(base.y),
+                           double(pnt.z) - double(base.z));
+        double bound = eps
+            * (absNormal.x * std::fabs(dir.x) + absNormal.y * std::fabs(dir.y)
+               + absNormal.z * std::fabs(dir.z));
+        dist[i] = normal * dir;
+        if (std::fabs(dist[i]) <= bound) {
+            dist[i] = 0.0;
+        }
+    }
+}
 
-        FacetIndex fidx = it1->first;
-        MeshGeomFacet f = cutMesh.GetFacet(fidx);
+int SetOperations::IntersectFacets(const MeshGeomFacet& f1,
+                                   const MeshGeomFacet& f2,
+                                   Base::Vector3f& rclPt0,
+                                   Base::Vector3f& rclPt1)
+{
+    auto isSeparated = [](const double dist[3]) {
+        return (dist[0] > 0.0 && dist[1] > 0.0 && dist[2] > 0.0)
+            || (dist[0] < 0.0 && dist[1] < 0.0 && dist[2] < 0.0);
+    };
+
+    double dist1[3];
+    Orientation(f2, f1, dist1);
+    if (isSeparated(dist1)) {
+        return 0;
+    }
 
-        // if (side == 1)
-        //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0,
-        //     1, 1);
+    double dist2[3];
+    Orientation(f1, f2, dist2);
+    if (isSeparated(dist2)) {
+        return 0;
+    }
 
-        // facet corner points
-        // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-        for (int i = 0; i < 3; i++)  // NOLINT
-        {
-            pointsSet.insert(f._aclPoints[i]);
-            points.push_back(f._aclPoints[i]);
-        }
+    // the coplanar case is handled by the edge/edge intersections
+    if (dist1[0] == 0.0 && dist1[1] == 0.0 && dist1[2] == 0.0) {
+        return f1.IntersectWithFacet(f2, rclPt0, rclPt1);
+    }
 
-        // triangulated facets
-        std::list<std::set<MeshPoint>::iterator>::iterator it2;
-        for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (pointsSet.find(*(*it2)) == pointsSet.end()) {
-                pointsSet.insert(*(*it2));
-                points.push_back(*(*it2));
+    auto interpolate = [](const Base::Vector3f& p, const Base::Vector3f& q, double t) {
+        return Base::Vector3d(double(p.x) + t * (double(q.x) - double(p.x)),
+                              double(p.y) + t * (double(q.y) - double(p.y)),
+                              double(p.z) + t * (double(q.z) - double(p.z)));
+    };
+
+    // The part of a facet that lies on the plane of the other facet
+    auto planeSegment = [&interpolate](const MeshGeomFacet& facet, const double dist[3]) {
+        std::vector<Base::Vector3d> points;
+        for (int i = 0; i < 3; i++) {
+            const Base::Vector3f& p = facet._aclPoints[i];
+            const Base::Vector3f& q = facet._aclPoints[(i + 1) % 3];
+            double dp = dist[i];
+            double dq = dist[(i + 1) % 3];
+            if (dp == 0.0) {
+                points.emplace_back(p.x, p.y, p.z);
+            }
+            if ((dp < 0.0 && dq > 0.0) || (dp > 0.0 && dq < 0.0)) {
+                // interpolate in a fixed direction so that the adjacent facet gets the same point
+                if (MeshPoint(q) < MeshPoint(p)) {
+                    points.push_back(interpolate(q, p, dq / (dq - dp)));
+                }
+                else {
+                    points.push_back(interpolate(p, q, dp / (dp - dq)));
+                }
             }
         }
+        return points;
+    };
 
-        Vector3f normal = f.GetNormal();
-        Vector3f base = points[0];
-        Vector3f dirX = points[1] - points[0];
-        dirX.Normalize();
-        Vector3f dirY = dirX % normal;
-
-        // project points to 2D plane
-        std::vector<Vector3f>::iterator it;
-        std::vector<Vector3f> vertices;
-        for (it = points.begin(); it != points.end(); ++it) {
-            Vector3f pv = *it;
-            pv.TransformToCoordinateSystem(base, dirX, dirY);
-            vertices.push_back(pv);
+    std::vector<Base::Vector3d> seg1 = planeSegment(f1, dist1);
+    std::vector<Base::Vector3d> seg2 = planeSegment(f2, dist2);
+    if (seg1.empty() || seg2.empty()) {
+        return 0;
+    }
+
+    // Both segments lie on the intersection line of the two planes. Their overlap is the
+    // intersection of the facets.
+    Base::Vector3d dir =
+        Base::toVector<double>(f1.GetNormal()) % Base::toVector<double>(f2.GetNormal());
+    auto range = [&dir](const std::vector<Base::Vector3d>& points) {
+        auto less = [&dir](const Base::Vector3d& p, const Base::Vector3d& q) {
+            return dir * p < dir * q;
+        };
+        auto minmax = std::minmax_element(points.begin(), points.end(), less);
+        return std::make_pair(*minmax.first, *minmax.second);
+    };
+
+    std::pair<Base::Vector3d, Base::Vector3d> range1 = range(seg1);
+    std::pair<Base::Vector3d, Base::Vector3d> range2 = range(seg2);
+    const Base::Vector3d& lo = dir * range1.first < dir * range2.first ? range2.first
+                                                                        : range1.first;
+    const Base::Vector3d& hi = dir * range1.second < dir * range2.second ? range1.second
+                                                                          : range2.second;
+    if (dir * hi < dir * lo) {
+        return 0;
+    }
+
+    rclPt0 = Base::toVector<float>(lo);
+    rclPt1 = Base::toVector<float>(hi);
+    return rclPt0 == rclPt1 ? 1 : 2;
+}
+
+int SetOperations::CountThreads(std::size_t count) const
+{
+    // Below this number of facets per thread it's not worth to start threads
+    const std::size_t minBlockSize = 1000;
+    if (_engine != Engine::BVH) {
+        return 1;
+    }
+
+    return MeshCore::count_threads(count, minBlockSize);
+}
+
+void SetOperations::AddCutLine(FacetIndex fidx1,
+                               const MeshGeomFacet& f1,
+                               FacetIndex fidx2,
+                               const MeshGeomFacet& f2,
+                               MeshPoint p0,
+                               MeshPoint p1,
+                               std::set<FacetIndex>& facetsCuttingEdge0,
+                               std::set<FacetIndex>& facetsCuttingEdge1)
+{
+    // optimize cut line if distance to nearest point is too small
+    float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
+    MeshPoint np0 = p0, np1 = p1;
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        float d1 = (f1._aclPoints[i] - p0).Length();
+        float d2 = (f1._aclPoints[i] - p1).Length();
+        if (d1 < minDist1) {
+            minDist1 = d1;
+            np0 = f1._aclPoints[i];
+        }
+        if (d2 < minDist2) {
+            minDist2 = d2;
+            p1 = f1._aclPoints[i];
         }
+    }  // for (int i = 0; i < 3; i++)
+
+    // optimize cut line if distance to nearest point is too small
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        float d1 = (f2._aclPoints[i] - p0).Length();
+        float d2 = (f2._aclPoints[i] - p1).Length();
+        if (d1 < minDist1) {
+            minDist1 = d1;
+            np0 = f2._aclPoints[i];
+        }
+        if (d2 < minDist2) {
+            minDist2 = d2;
+            np1 = f2._aclPoints[i];
+        }
+    }  // for (int i = 0; i < 3; i++)
 
-        DelaunayTriangulator tria;
-        tria.SetPolygon(vertices);
-        tria.TriangulatePolygon();
+    MeshPoint mp0 = np0;
+    MeshPoint mp1 = np1;
 
-        std::vector<MeshFacet> facets = tria.GetFacets();
-        for (auto& it : facets) {
-            if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
-                || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
-                continue;
-            }
+    if (mp0 != mp1) {
+        facetsCuttingEdge0.insert(fidx1);
+        facetsCuttingEdge1.insert(fidx2);
 
-            MeshGeomFacet facet(points[it._aulPoints[0]],
-                                points[it._aulPoints[1]],
-                                points[it._aulPoints[2]]);
-
-            // if (side == 1)
-            //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-            //  facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            // if (facet.Area() < 0.0001f)
-            //{ // too small facet
-            //   continue;
-            // }
-
-            float dist0 =
-                facet._aclPoints[0].DistanceToLine(facet._aclPoints[1],
-                                                   facet._aclPoints[1] - facet._aclPoints[2]);
-            float dist1 =
-                facet._aclPoints[1].DistanceToLine(facet._aclPoints[0],
-                                                   facet._aclPoints[0] - facet._aclPoints[2]);
-            float dist2 =
-                facet._aclPoints[2].DistanceToLine(facet._aclPoints[0],
-                                                   facet._aclPoints[0] - facet._aclPoints[1]);
-
-            if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
-                || (dist2 < _minDistanceToPoint)) {
-                continue;
-            }
+        _cutPoints.insert(mp0);
+        _cutPoints.insert(mp1);
 
-            // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-            // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-            // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+        std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+        std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
 
-            // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
-            // _minDistanceToPoint))
-            //{
-            //   continue;
-            // }
+        _edges[Edge(mp0, mp1)] = EdgeInfo();
 
-            facet.CalcNormal();
-            if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
-                std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-                facet.CalcNormal();
-            }
+        _facet2points[0][fidx1].push_back(pit0.first);
+        _facet2points[0][fidx1].push_back(pit1.first);
+        _facet2points[1][fidx2].push_back(pit0.first);
+        _facet2points[1][fidx2].push_back(pit1.first);
+    }
+    else {
+        std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
 
+        // do not insert a facet when only one corner point cuts the edge
+        // if (!((mp0 == f1._aclPoints[0]) || (mp0 == f1._aclPoints[1]) ||
+        //       (mp0 == f1._aclPoints[2])))
+        {
+            facetsCuttingEdge0.insert(fidx1);
+            _facet2points[0][fidx1].push_back(pit.first);
+        }
 
+        // if (!((mp0 == f2._aclPoints[0]) || (mp0 == f2._aclPoints[1]) ||
+        //       (mp0 == f2._aclPoints[2])))
+        {
+            facetsCuttingEdge1.insert(fidx2);
+            _facet2points[1][fidx2].push_back(pit.first);
+        }
+    }
+}
+
+void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+{
+    using FacetPoints = std::pair<const FacetIndex, std::list<std::set<MeshPoint>::iterator>>;
+    std::vector<const FacetPoints*> cutFacets;
+    cutFacets.reserve(_facet2points[side].size());
+    for (const auto& it : _facet2points[side]) {
+        cutFacets.push_back(&it);
+    }
+
+    // Triangulate the cut facets independently of each other
+    std::vector<std::vector<MeshGeomFacet>> triangulations(cutFacets.size());
+    auto triangulate = [this, &cutMesh, &cutFacets, &triangulations](std::size_t /*block*/,
+                                                                     std::size_t first,
+                                                                     std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            const FacetPoints* it1 = cutFacets[i];
+            TriangulateFacet(cutMesh.GetFacet(it1->first), it1->second, triangulations[i]);
+        }
+    };
+    MeshCore::parallel_blocks(cutFacets.size(), CountThreads(cutFacets.size()), triangulate);
+
+    for (std::size_t i = 0; i < cutFacets.size(); i++) {
+        FacetIndex fidx = cutFacets[i]->first;
+        for (auto& facet : triangulations[i]) {
             for (int j = 0; j < 3; j++) {
                 auto eit = _edges.find(Edge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]));
 
@@ -416,6 +550,104 @@ void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
     }
 }
 
+void SetOperations::TriangulateFacet(const MeshGeomFacet& f,
+                                     const std::list<std::set<MeshPoint>::iterator>& cutPoints,
+                                     std::vector<MeshGeomFacet>& result) const
+{
+    std::vector<Vector3f> points;
+    std::set<MeshPoint> pointsSet;
+
+    // facet corner points
+    // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        pointsSet.insert(f._aclPoints[i]);
+        points.push_back(f._aclPoints[i]);
+    }
+
+    // triangulated facets
+    std::list<std::set<MeshPoint>::iterator>::const_iterator it2;
+    for (it2 = cutPoints.begin(); it2 != cutPoints.end(); ++it2) {
+        if (pointsSet.find(*(*it2)) == pointsSet.end()) {
+            pointsSet.insert(*(*it2));
+            points.push_back(*(*it2));
+        }
+    }
+
+    Vector3f normal = f.GetNormal();
+    Vector3f base = points[0];
+    Vector3f dirX = points[1] - points[0];
+    dirX.Normalize();
+    Vector3f dirY = dirX % normal;
+
+    // project points to 2D plane
+    std::vector<Vector3f>::iterator it;
+    std::vector<Vector3f> vertices;
+    for (it = points.begin(); it != points.end(); ++it) {
+        Vector3f pv = *it;
+        pv.TransformToCoordinateSystem(base, dirX, dirY);
+        vertices.push_back(pv);
+    }
+
+    DelaunayTriangulator tria;
+    tria.SetPolygon(vertices);
+    tria.TriangulatePolygon();
+
+    std::vector<MeshFacet> facets = tria.GetFacets();
+    for (auto& it : facets) {
+        if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
+            || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
+            continue;
+        }
+
+        MeshGeomFacet facet(points[it._aulPoints[0]],
+                            points[it._aulPoints[1]],
+                            points[it._aulPoints[2]]);
+
+        // if (side == 1)
+        //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
+        //  facet._aclPoints[2], true, 3, 0, 1, 1);
+
+        // if (facet.Area() < 0.0001f)
+        //{ // too small facet
+        //   continue;
+        // }
+
+        float dist0 =
+            facet._aclPoints[0].DistanceToLine(facet._aclPoints[1],
+                                               facet._aclPoints[1] - facet._aclPoints[2]);
+        float dist1 =
+            facet._aclPoints[1].DistanceToLine(facet._aclPoints[0],
+                                               facet._aclPoints[0] - facet._aclPoints[2]);
+        float dist2 =
+            facet._aclPoints[2].DistanceToLine(facet._aclPoints[0],
+                                               facet._aclPoints[0] - facet._aclPoints[1]);
+
+        if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
+            || (dist2 < _minDistanceToPoint)) {
+            continue;
+        }
+
+        // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
+        // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
+        // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+
+        // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
+        // _minDistanceToPoint))
+        //{
+        //   continue;
+        // }
+
+        facet.CalcNormal();
+        if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
+            std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+            facet.CalcNormal();
+        }
+
+        result.push_back(facet);
+    }
+}
+
 void SetOperations::CollectFacets(int side, float mult)
 {
     // float distSave = MeshDefinitions::_fMinPointDistance;
@@ -438,6 +670,9 @@ void SetOperations::CollectFacets(int side, float mult)
     MeshAlgorithm algo(mesh);
     algo.ResetFacetFlag(static_cast<MeshFacet::TFlagType>(MeshFacet::VISIT | MeshFacet::TMP0));
 
+    // search tree of the other mesh, only built if needed
+    MeshFacetBVH tree;
+
     // bool hasFacetsNotVisited = true; // until facets not visited
     // search for facet not visited
     MeshFacetArray::_TConstIterator itf;
@@ -449,7 +684,11 @@ void SetOperations::CollectFacets(int side, float mult)
             CollectFacetVisitor visitor(mesh, facets, _edges, side, mult, _builder);
             mesh.VisitNeighbourFacets(visitor, itf - rFacets.begin());
 
-            if (visitor._addFacets == 0) {  // mark all facets to add it to the result
+            if (visitor._matches > 0 && visitor._mismatches > 0) {
+                // the cut line has a gap and the region reaches to both sides of it
+                ClassifyFacets(mesh, facets, tree, side, mult);
+            }
+            else if (visitor._addFacets == 0) {  // mark all facets to add it to the result
                 algo.SetFacetsFlag(facets, MeshFacet::TMP0);
             }
         }
@@ -465,6 +704,65 @@ void SetOperations::CollectFacets(int side, float mult)
     // MeshDefinitions::SetMinPointDistance(distSave);
 }
 
+void SetOperations::ClassifyFacets(const MeshKernel& mesh,
+                                   const std::vector<FacetIndex>& facets,
+                                   MeshFacetBVH& tree,
+                                   int side,
+                                   float mult)
+{
+    const MeshKernel& other = side == 0 ? _cutMesh1 : _cutMesh0;
+    if (tree.IsEmpty()) {
+        tree.Attach(other);
+    }
+
+    // A ray leaves a closed mesh through the first facet it hits if it starts inside. A single
+    // ray fails if it grazes a facet or passes through an edge or a gap, e.g. where the meshes
+    // touch or have coplanar facets, hence the majority of several skewed rays decides. Rays
+    // that hit a facet at a grazing angle don't vote.
+    const std::array<Base::Vector3f, 5> dirs {Base::Vector3f(0.5773F, 0.5774F, 0.5775F),
+                                              Base::Vector3f(-0.6017F, 0.4789F, 0.6392F),
+                                              Base::Vector3f(0.3611F, -0.7993F, 0.4803F),
+                                              Base::Vector3f(0.6389F, 0.6007F, -0.4807F),
+                                              Base::Vector3f(-0.4793F, -0.6411F, -0.5993F)};
+    const float minCosine = 0.01F;
+    std::vector<char> add(facets.size());
+    auto classify = [&](std::size_t /*block*/, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            Base::Vector3f center = mesh.GetFacet(facets[i]).GetGravityPoint();
+            int votes = 0;
+            for (Base::Vector3f dir : dirs) {
+                dir.Normalize();
+                Base::Vector3f hit;
+                FacetIndex index {};
+                if (!tree.NearestFacetOnRay(center, dir, hit, index)) {
+                    votes--;
+                    continue;
+                }
+                Base::Vector3f normal = other.GetFacet(index).GetNormal();
+                normal.Normalize();
+                float cosine = normal * dir;
+                if (cosine > minCosine) {
+                    votes++;
+                }
+                else if (cosine < -minCosine) {
+                    votes--;
+                }
+            }
+            bool inside = votes > 0;
+            add[i] = inside ? mult > 0.0F : mult < 0.0F;
+        }
+    };
+    MeshCore::parallel_blocks(facets.size(), CountThreads(facets.size()), classify);
+
+    std::vector<FacetIndex> added;
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        if (add[i]) {
+            added.push_back(facets[i]);
+        }
+    }
+    MeshAlgorithm(mesh).SetFacetsFlag(added, MeshFacet::TMP0);
+}
+
 SetOperations::CollectFacetVisitor::CollectFacetVisitor(const MeshKernel& mesh,
                                                         std::vector<FacetIndex>& facets,
                                                         std::map<Edge, EdgeInfo>& edges,
@@ -509,8 +807,9 @@ bool SetOperations::CollectFacetVisitor::AllowVisit(const MeshFacet& rclFacet,
         std::map<Edge, EdgeInfo>::iterator it = _edges.find(edge);
 
         if (it != _edges.end()) {
-            if (_addFacets == -1) {
-                // determine if the facets should add or not only once
+            // every crossing of the cut line is checked to detect regions that aren't bounded by
+            // it, the first one decides if the facets are added
+            {
                 MeshGeomFacet facet = _mesh.GetFacet(rclFrom);  // triangulated facet
                 MeshGeomFacet facetOther =
                     it->second
@@ -596,10 +895,13 @@ bool SetOperations::CollectFacetVisitor::AllowVisit(const MeshFacet& rclFacet,
                 //}
 
                 if (match) {
-                    _addFacets = 0;
+                    _matches++;
                 }
                 else {
-                    _addFacets = 1;
+                    _mismatches++;
+                }
+                if (_addFacets == -1) {
+                    _addFacets = match ? 0 : 1;
                 }
 
                 // matchCounter++;
@@ -44,6 +44,7 @@ class MeshGeomEdge;
 class MeshBuilder;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshFacetIterator;
 
@@ -62,6 +63,18 @@ public:
         Outer
     };
 
+    /// Algorithm to compute the intersection of the meshes
+    enum class Engine
+    {
+        /** The facet pairs are searched with two facet grids and intersected with
+         * MeshGeomFacet::IntersectWithFacet() which uses an absolute tolerance. */
+        Grid,
+        /** The facet pairs are searched with a bounding volume hierarchy and intersected with a
+         * tolerance relative to the facet size. The intersection and the re-triangulation of
+         * the cut facets run in several threads. */
+        BVH
+    };
+
     /// Construction
     SetOperations(const MeshKernel& cutMesh1,
                   const MeshKernel& cutMesh2,
@@ -75,13 +88,25 @@ public:
      * polyline goes direct to the point
      */
     void Do();
+    /** Sets the algorithm to compute the intersection of the meshes. By default this is
+     * Engine::Grid.
+     */
+    void SetEngine(Engine engine)
+    {
+        _engine = engine;
+    }
+    Engine GetEngine() const
+    {
+        return _engine;
+    }
 
 private:
-    const MeshKernel& _cutMesh0;  /** Mesh for set operations source 1 */
-    const MeshKernel& _cutMesh1;  /** Mesh for set operations source 2 */
-    MeshKernel& _resultMesh;      /** Result mesh */
-    OperationType _operationType; /** Set Operation Type */
-    float _minDistanceToPoint;    /** Minimal distance to facet corner points */
+    const MeshKernel& _cutMesh0;   /** Mesh for set operations source 1 */
+    const MeshKernel& _cutMesh1;   /** Mesh for set operations source 2 */
+    MeshKernel& _resultMesh;       /** Result mesh */
+    OperationType _operationType;  /** Set Operation Type */
+    float _minDistanceToPoint;     /** Minimal distance to facet corner points */
+    Engine _engine {Engine::Grid}; /** Algorithm to intersect the meshes */
 
 private:
     // Helper class cutting edge to its two attached facets
@@ -150,6 +175,8 @@ private:
         int _side;
         float _mult;
         int _addFacets {-1};  // 0: add facets to the result 1: do not add facets to the result
+        int _matches {0};     // number of crossed cut edges that add the facets
+        int _mismatches {0};  // number of crossed cut edges that don't add the facets
         Base::Builder3D& _builder;
 
         CollectFacetVisitor(const MeshKernel& mesh,
@@ -183,10 +210,47 @@ private:
 
     /** Cut mesh 1 with mesh 2 */
     void Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1);
+    /** Cut mesh 1 with mesh 2 using a BVH and several threads */
+    void CutBVH(std::set<FacetIndex>& facetsCuttingEdge0,
+                std::set<FacetIndex>& facetsCuttingEdge1);
+    /** Adds the cut line (\a p0, \a p1) of the facets \a f1 and \a f2 */
+    void AddCutLine(FacetIndex fidx1,
+                    const MeshGeomFacet& f1,
+                    FacetIndex fidx2,
+                    const MeshGeomFacet& f2,
+                    MeshPoint p0,
+                    MeshPoint p1,
+                    std::set<FacetIndex>& facetsCuttingEdge0,
+                    std::set<FacetIndex>& facetsCuttingEdge1);
+    /** Computes the signed distances of the corners of \a facet to the plane of \a plane,
+     * scaled by the length of its normal. Distances within the rounding error are set to zero.
+     */
+    static void Orientation(const MeshGeomFacet& plane, const MeshGeomFacet& facet, double dist[3]);
+    /** Intersects the facets \a f1 and \a f2. Unlike MeshGeomFacet::IntersectWithFacet() the
+     * tolerance is relative to the facets' size. Returns the number of intersection points.
+     */
+    static int IntersectFacets(const MeshGeomFacet& f1,
+                               const MeshGeomFacet& f2,
+                               Base::Vector3f& rclPt0,
+                               Base::Vector3f& rclPt1);
+    /** Number of threads to process \a count elements */
+    int CountThreads(std::size_t count) const;
     /** Trianglute each facets cut with its cutting points */
     void TriangulateMesh(const MeshKernel& cutMesh, int side);
+    /** Triangulate the facet \a f with its cutting points */
+    void TriangulateFacet(const MeshGeomFacet& f,
+                          const std::list<std::set<MeshPoint>::iterator>& cutPoints,
+                          std::vector<MeshGeomFacet>& result) const;
     /** search facets for adding (with region growing) */
     void CollectFacets(int side, float mult);
+    /** Decides for each of the \a facets of the triangulated mesh of \a side if it lies inside
+     * the other mesh. Used for regions that aren't bounded by the cut line.
+     */
+    void ClassifyFacets(const MeshKernel& mesh,
+                        const std::vector<FacetIndex>& facets,
+                        MeshFacetBVH& tree,
+                        int side,
+                        float mult);
     /** close gap in the mesh */
     void CloseGaps(MeshBuilder& meshBuilder);
 
@@ -33,12 +33,20 @@ using namespace std;
 
 PROPERTY_SOURCE(Mesh::SetOperations, Mesh::Feature)
 
+const char* SetOperations::EngineEnums[] = {"Grid", "BVH", nullptr};
 
 SetOperations::SetOperations()
 {
     ADD_PROPERTY(Source1, (nullptr));
     ADD_PROPERTY(Source2, (nullptr));
     ADD_PROPERTY(OperationType, ("union"));
+    ADD_PROPERTY_TYPE(Engine,
+                      (0L),
+                      "Base",
+                      App::Prop_None,
+                      "Algorithm to intersect the meshes. 'BVH' uses a bounding volume hierarchy, "
+                      "a tolerance relative to the facet size and several threads");
+    Engine.setEnums(EngineEnums);
 }
 
 short SetOperations::mustExecute() const
@@ -53,6 +61,9 @@ short SetOperations::mustExecute() const
         if (OperationType.isTouched()) {
             return 1;
         }
+        if (Engine.isTouched()) {
+            return 1;
+        }
     }
 
     return 0;
@@ -96,6 +107,8 @@ App::DocumentObjectExecReturn* SetOperations::execute()
                                       pcKernel->getKernel(),
                                       type,
                                       1.0e-5F);
+        setOp.SetEngine(Engine.isValue("BVH") ? MeshCore::SetOperations::Engine::BVH
+                                              : MeshCore::SetOperations::Engine::Grid);
         setOp.Do();
         Mesh.setValuePtr(pcKernel.release());
     }
@@ -22,6 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -29,6 +32,7 @@
 #include <Base/VectorPy.h>
 #include <Base/Writer.h>
 
+#include "Core/IO/WriterCompact.h"
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -919,9 +923,37 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
     }
 }
 
+int PropertyMeshKernel::getCompactEncoding() const
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Mesh");
+    bool compact = hGrp->GetBool("CompactEncoding", false);
+    long bits = hGrp->GetInt("CompactQuantization", 0);
+
+    auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
+    App::Document* doc = obj ? obj->getDocument() : nullptr;
+    if (doc && doc->SaveCompactMesh.getValue()) {
+        compact = true;
+        bits = doc->CompactMeshQuantization.getValue();
+    }
+
+    if (!compact) {
+        return -1;
+    }
+    return static_cast<int>(bits);
+}
+
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    int bits = getCompactEncoding();
+    if (bits < 0) {
+        _meshObject->save(writer.Stream());
+    }
+    else {
+        MeshCore::WriterCompact compact(_meshObject->getKernel());
+        compact.SetQuantization(bits);
+        compact.Save(writer.Stream());
+    }
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
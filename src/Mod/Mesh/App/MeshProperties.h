@@ -320,6 +320,13 @@ public:
     void Paste(const App::Property& from) override;
     //@}
 
+private:
+    /** Returns the number of quantization bits if the mesh is saved in the compact encoding
+     * or -1 for the uncompressed format. If the document's SaveCompactMesh is set its
+     * CompactMeshQuantization takes precedence over the user settings.
+     */
+    int getCompactEncoding() const;
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject {nullptr};
@@ -47,6 +47,7 @@
 
 // STL
 #include <algorithm>
+#include <array>
 #include <iomanip>
 #include <iostream>
 #include <list>
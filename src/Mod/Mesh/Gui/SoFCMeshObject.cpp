@@ -55,6 +55,7 @@
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/Selection/SoFCSelectionAction.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Elements.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -360,7 +361,7 @@ SoFCMeshPickNode::SoFCMeshPickNode()
 */
 SoFCMeshPickNode::~SoFCMeshPickNode()
 {
-    delete meshGrid;
+    delete meshTree;
 }
 
 // Doc from superclass.
@@ -375,10 +376,8 @@ void SoFCMeshPickNode::notify(SoNotList* list)
     if (f == &mesh) {
         const Mesh::MeshObject* meshObject = mesh.getValue();
         if (meshObject) {
-            MeshCore::MeshAlgorithm alg(meshObject->getKernel());
-            float fAvgLen = alg.GetAverageEdgeLength();
-            delete meshGrid;
-            meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0F * fAvgLen);
+            delete meshTree;
+            meshTree = new MeshCore::MeshFacetBVH(meshObject->getKernel());
         }
     }
 }
@@ -402,7 +401,7 @@ void SoFCMeshPickNode::pick(SoPickAction* action)
     Base::Vector3f pt(pos[0], pos[1], pos[2]);
     Base::Vector3f dr(dir[0], dir[1], dir[2]);
     Mesh::FacetIndex index {};
-    if (alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index)) {
+    if (alg.NearestFacetOnRay(pt, dr, *meshTree, pt, index)) {
         SoPickedPoint* pp = raypick->addIntersection(SbVec3f(pt.x, pt.y, pt.z));
         if (pp) {
             SoFaceDetail* det = new SoFaceDetail();
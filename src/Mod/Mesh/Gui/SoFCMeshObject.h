@@ -38,7 +38,7 @@ using GLfloat = float;
 
 namespace MeshCore
 {
-class MeshFacetGrid;
+class MeshFacetBVH;
 }
 
 namespace MeshGui
@@ -105,7 +105,7 @@ protected:
     ~SoFCMeshPickNode() override;
 
 private:
-    MeshCore::MeshFacetGrid* meshGrid {nullptr};
+    MeshCore::MeshFacetBVH* meshTree {nullptr};
 };
 
 // -------------------------------------------------------
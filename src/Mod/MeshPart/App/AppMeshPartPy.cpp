@@ -100,7 +100,8 @@ public:
             "                         AngularDeflection=0.5,\n"
             "                         Relative=False,"
             "                         Segments=False,\n"
-            "                         GroupColors=[])\n"
+            "                         GroupColors=[],\n"
+            "                         Parallel=False)\n"
             "    meshFromShape(Shape, MaxLength)\n"
             "    meshFromShape(Shape, MaxArea)\n"
             "    meshFromShape(Shape, LocalLength)\n"
@@ -126,6 +127,7 @@ public:
             "    AngularDeflection (optional, float)\n"
             "    Segments (optional, boolean)\n"
             "    GroupColors (optional, list of (Red, Green, Blue) tuples)\n"
+            "    Parallel (optional, boolean) - mesh the faces on several threads\n"
             "    MaxLength (required, float)\n"
             "    MaxArea (required, float)\n"
             "    LocalLength (required, float)\n"
@@ -482,18 +484,21 @@ private:
             return Py::asObject(new Mesh::MeshPy(mesh));
         };
 
-        static const std::array<const char *, 7> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
-                                                                    "Relative", "Segments", "GroupColors", nullptr};
+        static const std::array<const char *, 8> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
+                                                                    "Relative", "Segments", "GroupColors",
+                                                                    "Parallel", nullptr};
         PyErr_Clear();
         double lindeflection=0;
         double angdeflection=0.5;
         PyObject* relative = Py_False;
         PyObject* segment = Py_False;
         PyObject* groupColors = nullptr;
-        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!O", kwds_lindeflection,
+        PyObject* parallel = Py_False;
+        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!OO!", kwds_lindeflection,
                                                 &(Part::TopoShapePy::Type), &shape, &lindeflection,
                                                 &angdeflection, &(PyBool_Type), &relative,
-                                                &(PyBool_Type), &segment, &groupColors)) {
+                                                &(PyBool_Type), &segment, &groupColors,
+                                                &(PyBool_Type), &parallel)) {
             MeshPart::Mesher mesher(static_cast<Part::TopoShapePy*>(shape)->getTopoShapePtr()->getShape());
             mesher.setMethod(MeshPart::Mesher::Standard);
             mesher.setDeflection(lindeflection);
@@ -501,6 +506,7 @@ private:
             mesher.setRegular(true);
             mesher.setRelative(Base::asBoolean(relative));
             mesher.setSegments(Base::asBoolean(segment));
+            mesher.setParallel(Base::asBoolean(parallel));
             if (groupColors) {
                 Py::Sequence list(groupColors);
                 std::vector<uint32_t> colors;
@@ -22,8 +22,11 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <numbers>
@@ -33,6 +36,8 @@
 
 #include <Eigen/SparseCholesky>
 
+#include <Mod/Mesh/App/Core/Functional.h>
+
 #include "MeshFlatteningLscmRelax.h"
 
 
@@ -142,41 +147,105 @@ LscmRelax::LscmRelax(
 //////////////////////////////////////////////////////////////////////////
 /////////////////                 F.E.M                      /////////////
 //////////////////////////////////////////////////////////////////////////
+void LscmRelax::init_relax_system()
+{
+    long n = this->vertices.cols();
+    long size = n * 2 + 3;
+    std::vector<trip> K_g_triplets;
+    K_g_triplets.reserve(this->triangles.cols() * 36 + n * 8);
+    for (long i=0; i < this->triangles.cols(); i++)
+    {
+        for (int j=0; j < 6; j++)
+            for (int k=0; k < 6; k++)
+                K_g_triplets.emplace_back(trip(this->triangles(j / 2, i) * 2 + j % 2,
+                                               this->triangles(k / 2, i) * 2 + k % 2, 0));
+    }
+    // lagrange multiplier (fixing total ux, total uy and ux*y-uy*x)
+    for (long i=0; i < n; i++)
+    {
+        K_g_triplets.emplace_back(trip(i * 2, n * 2, 0));
+        K_g_triplets.emplace_back(trip(n * 2, i * 2, 0));
+        K_g_triplets.emplace_back(trip(i * 2 + 1, n * 2 + 1, 0));
+        K_g_triplets.emplace_back(trip(n * 2 + 1, i * 2 + 1, 0));
+        K_g_triplets.emplace_back(trip(i * 2, n * 2 + 2, 0));
+        K_g_triplets.emplace_back(trip(n * 2 + 2, i * 2, 0));
+        K_g_triplets.emplace_back(trip(i * 2 + 1, n * 2 + 2, 0));
+        K_g_triplets.emplace_back(trip(n * 2 + 2, i * 2 + 1, 0));
+    }
+    // the explicit zeros are kept, so the pattern doesn't depend on the values
+    this->K_relax.resize(size, size);
+    this->K_relax.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
+
+    const int* outer = this->K_relax.outerIndexPtr();
+    const int* inner = this->K_relax.innerIndexPtr();
+    auto value_index = [outer, inner](const trip& t) {
+        return static_cast<int>(std::lower_bound(inner + outer[t.col()],
+                                                 inner + outer[t.col() + 1], t.row()) - inner);
+    };
+    long triangle_count = this->triangles.cols() * 36;
+    this->K_relax_index.resize(triangle_count);
+    this->K_relax_lagrange.resize(n * 8);
+    for (long i=0; i < triangle_count; i++)
+        this->K_relax_index[i] = value_index(K_g_triplets[i]);
+    for (long i=0; i < n * 8; i++)
+        this->K_relax_lagrange[i] = value_index(K_g_triplets[triangle_count + i]);
+
+    // greedy coloring: every vertex remembers the colors of its triangles. Triangles that
+    // don't get one of the first 63 colors end up in the last group which is run sequentially.
+    std::vector<uint64_t> vertex_colors(n, 0);
+    this->relax_colors.clear();
+    for (long i=0; i < this->triangles.cols(); i++)
+    {
+        uint64_t used = vertex_colors[this->triangles(0, i)] |
+                        vertex_colors[this->triangles(1, i)] |
+                        vertex_colors[this->triangles(2, i)];
+        int color = std::min(std::countr_one(used), relax_max_colors - 1);
+        for (int j=0; j < 3; j++)
+            vertex_colors[this->triangles(j, i)] |= uint64_t(1) << color;
+        if (static_cast<int>(this->relax_colors.size()) <= color)
+            this->relax_colors.resize(color + 1);
+        this->relax_colors[color].push_back(i);
+    }
+
+    this->relax_solver = std::make_shared<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+    this->relax_solver->analyzePattern(this->K_relax);
+}
+
 void LscmRelax::relax(double weight)
 {
+    if (!this->relax_solver || this->K_relax.rows() != this->vertices.cols() * 2 + 3)
+        this->init_relax_system();
+
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
-    // for every triangle
-    Eigen::Matrix<double, 3, 6> B;
-    Eigen::Matrix<double, 2, 2> T;
-    Eigen::Matrix<double, 6, 6> K_m;
-    Eigen::Matrix<double, 6, 1> u_m, rhs_m;
-    Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
+    long n = this->vertices.cols();
+    Eigen::VectorXd rhs(n * 2 + 3);
     if (this->sol.size() == 0)
-        this->sol.Zero(this->vertices.cols() * 2 + 3);
-    spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
-    Vector2 v1, v2, v3, v12, v23, v31;
-    long row_pos, col_pos;
-    double A;
-
+        this->sol.Zero(n * 2 + 3);
+    double* values = this->K_relax.valuePtr();
+    std::fill(values, values + this->K_relax.nonZeros(), 0.);
     rhs.setZero();
 
-    for (long i=0; i<this->triangles.cols(); i++)
+    // for every triangle
+    auto assemble = [&](long i)
     {
         // 1: construct B-mat in m-system
-        v1 = this->flat_vertices.col(this->triangles(0, i));
-        v2 = this->flat_vertices.col(this->triangles(1, i));
-        v3 = this->flat_vertices.col(this->triangles(2, i));
-        v12 = v2 - v1;
-        v23 = v3 - v2;
-        v31 = v1 - v3;
+        Eigen::Matrix<double, 3, 6> B;
+        Eigen::Matrix<double, 2, 2> T;
+        Eigen::Matrix<double, 6, 6> K_m;
+        Eigen::Matrix<double, 6, 1> u_m, rhs_m;
+        Vector2 v1 = this->flat_vertices.col(this->triangles(0, i));
+        Vector2 v2 = this->flat_vertices.col(this->triangles(1, i));
+        Vector2 v3 = this->flat_vertices.col(this->triangles(2, i));
+        Vector2 v12 = v2 - v1;
+        Vector2 v23 = v3 - v2;
+        Vector2 v31 = v1 - v3;
         B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
               0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
              -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
         T << v12.x(), -v12.y(),
              v12.y(), v12.x();
         T /= v12.norm();
-        A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
+        double A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
         B /= A * 2; // (2*area)
 
         // 2: sigma due dqlg in m-system
@@ -188,20 +257,31 @@ void LscmRelax::relax(double weight)
         K_m = B.transpose() * this->C * B * A;
 
         // 5: add to rhs_g, K_g
-        for (int j=0; j < 3; j++)
+        const int* index = this->K_relax_index.data() + i * 36;
+        for (int j=0; j < 6; j++)
+        {
+            rhs[this->triangles(j / 2, i) * 2 + j % 2] += rhs_m[j];
+            for (int k=0; k < 6; k++)
+                values[index[j * 6 + k]] += K_m(j, k);
+        }
+    };
+
+    // the triangles of one color share no vertex and thus no entry of K_g and rhs
+    for (std::size_t color=0; color < this->relax_colors.size(); color++)
+    {
+        const std::vector<long>& tris = this->relax_colors[color];
+        if (static_cast<int>(color) == relax_max_colors - 1)
         {
-            row_pos = this->triangles(j, i);
-            rhs[row_pos * 2]     += rhs_m[j * 2];
-            rhs[row_pos * 2 + 1] += rhs_m[j * 2 +1];
-            for (int k=0; k < 3; k++)
-            {
-                col_pos = this->triangles(k, i);
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1)));
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1)));
-                // we don't have to fill all because the matrix is symmetric.
-            }
+            for (long i: tris)
+                assemble(i);
+        }
+        else
+        {
+            MeshCore::parallel_blocks(tris.size(), MeshCore::count_threads(tris.size(), 1024),
+                [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (std::size_t i=begin; i < end; i++)
+                        assemble(tris[i]);
+                });
         }
     }
     // FIXING SOME PINS:
@@ -248,19 +328,20 @@ void LscmRelax::relax(double weight)
     //     K_g_triplets.push_back(trip(i, i, 0.01));
 
     // lagrange multiplier
-    for (long i=0; i < this->flat_vertices.cols() ; i++)
+    for (long i=0; i < n; i++)
     {
+        const int* index = this->K_relax_lagrange.data() + i * 8;
         // fixing total ux
-        K_g_triplets.emplace_back(trip(i * 2, this->flat_vertices.cols() * 2, 1));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2, i * 2, 1));
+        values[index[0]] = 1;
+        values[index[1]] = 1;
         // fixing total uy
-        K_g_triplets.emplace_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 1, 1));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 1, i * 2 + 1, 1));
+        values[index[2]] = 1;
+        values[index[3]] = 1;
         // fixing ux*y-uy*x
-        K_g_triplets.emplace_back(trip(i * 2, this->flat_vertices.cols() * 2 + 2, - this->flat_vertices(1, i)));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2, - this->flat_vertices(1, i)));
-        K_g_triplets.emplace_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 2, this->flat_vertices(0, i)));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2 + 1, this->flat_vertices(0, i)));
+        values[index[4]] = - this->flat_vertices(1, i);
+        values[index[5]] = - this->flat_vertices(1, i);
+        values[index[6]] = this->flat_vertices(0, i);
+        values[index[7]] = this->flat_vertices(0, i);
     }
 
     // project out the nullspace solution:
@@ -279,13 +360,12 @@ void LscmRelax::relax(double weight)
     // rhs -= nullspace1.dot(rhs) * nullspace1;
     // rhs -= nullspace2.dot(rhs) * nullspace2;
 
-    K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
 
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    // the symbolic analysis of the pattern is reused, only the numeric factorization is redone
+    this->relax_solver->factorize(this->K_relax);
+    this->sol = this->relax_solver->solve(-rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
@@ -40,6 +40,8 @@
 #include <tuple>
 #include <vector>
 
+#include <Eigen/SparseCholesky>
+
 #include "MeshFlattening.h"
 
 
@@ -89,6 +91,17 @@ private:
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
+    // The sparsity pattern of the stiffness matrix of relax() only depends on the triangles.
+    // It is built and analysed with the first call, later calls only refill the values.
+    // Triangles of the same color don't share a vertex and are assembled on several threads.
+    void init_relax_system();
+    spMat K_relax;
+    std::vector<int> K_relax_index;         // 36 value indices per triangle
+    std::vector<int> K_relax_lagrange;      // 8 value indices per vertex
+    static constexpr int relax_max_colors = 64;
+    std::vector<std::vector<long>> relax_colors;
+    std::shared_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> relax_solver;
+
 public:
     LscmRelax() = default;
     LscmRelax(
@@ -23,17 +23,25 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <numeric>
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <Poly_Triangle.hxx>
 #include <Standard_Version.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
+
+#include <QtConcurrentMap>
 #endif
 
 #include <Base/Console.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Part/App/BRepMesh.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Part/App/TopoShape.h>
 
 #include "Mesher.h"
@@ -127,20 +135,66 @@ namespace MeshPart
 class BrepMesh
 {
     bool segments;
+    bool parallel;
     std::vector<uint32_t> colors;
 
 public:
-    BrepMesh(bool s, const std::vector<uint32_t>& c)
+    BrepMesh(bool s, bool p, const std::vector<uint32_t>& c)
         : segments(s)
+        , parallel(p)
         , colors(c)
     {}
 
+    /// Same as TopoShape::getDomains() but reads the triangulations of the faces on several threads
+    static void getDomains(const TopoDS_Shape& shape, std::vector<Part::TopoShape::Domain>& domains)
+    {
+        std::vector<TopoDS_Face> faces;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            faces.push_back(TopoDS::Face(xp.Current()));
+        }
+
+        domains.resize(faces.size());
+        std::vector<std::size_t> indices(faces.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        QtConcurrent::blockingMap(indices, [&faces, &domains](std::size_t index) {
+            std::vector<gp_Pnt> points;
+            std::vector<Poly_Triangle> facets;
+            // a face that cannot be meshed gets an empty domain
+            if (!Part::Tools::getTriangulation(faces[index], points, facets)) {
+                return;
+            }
+
+            Part::TopoShape::Domain& domain = domains[index];
+            domain.points.reserve(points.size());
+            for (const auto& it : points) {
+                domain.points.emplace_back(it.X(), it.Y(), it.Z());
+            }
+
+            domain.facets.reserve(facets.size());
+            for (const auto& it : facets) {
+                Standard_Integer N1 {}, N2 {}, N3 {};
+                it.Get(N1, N2, N3);
+
+                Part::TopoShape::Facet tria;
+                tria.I1 = N1;
+                tria.I2 = N2;
+                tria.I3 = N3;
+                domain.facets.push_back(tria);
+            }
+        });
+    }
+
     Mesh::MeshObject* create(const std::vector<Part::TopoShape::Domain>& domains) const
     {
         std::vector<Base::Vector3d> points;
         std::vector<Part::TopoShape::Facet> facets;
         Part::BRepMesh mesh;
-        mesh.getFacesFromDomains(domains, points, facets);
+        if (parallel) {
+            mesh.getFacesFromDomainsParallel(domains, points, facets);
+        }
+        else {
+            mesh.getFacesFromDomains(domains, points, facets);
+        }
 
         MeshCore::MeshFacetArray faces;
         faces.reserve(facets.size());
@@ -225,13 +279,19 @@ Mesh::MeshObject* Mesher::createStandard() const
 {
     if (!shape.IsNull()) {
         BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        // in parallel mode OCC meshes the faces on its own thread pool
+        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection, parallel);
     }
 
     std::vector<Part::TopoShape::Domain> domains;
-    Part::TopoShape(shape).getDomains(domains);
+    if (parallel) {
+        BrepMesh::getDomains(shape, domains);
+    }
+    else {
+        Part::TopoShape(shape).getDomains(domains);
+    }
 
-    BrepMesh brepmesh(this->segments, this->colors);
+    BrepMesh brepmesh(this->segments, this->parallel, this->colors);
     return brepmesh.create(domains);
 }
 
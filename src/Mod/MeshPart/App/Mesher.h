@@ -143,6 +143,15 @@ public:
     {
         return segments;
     }
+    /// Meshes the faces and merges their points on several threads (Standard method only)
+    void setParallel(bool s)
+    {
+        parallel = s;
+    }
+    bool isParallel() const
+    {
+        return parallel;
+    }
     void setColors(const std::vector<uint32_t>& c)
     {
         colors = c;
@@ -229,6 +238,7 @@ private:
     bool relative {false};
     bool regular {false};
     bool segments {false};
+    bool parallel {false};
 #if defined(HAVE_NETGEN)
     int fineness {5};
     double growthRate {0};
@@ -44,6 +44,7 @@
 #include <map>
 #include <memory>
 #include <numbers>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -67,6 +68,7 @@
 #include <Geom_Curve.hxx>
 #include <Geom_Plane.hxx>
 #include <Geom_Surface.hxx>
+#include <Poly_Triangle.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Standard_Failure.hxx>
 #include <Standard_Version.hxx>
@@ -79,5 +81,8 @@
 #include <TopoDS_Shape.hxx>
 #include <gp_Pln.hxx>
 
+// Qt
+#include <QtConcurrentMap>
+
 #endif  // _PreComp_
 #endif
@@ -131,6 +131,7 @@
 #include "PrismExtension.h"
 #include "PropertyGeometryList.h"
 #include "PropertyTopoShapeList.h"
+#include "TessellationCache.h"
 
 #include <BRepFeat/MakePrismPy.h>
 
@@ -190,6 +191,7 @@
 #include "MeasureClient.h"
 
 #include <FuzzyHelper.h>
+#include <FCBRepAlgoAPI_BooleanOperation.h>
 
 #include <App/Services.h>
 #include <Services.h>
@@ -418,6 +420,7 @@ PyMOD_INIT_FUNC(Part)
     Part::PropertyFilletEdges   ::init();
     Part::PropertyShapeCache    ::init();
     Part::PropertyTopoShapeList ::init();
+    Part::PropertyTessellationCache::init();
 
     Part::FaceMaker             ::init();
     Part::FaceMakerPublic       ::init();
@@ -577,6 +580,7 @@ PyMOD_INIT_FUNC(Part)
         .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
 
     Part::FuzzyHelper::setBooleanFuzzy(hGrp->GetFloat("BooleanFuzzy",10.0));
+    FCBRepAlgoAPIHelper::setSplitDisjoint(hGrp->GetBool("BooleanSplitDisjoint", false));
 
     Base::registerServiceImplementation<App::SubObjectPlacementProvider>(new AttacherSubObjectPlacement);
     Base::registerServiceImplementation<App::CenterOfMassProvider>(new PartCenterOfMass);
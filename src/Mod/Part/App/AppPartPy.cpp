@@ -607,6 +607,10 @@ public:
         add_varargs_method("clearShapeCache",&Module::clearShapeCache,
             "clearShapeCache() -- Clears internal shape cache"
         );
+        add_varargs_method("getResultCacheStatistics",&Module::getResultCacheStatistics,
+            "getResultCacheStatistics(reset=False) -- Returns a tuple with the number of hits and misses\n"
+            "of the recomputes of features that cache their result"
+        );
         add_keyword_method("getShape",&Module::getShape,
             "getShape(obj,subname=None,mat=None,needSubElement=False,transform=True,retType=0):\n"
             "Obtain the TopoShape of a given object with SubName reference\n\n"
@@ -2317,6 +2321,19 @@ private:
         return Py::Object();
     }
 
+    Py::Object getResultCacheStatistics(const Py::Tuple &args) {
+        PyObject *reset = Py_False;
+        if (!PyArg_ParseTuple(args.ptr(),"|O!",&PyBool_Type,&reset))
+            throw Py::Exception();
+        const auto& stats = Part::Feature::getResultCacheStatistics();
+        Py::Tuple tuple(2);
+        tuple.setItem(0, Py::Long(stats.hits));
+        tuple.setItem(1, Py::Long(stats.misses));
+        if (Base::asBoolean(reset))
+            Part::Feature::resetResultCacheStatistics();
+        return tuple;
+    }
+
     Py::Object splitSubname(const Py::Tuple& args) {
         const char *subname;
         if (!PyArg_ParseTuple(args.ptr(), "s",&subname))
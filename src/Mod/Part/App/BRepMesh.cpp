@@ -25,7 +25,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <limits>
+#include <numeric>
 #include <Precision.hxx>
+#include <QThread>
+#include <QtConcurrentMap>
 #endif
 
 #include "BRepMesh.h"
@@ -246,6 +250,82 @@ private:
     std::vector<std::size_t> mapPointIndex;
 };
 
+// A point of a domain together with the facet corner where it is used first
+struct WeldVertex
+{
+    Base::Vector3d p;
+    std::size_t firstUse;
+    uint32_t domain;
+    uint32_t index;
+
+    // same order as MeshVertex, equal points are sorted by their first use
+    bool operator < (const WeldVertex &v) const
+    {
+        if (p.x != v.p.x) {
+            return p.x < v.p.x;
+        }
+        if (p.y != v.p.y) {
+            return p.y < v.p.y;
+        }
+        if (p.z != v.p.z) {
+            return p.z < v.p.z;
+        }
+        return firstUse < v.firstUse;
+    }
+
+    bool isEqual(const WeldVertex &v) const
+    {
+        return !(p.x != v.p.x || p.y != v.p.y || p.z != v.p.z);
+    }
+};
+
+// sorts chunks of the array on several threads and merges them pairwise
+template <typename T>
+void parallelSort(std::vector<T>& values)
+{
+    const std::size_t minChunkSize = 10000;
+    std::size_t numChunks = std::min<std::size_t>(std::max(QThread::idealThreadCount(), 1),
+                                                  values.size() / minChunkSize);
+    if (numChunks < 2) {
+        std::sort(values.begin(), values.end());
+        return;
+    }
+
+    std::size_t chunkSize = (values.size() + numChunks - 1) / numChunks;
+    std::vector<std::size_t> bounds;
+    for (std::size_t pos = 0; pos < values.size(); pos += chunkSize) {
+        bounds.push_back(pos);
+    }
+    bounds.push_back(values.size());
+
+    std::vector<std::size_t> chunks(bounds.size() - 1);
+    std::iota(chunks.begin(), chunks.end(), 0);
+    QtConcurrent::blockingMap(chunks, [&values, &bounds](std::size_t chunk) {
+        std::sort(values.begin() + bounds[chunk], values.begin() + bounds[chunk + 1]);
+    });
+
+    while (bounds.size() > 2) {
+        chunks.clear();
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            chunks.push_back(i);
+        }
+        QtConcurrent::blockingMap(chunks, [&values, &bounds](std::size_t chunk) {
+            std::inplace_merge(values.begin() + bounds[chunk],
+                               values.begin() + bounds[chunk + 1],
+                               values.begin() + bounds[chunk + 2]);
+        });
+
+        std::vector<std::size_t> merged;
+        for (std::size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != values.size()) {
+            merged.push_back(values.size());
+        }
+        bounds.swap(merged);
+    }
+}
+
 }
 
 void BRepMesh::getFacesFromDomains(const std::vector<Domain>& domains,
@@ -307,6 +387,133 @@ void BRepMesh::getFacesFromDomains(const std::vector<Domain>& domains,
     }
 }
 
+void BRepMesh::getFacesFromDomainsParallel(const std::vector<Domain>& domains,
+                                           std::vector<Base::Vector3d>& points,
+                                           std::vector<Facet>& faces)
+{
+    // getFacesFromDomains() numbers the points in the order they are first used by the facet
+    // corners of all domains. Here the points are sorted instead and every group of equal points
+    // gets the index of the first use of any of its members.
+    const std::size_t numDomains = domains.size();
+    std::vector<std::size_t> domainIndices(numDomains);
+    std::iota(domainIndices.begin(), domainIndices.end(), 0);
+
+    std::vector<std::size_t> cornerOffsets(numDomains + 1, 0);
+    for (std::size_t i = 0; i < numDomains; i++) {
+        cornerOffsets[i + 1] = cornerOffsets[i] + 3 * domains[i].facets.size();
+    }
+
+    // collect the used points of each domain
+    const std::size_t unused = std::numeric_limits<std::size_t>::max();
+    std::vector<std::vector<WeldVertex>> domainVertices(numDomains);
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        const Domain& domain = domains[index];
+        std::vector<std::size_t> firstUse(domain.points.size(), unused);
+        std::size_t corner = cornerOffsets[index];
+        for (const Facet& df : domain.facets) {
+            for (uint32_t pointIndex : {df.I1, df.I2, df.I3}) {
+                if (firstUse[pointIndex] == unused) {
+                    firstUse[pointIndex] = corner;
+                }
+                corner++;
+            }
+        }
+
+        std::vector<WeldVertex>& vertices = domainVertices[index];
+        for (std::size_t i = 0; i < firstUse.size(); i++) {
+            if (firstUse[i] != unused) {
+                vertices.push_back({domain.points[i], firstUse[i], uint32_t(index), uint32_t(i)});
+            }
+        }
+    });
+
+    std::vector<std::size_t> vertexOffsets(numDomains + 1, 0);
+    for (std::size_t i = 0; i < numDomains; i++) {
+        vertexOffsets[i + 1] = vertexOffsets[i] + domainVertices[i].size();
+    }
+    std::vector<WeldVertex> vertices(vertexOffsets.back());
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        std::copy(domainVertices[index].begin(),
+                  domainVertices[index].end(),
+                  vertices.begin() + vertexOffsets[index]);
+        std::vector<WeldVertex>().swap(domainVertices[index]);
+    });
+
+    parallelSort(vertices);
+
+    // the first vertex of each group of equal points has the smallest first use
+    std::vector<uint32_t> group(vertices.size());
+    std::vector<std::pair<std::size_t, uint32_t>> firstUses;
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+        if (i == 0 || !vertices[i].isEqual(vertices[i - 1])) {
+            firstUses.emplace_back(vertices[i].firstUse, uint32_t(firstUses.size()));
+        }
+        group[i] = uint32_t(firstUses.size() - 1);
+    }
+    parallelSort(firstUses);
+
+    std::vector<uint32_t> pointIndex(firstUses.size());
+    std::vector<std::size_t> groupStart(firstUses.size());
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+        if (i == 0 || group[i] != group[i - 1]) {
+            groupStart[group[i]] = i;
+        }
+    }
+    std::vector<Base::Vector3d> meshPoints(firstUses.size());
+    for (std::size_t i = 0; i < firstUses.size(); i++) {
+        pointIndex[firstUses[i].second] = uint32_t(i);
+        meshPoints[i] = vertices[groupStart[firstUses[i].second]].p;
+    }
+
+    // map the points of the domains to the mesh points and convert the facets
+    std::vector<std::vector<uint32_t>> domainPointIndex(numDomains);
+    for (std::size_t i = 0; i < numDomains; i++) {
+        domainPointIndex[i].resize(domains[i].points.size());
+    }
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+        domainPointIndex[vertices[i].domain][vertices[i].index] = pointIndex[group[i]];
+    }
+
+    std::vector<std::vector<Facet>> domainFaces(numDomains);
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        const std::vector<uint32_t>& mapIndex = domainPointIndex[index];
+        std::vector<Facet>& domainFacets = domainFaces[index];
+        domainFacets.reserve(domains[index].facets.size());
+        for (const Facet& df : domains[index].facets) {
+            Facet face;
+            face.I1 = mapIndex[df.I1];
+            face.I2 = mapIndex[df.I2];
+            face.I3 = mapIndex[df.I3];
+
+            // make sure that we don't insert invalid facets
+            if (face.I1 != face.I2 &&
+                face.I2 != face.I3 &&
+                face.I3 != face.I1) {
+                domainFacets.push_back(face);
+            }
+        }
+    });
+
+    std::size_t numFaces = 0;
+    for (const auto& it : domainFaces) {
+        numFaces += it.size();
+    }
+    faces.reserve(numFaces);
+    for (const auto& it : domainFaces) {
+        faces.insert(faces.end(), it.begin(), it.end());
+        domainSizes.push_back(it.size());
+    }
+
+    points.swap(meshPoints);
+
+    MergeVertex merge(points, faces, Precision::Confusion());
+    if (merge.hasDuplicatedPoints()) {
+        merge.mergeDuplicatedPoints();
+        points = merge.getPoints();
+        faces = merge.getFacets();
+    }
+}
+
 std::vector<BRepMesh::Segment> BRepMesh::createSegments() const
 {
     std::size_t numMeshFaces = 0;
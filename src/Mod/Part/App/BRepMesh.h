@@ -39,6 +39,11 @@ public:
     void getFacesFromDomains(const std::vector<Domain>& domains,
                              std::vector<Base::Vector3d>& points,
                              std::vector<Facet>& faces);
+    /** Does the same as getFacesFromDomains() but converts the domains and welds their points
+     * on several threads. The result is identical. */
+    void getFacesFromDomainsParallel(const std::vector<Domain>& domains,
+                                     std::vector<Base::Vector3d>& points,
+                                     std::vector<Facet>& faces);
     std::vector<Segment> createSegments() const;
 
 private:
@@ -23,12 +23,15 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <exception>
+# include <memory>
 # include <BRepAdaptor_Surface.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
+# include <BRepCheck_Analyzer.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
@@ -41,6 +44,8 @@
 # include <TopoDS.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
+# include <QThread>
+# include <QtConcurrentMap>
 #endif
 
 #include "CrossSection.h"
@@ -257,17 +262,158 @@ TopoShape TopoCrossSection::slice(int idx, double d) const
         TopoShape::SingleShapeCompoundCreationPolicy::returnShape);
 }
 
+/// The boolean operations of one plane, filled by a worker thread
+struct TopoCrossSection::PlaneSlice
+{
+    int index = 0;
+    double distance = 0.0;
+    TopoDS_Face face;
+    std::unique_ptr<BRepPrimAPI_MakeHalfSpace> mkSolid;
+    std::vector<std::unique_ptr<BRepAlgoAPI_BooleanOperation>> operations;
+    std::exception_ptr error;
+};
+
+void TopoCrossSection::slices(const std::vector<double>& distances,
+                              std::vector<TopoShape>& wires,
+                              bool parallel) const
+{
+    if (!parallel || distances.size() < 2) {
+        int index = 0;
+        for (double d : distances) {
+            slice(++index, d, wires);
+        }
+        return;
+    }
+
+    // the same sub-shapes as used by slice()
+    bool solid = true;
+    std::vector<TopoShape> shapes = shape.getSubTopoShapes(TopAbs_SOLID);
+    if (shapes.empty()) {
+        solid = false;
+        shapes = shape.getSubTopoShapes(TopAbs_SHELL);
+        if (shapes.empty()) {
+            shapes = shape.getSubTopoShapes(TopAbs_FACE);
+        }
+    }
+
+    // The input doesn't change from plane to plane, so it's checked only once
+    // and not by each boolean operation.
+    for (const auto& s : shapes) {
+        if (!BRepCheck_Analyzer(s.getShape()).IsValid()) {
+            Standard_ConstructionError::Raise("Base shape is not valid for boolean operation");
+        }
+    }
+
+    // The boolean operations don't depend on each other and run concurrently.
+    // Mapping the element names uses the string hasher of the shape which isn't
+    // thread-safe, so this is done afterwards in the order of the planes. The
+    // planes are handled in blocks to limit the memory held by the operations.
+    const auto blockSize = static_cast<std::size_t>(4 * std::max(QThread::idealThreadCount(), 1));
+    for (std::size_t start = 0; start < distances.size(); start += blockSize) {
+        std::vector<PlaneSlice> planes(std::min(blockSize, distances.size() - start));
+        for (std::size_t i = 0; i < planes.size(); i++) {
+            planes[i].index = static_cast<int>(start + i + 1);
+            planes[i].distance = distances[start + i];
+        }
+
+        QtConcurrent::blockingMap(planes, [&](PlaneSlice& plane) {
+            makeSlice(plane, shapes, solid);
+        });
+
+        for (auto& plane : planes) {
+            if (plane.error) {
+                std::rethrow_exception(plane.error);
+            }
+            for (std::size_t i = 0; i < plane.operations.size(); i++) {
+                auto& op = *plane.operations[i];
+                if (solid) {
+                    mapSolid(plane.index,
+                             plane.distance,
+                             shapes[i],
+                             plane.face,
+                             *plane.mkSolid,
+                             op,
+                             wires);
+                }
+                else {
+                    mapNonSolid(plane.index, shapes[i], op, wires);
+                }
+            }
+        }
+    }
+}
+
+void TopoCrossSection::makeSlice(PlaneSlice& plane,
+                                 const std::vector<TopoShape>& shapes,
+                                 bool solid) const
+{
+    try {
+        gp_Pln slicePlane(a, b, c, -plane.distance);
+        if (solid) {
+            plane.face = BRepBuilderAPI_MakeFace(slicePlane).Face();
+            plane.mkSolid = std::make_unique<BRepPrimAPI_MakeHalfSpace>(
+                plane.face,
+                getReferencePoint(plane.distance));
+        }
+
+        for (const auto& s : shapes) {
+            TopTools_ListOfShape arguments;
+            arguments.Append(s.getShape());
+            if (solid) {
+                TopTools_ListOfShape tools;
+                tools.Append(plane.mkSolid->Shape());
+                auto mkCut = std::make_unique<FCBRepAlgoAPI_Cut>();
+                mkCut->SetArguments(arguments);
+                mkCut->SetTools(tools);
+                mkCut->setAutoFuzzy();
+                mkCut->Build();
+                plane.operations.push_back(std::move(mkCut));
+            }
+            else {
+                auto mkSection = std::make_unique<FCBRepAlgoAPI_Section>();
+                mkSection->SetArguments(arguments);
+                mkSection->Init2(slicePlane);
+                mkSection->setAutoFuzzy();
+                mkSection->Build();
+                plane.operations.push_back(std::move(mkSection));
+            }
+        }
+    }
+    catch (...) {
+        plane.error = std::current_exception();
+    }
+}
+
+gp_Pnt TopoCrossSection::getReferencePoint(double d) const
+{
+    // Make sure to choose a point that does not lie on the plane (fixes #0001228)
+    gp_Vec tempVector(a, b, c);
+    tempVector.Normalize();  // just in case.
+    tempVector *= (d + 1.0);
+    gp_Pnt refPoint(0.0, 0.0, 0.0);
+    refPoint.Translate(tempVector);
+    return refPoint;
+}
+
 void TopoCrossSection::sliceNonSolid(int idx,
                                      double d,
                                      const TopoShape& shape,
                                      std::vector<TopoShape>& wires) const
 {
     FCBRepAlgoAPI_Section cs(shape.getShape(), gp_Pln(a, b, c, -d));
-    if (cs.IsDone()) {
+    mapNonSolid(idx, shape, cs, wires);
+}
+
+void TopoCrossSection::mapNonSolid(int idx,
+                                   const TopoShape& shape,
+                                   BRepAlgoAPI_BooleanOperation& mkSection,
+                                   std::vector<TopoShape>& wires) const
+{
+    if (mkSection.IsDone()) {
         std::string prefix(op);
         prefix += Data::indexSuffix(idx);
         auto res = TopoShape()
-                       .makeElementShape(cs, shape, prefix.c_str())
+                       .makeElementShape(mkSection, shape, prefix.c_str())
                        .makeElementWires()
                        .getSubTopoShapes(TopAbs_WIRE);
         wires.insert(wires.end(), res.begin(), res.end());
@@ -281,42 +427,48 @@ void TopoCrossSection::sliceSolid(int idx,
 {
     gp_Pln slicePlane(a, b, c, -d);
     BRepBuilderAPI_MakeFace mkFace(slicePlane);
-    TopoShape face(idx);
-    face.setShape(mkFace.Face());
+    BRepPrimAPI_MakeHalfSpace mkSolid(mkFace.Face(), getReferencePoint(d));
+    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), mkSolid.Shape());
+    mapSolid(idx, d, shape, mkFace.Face(), mkSolid, mkCut, wires);
+}
 
-    // Make sure to choose a point that does not lie on the plane (fixes #0001228)
-    gp_Vec tempVector(a, b, c);
-    tempVector.Normalize();  // just in case.
-    tempVector *= (d + 1.0);
-    gp_Pnt refPoint(0.0, 0.0, 0.0);
-    refPoint.Translate(tempVector);
+void TopoCrossSection::mapSolid(int idx,
+                                double d,
+                                const TopoShape& shape,
+                                const TopoDS_Face& sliceFace,
+                                BRepPrimAPI_MakeHalfSpace& mkSolid,
+                                BRepAlgoAPI_BooleanOperation& mkCut,
+                                std::vector<TopoShape>& wires) const
+{
+    if (!mkCut.IsDone()) {
+        return;
+    }
 
-    BRepPrimAPI_MakeHalfSpace mkSolid(TopoDS::Face(face.getShape()), refPoint);
+    gp_Pln slicePlane(a, b, c, -d);
+    TopoShape planeFace(idx);
+    planeFace.setShape(sliceFace);
     TopoShape solid(idx);
     std::string prefix(op);
     prefix += Data::indexSuffix(idx);
-    solid.makeElementShape(mkSolid, face, prefix.c_str());
-    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
-
-    if (mkCut.IsDone()) {
-        TopoShape res(shape.Tag, shape.Hasher);
-        std::vector<TopoShape> shapes;
-        shapes.push_back(shape);
-        shapes.push_back(solid);
-        res.makeElementShape(mkCut, shapes, prefix.c_str());
-        for (auto& face : res.getSubTopoShapes(TopAbs_FACE)) {
-            BRepAdaptor_Surface adapt(TopoDS::Face(face.getShape()));
-            if (adapt.GetType() == GeomAbs_Plane) {
-                gp_Pln plane = adapt.Plane();
-                if (plane.Axis().IsParallel(slicePlane.Axis(), Precision::Confusion())
-                    && plane.Distance(slicePlane.Location()) < Precision::Confusion()) {
-                    auto repaired_wires = TopoShape(face.Tag)
-                                              .makeElementWires(face.getSubTopoShapes(TopAbs_EDGE),
-                                                                prefix.c_str(),
-                                                                true)
-                                              .getSubTopoShapes(TopAbs_WIRE);
-                    wires.insert(wires.end(), repaired_wires.begin(), repaired_wires.end());
-                }
+    solid.makeElementShape(mkSolid, planeFace, prefix.c_str());
+
+    TopoShape res(shape.Tag, shape.Hasher);
+    std::vector<TopoShape> shapes;
+    shapes.push_back(shape);
+    shapes.push_back(solid);
+    res.makeElementShape(mkCut, shapes, prefix.c_str());
+    for (auto& face : res.getSubTopoShapes(TopAbs_FACE)) {
+        BRepAdaptor_Surface adapt(TopoDS::Face(face.getShape()));
+        if (adapt.GetType() == GeomAbs_Plane) {
+            gp_Pln plane = adapt.Plane();
+            if (plane.Axis().IsParallel(slicePlane.Axis(), Precision::Confusion())
+                && plane.Distance(slicePlane.Location()) < Precision::Confusion()) {
+                auto repaired_wires = TopoShape(face.Tag)
+                                          .makeElementWires(face.getSubTopoShapes(TopAbs_EDGE),
+                                                            prefix.c_str(),
+                                                            true)
+                                          .getSubTopoShapes(TopAbs_WIRE);
+                wires.insert(wires.end(), repaired_wires.begin(), repaired_wires.end());
             }
         }
     }
@@ -29,6 +29,8 @@
 #include "TopoShape.h"
 
 
+class BRepAlgoAPI_BooleanOperation;
+class TopoDS_Face;
 class TopoDS_Shape;
 class TopoDS_Wire;
 
@@ -59,10 +61,35 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /** Slices the shape at all the given distances
+     *
+     * The wires are appended in the order of the distances and the slices
+     * are indexed starting from 1, i.e. the result is the same as calling
+     * slice() for each distance. If \a parallel is true the input shape is
+     * checked only once and the boolean operations of the planes are run
+     * concurrently.
+     */
+    void slices(const std::vector<double>& distances,
+                std::vector<TopoShape>& wires,
+                bool parallel) const;
 
 private:
+    struct PlaneSlice;
     void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
     void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    void makeSlice(PlaneSlice& plane, const std::vector<TopoShape>& shapes, bool solid) const;
+    void mapNonSolid(int idx,
+                     const TopoShape& shape,
+                     BRepAlgoAPI_BooleanOperation& mkSection,
+                     std::vector<TopoShape>& wires) const;
+    void mapSolid(int idx,
+                  double d,
+                  const TopoShape& shape,
+                  const TopoDS_Face& face,
+                  BRepPrimAPI_MakeHalfSpace& mkSolid,
+                  BRepAlgoAPI_BooleanOperation& mkCut,
+                  std::vector<TopoShape>& wires) const;
+    gp_Pnt getReferencePoint(double d) const;
 
 private:
     double a, b, c;
@@ -27,15 +27,262 @@
   */
 
 #include <FCBRepAlgoAPI_BooleanOperation.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <set>
+#include <QtConcurrentMap>
 #include <BRepBndLib.hxx>
+#include <Bnd_BoundSortBox.hxx>
 #include <Bnd_Box.hxx>
+#include <Bnd_HArray1OfBox.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRep_Builder.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TopExp.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Iterator.hxx>
 #include <Precision.hxx>
 #include <FuzzyHelper.h>
 
+namespace {
+
+bool SplitDisjoint = false;
+
+// Arguments and tools of one of the independent operations a boolean is split into.
+// Without tools the arguments are passed to the result unchanged.
+struct Partition
+{
+    TopTools_ListOfShape arguments;
+    TopTools_ListOfShape tools;
+};
+
+void addShapes(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& shapes)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        shapes.push_back(shape);
+        return;
+    }
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        addShapes(it.Value(), shapes);
+    }
+}
+
+void addToCompound(BRep_Builder& builder, TopoDS_Compound& comp, const TopoDS_Shape& shape)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        builder.Add(comp, shape);
+        return;
+    }
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        builder.Add(comp, it.Value());
+    }
+}
+
+// bounding boxes enlarged by the gap, fails for shapes without extent
+bool getBoxes(const std::vector<TopoDS_Shape>& shapes,
+              double gap,
+              Handle(Bnd_HArray1OfBox)& boxes,
+              Bnd_Box& bounds)
+{
+    boxes = new Bnd_HArray1OfBox(1, static_cast<int>(shapes.size()));
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        Bnd_Box box;
+        BRepBndLib::Add(shapes[i], box);
+        if (box.IsVoid()) {
+            return false;
+        }
+        box.Enlarge(gap);
+        boxes->SetValue(static_cast<int>(i + 1), box);
+        bounds.Add(box);
+    }
+    return true;
+}
+
+// groups of the indices of transitively overlapping boxes, ordered by their first index
+std::vector<std::vector<int>> clusterBoxes(const Handle(Bnd_HArray1OfBox)& boxes,
+                                           const Bnd_Box& bounds)
+{
+    const int count = boxes->Length();
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    Bnd_BoundSortBox sorter;
+    sorter.Initialize(bounds, boxes);
+    for (int i = 0; i < count; ++i) {
+        const TColStd_ListOfInteger& hits = sorter.Compare(boxes->Value(i + 1));
+        for (TColStd_ListOfInteger::Iterator it(hits); it.More(); it.Next()) {
+            int a = find(i);
+            int b = find(it.Value() - 1);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> clusters;
+    std::vector<int> clusterIndex(count, -1);
+    for (int i = 0; i < count; ++i) {
+        int root = find(i);
+        if (clusterIndex[root] < 0) {
+            clusterIndex[root] = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[clusterIndex[root]].push_back(i);
+    }
+    return clusters;
+}
+
+// Split a cut or common into operations on groups of overlapping arguments, each with the
+// tools that touch them. Like in Build(), the children of a compound argument are cut one by
+// one and the shapes of a compound tool are fused before the cut.
+bool splitByTools(const TopTools_ListOfShape& arguments,
+                  const TopTools_ListOfShape& toolList,
+                  double gap,
+                  BOPAlgo_Operation operation,
+                  std::vector<Partition>& partitions)
+{
+    bool isCut = operation == BOPAlgo_CUT;
+    bool compoundTool = isCut && toolList.Size() == 1
+        && toolList.First().ShapeType() == TopAbs_COMPOUND;
+    bool perChild = isCut && !compoundTool && arguments.Size() == 1
+        && arguments.First().ShapeType() == TopAbs_COMPOUND;
+    std::vector<TopoDS_Shape> regions;
+    if (perChild) {
+        for (TopoDS_Iterator it(arguments.First()); it.More(); it.Next()) {
+            regions.push_back(it.Value());
+        }
+    }
+    else {
+        for (TopTools_ListOfShape::Iterator it(arguments); it.More(); it.Next()) {
+            regions.push_back(it.Value());
+        }
+    }
+    std::vector<TopoDS_Shape> tools;
+    if (compoundTool) {
+        addShapes(toolList.First(), tools);
+    }
+    else {
+        for (TopTools_ListOfShape::Iterator it(toolList); it.More(); it.Next()) {
+            tools.push_back(it.Value());
+        }
+    }
+    if (regions.empty() || tools.empty()) {
+        return false;
+    }
+
+    Handle(Bnd_HArray1OfBox) regionBoxes;
+    Handle(Bnd_HArray1OfBox) toolBoxes;
+    Bnd_Box regionBounds;
+    Bnd_Box toolBounds;
+    if (!getBoxes(regions, gap, regionBoxes, regionBounds)
+        || !getBoxes(tools, gap, toolBoxes, toolBounds)) {
+        return false;
+    }
+
+    // separate arguments are intersected with each other, so overlapping ones stay together
+    std::vector<std::vector<int>> clusters;
+    if (perChild) {
+        for (int i = 0; i < static_cast<int>(regions.size()); ++i) {
+            clusters.push_back({i});
+        }
+    }
+    else {
+        clusters = clusterBoxes(regionBoxes, regionBounds);
+    }
+
+    Bnd_BoundSortBox sorter;
+    sorter.Initialize(toolBounds, toolBoxes);
+    for (const auto& cluster : clusters) {
+        std::set<int> hits;
+        Partition partition;
+        for (int i : cluster) {
+            const TColStd_ListOfInteger& toolHits = sorter.Compare(regionBoxes->Value(i + 1));
+            for (TColStd_ListOfInteger::Iterator it(toolHits); it.More(); it.Next()) {
+                hits.insert(it.Value() - 1);
+            }
+            partition.arguments.Append(regions[i]);
+        }
+        if (clusters.size() == 1 && hits.size() == tools.size()) {
+            // nothing to gain, e.g. a single perforated plate: cutting it into tiles would
+            // change its topology, so this stays one operation
+            return false;
+        }
+        if (hits.empty()) {
+            if (isCut) {
+                partitions.push_back(std::move(partition));
+            }
+            continue;
+        }
+        if (compoundTool) {
+            BRep_Builder builder;
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            for (int i : hits) {
+                builder.Add(comp, tools[i]);
+            }
+            partition.tools.Append(comp);
+        }
+        else {
+            for (int i : hits) {
+                partition.tools.Append(tools[i]);
+            }
+        }
+        partitions.push_back(std::move(partition));
+    }
+    return true;
+}
+
+// Split a fuse into the fusions of groups of overlapping shapes
+bool splitByOverlap(const TopTools_ListOfShape& arguments,
+                    const TopTools_ListOfShape& tools,
+                    double gap,
+                    std::vector<Partition>& partitions)
+{
+    std::vector<TopoDS_Shape> shapes;
+    for (const auto* list : {&arguments, &tools}) {
+        for (TopTools_ListOfShape::Iterator it(*list); it.More(); it.Next()) {
+            // the children of a compound may overlap each other, leave that to OCCT
+            if (it.Value().ShapeType() == TopAbs_COMPOUND) {
+                return false;
+            }
+            shapes.push_back(it.Value());
+        }
+    }
+    if (shapes.size() < 2) {
+        return false;
+    }
+
+    Handle(Bnd_HArray1OfBox) boxes;
+    Bnd_Box bounds;
+    if (!getBoxes(shapes, gap, boxes, bounds)) {
+        return false;
+    }
+    auto clusters = clusterBoxes(boxes, bounds);
+    if (clusters.size() < 2) {
+        return false;
+    }
+    for (const auto& cluster : clusters) {
+        Partition partition;
+        partition.arguments.Append(shapes[cluster.front()]);
+        for (std::size_t i = 1; i < cluster.size(); ++i) {
+            partition.tools.Append(shapes[cluster[i]]);
+        }
+        partitions.push_back(std::move(partition));
+    }
+    return true;
+}
+
+}  // namespace
+
 FCBRepAlgoAPI_BooleanOperation::FCBRepAlgoAPI_BooleanOperation()
 {
     SetRunParallel(Standard_True);
@@ -74,6 +321,14 @@ void FCBRepAlgoAPIHelper::setAutoFuzzy(BRepAlgoAPI_BooleanOperation* op) {
     op->SetFuzzyValue(Part::FuzzyHelper::getBooleanFuzzy() * sqrt(bounds.SquareExtent()) * Precision::Confusion());
 }
 
+void FCBRepAlgoAPIHelper::setSplitDisjoint(bool enable) {
+    SplitDisjoint = enable;
+}
+
+bool FCBRepAlgoAPIHelper::isSplitDisjoint() {
+    return SplitDisjoint;
+}
+
 void FCBRepAlgoAPIHelper::setAutoFuzzy(BRepAlgoAPI_BuilderAlgo* op) {
     Bnd_Box bounds;
     for (TopTools_ListOfShape::Iterator it(op->Arguments()); it.More(); it.Next())
@@ -90,11 +345,19 @@ void FCBRepAlgoAPI_BooleanOperation::Build(const Message_ProgressRange& progress
     if (progressRange.UserBreak()) {
         Standard_ConstructionError::Raise("User aborted");
     }
-    if (myOperation == BOPAlgo_CUT && myArguments.Size() == 1 && myTools.Size() == 1 && myTools.First().ShapeType() == TopAbs_COMPOUND) {
+    myCombinedHistory = false;
+    mySubOperations.clear();
+    myResultShapes.Clear();
+    if (SplitDisjointBuild(progressRange)) {
+        // split into independent operations
+    } else if (myOperation == BOPAlgo_CUT && myArguments.Size() == 1 && myTools.Size() == 1 && myTools.First().ShapeType() == TopAbs_COMPOUND) {
         // cut argument and compound tool
         TopTools_ListOfShape myOriginalArguments = myArguments;
         TopTools_ListOfShape myOriginalTools = myTools;
+        bool allowSplit = myAllowSplit;
+        myAllowSplit = false;
         RecursiveCutFusedTools(myOriginalArguments, myOriginalTools.First());
+        myAllowSplit = allowSplit;
         myArguments = myOriginalArguments;
         myTools = myOriginalTools;
         
@@ -167,21 +430,174 @@ void FCBRepAlgoAPI_BooleanOperation::RecursiveCutCompound(const TopoDS_Shape& th
     builder.MakeCompound(comp);
     
     // iterate through shapes in argument compound and cut each one with the tool
+    // keep the operations to report the history of all of them
+    std::vector<std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>> operations;
     TopoDS_Iterator it(theArgument);
     for (; it.More(); it.Next()) {
-        myArguments.Clear();
-        myArguments.Append(it.Value());
-        Build();
+        TopTools_ListOfShape arguments;
+        arguments.Append(it.Value());
+        auto op = MakeSubOperation(arguments, myTools);
+        op->Build();
         
-        if (!IsDone()) {
+        if (!op->IsDone()) {
             myShape = {};
+            NotDone();
             return;
         }
         
-        builder.Add(comp, myShape);
+        builder.Add(comp, op->Shape());
+        operations.push_back(std::move(op));
     }
     
     // result is a compound of individual cuts
     myShape = comp;
+    SetSubOperations(std::move(operations));
+}
+
+std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>
+FCBRepAlgoAPI_BooleanOperation::MakeSubOperation(const TopTools_ListOfShape& theArguments,
+                                                 const TopTools_ListOfShape& theTools) const
+{
+    auto op = std::make_unique<FCBRepAlgoAPI_BooleanOperation>();
+    op->myAllowSplit = false;
+    op->SetOperation(myOperation);
+    op->SetArguments(theArguments);
+    op->SetTools(theTools);
+    op->SetFuzzyValue(FuzzyValue());
+    op->SetNonDestructive(NonDestructive());
+    op->SetGlue(Glue());
+    op->SetCheckInverted(CheckInverted());
+    op->SetUseOBB(UseOBB());
+    return op;
+}
+
+void FCBRepAlgoAPI_BooleanOperation::SetSubOperations(
+    std::vector<std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>>&& theOperations)
+{
+    myResultShapes.Clear();
+    TopExp::MapShapes(myShape, myResultShapes);
+    mySubOperations = std::move(theOperations);
+    myCombinedHistory = true;
+    Done();
+}
+
+bool FCBRepAlgoAPI_BooleanOperation::SplitDisjointBuild(const Message_ProgressRange& progressRange)
+{
+    if (!SplitDisjoint || !myAllowSplit) {
+        return false;
+    }
+
+    // Shapes closer than the fuzzy value interact, so enlarge the boxes by it
+    double gap = FuzzyValue() + Precision::Confusion();
+    std::vector<Partition> partitions;
+    bool split = false;
+    switch (myOperation) {
+        case BOPAlgo_CUT:
+        case BOPAlgo_COMMON:
+            split = splitByTools(myArguments, myTools, gap, myOperation, partitions);
+            break;
+        case BOPAlgo_FUSE:
+            split = splitByOverlap(myArguments, myTools, gap, partitions);
+            break;
+        default:
+            break;
+    }
+    if (!split) {
+        return false;
+    }
+
+    // The operations handle compound arguments and tools like an unsplit operation would
+    std::vector<std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>> operations;
+    for (const auto& partition : partitions) {
+        if (partition.tools.IsEmpty()) {
+            continue;
+        }
+        operations.push_back(MakeSubOperation(partition.arguments, partition.tools));
+    }
+
+    // The operations share the input shapes, which are left unchanged in non-destructive mode.
+    // Running them concurrently keeps more threads busy than the parallel mode of a single
+    // operation, so that is only used if there is just one.
+    bool runParallel = RunParallel() && operations.size() == 1;
+    std::atomic<bool> failed {false};
+    QtConcurrent::blockingMap(operations,
+                              [&](std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>& op) {
+        if (failed || progressRange.UserBreak()) {
+            failed = true;
+            return;
+        }
+        try {
+            op->SetRunParallel(runParallel);
+            op->Build();
+            if (!op->IsDone() || op->HasErrors()) {
+                failed = true;
+            }
+        }
+        catch (const Standard_Failure&) {
+            failed = true;
+        }
+    });
+    if (progressRange.UserBreak()) {
+        Standard_ConstructionError::Raise("User aborted");
+    }
+    if (failed) {
+        // let the single operation report the error
+        return false;
+    }
+
+    Clear();
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    auto op = operations.begin();
+    for (const auto& partition : partitions) {
+        if (partition.tools.IsEmpty()) {
+            for (TopTools_ListOfShape::Iterator it(partition.arguments); it.More(); it.Next()) {
+                addToCompound(builder, comp, it.Value());
+            }
+        }
+        else {
+            addToCompound(builder, comp, (*op++)->Shape());
+        }
+    }
+    myShape = comp;
+    SetSubOperations(std::move(operations));
+    return true;
+}
+
+const TopTools_ListOfShape& FCBRepAlgoAPI_BooleanOperation::Modified(const TopoDS_Shape& theS)
+{
+    if (!myCombinedHistory) {
+        return BRepAlgoAPI_BooleanOperation::Modified(theS);
+    }
+    myGenerated.Clear();
+    for (auto& op : mySubOperations) {
+        for (TopTools_ListOfShape::Iterator it(op->Modified(theS)); it.More(); it.Next()) {
+            myGenerated.Append(it.Value());
+        }
+    }
+    return myGenerated;
+}
+
+const TopTools_ListOfShape& FCBRepAlgoAPI_BooleanOperation::Generated(const TopoDS_Shape& theS)
+{
+    if (!myCombinedHistory) {
+        return BRepAlgoAPI_BooleanOperation::Generated(theS);
+    }
+    myGenerated.Clear();
+    for (auto& op : mySubOperations) {
+        for (TopTools_ListOfShape::Iterator it(op->Generated(theS)); it.More(); it.Next()) {
+            myGenerated.Append(it.Value());
+        }
+    }
+    return myGenerated;
+}
+
+Standard_Boolean FCBRepAlgoAPI_BooleanOperation::IsDeleted(const TopoDS_Shape& theS)
+{
+    if (!myCombinedHistory) {
+        return BRepAlgoAPI_BooleanOperation::IsDeleted(theS);
+    }
+    return !myResultShapes.Contains(theS) && Modified(theS).IsEmpty();
 }
 
@@ -29,14 +29,22 @@
 #ifndef FCREPALGOAPIBOOLEANOPERATION_H
 #define FCREPALGOAPIBOOLEANOPERATION_H
 
+#include <memory>
+#include <vector>
 #include <BRepAlgoAPI_BooleanOperation.hxx>
 #include <Message_ProgressRange.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 
 class FCBRepAlgoAPIHelper
 {
 public:
     static void setAutoFuzzy(BRepAlgoAPI_BooleanOperation* op);
     static void setAutoFuzzy(BRepAlgoAPI_BuilderAlgo* op);
+
+    // enable or disable splitting booleans into independent operations on operands with
+    // disjoint bounding boxes, disabled by default
+    Standard_EXPORT static void setSplitDisjoint(bool enable);
+    Standard_EXPORT static bool isSplitDisjoint();
 };
 
 class FCBRepAlgoAPI_BooleanOperation : public BRepAlgoAPI_BooleanOperation
@@ -60,6 +68,12 @@ public:
     Standard_EXPORT virtual void Build(const Message_ProgressRange& progressRange);
 #endif
 
+    // history of the shape, combined from the separate operations if the boolean was split
+    // or the children of a compound argument were cut one by one
+    Standard_EXPORT const TopTools_ListOfShape& Modified(const TopoDS_Shape& theS) Standard_OVERRIDE;
+    Standard_EXPORT const TopTools_ListOfShape& Generated(const TopoDS_Shape& theS) Standard_OVERRIDE;
+    Standard_EXPORT Standard_Boolean IsDeleted(const TopoDS_Shape& theS) Standard_OVERRIDE;
+
 protected: //! @name Constructors
 
   //! Constructor to perform Boolean operation on only two arguments.
@@ -73,5 +87,23 @@ private:
   Standard_EXPORT void RecursiveCutFusedTools(const TopTools_ListOfShape& theOriginalArguments,
                                               const TopoDS_Shape& theTool);
   Standard_EXPORT void RecursiveCutCompound(const TopoDS_Shape& theArgument);
+
+  //! Split a cut, common or fuse into operations on operands with disjoint bounding boxes
+  //! and run them concurrently. Returns false if the operation can't be split, e.g. if all
+  //! tools touch a single solid. Such a solid is never split itself.
+  Standard_EXPORT bool SplitDisjointBuild(const Message_ProgressRange& progressRange);
+  //! An operation with the settings of this one, which isn't split itself
+  Standard_EXPORT std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>
+  MakeSubOperation(const TopTools_ListOfShape& theArguments,
+                   const TopTools_ListOfShape& theTools) const;
+  //! Take the result of the operations that built myShape and report their combined history
+  Standard_EXPORT void SetSubOperations(
+      std::vector<std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>>&& theOperations);
+
+  std::vector<std::unique_ptr<FCBRepAlgoAPI_BooleanOperation>> mySubOperations;
+  TopTools_IndexedMapOfShape myResultShapes;
+  bool myCombinedHistory = false;
+  // false for the split operations and while the recursive cuts run
+  bool myAllowSplit = true;
 };
 #endif
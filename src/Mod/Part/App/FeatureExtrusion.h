@@ -108,6 +108,9 @@ public: //mode enumerations
 protected:
     void setupObject() override;
     void onChanged(const App::Property* prop) override;
+    bool canCacheResult() const override {
+        return true;
+    }
 };
 
 /**
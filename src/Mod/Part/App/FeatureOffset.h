@@ -57,6 +57,11 @@ public:
     }
     //@}
 
+protected:
+    bool canCacheResult() const override {
+        return true;
+    }
+
 private:
     static const char* ModeEnums[];
     static const char* JoinEnums[];
@@ -67,6 +67,10 @@ public:
         return "PartGui::ViewProviderMultiCommon";
     }
 
+protected:
+    bool canCacheResult() const override {
+        return true;
+    }
 };
 
 }
@@ -67,6 +67,10 @@ public:
         return "PartGui::ViewProviderMultiFuse";
     }
 
+protected:
+    bool canCacheResult() const override {
+        return true;
+    }
 };
 
 }
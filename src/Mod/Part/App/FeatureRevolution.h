@@ -84,6 +84,9 @@ private:
 
 protected:
     void setupObject() override;
+    bool canCacheResult() const override {
+        return true;
+    }
 };
 
 } //namespace Part
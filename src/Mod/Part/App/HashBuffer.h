@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef PART_HASHBUFFER_H
+#define PART_HASHBUFFER_H
+
+#include <cstdint>
+#include <streambuf>
+
+namespace Part
+{
+
+/** Stream buffer that computes the 64 bit FNV-1a hash of everything written to it.
+ * The hash doesn't depend on the platform, so it can be stored with a document.
+ */
+class HashBuffer: public std::streambuf
+{
+public:
+    uint64_t value() const
+    {
+        return hash;
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            add(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+    std::streamsize xsputn(const char* str, std::streamsize count) override
+    {
+        for (std::streamsize i = 0; i < count; i++) {
+            add(str[i]);
+        }
+        return count;
+    }
+
+private:
+    void add(char ch)
+    {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 0x100000001b3ULL;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+};
+
+}  // namespace Part
+
+#endif  // PART_HASHBUFFER_H
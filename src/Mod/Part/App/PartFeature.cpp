@@ -68,11 +68,14 @@
 #include <Base/Exception.h>
 #include <Base/Placement.h>
 #include <Base/Rotation.h>
+#include <Base/Parameter.h>
 #include <Base/Stream.h>
 #include <Base/Tools.h>
+#include <Base/Writer.h>
 #include <Mod/Material/App/MaterialManager.h>
 
 #include "Geometry.h"
+#include "HashBuffer.h"
 #include "PartFeature.h"
 #include "PartFeaturePy.h"
 #include "PartPyCXX.h"
@@ -86,6 +89,44 @@ FC_LOG_LEVEL_INIT("Part",true,true)
 
 PROPERTY_SOURCE(Part::Feature, App::GeoFeature)
 
+Feature::ResultCacheStatistics Feature::_resultCacheStatistics;
+
+namespace
+{
+// writer that computes the hash of the saved properties
+class HashWriter: public Base::Writer
+{
+public:
+    HashWriter()
+        : str(&buffer)
+    {
+        setForceXML(true);
+    }
+    std::ostream& Stream() override
+    {
+        return str;
+    }
+    void writeFiles() override
+    {}
+    uint64_t value()
+    {
+        str.flush();
+        return buffer.value();
+    }
+
+private:
+    HashBuffer buffer;
+    std::ostream str;
+};
+
+bool isResultCacheEnabled()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    return hGrp->GetBool("CacheFeatureResults", false);
+}
+}  // namespace
+
 
 Feature::Feature()
 {
@@ -104,7 +145,27 @@ short Feature::mustExecute() const
 App::DocumentObjectExecReturn *Feature::recompute()
 {
     try {
-        return App::GeoFeature::recompute();
+        // Extensions may depend on more than the properties of this object
+        bool useCache = canCacheResult() && !hasExtensions() && isResultCacheEnabled();
+        uint64_t hash = 0;
+        if (useCache) {
+            hash = getInputHash();
+            // 'Mark to recompute' must always execute
+            bool forced = testStatus(App::ObjectStatus::ForceRecompute);
+            if (!forced && _resultHash != 0 && _resultHash == hash
+                && !Shape.getValue().IsNull()) {
+                _resultCacheStatistics.hits++;
+                FC_LOG("Reuse result of " << getFullName());
+                return App::DocumentObject::StdReturn;
+            }
+            _resultCacheStatistics.misses++;
+        }
+
+        auto ret = App::GeoFeature::recompute();
+        if (useCache) {
+            _resultHash = ret == App::DocumentObject::StdReturn ? hash : 0;
+        }
+        return ret;
     }
     catch (Standard_Failure& e) {
 
@@ -120,6 +181,59 @@ App::DocumentObjectExecReturn *Feature::execute()
     return GeoFeature::execute();
 }
 
+uint64_t Feature::getInputHash() const
+{
+    HashWriter writer;
+    writer.Stream() << getTypeId().getName() << '\n';
+
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (App::Property* prop : props) {
+        if (prop == &Shape || prop == &Label || prop == &Label2 || prop == &Visibility
+            || prop == &ExpressionEngine || prop == &ShapeMaterial) {
+            continue;
+        }
+        if ((getPropertyType(prop) & (App::Prop_Output | App::Prop_Transient))
+            || prop->testStatus(App::Property::Output)
+            || prop->testStatus(App::Property::Transient)) {
+            continue;
+        }
+        writer.Stream() << prop->getName() << '\n';
+        prop->Save(writer);
+
+        // the identity of the linked shapes: an upstream feature that reused its result keeps
+        // its TShape, any other recompute creates a new one
+        if (auto link = freecad_cast<App::PropertyLinkBase*>(prop)) {
+            std::vector<App::DocumentObject*> objs;
+            link->getLinks(objs);
+            for (auto obj : objs) {
+                TopoShape shape =
+                    getTopoShape(obj, ShapeOption::ResolveLink | ShapeOption::Transform);
+                const TopoDS_Shape& occShape = shape.getShape();
+                auto tshape = reinterpret_cast<std::uintptr_t>(occShape.TShape().get());
+                writer.Stream() << tshape << ' ' << occShape.Orientation() << ' ' << shape.Tag
+                                << ' ' << shape.getElementMapVersion() << ' '
+                                << shape.getElementMapSize() << '\n';
+                Base::Matrix4D mat = shape.getTransform();
+                double values[16];
+                mat.getMatrix(values);
+                writer.Stream().write(reinterpret_cast<const char*>(values), sizeof(values));
+            }
+        }
+    }
+    return writer.value();
+}
+
+const Feature::ResultCacheStatistics& Feature::getResultCacheStatistics()
+{
+    return _resultCacheStatistics;
+}
+
+void Feature::resetResultCacheStatistics()
+{
+    _resultCacheStatistics = ResultCacheStatistics();
+}
+
 PyObject *Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
@@ -1512,6 +1626,8 @@ void Feature::onChanged(const App::Property* prop)
             this->Shape._Shape.setTransform(this->Placement.getValue().toMatrix());
         }
         else {
+            // the shape has been set from outside, the result hash doesn't apply any more
+            _resultHash = 0;
             Base::Placement p;
             // shape must not be null to override the placement
             if (!this->Shape.getValue().IsNull()) {
@@ -174,9 +174,35 @@ public:
                                                        Data::SearchOptions options = Data::SearchOption::CheckGeometry,
                                                        double tol = 1e-7,
                                                        double atol = 1e-10) const override;
+
+    /** @name Result cache
+     * A feature that opts in with canCacheResult() skips execute() if the hash
+     * of its input properties and of the shapes of the linked objects is the same
+     * as for the current result. The linked shapes are hashed by their identity,
+     * so the hash is only kept for the session and is reset if Shape is set from
+     * outside a recompute. App::DocumentObject::enforceRecompute() always
+     * executes the feature. The cache is off unless the Mod/Part/General
+     * parameter CacheFeatureResults is set.
+     */
+    //@{
+    struct ResultCacheStatistics
+    {
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+    };
+    static const ResultCacheStatistics& getResultCacheStatistics();
+    static void resetResultCacheStatistics();
+    /// Returns the hash of the input properties and of the identity of the linked shapes
+    uint64_t getInputHash() const;
+    //@}
+
 protected:
     /// recompute only this object
     App::DocumentObjectExecReturn *recompute() override;
+    /// Returns true if the result only depends on the input properties and the linked shapes
+    virtual bool canCacheResult() const {
+        return false;
+    }
     /// recalculate the feature
     App::DocumentObjectExecReturn *execute() override;
     void onBeforeChange(const App::Property* prop) override;
@@ -213,6 +239,8 @@ private:
     struct ElementCache;
     std::map<std::string, ElementCache> _elementCache;
     std::vector<std::pair<std::string, PropertyPartShape*>> _elementCachePrefixMap;
+    static ResultCacheStatistics _resultCacheStatistics;
+    uint64_t _resultHash = 0;
 };
 
 class PartExport FilletBase : public Part::Feature
@@ -233,6 +261,9 @@ public:
 protected:
     void onDocumentRestored() override;
     void onChanged(const App::Property *) override;
+    bool canCacheResult() const override {
+        return true;
+    }
     void syncEdgeLink();
 };
 
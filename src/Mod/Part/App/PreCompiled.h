@@ -46,7 +46,10 @@
 #include <limits>
 
 // STL
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <exception>
 #include <fcntl.h>
 #include <fstream>
 #include <list>
@@ -54,12 +57,18 @@
 #include <map>
 #include <memory>
 #include <numbers>
+#include <numeric>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // Qt
+#include <QThread>
+#include <QtConcurrentMap>
 #include <QtGlobal>
 
 // Boost
@@ -52,11 +52,57 @@ PropertyGeometryList::PropertyGeometryList() = default;
 
 PropertyGeometryList::~PropertyGeometryList()
 {
+    if (_sharedFrom) {
+        // the geometries still belong to the list this was copied from
+        auto &copies = _sharedFrom->_sharingCopies;
+        copies.erase(std::remove(copies.begin(), copies.end(), this), copies.end());
+        return;
+    }
+    releaseValues({});
     for (auto it : _lValueList) {
         if (it) delete it;
     }
 }
 
+void PropertyGeometryList::aboutToReplaceValues()
+{
+    ++_replacing;
+    try {
+        aboutToSetValue();
+    }
+    catch (...) {
+        --_replacing;
+        releaseValues({});
+        throw;
+    }
+    --_replacing;
+}
+
+void PropertyGeometryList::releaseValues(const std::vector<Geometry*> &dropped)
+{
+    // 'dropped' is sorted and holds the geometries that are no longer in the
+    // list. Each of them is moved to one of the sharing copies or deleted, the
+    // copies clone all other geometries.
+    std::vector<bool> moved(dropped.size(), false);
+    for (auto copy : _sharingCopies) {
+        for (auto &geo : copy->_lValueList) {
+            auto it = std::lower_bound(dropped.begin(), dropped.end(), geo);
+            auto index = it - dropped.begin();
+            if (it != dropped.end() && *it == geo && !moved[index])
+                moved[index] = true;
+            else
+                geo = geo->clone();
+        }
+        copy->_sharedFrom = nullptr;
+    }
+    _sharingCopies.clear();
+
+    for (std::size_t i = 0; i < dropped.size(); i++) {
+        if (!moved[i])
+            delete dropped[i];
+    }
+}
+
 void PropertyGeometryList::setSize(int newSize)
 {
     for (unsigned int i = newSize; i < _lValueList.size(); i++)
@@ -72,10 +118,10 @@ int PropertyGeometryList::getSize() const
 void PropertyGeometryList::setValue(const Geometry* lValue)
 {
     if (lValue) {
-        aboutToSetValue();
+        aboutToReplaceValues();
         Geometry* newVal = lValue->clone();
-        for (auto it : _lValueList)
-            delete it;
+        std::sort(_lValueList.begin(), _lValueList.end());
+        releaseValues(_lValueList);
         _lValueList.resize(1);
         _lValueList[0] = newVal;
         hasSetValue();
@@ -85,7 +131,7 @@ void PropertyGeometryList::setValue(const Geometry* lValue)
 void PropertyGeometryList::setValues(const std::vector<Geometry*>& lValue)
 {
     auto copy = lValue;
-    aboutToSetValue();
+    aboutToReplaceValues();
     std::sort(_lValueList.begin(), _lValueList.end());
     for (auto & geo : copy) {
         auto range = std::equal_range(_lValueList.begin(), _lValueList.end(), geo);
@@ -96,8 +142,7 @@ void PropertyGeometryList::setValues(const std::vector<Geometry*>& lValue)
         else
             _lValueList.erase(range.first, range.second);
     }
-    for (auto v : _lValueList)
-        delete v;
+    releaseValues(_lValueList);
     _lValueList = std::move(copy);
     hasSetValue();
 }
@@ -106,14 +151,13 @@ void PropertyGeometryList::setValues(std::vector<Geometry*> &&lValue)
 {
     // Unlike above, the moved version of setValues() indicates the caller want
     // us to manager the memory of the passed in values. So no need clone.
-    aboutToSetValue();
+    aboutToReplaceValues();
     std::sort(_lValueList.begin(), _lValueList.end());
     for (auto geo : lValue) {
         auto range = std::equal_range(_lValueList.begin(), _lValueList.end(), geo);
         _lValueList.erase(range.first, range.second);
     }
-    for (auto geo : _lValueList)
-        delete geo;
+    releaseValues(_lValueList);
     _lValueList = std::move(lValue);
     hasSetValue();
 }
@@ -124,11 +168,13 @@ void PropertyGeometryList::set1Value(int idx, std::unique_ptr<Geometry> &&lValue
         return;
     if(idx>=(int)_lValueList.size())
         throw Base::IndexError("Index out of bound");
-    aboutToSetValue();
-    if(idx < 0)
+    aboutToReplaceValues();
+    if(idx < 0) {
+        releaseValues({});
         _lValueList.push_back(lValue.release());
+    }
     else {
-        delete _lValueList[idx];
+        releaseValues({_lValueList[idx]});
         _lValueList[idx] = lValue.release();
     }
     hasSetValue();
@@ -289,7 +335,16 @@ void PropertyGeometryList::Restore(Base::XMLReader &reader)
 App::Property *PropertyGeometryList::Copy() const
 {
     PropertyGeometryList *p = new PropertyGeometryList();
-    p->setValues(_lValueList);
+    if (_replacing) {
+        // The values are about to be replaced, e.g. this is the copy for undo. Share
+        // the geometries until the new values are set, see releaseValues().
+        p->_lValueList = _lValueList;
+        p->_sharedFrom = const_cast<PropertyGeometryList*>(this);  // NOLINT
+        _sharingCopies.push_back(p);
+    }
+    else {
+        p->setValues(_lValueList);
+    }
     return p;
 }
 
@@ -91,9 +91,20 @@ public:
 private:
     void trySaveGeometry(Geometry * geom, Base::Writer &writer) const;
     void tryRestoreGeometry(Geometry * geom, Base::XMLReader &reader);
+    void aboutToReplaceValues();
+    void releaseValues(const std::vector<Geometry*> &dropped);
 
 private:
     std::vector<Geometry*> _lValueList;
+
+    /** Copies made while the values are replaced, e.g. the undo copy made by
+     * aboutToSetValue(). They share the geometries instead of cloning them and
+     * take over the dropped ones once the new values are set.
+     */
+    mutable std::vector<PropertyGeometryList*> _sharingCopies;
+    /// The list whose geometries this copy shares
+    PropertyGeometryList *_sharedFrom = nullptr;
+    int _replacing = 0;
 };
 
 } // namespace Part
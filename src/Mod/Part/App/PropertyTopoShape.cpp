@@ -32,7 +32,9 @@
 # include <OSD_OpenFile.hxx>
 # include <Standard_Failure.hxx>
 # include <Standard_Version.hxx>
+# include <TopLoc_Location.hxx>
 # include <TopoDS.hxx>
+# include <gp_Trsf.hxx>
 #endif // _PreComp_
 
 #include <App/Application.h>
@@ -57,6 +59,27 @@ FC_LOG_LEVEL_INIT("App", true, true)
 namespace sp = std::placeholders;
 using namespace Part;
 
+namespace
+{
+// Shapes with the same TopoDS_TShape are saved only once per document, the other properties
+// reference the file and only store their own location and orientation. Versions that don't
+// know the 'shared' attribute restore such properties with an empty shape, so this is opt-in.
+std::string getSharedShapeKey(const TopoDS_Shape& shape)
+{
+    if (shape.IsNull()) {
+        return {};
+    }
+    bool shared = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("SaveSharedShapes", false);
+    if (!shared) {
+        return {};
+    }
+    std::ostringstream str;
+    str << "Part::TopoShape " << static_cast<const void*>(shape.TShape().get());
+    return str.str();
+}
+}
+
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData)
 
 PropertyPartShape::PropertyPartShape() = default;
@@ -284,9 +307,30 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     bool binary = writer.getMode("BinaryBrep");
     bool toXML = writer.isForceXML();
     if(!toXML) {
-        writer.Stream() << " file=\""
-                        << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this)
-                        << "\"/>\n";
+        std::string key;
+        std::string file;
+        if (owner) {
+            key = getSharedShapeKey(_Shape.getShape());
+            if (!key.empty())
+                file = owner->getDocument()->getSharedFile(key);
+        }
+        if (!file.empty()) {
+            const TopoDS_Shape& shape = _Shape.getShape();
+            Base::Matrix4D mat = TopoShape::convert(shape.Location().Transformation());
+            writer.Stream() << " shared=\"" << file << '"'
+                            << " orientation=\"" << static_cast<int>(shape.Orientation()) << '"';
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 4; j++)
+                    writer.Stream() << " a" << i + 1 << j + 1 << "=\"" << mat[i][j] << '"';
+            }
+            writer.Stream() << "/>\n";
+        }
+        else {
+            file = writer.addFile(getFileName(binary?".bin":".brp").c_str(), this);
+            if (!key.empty())
+                owner->getDocument()->addSharedFile(key, file);
+            writer.Stream() << " file=\"" << file << "\"/>\n";
+        }
     } else if(binary) {
         writer.Stream() << " binary=\"1\">\n";
         _Shape.exportBinary(writer.beginCharStream(Base::CharStreamFormat::Base64Encoded));
@@ -333,18 +377,31 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     int save_hasher = reader.getAttribute<int>("SaveHasher", 0);
 
     TopoShape shape;
+    _SharedFile.clear();
 
     if (reader.hasAttribute("file")) {
         std::string file = reader.getAttribute<const char*>("file");
         if (!file.empty()) {
             // initiate a file read
             reader.addFile(file.c_str(), this);
+            if (owner)
+                owner->getDocument()->setSharedFileOwner(file, this);
+        }
+    }
+    else if (reader.hasAttribute("shared")) {
+        // the shape is restored in afterRestore() once all files are read
+        _SharedFile = reader.getAttribute<const char*>("shared");
+        _SharedOrientation = reader.getAttribute<int>("orientation", 0);
+        _SharedLocation = Base::Matrix4D();
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 4; j++) {
+                std::string name = "a" + std::to_string(i + 1) + std::to_string(j + 1);
+                _SharedLocation[i][j] = reader.getAttribute<double>(name.c_str());
+            }
         }
     }
     else if (reader.hasAttribute(("binary")) && reader.getAttribute<long>("binary")) {
-        TopoShape shape;
         shape.importBinary(reader.beginCharStream());
-        shape = shape.getShape();
     }
     else if (reader.hasAttribute("brep") && reader.getAttribute<long>("brep")) {
         shape.importBrep(reader.beginCharStream(Base::CharStreamFormat::Raw));
@@ -407,8 +464,41 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     }
 }
 
+void PropertyPartShape::restoreSharedShape()
+{
+    std::string file;
+    file.swap(_SharedFile);
+    auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+    if (!owner)
+        return;
+
+    auto prop = dynamic_cast<PropertyPartShape*>(owner->getDocument()->getSharedFileOwner(file));
+    if (!prop || prop->_Shape.isNull()) {
+        // the owner of the file may not be loaded in a partial document
+        FC_WARN("Shared shape '" << file << "' of " << getFullName() << " is not restored");
+        owner->getDocument()->addRecomputeObject(owner);
+        return;
+    }
+
+    // share the TShape of the owner and keep the own element map
+    TopoDS_Shape shape = prop->_Shape.getShape();
+    gp_Trsf trsf = TopoShape::convert(_SharedLocation);
+    if (trsf.Form() == gp_Identity)
+        shape.Location(TopLoc_Location());
+    else
+        shape.Location(TopLoc_Location(trsf));
+    shape.Orientation(static_cast<TopAbs_Orientation>(_SharedOrientation));
+
+    aboutToSetValue();
+    _Shape.setShape(shape, false);
+    hasSetValue();
+}
+
 void PropertyPartShape::afterRestore()
 {
+    if (!_SharedFile.empty())
+        restoreSharedShape();
+
     if (_Shape.isRestoreFailed()) {
         // this cause GeoFeature::updateElementReference() to call
         // PropertyLinkBase::updateElementReferences() with reverse = true, in
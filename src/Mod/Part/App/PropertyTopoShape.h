@@ -110,12 +110,17 @@ private:
     void saveToFile(Base::Writer &writer) const;
     void loadFromFile(Base::Reader &reader);
     void loadFromStream(Base::Reader &reader);
+    void restoreSharedShape();
 
 private:
     TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    // file of another property holding the same shape, see Save()
+    std::string _SharedFile;
+    Base::Matrix4D _SharedLocation;
+    int _SharedOrientation = 0;
 };
 
 struct PartExport ShapeHistory {
@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#include <BRep_Tool.hxx>
+#include <Geom_Surface.hxx>
+#include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/Parameter.h>
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "HashBuffer.h"
+#include "TessellationCache.h"
+
+
+using namespace Part;
+
+namespace
+{
+Base::OutputStream& operator<<(Base::OutputStream& str, const Base::Vector3f& vec)
+{
+    return str << vec.x << vec.y << vec.z;
+}
+
+Base::InputStream& operator>>(Base::InputStream& str, Base::Vector3f& vec)
+{
+    return str >> vec.x >> vec.y >> vec.z;
+}
+
+template<typename T>
+void saveValues(Base::OutputStream& str, const std::vector<T>& values)
+{
+    str << static_cast<uint32_t>(values.size());
+    for (const T& it : values) {
+        str << it;
+    }
+}
+
+// the number of bytes left in the stream or -1 if it cannot be determined
+std::streamoff remainingBytes(std::istream& in)
+{
+    std::streampos pos = in.tellg();
+    if (pos < 0) {
+        in.clear();
+        return -1;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(pos);
+    if (end < 0 || !in) {
+        in.clear();
+        in.seekg(pos);
+        return -1;
+    }
+    return end - pos;
+}
+
+template<typename T>
+void restoreValues(Base::InputStream& str, std::istream& in, std::vector<T>& values)
+{
+    uint32_t count = 0;
+    str >> count;
+    if (!in) {
+        throw Base::FileException("Failed to read tessellation");
+    }
+    std::streamoff left = remainingBytes(in);
+    if (left >= 0 && static_cast<uint64_t>(count) * sizeof(T) > static_cast<uint64_t>(left)) {
+        throw Base::FileException("Failed to read tessellation");
+    }
+    // read in chunks so that a corrupt count of a stream of unknown size cannot trigger a huge
+    // allocation
+    const std::size_t chunk = 1 << 20;
+    values.clear();
+    while (values.size() < count) {
+        std::size_t offset = values.size();
+        values.resize(offset + std::min<std::size_t>(chunk, count - offset));
+        for (std::size_t i = offset; i < values.size(); i++) {
+            str >> values[i];
+        }
+        if (!in) {
+            throw Base::FileException("Failed to read tessellation");
+        }
+    }
+}
+
+bool isValidIndex(const std::vector<int32_t>& indices, std::size_t numPoints)
+{
+    return std::all_of(indices.begin(), indices.end(), [numPoints](int32_t index) {
+        return index >= -1 && index < static_cast<int64_t>(numPoints);
+    });
+}
+}  // namespace
+
+TessellationCache::Statistics TessellationCache::statistics;
+
+TessellationCache::TessellationCache(uint64_t key, Arrays arrays)
+    : key(key)
+    , arrays(std::move(arrays))
+{}
+
+bool TessellationCache::isEnabled()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    return hGrp->GetBool("SaveTessellation", false);
+}
+
+uint64_t TessellationCache::makeKey(const TopoDS_Shape& shape,
+                                    long tag,
+                                    double deflection,
+                                    double angle,
+                                    bool normalsFromUV)
+{
+    // Only values that are the same after a document is reloaded are hashed. The vertices are
+    // rounded to float so that a text BREP round trip doesn't change the key.
+    HashBuffer buffer;
+    std::ostream str(&buffer);
+    str.precision(9);
+    str << tag << '\n';
+
+    TopoDS_Shape local = shape.Located(TopLoc_Location());
+    TopTools_IndexedMapOfShape faces;
+    TopTools_IndexedMapOfShape edges;
+    TopTools_IndexedMapOfShape vertices;
+    TopExp::MapShapes(local, TopAbs_FACE, faces);
+    TopExp::MapShapes(local, TopAbs_EDGE, edges);
+    TopExp::MapShapes(local, TopAbs_VERTEX, vertices);
+    str << faces.Extent() << ' ' << edges.Extent() << ' ' << vertices.Extent() << '\n';
+    for (int i = 1; i <= faces.Extent(); i++) {
+        Handle(Geom_Surface) surface = BRep_Tool::Surface(TopoDS::Face(faces(i)));
+        str << (surface.IsNull() ? "" : surface->DynamicType()->Name()) << '\n';
+    }
+    for (int i = 1; i <= vertices.Extent(); i++) {
+        gp_Pnt pnt = BRep_Tool::Pnt(TopoDS::Vertex(vertices(i)));
+        str << static_cast<float>(pnt.X()) << ' ' << static_cast<float>(pnt.Y()) << ' '
+            << static_cast<float>(pnt.Z()) << '\n';
+    }
+
+    str.precision(17);
+    str << deflection << ' ' << angle << ' ' << normalsFromUV;
+    str.flush();
+    return buffer.value();
+}
+
+const TessellationCache::Statistics& TessellationCache::getStatistics()
+{
+    return statistics;
+}
+
+void TessellationCache::resetStatistics()
+{
+    statistics = Statistics();
+}
+
+bool TessellationCache::lookup(uint64_t key) const
+{
+    if (isEmpty() || this->key != key) {
+        statistics.misses++;
+        return false;
+    }
+
+    statistics.hits++;
+    return true;
+}
+
+void TessellationCache::save(Base::OutputStream& str) const
+{
+    str << key;
+    saveValues(str, arrays.points);
+    saveValues(str, arrays.normals);
+    saveValues(str, arrays.faceIndex);
+    saveValues(str, arrays.partIndex);
+    saveValues(str, arrays.lineIndex);
+    str << arrays.nodeStart;
+}
+
+void TessellationCache::restore(Base::InputStream& str, std::istream& in)
+{
+    clear();
+    try {
+        str >> key;
+        restoreValues(str, in, arrays.points);
+        restoreValues(str, in, arrays.normals);
+        restoreValues(str, in, arrays.faceIndex);
+        restoreValues(str, in, arrays.partIndex);
+        restoreValues(str, in, arrays.lineIndex);
+        str >> arrays.nodeStart;
+    }
+    catch (const Base::FileException&) {
+        clear();
+        throw;
+    }
+    catch (const std::exception&) {
+        // std::bad_alloc or std::length_error
+        clear();
+        throw Base::FileException("Failed to read tessellation");
+    }
+
+    // the part index holds the number of triangles of each face
+    int64_t numTriangles = std::count(arrays.faceIndex.begin(), arrays.faceIndex.end(), -1);
+    bool validParts = true;
+    for (int32_t count : arrays.partIndex) {
+        numTriangles -= count;
+        validParts = validParts && count >= 0 && numTriangles >= 0;
+    }
+    if (!in || arrays.normals.size() > arrays.points.size() || arrays.nodeStart < 0
+        || arrays.nodeStart > int32_t(arrays.points.size())
+        || !isValidIndex(arrays.faceIndex, arrays.points.size())
+        || !isValidIndex(arrays.lineIndex, arrays.points.size()) || !validParts) {
+        clear();
+        throw Base::FileException("Failed to read tessellation");
+    }
+}
+
+void TessellationCache::clear()
+{
+    key = 0;
+    arrays = Arrays();
+}
+
+unsigned int TessellationCache::getMemSize() const
+{
+    std::size_t size = (arrays.points.size() + arrays.normals.size()) * sizeof(Base::Vector3f)
+        + (arrays.faceIndex.size() + arrays.partIndex.size() + arrays.lineIndex.size())
+            * sizeof(int32_t);
+    return static_cast<unsigned int>(size);
+}
+
+// ----------------------------------------------------------------
+
+TYPESYSTEM_SOURCE(Part::PropertyTessellationCache, App::Property)
+
+PropertyTessellationCache::PropertyTessellationCache() = default;
+
+PropertyTessellationCache::~PropertyTessellationCache() = default;
+
+void PropertyTessellationCache::setValue(std::shared_ptr<const TessellationCache> cache)
+{
+    aboutToSetValue();
+    _cache = std::move(cache);
+    hasSetValue();
+}
+
+void PropertyTessellationCache::Save(Base::Writer& writer) const
+{
+    // the tessellation is a cache and therefore never written as XML
+    if (!_cache || _cache->isEmpty() || writer.isForceXML()) {
+        writer.Stream() << writer.ind() << "<Tessellation file=\"\"/>" << std::endl;
+    }
+    else {
+        writer.Stream() << writer.ind() << "<Tessellation file=\""
+                        << writer.addFile(getName(), this) << "\"/>" << std::endl;
+    }
+}
+
+void PropertyTessellationCache::Restore(Base::XMLReader& reader)
+{
+    reader.readElement("Tessellation");
+    std::string file(reader.getAttribute<const char*>("file"));
+
+    if (!file.empty()) {
+        // initiate a file read
+        reader.addFile(file.c_str(), this);
+    }
+}
+
+void PropertyTessellationCache::SaveDocFile(Base::Writer& writer) const
+{
+    if (_cache) {
+        Base::OutputStream str(writer.Stream());
+        _cache->save(str);
+    }
+}
+
+void PropertyTessellationCache::RestoreDocFile(Base::Reader& reader)
+{
+    auto cache = std::make_shared<TessellationCache>();
+    try {
+        Base::InputStream str(reader);
+        cache->restore(str, reader);
+    }
+    catch (const Base::Exception& e) {
+        // the shape will be tessellated again
+        Base::Console().warning("%s\n", e.what());
+        cache->clear();
+    }
+    catch (const std::exception&) {
+        Base::Console().warning("Failed to read tessellation\n");
+        cache->clear();
+    }
+    setValue(cache);
+}
+
+App::Property* PropertyTessellationCache::Copy() const
+{
+    PropertyTessellationCache* p = new PropertyTessellationCache();
+    p->_cache = _cache;
+    return p;
+}
+
+void PropertyTessellationCache::Paste(const App::Property& from)
+{
+    aboutToSetValue();
+    _cache = dynamic_cast<const PropertyTessellationCache&>(from)._cache;
+    hasSetValue();
+}
+
+unsigned int PropertyTessellationCache::getMemSize() const
+{
+    return _cache ? _cache->getMemSize() : 0;
+}
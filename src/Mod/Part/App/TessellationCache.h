@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef PART_TESSELLATIONCACHE_H
+#define PART_TESSELLATIONCACHE_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <App/Property.h>
+#include <Base/Vector3D.h>
+#include <Mod/Part/PartGlobal.h>
+
+
+class TopoDS_Shape;
+
+namespace Base
+{
+class InputStream;
+class OutputStream;
+}  // namespace Base
+
+namespace Part
+{
+
+/** Tessellation of a shape as used by the scene graph of PartGui::ViewProviderPartExt.
+ * The key identifies the shape and the meshing parameters the tessellation was computed with, so
+ * a stored tessellation can be reused after loading a document instead of meshing the shape again.
+ */
+class PartExport TessellationCache
+{
+public:
+    struct Statistics
+    {
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+    };
+
+    /// The arrays of the coordinate, normal, face, edge and point nodes
+    struct Arrays
+    {
+        std::vector<Base::Vector3f> points;
+        std::vector<Base::Vector3f> normals;
+        std::vector<int32_t> faceIndex;
+        std::vector<int32_t> partIndex;
+        std::vector<int32_t> lineIndex;
+        int32_t nodeStart = 0;
+    };
+
+    TessellationCache() = default;
+    TessellationCache(uint64_t key, Arrays arrays);
+
+    /// Returns true if tessellations should be stored with the document
+    static bool isEnabled();
+    /** Computes the key of the tessellation of \a shape. The key combines the \a tag of the shape,
+     * i.e. the ID of its object, with the number of its sub-shapes, the types of its surfaces and
+     * the coordinates of its vertices, all without its location, and the deflection, the angular
+     * deflection and whether the normals are taken from the UV nodes. It's much cheaper than
+     * hashing the whole shape and stays the same when the document is reloaded.
+     */
+    static uint64_t makeKey(const TopoDS_Shape& shape,
+                            long tag,
+                            double deflection,
+                            double angle,
+                            bool normalsFromUV);
+    /// Returns how often a stored tessellation could be used or was outdated
+    static const Statistics& getStatistics();
+    static void resetStatistics();
+
+    uint64_t getKey() const
+    {
+        return key;
+    }
+    bool isEmpty() const
+    {
+        return arrays.points.empty();
+    }
+    const Arrays& getArrays() const
+    {
+        return arrays;
+    }
+
+    /// Returns true if the stored tessellation can be used for \a key and updates the statistics
+    bool lookup(uint64_t key) const;
+
+    void save(Base::OutputStream& str) const;
+    /** Restores the tessellation from \a str, which reads from \a in. The counts of the arrays
+     * are checked against the size of the stream and the indices against the number of points.
+     * Throws a Base::FileException and leaves the cache empty if the data is invalid.
+     */
+    void restore(Base::InputStream& str, std::istream& in);
+    void clear();
+    unsigned int getMemSize() const;
+
+private:
+    uint64_t key = 0;
+    Arrays arrays;
+
+    static Statistics statistics;
+};
+
+/** Stores a tessellation with the document. */
+class PartExport PropertyTessellationCache: public App::Property
+{
+    TYPESYSTEM_HEADER_WITH_OVERRIDE();
+
+public:
+    PropertyTessellationCache();
+    ~PropertyTessellationCache() override;
+
+    void setValue(std::shared_ptr<const TessellationCache>);
+    const std::shared_ptr<const TessellationCache>& getValue() const
+    {
+        return _cache;
+    }
+
+    void Save(Base::Writer& writer) const override;
+    void Restore(Base::XMLReader& reader) override;
+
+    void SaveDocFile(Base::Writer& writer) const override;
+    void RestoreDocFile(Base::Reader& reader) override;
+
+    Property* Copy() const override;
+    void Paste(const Property& from) override;
+    unsigned int getMemSize() const override;
+
+private:
+    std::shared_ptr<const TessellationCache> _cache;
+};
+
+}  // namespace Part
+
+#endif  // PART_TESSELLATIONCACHE_H
@@ -23,6 +23,8 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <cassert>
+# include <numeric>
+# include <unordered_map>
 # include <BRep_Tool.hxx>
 # include <BRepAdaptor_Curve.hxx>
 # include <BRepAdaptor_Surface.hxx>
@@ -59,7 +61,9 @@
 # include <TColStd_ListOfTransient.hxx>
 # include <TColgp_SequenceOfXY.hxx>
 # include <TColgp_SequenceOfXYZ.hxx>
+# include <TopExp.hxx>
 # include <TopoDS.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # if OCC_VERSION_HEX < 0x070600
 # include <Adaptor3d_HCurveOnSurface.hxx>
 # include <GeomAdaptor_HCurve.hxx>
@@ -779,3 +783,41 @@ bool Part::Tools::isConcave(const TopoDS_Face &face, const gp_Pnt &pointOfVue, c
 
     return result;
 }
+
+std::vector<std::vector<std::size_t>>
+Part::Tools::groupBySharedSubShapes(const std::vector<TopoDS_Shape>& shapes)
+{
+    std::vector<std::size_t> parent(shapes.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t index) {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    };
+
+    std::unordered_map<const Standard_Transient*, std::size_t> owners;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shapes[i], TopAbs_FACE, subShapes);
+        TopExp::MapShapes(shapes[i], TopAbs_EDGE, subShapes);
+        for (int j = 1; j <= subShapes.Extent(); j++) {
+            auto it = owners.emplace(subShapes(j).TShape().get(), i);
+            if (!it.second) {
+                parent[find(i)] = find(it.first->second);
+            }
+        }
+    }
+
+    std::unordered_map<std::size_t, std::size_t> groupIndex;
+    std::vector<std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        auto it = groupIndex.emplace(find(i), groups.size());
+        if (it.second) {
+            groups.emplace_back();
+        }
+        groups[it.first->second].push_back(i);
+    }
+    return groups;
+}
@@ -235,6 +235,16 @@ public:
      * and false otherwise, plane case included.
      */
     static bool isConcave(const TopoDS_Face &face, const gp_Pnt &pointOfVue, const gp_Dir &direction);
+
+    /*!
+     * \brief groupBySharedSubShapes
+     * Meshing writes the triangulation into the faces and edges of a shape, so shapes that share
+     * faces or edges must not be meshed concurrently. This puts such shapes into one group.
+     * \param shapes
+     * \return the indexes of the shapes of each group, ordered by the first index of a group
+     */
+    static std::vector<std::vector<std::size_t>>
+    groupBySharedSubShapes(const std::vector<TopoDS_Shape>& shapes);
 };
 
 } //namespace Part
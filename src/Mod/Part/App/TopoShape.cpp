@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <array>
 # include <cmath>
 # include <cstdlib>
@@ -160,6 +161,7 @@
 # include <boost/core/ignore_unused.hpp>
 #endif // _PreComp_
 
+#include <App/Application.h>
 #include <App/Material.h>
 #include <App/ElementNamingUtils.h>
 #include <Base/BoundBox.h>
@@ -782,24 +784,37 @@ void TopoShape::importBrep(std::istream& str, int indicator)
 
 void TopoShape::importBinary(std::istream& str)
 {
+    // BinTools reads value by value, which is slow on a zip or base64 stream. So take the whole
+    // content in large blocks first and let BinTools read from memory.
+    std::string data;
+    std::array<char, 65536> block {};
+    std::streambuf* buf = str.rdbuf();
+    for (std::streamsize count; (count = buf->sgetn(block.data(), block.size())) > 0;) {
+        data.append(block.data(), static_cast<std::size_t>(count));
+    }
+    std::istringstream in(std::move(data), std::ios::in | std::ios::binary);
+
     BinTools_ShapeSet theShapeSet;
-    theShapeSet.Read(str);
     Standard_Integer shapeId=0, locId=0, orient=0;
-    BinTools::GetInteger(str, shapeId);
-    if (shapeId <= 0 || shapeId > theShapeSet.NbShapes())
-        return;
+    try {
+        // The format version is stored in the header, a version that is newer than the one
+        // supported by OCCT fails here
+        theShapeSet.Read(in);
+        BinTools::GetInteger(in, shapeId);
+        if (shapeId <= 0 || shapeId > theShapeSet.NbShapes())
+            return;
 
-    BinTools::GetInteger(str, locId);
-    BinTools::GetInteger(str, orient);
-    TopAbs_Orientation anOrient = static_cast<TopAbs_Orientation>(orient);
+        BinTools::GetInteger(in, locId);
+        BinTools::GetInteger(in, orient);
+        TopAbs_Orientation anOrient = static_cast<TopAbs_Orientation>(orient);
 
-    try {
         this->_Shape = theShapeSet.Shape(shapeId);
         this->_Shape.Location(theShapeSet.Locations().Location (locId));
         this->_Shape.Orientation (anOrient);
     }
-    catch (Standard_Failure&) {
-        throw Base::RuntimeError("Failed to read shape from binary stream");
+    catch (Standard_Failure& e) {
+        throw Base::RuntimeError(std::string("Failed to read shape from binary stream: ")
+                                 + e.GetMessageString());
     }
 }
 
@@ -907,6 +922,15 @@ void TopoShape::exportBrep(std::ostream& out) const
 }
 
 void TopoShape::exportBinary(std::ostream& out) const
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    exportBinary(out,
+                 hGrp->GetBool("BinaryBrepTriangles", false),
+                 static_cast<int>(hGrp->GetInt("BinaryBrepVersion", 3)));
+}
+
+void TopoShape::exportBinary(std::ostream& out, bool withTriangles, int version) const
 {
     // See BinTools_FormatVersion of OCCT 7.6
     enum {
@@ -916,26 +940,43 @@ void TopoShape::exportBinary(std::ostream& out) const
         VERSION_4 = 4
     };
 
+    // VERSION_4 is only written by BinTools_ShapeWriter, which doesn't use the layout of a shape
+    // set followed by the shape index. VERSION_3 is new in OCCT 7.6.
+#if OCC_VERSION_HEX >= 0x070600
+    version = std::clamp<int>(version, VERSION_1, VERSION_3);
+#else
+    version = std::clamp<int>(version, VERSION_1, VERSION_2);
+#endif
+
     // An example how to use BinTools_ShapeSet can be found in BinMNaming_NamedShapeDriver.cxx
     BinTools_ShapeSet theShapeSet;
-    theShapeSet.SetFormatNb(VERSION_3);
+    theShapeSet.SetFormatNb(version);
+    theShapeSet.SetWithTriangles(withTriangles);
+#if OCC_VERSION_HEX >= 0x070600
+    theShapeSet.SetWithNormals(withTriangles && version >= VERSION_3);
+#endif
+
+    // BinTools writes value by value, so collect the output in memory and pass it on at once
+    std::ostringstream buffer(std::ios::out | std::ios::binary);
     if (this->_Shape.IsNull()) {
         theShapeSet.Add(this->_Shape);
-        theShapeSet.Write(out);
-        BinTools::PutInteger(out, -1);
-        BinTools::PutInteger(out, -1);
-        BinTools::PutInteger(out, -1);
+        theShapeSet.Write(buffer);
+        BinTools::PutInteger(buffer, -1);
+        BinTools::PutInteger(buffer, -1);
+        BinTools::PutInteger(buffer, -1);
     }
     else {
         Standard_Integer shapeId = theShapeSet.Add(this->_Shape);
         Standard_Integer locId = theShapeSet.Locations().Index(this->_Shape.Location());
         Standard_Integer orient = static_cast<int>(this->_Shape.Orientation());
 
-        theShapeSet.Write(out);
-        BinTools::PutInteger(out, shapeId);
-        BinTools::PutInteger(out, locId);
-        BinTools::PutInteger(out, orient);
+        theShapeSet.Write(buffer);
+        BinTools::PutInteger(buffer, shapeId);
+        BinTools::PutInteger(buffer, locId);
+        BinTools::PutInteger(buffer, orient);
     }
+    auto data = buffer.view();
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
 }
 
 void TopoShape::dump(std::ostream& out) const
@@ -477,7 +477,16 @@ public:
     void exportStep(const char* FileName) const;
     void exportBrep(const char* FileName) const;
     void exportBrep(std::ostream&) const;
+    /// Export in binary format with the options BinaryBrepTriangles and BinaryBrepVersion
+    /// of BaseApp/Preferences/Mod/Part/General
     void exportBinary(std::ostream&) const;
+    /** Export in binary format
+     *
+     * @param withTriangles: whether to include the triangulation of the faces
+     * @param version: format version of OCCT's BinTools, clamped to the
+     *                 versions that can be written by the OCCT in use
+     */
+    void exportBinary(std::ostream&, bool withTriangles, int version) const;
     void exportStl(const char* FileName, double deflection) const;
     void exportFaceSet(double, double, const std::vector<Base::Color>&, std::ostream&) const;
     void exportLineSet(std::ostream&) const;
@@ -1649,6 +1658,23 @@ public:
                                        const Mapper &mapper,
                                        const std::vector<TopoShape> &sources,
                                        const char *op=nullptr);
+
+    /** Enable or disable on demand generation of element maps
+     *
+     * When enabled, makeShapeWithElementMap() only records the source shapes
+     * and the history reported by the mapper. The element map is generated
+     * from this record the first time it is needed, e.g. when looking up an
+     * element name, when the shape is used as the source of another operation,
+     * or when it is saved. The generated names are the same as the ones of
+     * the eager generation, only the string IDs of a shared hasher may be
+     * assigned in a different order.
+     *
+     * The default is taken from the parameter LazyElementMap in
+     * BaseApp/Preferences/Mod/Part/General.
+     */
+    static void setLazyElementMap(bool enable);
+    /// Return whether element maps are generated on demand
+    static bool isLazyElementMap();
     /**
      * When given a single shape to create a compound, two results are possible: either to simply
      * return the shape as given, or to force it to be placed in a Compound.
@@ -1984,6 +2010,8 @@ public:
      * @param distances: distances to move the section plane for making slices
      * @param op: optional string to be encoded into topo naming for indicating
      *            the operation
+     * @param parallel: whether to compute the slices concurrently. The result
+     *                  is the same either way.
      *
      * @return The original content of this TopoShape is discarded and replaced
      *         with the new shape. The function returns the TopoShape itself as
@@ -1993,7 +2021,8 @@ public:
     TopoShape& makeElementSlices(const TopoShape& source,
                                  const Base::Vector3d& dir,
                                  const std::vector<double>& distances,
-                                 const char* op = nullptr);
+                                 const char* op = nullptr,
+                                 bool parallel = true);
     /** Make multiple cross section slices
      *
      * @param source: the source shape
@@ -2001,14 +2030,17 @@ public:
      * @param distances: distances to move the section plane for making slices
      * @param op: optional string to be encoded into topo naming for indicating
      *            the operation
+     * @param parallel: whether to compute the slices concurrently. The result
+     *                  is the same either way.
      *
      * @return Return the new shape. The TopoShape itself is not modified.
      */
     TopoShape makeElementSlices(const Base::Vector3d& dir,
                                 const std::vector<double>& distances,
-                                const char* op = nullptr) const
+                                const char* op = nullptr,
+                                bool parallel = true) const
     {
-        return TopoShape(0, Hasher).makeElementSlices(*this, dir, distances, op);
+        return TopoShape(0, Hasher).makeElementSlices(*this, dir, distances, op, parallel);
     }
 
     /* Make fillet shape
@@ -2559,11 +2591,20 @@ public:
     friend class TopoShapeCache;
 
 private:
+    /// Generate the element map of the shape from the history reported by a mapper
+    TopoShape& buildElementMap(const Mapper& mapper,
+                               const std::vector<TopoShape>& sources,
+                               const char* op);
+
     // Cache storage
     mutable std::shared_ptr<TopoShapeCache> _parentCache;
     mutable std::shared_ptr<TopoShapeCache> _cache;
     mutable TopLoc_Location _subLocation;
 
+    /// Record of a makeShapeWithElementMap() call whose element map is not yet generated
+    struct PendingElementMap;
+    mutable std::shared_ptr<PendingElementMap> _pendingElementMap;
+
     /** Helper class to ensure synchronization of element map and cache
      *
      * It exposes constant methods of OCCT TopoDS_Shape unchanged, and wraps all
@@ -2589,6 +2630,7 @@ private:
                 _owner->resetElementMap();
                 _owner->_cache.reset();
                 _owner->_parentCache.reset();
+                _owner->_pendingElementMap.reset();
             }
         }
 
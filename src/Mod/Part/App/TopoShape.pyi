@@ -309,10 +309,15 @@ class TopoShape(ComplexGeoData):
         ...
 
     @constmethod
-    def slices(self, direction: Vector, distancesList: List[float]) -> List:
+    def slices(
+        self, direction: Vector, distancesList: List[float], parallel: bool = True, /
+    ) -> List:
         """
         Make slices of this shape.
-        slices(direction, distancesList) --> Wires
+        slices(direction, distancesList, [parallel=True]) --> Wires
+
+        If parallel is True the slices are computed concurrently. The
+        result doesn't depend on it.
         """
         ...
 
@@ -66,6 +66,10 @@ public:
     /// generated.
     Data::ElementMapPtr cachedElementMap;
 
+    /// Record of the owner TopoShape for generating its element map on demand. It is kept here so
+    /// that sub shapes obtained before the map is generated can trigger the generation.
+    std::shared_ptr<TopoShape::PendingElementMap> pendingElementMap;
+
     /// Location of the original cached TopoDS_Shape.
     TopLoc_Location subLocation;
 
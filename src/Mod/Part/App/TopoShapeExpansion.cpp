@@ -25,8 +25,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <unordered_map>
 
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
@@ -100,6 +102,7 @@
 #include "Base/Tools.h"
 #include "OCCTProgressIndicator.h"
 
+#include <App/Application.h>
 #include <App/ElementMap.h>
 #include <App/ElementNamingUtils.h>
 #include <ShapeAnalysis_FreeBoundsProperties.hxx>
@@ -132,6 +135,70 @@ static void expandCompound(const TopoShape& shape, std::vector<TopoShape>& res)
     }
 }
 
+namespace
+{
+// -1 until the default is read from the parameters
+std::atomic<int> lazyElementMap {-1};
+}  // namespace
+
+void TopoShape::setLazyElementMap(bool enable)
+{
+    lazyElementMap = enable ? 1 : 0;
+}
+
+bool TopoShape::isLazyElementMap()
+{
+    int lazy = lazyElementMap;
+    if (lazy < 0) {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+        lazy = hGrp->GetBool("LazyElementMap", false) ? 1 : 0;
+        int unset = -1;
+        if (!lazyElementMap.compare_exchange_strong(unset, lazy)) {
+            lazy = unset;
+        }
+    }
+    return lazy != 0;
+}
+
+/** Record of a makeShapeWithElementMap() call for generating the element map later
+ *
+ * The mapper given to makeShapeWithElementMap() usually refers to an OCCT
+ * maker that does not outlive the call, so the record keeps a copy of the
+ * history it reports for the sub shapes of the sources, and replays it as a
+ * mapper when the element map is generated.
+ */
+struct TopoShape::PendingElementMap: TopoShape::Mapper
+{
+    struct History
+    {
+        std::vector<TopoDS_Shape> modified;
+        std::vector<TopoDS_Shape> generated;
+    };
+    std::unordered_map<TopoDS_Shape, History, ShapeHasher, ShapeHasher> history;
+
+    TopoDS_Shape shape;
+    std::vector<TopoShape> sources;
+    std::string op;
+    long tag = 0;
+    App::StringHasherRef hasher;
+
+    /// The generated element map, shared by all copies of the shape
+    Data::ElementMapPtr elementMap;
+
+    const std::vector<TopoDS_Shape>& generated(const TopoDS_Shape& s) const override
+    {
+        auto it = history.find(s);
+        return it != history.end() ? it->second.generated : _res;
+    }
+
+    const std::vector<TopoDS_Shape>& modified(const TopoDS_Shape& s) const override
+    {
+        auto it = history.find(s);
+        return it != history.end() ? it->second.modified : _res;
+    }
+};
+
 void TopoShape::initCache(int reset) const
 {
     if (reset > 0 || !_cache || _cache->isTouched(_Shape)) {
@@ -158,6 +225,8 @@ Data::ElementMapPtr TopoShape::resetElementMap(Data::ElementMapPtr elementMap)
         _cache->subLocation.Identity();
         _subLocation.Identity();
         _parentCache.reset();
+        _pendingElementMap.reset();
+        _cache->pendingElementMap.reset();
     }
     return Data::ComplexGeoData::resetElementMap(elementMap);
 }
@@ -165,13 +234,34 @@ Data::ElementMapPtr TopoShape::resetElementMap(Data::ElementMapPtr elementMap)
 void TopoShape::flushElementMap() const
 {
     initCache();
-    if (!elementMap(false) && this->_cache) {
+    if (!elementMap(false) && this->_pendingElementMap) {
+        auto pending = std::move(this->_pendingElementMap);
+        if (!pending->elementMap) {
+            TopoShape self(pending->tag, pending->hasher, pending->shape);
+            self._cache = _cache;
+            self.buildElementMap(*pending, pending->sources, pending->op.c_str());
+            pending->elementMap = self.elementMap(false);
+            if (!pending->hasher) {
+                pending->hasher = self.Hasher;
+            }
+            // Other copies of the shape share the record, keep only the result for them
+            pending->sources.clear();
+            pending->history.clear();
+        }
+        auto owner = const_cast<TopoShape*>(this);  // NOLINT
+        if (!owner->Hasher) {
+            owner->Hasher = pending->hasher;
+        }
+        owner->resetElementMap(pending->elementMap);
+    }
+    else if (!elementMap(false) && this->_cache) {
         if (this->_cache->cachedElementMap) {
             const_cast<TopoShape*>(this)->resetElementMap(this->_cache->cachedElementMap);
         }
         else if (this->_parentCache) {
             TopoShape parent(this->Tag, this->Hasher, this->_parentCache->shape);
             parent._cache = _parentCache;
+            parent._pendingElementMap = _parentCache->pendingElementMap;
             parent.flushElementMap();
             TopoShape self(this->Tag,
                            this->Hasher,
@@ -189,6 +279,7 @@ void TopoShape::setShape(const TopoDS_Shape& shape, bool resetElementMap)
 {
     if (resetElementMap) {
         this->resetElementMap();
+        _pendingElementMap.reset();
     }
     else if (_cache && _cache->isTouched(shape)) {
         this->flushElementMap();
@@ -281,6 +372,7 @@ void TopoShape::operator=(const TopoShape& sh)
         this->_cache = sh._cache;
         this->_parentCache = sh._parentCache;
         this->_subLocation = sh._subLocation;
+        this->_pendingElementMap = sh._pendingElementMap;
         resetElementMap(sh.elementMap(false));
     }
 }
@@ -715,8 +807,9 @@ std::vector<TopoDS_Shape> TopoShape::findAncestorsShapes(const TopoDS_Shape& sub
 
 bool TopoShape::hasPendingElementMap() const
 {
-    return !elementMap(false) && this->_cache
-        && (this->_parentCache || this->_cache->cachedElementMap);
+    return !elementMap(false)
+        && (this->_pendingElementMap
+            || (this->_cache && (this->_parentCache || this->_cache->cachedElementMap)));
 }
 
 bool TopoShape::canMapElement(const TopoShape& other) const
@@ -727,6 +820,10 @@ bool TopoShape::canMapElement(const TopoShape& other) const
     if ((other.Tag == 0) && !other.elementMap(false) && !other.hasPendingElementMap()) {
         return false;
     }
+    if (_pendingElementMap) {
+        // Names are about to be added, generate the recorded ones first
+        flushElementMap();
+    }
     initCache();
     other.initCache();
     _cache->relations.clear();
@@ -1385,7 +1482,6 @@ void checkForParallelOrCoplanar(const TopoDS_Shape& newShape,
     }
 }
 
-// TODO: Refactor makeShapeWithElementMap to reduce complexity
 TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
                                               const Mapper& mapper,
                                               const std::vector<TopoShape>& shapes,
@@ -1400,6 +1496,50 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
         return *this;
     }
 
+    if (!isLazyElementMap()) {
+        return buildElementMap(mapper, shapes, op);
+    }
+
+    // Query the mapper for the same sub shapes as buildElementMap() does
+    auto pending = std::make_shared<PendingElementMap>();
+    bool canMap = false;
+    static const std::array<TopAbs_ShapeEnum, 3> types = {TopAbs_VERTEX, TopAbs_EDGE, TopAbs_FACE};
+    for (auto& incomingShape : shapes) {
+        if (!canMapElement(incomingShape)) {
+            continue;
+        }
+        canMap = true;
+        for (auto type : types) {
+            auto& otherMap = incomingShape._cache->getAncestry(type);
+            for (int i = 1; i <= otherMap.count(); i++) {
+                auto otherElement = otherMap.find(incomingShape._Shape, i);
+                auto res = pending->history.try_emplace(otherElement);
+                if (res.second) {
+                    res.first->second.modified = mapper.modified(otherElement);
+                    res.first->second.generated = mapper.generated(otherElement);
+                }
+            }
+        }
+    }
+    if (!canMap) {
+        return *this;
+    }
+    pending->shape = _Shape;
+    pending->sources = shapes;
+    pending->op = op ? op : Part::OpCodes::Maker;
+    pending->tag = Tag;
+    pending->hasher = Hasher;
+    initCache();
+    _cache->pendingElementMap = pending;
+    _pendingElementMap = std::move(pending);
+    return *this;
+}
+
+// TODO: Refactor buildElementMap to reduce complexity
+TopoShape& TopoShape::buildElementMap(const Mapper& mapper,
+                                      const std::vector<TopoShape>& shapes,
+                                      const char* op)
+{
     size_t canMap = 0;
     for (auto& incomingShape : shapes) {
         if (canMapElement(incomingShape)) {
@@ -3940,14 +4080,12 @@ TopoShape& TopoShape::makeElementSlice(const TopoShape& shape,
 TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
                                         const Base::Vector3d& dir,
                                         const std::vector<double>& distances,
-                                        const char* op)
+                                        const char* op,
+                                        bool parallel)
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(distances, wires, parallel);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
@@ -739,7 +739,9 @@ PyObject*  TopoShapePy::slice(PyObject *args) const
 PyObject*  TopoShapePy::slices(PyObject *args) const
 {
     PyObject *dir, *dist;
-    if (!PyArg_ParseTuple(args, "O!O", &(Base::VectorPy::Type), &dir, &dist))
+    PyObject *parallel = Py_True;
+    if (!PyArg_ParseTuple(args, "O!O|O!", &(Base::VectorPy::Type), &dir, &dist,
+                          &PyBool_Type, &parallel))
         return nullptr;
 
     try {
@@ -749,7 +751,8 @@ PyObject*  TopoShapePy::slices(PyObject *args) const
         d.reserve(list.size());
         for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
             d.push_back((double)Py::Float(*it));
-        return Py::new_reference_to(shape2pyshape(getTopoShapePtr()->makeElementSlices(vec, d)));
+        return Py::new_reference_to(shape2pyshape(
+            getTopoShapePtr()->makeElementSlices(vec, d, nullptr, Base::asBoolean(parallel))));
     }
     catch (Standard_Failure& e) {
         PyErr_SetString(PartExceptionOCCError, e.GetMessageString());
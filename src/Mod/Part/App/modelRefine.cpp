@@ -24,8 +24,12 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cmath>
+# include <exception>
 # include <numbers>
 # include <iterator>
+# include <map>
+# include <set>
 # include <Bnd_Box.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -64,8 +68,11 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
+# include <TopTools_DataMapOfShapeInteger.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 # include <TopTools_ListOfShape.hxx>
+# include <QtConcurrentMap>
 #endif // _PreComp_
 
 #include <Base/Console.h>
@@ -86,33 +93,38 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //an edge that is found again is an inner edge and removed. The map holds
+    //the position of the edges that are currently kept.
+    EdgeVectorType edges;
+    std::vector<bool> removed;
+    TopTools_DataMapOfShapeInteger positions;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
-        EdgeVectorType faceEdges;
-        EdgeVectorType::iterator faceEdgesIt;
-        getFaceEdges(*faceIt, faceEdges);
-        for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
+        TopExp_Explorer it;
+        for (it.Init(*faceIt, TopAbs_EDGE); it.More(); it.Next())
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            const TopoDS_Edge &edge = TopoDS::Edge(it.Current());
+            if (positions.IsBound(edge))
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
+                removed[positions.Find(edge)] = true;
+                positions.UnBind(edge);
+            }
+            else
+            {
+                positions.Bind(edge, static_cast<int>(edges.size()));
+                edges.push_back(edge);
+                removed.push_back(false);
             }
-            if (!foundSignal)
-                edges.push_back(*faceEdgesIt);
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    edgesOut.reserve(positions.Extent());
+    for (std::size_t index = 0; index < edges.size(); ++index)
+    {
+        if (!removed[index])
+            edgesOut.push_back(edges[index]);
+    }
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -206,11 +218,7 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
     FaceVectorType::const_iterator it;
     for (it = facesIn.begin(); it != facesIn.end(); ++it)
         facesInMap.Add(*it);
-    //the reserve call guarantees the vector will never get "pushed back" in the
-    //recursiveFind calls, thus invalidating the iterators. We can be sure of this as any one
-    //matched set can't be bigger than the set passed in. if we have seg faults, we will
-    //want to turn this tempFaces vector back into a std::list ensuring valid iterators
-    //at the expense of std::find speed.
+    //any one matched set can't be bigger than the set passed in.
     FaceVectorType tempFaces;
     tempFaces.reserve(facesIn.size() + 1);
 
@@ -222,7 +230,7 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
 
         tempFaces.clear();
         processedMap.Add(*it);
-        recursiveFind(*it, tempFaces);
+        findAdjacent(*it, tempFaces);
         if (tempFaces.size() > 1)
         {
             adjacencyArray.push_back(tempFaces);
@@ -230,25 +238,50 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
     }
 }
 
-void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector)
+void FaceAdjacencySplitter::findAdjacent(const TopoDS_Face &face, FaceVectorType &outVector)
 {
-    outVector.push_back(face);
-
-    const TopTools_ListOfShape &edges = faceToEdgeMap.FindFromKey(face);
-    TopTools_ListIteratorOfListOfShape edgeIt;
-    for (edgeIt.Initialize(edges); edgeIt.More(); edgeIt.Next())
+    //depth first search in the same order as a recursion would do it, but large
+    //shells can't run out of stack.
+    struct Frame
     {
-        const TopTools_ListOfShape &faces = edgeToFaceMap.FindFromKey(edgeIt.Value());
+        TopTools_ListIteratorOfListOfShape edgeIt;
         TopTools_ListIteratorOfListOfShape faceIt;
-        for (faceIt.Initialize(faces); faceIt.More(); faceIt.Next())
+    };
+    std::vector<Frame> stack;
+    auto visit = [&](const TopoDS_Shape &current)
+    {
+        outVector.push_back(TopoDS::Face(current));
+        Frame frame;
+        frame.edgeIt.Initialize(faceToEdgeMap.FindFromKey(current));
+        if (frame.edgeIt.More())
+            frame.faceIt.Initialize(edgeToFaceMap.FindFromKey(frame.edgeIt.Value()));
+        stack.push_back(frame);
+    };
+
+    visit(face);
+    while (!stack.empty())
+    {
+        Frame &frame = stack.back();
+        if (!frame.edgeIt.More())
+        {
+            stack.pop_back();
+            continue;
+        }
+        if (!frame.faceIt.More())
         {
-            if (!facesInMap.Contains(faceIt.Value()))
-                continue;
-            if (processedMap.Contains(faceIt.Value()))
-                continue;
-            processedMap.Add(faceIt.Value());
-            recursiveFind(TopoDS::Face(faceIt.Value()), outVector);
+            frame.edgeIt.Next();
+            if (frame.edgeIt.More())
+                frame.faceIt.Initialize(edgeToFaceMap.FindFromKey(frame.edgeIt.Value()));
+            continue;
         }
+        TopoDS_Shape next = frame.faceIt.Value();
+        frame.faceIt.Next();
+        if (!facesInMap.Contains(next))
+            continue;
+        if (processedMap.Contains(next))
+            continue;
+        processedMap.Add(next);
+        visit(next);
     }
 }
 
@@ -256,28 +289,46 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
+    //comparing every face with the first face of every group is quadratic. The
+    //groups are looked up by the key of their first face instead and only the
+    //ones with a close key are compared. The first matching group is used, so
+    //the result is the same.
+    std::vector<double> keys(faces.size());
+    std::vector<bool> hasKey(faces.size());
+    double scale(0.0);
+    for (std::size_t index = 0; index < faces.size(); ++index)
+    {
+        double faceScale(0.0);
+        double key(0.0);
+        hasKey[index] = object->getKey(faces[index], key, faceScale);
+        keys[index] = key;
+        scale = std::max(scale, faceScale);
+    }
+    double tolerance = 8.0 * Precision::Confusion() * (1.0 + scale);
+
     std::vector<FaceVectorType> tempVector;
-    tempVector.reserve(faces.size());
-    FaceVectorType::const_iterator faceIt;
-    for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    std::multimap<double, std::size_t> groupKeys;
+    for (std::size_t index = 0; index < faces.size(); ++index)
     {
-        bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        //a face without a key isn't equal to any other face.
+        if (!hasKey[index])
+            continue;
+        const TopoDS_Face &face = faces[index];
+        std::size_t match = tempVector.size();
+        auto last = groupKeys.upper_bound(keys[index] + tolerance);
+        for (auto it = groupKeys.lower_bound(keys[index] - tolerance); it != last; ++it)
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
-            {
-                (*tempIt).push_back(*faceIt);
-                foundMatch = true;
-                break;
-            }
+            if (it->second < match && object->isEqual(tempVector[it->second].front(), face))
+                match = it->second;
         }
-        if (!foundMatch)
+        if (match < tempVector.size())
         {
-            FaceVectorType another;
-            another.reserve(faces.size());
-            another.push_back(*faceIt);
-            tempVector.push_back(another);
+            tempVector[match].push_back(face);
+        }
+        else
+        {
+            groupKeys.emplace(keys[index], tempVector.size());
+            tempVector.emplace_back(1, face);
         }
     }
     std::vector<FaceVectorType>::iterator it;
@@ -298,20 +349,65 @@ GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
     return surfaceTest.GetType();
 }
 
+bool FaceTypedBase::getKey(const TopoDS_Face &, double &key, double &scale) const
+{
+    //all faces are compared with each other.
+    key = 0.0;
+    scale = 0.0;
+    return true;
+}
+
+namespace
+{
+    //arbitrary weights to turn a point or direction into a key. Irrational
+    //ratios make it unlikely that different points of a regular pattern get
+    //the same key.
+    const gp_XYZ keyWeights(1.0, 0.7548776662466927, 0.5698402909980532);
+
+    //the key of a line or plane through the given point and with the given
+    //direction, it doesn't depend on the orientation.
+    double getAxisKey(const gp_XYZ &closest, const gp_XYZ &direction)
+    {
+        return keyWeights.Dot(closest) + std::fabs(keyWeights.Dot(direction));
+    }
+}
+
 void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const
 {
     EdgeVectorType bEdges;
     boundaryEdges(facesIn, bEdges);
 
-    std::list<TopoDS_Edge> edges;
-    std::copy(bEdges.begin(), bEdges.end(), back_inserter(edges));
-    while(!edges.empty())
+    //the edges that are not used yet, by their first vertex and in the order
+    //of bEdges. The next edge of a boundary is the first one that starts at
+    //the end of the previous edge.
+    TopTools_IndexedMapOfShape vertexMap;
+    std::vector<std::set<std::size_t>> edgesByVertex;
+    std::vector<int> firstVertex(bEdges.size());
+    for (std::size_t index = 0; index < bEdges.size(); ++index)
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(edges.front(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(edges.front(), Standard_True);
+        int vertex = vertexMap.Add(TopExp::FirstVertex(bEdges[index], Standard_True)) - 1;
+        if (vertex >= static_cast<int>(edgesByVertex.size()))
+            edgesByVertex.resize(vertex + 1);
+        edgesByVertex[vertex].insert(index);
+        firstVertex[index] = vertex;
+    }
+
+    std::vector<bool> used(bEdges.size(), false);
+    auto useEdge = [&](std::size_t index)
+    {
+        used[index] = true;
+        edgesByVertex[firstVertex[index]].erase(index);
+    };
+
+    for (std::size_t start = 0; start < bEdges.size(); ++start)
+    {
+        if (used[start])
+            continue;
+        useEdge(start);
+        TopoDS_Vertex destination = TopExp::FirstVertex(bEdges[start], Standard_True);
+        TopoDS_Vertex lastVertex = TopExp::LastVertex(bEdges[start], Standard_True);
         EdgeVectorType boundary;
-        boundary.push_back(edges.front());
-        edges.pop_front();
+        boundary.push_back(bEdges[start]);
         //single edge closed check.
         if (destination.IsSame(lastVertex))
         {
@@ -320,24 +416,20 @@ void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<Edg
         }
 
         bool closedSignal(false);
-        std::list<TopoDS_Edge>::iterator it;
-        for (it = edges.begin(); it != edges.end();)
+        while (true)
         {
-            TopoDS_Vertex currentVertex = TopExp::FirstVertex(*it, Standard_True);
-            if (lastVertex.IsSame(currentVertex))
+            int vertex = vertexMap.FindIndex(lastVertex) - 1;
+            if (vertex < 0 || edgesByVertex[vertex].empty())
+                break;
+            std::size_t next = *edgesByVertex[vertex].begin();
+            useEdge(next);
+            boundary.push_back(bEdges[next]);
+            lastVertex = TopExp::LastVertex(bEdges[next], Standard_True);
+            if (lastVertex.IsSame(destination))
             {
-                boundary.push_back(*it);
-                lastVertex = TopExp::LastVertex(*it, Standard_True);
-                edges.erase(it);
-                it = edges.begin();
-                if (lastVertex.IsSame(destination))
-                {
-                    closedSignal = true;
-                    break;
-                }
-                continue;
+                closedSignal = true;
+                break;
             }
-            ++it;
         }
         if (closedSignal)
             boundariesOut.push_back(boundary);
@@ -387,6 +479,20 @@ GeomAbs_SurfaceType FaceTypedPlane::getType() const
     return GeomAbs_Plane;
 }
 
+bool FaceTypedPlane::getKey(const TopoDS_Face &face, double &key, double &scale) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+
+    gp_Pln plane(planeSurface->Pln());
+    const gp_XYZ &direction = plane.Position().Direction().XYZ();
+    const gp_XYZ &location = plane.Location().XYZ();
+    key = getAxisKey(direction * direction.Dot(location), direction);
+    scale = location.Modulus();
+    return true;
+}
+
 TopoDS_Face FaceTypedPlane::buildFace(const FaceVectorType &faces) const
 {
     std::vector<TopoDS_Wire> wires;
@@ -483,6 +589,21 @@ GeomAbs_SurfaceType FaceTypedCylinder::getType() const
     return GeomAbs_Cylinder;
 }
 
+bool FaceTypedCylinder::getKey(const TopoDS_Face &face, double &key, double &scale) const
+{
+    Handle(Geom_CylindricalSurface) surface = getGeomCylinder(face);
+    if (surface.IsNull())
+        return false;
+
+    gp_Cylinder cylinder = surface->Cylinder();
+    const gp_XYZ &direction = cylinder.Axis().Direction().XYZ();
+    const gp_XYZ &location = cylinder.Location().XYZ();
+    gp_XYZ closest = location - direction * direction.Dot(location);
+    key = cylinder.Radius() + getAxisKey(closest, direction);
+    scale = location.Modulus();
+    return true;
+}
+
 // Auxiliary method
 const TopoDS_Face fixFace(const TopoDS_Face& f) {
     static TopoDS_Face dummy;
@@ -961,6 +1082,18 @@ GeomAbs_SurfaceType FaceTypedBSpline::getType() const
     return GeomAbs_BSplineSurface;
 }
 
+bool FaceTypedBSpline::getKey(const TopoDS_Face &face, double &key, double &scale) const
+{
+    //equal surfaces have the same poles.
+    Handle(Geom_BSplineSurface) surface = Handle(Geom_BSplineSurface)::DownCast(BRep_Tool::Surface(face));
+    if (surface.IsNull())
+        return false;
+
+    key = keyWeights.Dot(surface->Pole(1, 1).XYZ());
+    scale = 0.0;
+    return true;
+}
+
 TopoDS_Face FaceTypedBSpline::buildFace(const FaceVectorType &faces) const
 {
     std::vector<TopoDS_Wire> wires;
@@ -1022,6 +1155,79 @@ FaceTypedBSpline& ModelRefine::getBSplineObject()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+    struct MergeGroup
+    {
+        FaceTypedBase *type;
+        FaceVectorType faces;
+        TopoDS_Face newFace;
+        std::exception_ptr error;
+    };
+
+    //builds the new faces of the groups concurrently. Making a face may fix the
+    //tolerance of its edges and vertices, so groups with a common vertex are
+    //never built at the same time: the groups are coloured such that groups of
+    //the same colour have no vertex in common and the colours are built one
+    //after the other.
+    void buildFaces(std::vector<MergeGroup> &groups)
+    {
+        TopTools_IndexedMapOfShape vertexMap;
+        std::vector<std::vector<int>> groupVertices(groups.size());
+        std::vector<std::vector<std::size_t>> vertexGroups;
+        for (std::size_t index = 0; index < groups.size(); ++index)
+        {
+            TopTools_IndexedMapOfShape faceVertices;
+            for (const auto &face : groups[index].faces)
+                TopExp::MapShapes(face, TopAbs_VERTEX, faceVertices);
+            for (int i = 1; i <= faceVertices.Extent(); ++i)
+            {
+                int vertex = vertexMap.Add(faceVertices(i)) - 1;
+                if (vertex >= static_cast<int>(vertexGroups.size()))
+                    vertexGroups.resize(vertex + 1);
+                vertexGroups[vertex].push_back(index);
+                groupVertices[index].push_back(vertex);
+            }
+        }
+
+        std::vector<int> colors(groups.size(), -1);
+        std::vector<std::vector<std::size_t>> colorGroups;
+        for (std::size_t index = 0; index < groups.size(); ++index)
+        {
+            std::vector<bool> taken(colorGroups.size(), false);
+            for (int vertex : groupVertices[index])
+            {
+                for (std::size_t other : vertexGroups[vertex])
+                {
+                    if (colors[other] >= 0)
+                        taken[colors[other]] = true;
+                }
+            }
+            auto color = static_cast<int>(std::find(taken.begin(), taken.end(), false) - taken.begin());
+            if (color == static_cast<int>(colorGroups.size()))
+                colorGroups.emplace_back();
+            colors[index] = color;
+            colorGroups[color].push_back(index);
+        }
+
+        for (auto &batch : colorGroups)
+        {
+            QtConcurrent::blockingMap(batch, [&groups](std::size_t index)
+            {
+                MergeGroup &group = groups[index];
+                try
+                {
+                    group.newFace = group.type->buildFace(group.faces);
+                }
+                catch (...)
+                {
+                    group.error = std::current_exception();
+                }
+            });
+        }
+    }
+}
+
 FaceUniter::FaceUniter(const TopoDS_Shell &shellIn) : modifiedSignal(false)
 {
     workShell = shellIn;
@@ -1051,6 +1257,7 @@ bool FaceUniter::process()
 
     ModelRefine::FaceAdjacencySplitter adjacencySplitter(workShell);
 
+    std::vector<MergeGroup> groups;
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
     {
         ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
@@ -1059,40 +1266,36 @@ bool FaceUniter::process()
         for (std::size_t indexEquality(0); indexEquality < equalitySplitter.getGroupCount(); ++indexEquality)
         {
             adjacencySplitter.split(equalitySplitter.getGroup(indexEquality));
-//            std::cout << "      adjacency group count: " << adjacencySplitter.getGroupCount() << std::endl;
             for (std::size_t adjacentIndex(0); adjacentIndex < adjacencySplitter.getGroupCount(); ++adjacentIndex)
-            {
-//                    std::cout << "         face count is: " << adjacencySplitter.getGroup(adjacentIndex).size() << std::endl;
-                TopoDS_Face newFace = (*typeIt)->buildFace(adjacencySplitter.getGroup(adjacentIndex));
-                if (!newFace.IsNull())
-                {
-                    // the created face should have the same orientation as the input faces
-                    const FaceVectorType& faces = adjacencySplitter.getGroup(adjacentIndex);
-                    if (!faces.empty() && newFace.Orientation() != faces[0].Orientation()) {
-                        checkFinalShell = true;
-                    }
-                    facesToSew.push_back(newFace);
-
-                    // This reserve is probably not actually an improvement over letting
-                    // emplace_back allocate as needed. Leaving the code here for study if someone
-                    // wants to measure it. Coverity issue 356645. - chennes, March 2025
-                    //if (facesToRemove.capacity() <= facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size())
-                    //    facesToRemove.reserve(facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size());
-
-                    FaceVectorType temp = adjacencySplitter.getGroup(adjacentIndex);
-                    facesToRemove.insert(facesToRemove.end(), temp.begin(), temp.end());
-                    // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
-                    // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
-                    // be replaced by references to the new face. To achieve this all shapes should be marked as
-                    // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
-                    // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
-                    if (!temp.empty())
-                    {
-                        for (const auto & f : temp)
-                              modifiedShapes.emplace_back(f, newFace);
-                    }
-                }
+                groups.push_back({*typeIt, adjacencySplitter.getGroup(adjacentIndex), TopoDS_Face(), nullptr});
+        }
+    }
+
+    //the groups are independent of each other, only the results are used in order.
+    buildFaces(groups);
+
+    for (const auto &group : groups)
+    {
+        if (group.error)
+            std::rethrow_exception(group.error);
+        const TopoDS_Face &newFace = group.newFace;
+        if (!newFace.IsNull())
+        {
+            // the created face should have the same orientation as the input faces
+            const FaceVectorType& faces = group.faces;
+            if (!faces.empty() && newFace.Orientation() != faces[0].Orientation()) {
+                checkFinalShell = true;
             }
+            facesToSew.push_back(newFace);
+
+            facesToRemove.insert(facesToRemove.end(), faces.begin(), faces.end());
+            // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
+            // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
+            // be replaced by references to the new face. To achieve this all shapes should be marked as
+            // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
+            // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
+            for (const auto & f : faces)
+                modifiedShapes.emplace_back(f, newFace);
         }
     }
     if (!facesToSew.empty())
@@ -1169,21 +1372,30 @@ bool FaceUniter::process()
                     workShell = TopoDS::Shell(workShell.Reversed());
             }
         }
-        // update the list of modifications
+        // update the list of modifications, the entries are looked up by their new face
+        // Note: IsEqual() for some reason does not work, the map uses IsSame()
+        TopTools_DataMapOfShapeInteger newFaceIndex;
+        std::vector<std::vector<std::size_t>> newFaceEntries;
+        for (std::size_t index = 0; index < modifiedShapes.size(); ++index)
+        {
+            const TopoDS_Shape &newFace = modifiedShapes[index].second;
+            if (!newFaceIndex.IsBound(newFace))
+            {
+                newFaceIndex.Bind(newFace, static_cast<int>(newFaceEntries.size()));
+                newFaceEntries.emplace_back();
+            }
+            newFaceEntries[newFaceIndex.Find(newFace)].push_back(index);
+        }
         TopTools_DataMapOfShapeShape faceMap;
         edgeFuse.Faces(faceMap);
         for (mapIt.Initialize(faceMap); mapIt.More(); mapIt.Next())
         {
-            bool isModifiedFace = false;
-            for (auto & it : modifiedShapes)
+            if (newFaceIndex.IsBound(mapIt.Key()))
             {
-                if (mapIt.Key().IsSame(it.second)) {
-                    // Note: IsEqual() for some reason does not work
-                    it.second = mapIt.Value();
-                    isModifiedFace = true;
-                }
+                for (std::size_t index : newFaceEntries[newFaceIndex.Find(mapIt.Key())])
+                    modifiedShapes[index].second = mapIt.Value();
             }
-            if (!isModifiedFace)
+            else
             {
                 // Catch faces that were not united but whose boundary was changed (probably because
                 // several adjacent faces were united)
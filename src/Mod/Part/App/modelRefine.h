@@ -63,6 +63,12 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        /** A number to sort the faces by so that only faces with close keys need to be
+         * compared. The keys of equal faces differ by less than
+         * 8 * Precision::Confusion() * (1 + scale). Returns false if the face can't be
+         * equal to any other face.
+         */
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &scale) const;
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
@@ -79,6 +85,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool getKey(const TopoDS_Face &face, double &key, double &scale) const override;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -91,6 +98,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool getKey(const TopoDS_Face &face, double &key, double &scale) const override;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
@@ -106,6 +114,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool getKey(const TopoDS_Face &face, double &key, double &scale) const override;
         friend FaceTypedBSpline& getBSplineObject();
     };
     FaceTypedBSpline& getBSplineObject();
@@ -135,7 +144,7 @@ namespace ModelRefine
 
     private:
         FaceAdjacencySplitter() = default;
-        void recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector);
+        void findAdjacent(const TopoDS_Face &face, FaceVectorType &outVector);
         std::vector<FaceVectorType> adjacencyArray;
         TopTools_MapOfShape processedMap;
         TopTools_MapOfShape facesInMap;
@@ -51,8 +51,12 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // OpenCasCade
@@ -84,6 +88,7 @@
 
 // Qt Toolkit
 # include <Gui/QtAll.h>
+# include <QtConcurrentMap>
 
 // Inventor includes OpenGL
 # include <Gui/InventorAll.h>
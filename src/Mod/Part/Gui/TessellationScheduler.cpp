@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Standard_Failure.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <QTimer>
+#include <QtConcurrentMap>
+#endif
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Console.h>
+#include <Base/TimeInfo.h>
+#include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/TessellationCache.h>
+#include <Mod/Part/App/Tools.h>
+
+#include "TessellationScheduler.h"
+#include "ViewProviderExt.h"
+
+
+FC_LOG_LEVEL_INIT("Part", true, true)
+
+using namespace PartGui;
+
+namespace
+{
+struct TessellationJob
+{
+    ViewProviderPartExt* vp = nullptr;
+    TopoDS_Shape shape;
+    IMeshTools_Parameters params;
+    bool useCache = false;
+    std::shared_ptr<const Part::TessellationCache> cache;
+    long tag = 0;
+    bool normalsFromUV = true;
+    // computed by the worker and passed to updateVisual()
+    std::optional<uint64_t> key;
+};
+
+void tessellate(TessellationJob& job)
+{
+    try {
+        if (job.useCache) {
+            job.key = Part::TessellationCache::makeKey(job.shape,
+                                                       job.tag,
+                                                       job.params.Deflection,
+                                                       job.params.Angle,
+                                                       job.normalsFromUV);
+            if (job.cache && job.cache->getKey() == *job.key && !job.cache->isEmpty()) {
+                return;
+            }
+        }
+        BRepMesh_IncrementalMesh(job.shape, job.params);
+    }
+    catch (...) {
+        // updateVisual() tries again and reports the error
+    }
+}
+
+// Shapes that share sub-shapes are put into one group that is meshed by a single thread
+std::vector<std::vector<TessellationJob*>> groupJobs(std::vector<TessellationJob>& jobs)
+{
+    std::vector<TopoDS_Shape> shapes;
+    shapes.reserve(jobs.size());
+    for (const TessellationJob& job : jobs) {
+        shapes.push_back(job.shape);
+    }
+
+    std::vector<std::vector<TessellationJob*>> groups;
+    for (const auto& indexes : Part::Tools::groupBySharedSubShapes(shapes)) {
+        auto& group = groups.emplace_back();
+        for (std::size_t index : indexes) {
+            group.push_back(&jobs[index]);
+        }
+    }
+    return groups;
+}
+}  // namespace
+
+TessellationScheduler* TessellationScheduler::_instance = nullptr;
+
+TessellationScheduler& TessellationScheduler::instance()
+{
+    if (!_instance) {
+        _instance = new TessellationScheduler();
+    }
+    return *_instance;
+}
+
+TessellationScheduler::TessellationScheduler()
+{
+    // NOLINTBEGIN
+    connectFinishRestoreDocument = App::GetApplication().signalFinishRestoreDocument.connect(
+        [this](const App::Document&) {
+            process();
+        });
+    // NOLINTEND
+}
+
+TessellationScheduler::~TessellationScheduler()
+{
+    connectFinishRestoreDocument.disconnect();
+}
+
+void TessellationScheduler::add(ViewProviderPartExt* vp)
+{
+    pending.push_back(vp);
+
+    // objects imported into a document don't get a signal when finished
+    if (!scheduled) {
+        scheduled = true;
+        QTimer::singleShot(0, [this]() {
+            process();
+        });
+    }
+}
+
+void TessellationScheduler::remove(ViewProviderPartExt* vp)
+{
+    pending.erase(std::remove(pending.begin(), pending.end(), vp), pending.end());
+}
+
+void TessellationScheduler::process()
+{
+    std::vector<ViewProviderPartExt*> views;
+    views.swap(pending);
+    scheduled = false;
+
+    auto isPending = [](const ViewProviderPartExt* vp) {
+        return vp->VisualTouched && (vp->isUpdateForced() || vp->Visibility.getValue());
+    };
+    views.erase(std::remove_if(views.begin(),
+                               views.end(),
+                               [&isPending](const ViewProviderPartExt* vp) {
+                                   return !isPending(vp);
+                               }),
+                views.end());
+    if (views.empty()) {
+        return;
+    }
+
+    Base::TimeElapsed startTime;
+    std::unordered_map<ViewProviderPartExt*, uint64_t> keys;
+    if (views.size() > 1) {
+        std::vector<TessellationJob> jobs;
+        jobs.reserve(views.size());
+        bool useCache = Part::TessellationCache::isEnabled();
+        for (ViewProviderPartExt* vp : views) {
+            try {
+                TessellationJob job;
+                job.vp = vp;
+                job.shape = Part::Feature::getShape(vp->getObject(),
+                                                    Part::ShapeOption::ResolveLink
+                                                        | Part::ShapeOption::Transform);
+                if (job.shape.IsNull()) {
+                    continue;
+                }
+                job.params = vp->getMeshParameters(job.shape);
+                if (useCache) {
+                    job.useCache = true;
+                    job.cache = vp->Tessellation.getValue();
+                    job.tag = vp->getObject()->getID();
+                    job.normalsFromUV = vp->NormalsFromUV;
+                }
+                jobs.push_back(job);
+            }
+            catch (const Standard_Failure&) {
+                // updateVisual() tries again and reports the error
+            }
+        }
+
+        auto groups = groupJobs(jobs);
+        QtConcurrent::blockingMap(groups, [](const std::vector<TessellationJob*>& group) {
+            for (TessellationJob* job : group) {
+                tessellate(*job);
+            }
+        });
+        for (const TessellationJob& job : jobs) {
+            if (job.key) {
+                keys[job.vp] = *job.key;
+            }
+        }
+        FC_LOG("Tessellated " << jobs.size() << " shapes in " << groups.size() << " groups in "
+                              << Base::TimeElapsed::diffTimeF(startTime, Base::TimeElapsed())
+                              << " s");
+    }
+
+    // the shapes are meshed now, so this only builds the scene graphs
+    for (ViewProviderPartExt* vp : views) {
+        auto it = keys.find(vp);
+        vp->updateVisual(it != keys.end() ? std::optional<uint64_t>(it->second) : std::nullopt);
+    }
+    FC_LOG("Updated " << views.size() << " views in "
+                      << Base::TimeElapsed::diffTimeF(startTime, Base::TimeElapsed()) << " s");
+}
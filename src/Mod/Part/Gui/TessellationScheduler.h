@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef PARTGUI_TESSELLATIONSCHEDULER_H
+#define PARTGUI_TESSELLATIONSCHEDULER_H
+
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include <Mod/Part/PartGlobal.h>
+
+
+namespace PartGui
+{
+
+class ViewProviderPartExt;
+
+/** Computes the visual of the view providers of a loaded document at once.
+ * Instead of tessellating one shape after the other, the shapes of all pending view providers
+ * are meshed concurrently. Only the scene graph is then built on the main thread.
+ */
+class PartGuiExport TessellationScheduler
+{
+public:
+    static TessellationScheduler& instance();
+
+    /// Adds a view provider whose visual is updated with the next call of process()
+    void add(ViewProviderPartExt* vp);
+    void remove(ViewProviderPartExt* vp);
+    /// Tessellates the shapes of the pending view providers and updates their visual
+    void process();
+
+private:
+    TessellationScheduler();
+    ~TessellationScheduler();
+
+    std::vector<ViewProviderPartExt*> pending;
+    bool scheduled = false;
+    boost::signals2::connection connectFinishRestoreDocument;
+
+    static TessellationScheduler* _instance;
+};
+
+}  // namespace PartGui
+
+#endif  // PARTGUI_TESSELLATIONSCHEDULER_H
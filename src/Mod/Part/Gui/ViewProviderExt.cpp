@@ -91,6 +91,7 @@
 #include "SoBrepFaceSet.h"
 #include "SoBrepPointSet.h"
 #include "TaskFaceAppearances.h"
+#include "TessellationScheduler.h"
 
 
 FC_LOG_LEVEL_INIT("Part", true, true)
@@ -185,6 +186,10 @@ ViewProviderPartExt::ViewProviderPartExt()
     ADD_PROPERTY_TYPE(DrawStyle,((long int)0), osgroup, App::Prop_None, "Defines the style of the edges in the 3D view.");
     DrawStyle.setEnums(DrawStyleEnums);
     ADD_PROPERTY_TYPE(ShowPlacement,(false), "Display Options", App::Prop_None, "If true, placement of object is additionally rendered.");
+    ADD_PROPERTY_TYPE(Tessellation, (), osgroup, App::PropertyType(App::Prop_Output | App::Prop_Hidden),
+            "Tessellation of the shape stored with the document.");
+    // a changed tessellation must not mark the document as modified
+    Tessellation.setStatus(App::Property::NoModify, true);
 
     coords = new SoCoordinate3();
     coords->ref();
@@ -258,6 +263,7 @@ ViewProviderPartExt::~ViewProviderPartExt()
     normb->unref();
     lineset->unref();
     nodeset->unref();
+    TessellationScheduler::instance().remove(this);
 }
 
 PyObject* ViewProviderPartExt::getPyObject()
@@ -879,6 +885,12 @@ void ViewProviderPartExt::finishRestoring()
     if (_diffuseColor.getSize() > 1) {
         onChanged(&_diffuseColor);
     }
+    // The visual is computed once all files are read, so that a stored
+    // tessellation can be used and the shapes of all objects can be
+    // tessellated at once
+    if ((isUpdateForced() || Visibility.getValue()) && VisualTouched) {
+        TessellationScheduler::instance().add(this);
+    }
     Gui::ViewProviderGeometryObject::finishRestoring();
 }
 
@@ -926,8 +938,104 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
+IMeshTools_Parameters ViewProviderPartExt::getMeshParameters(const TopoDS_Shape& shape) const
+{
+    // calculating the deflection value
+    Bnd_Box bounds;
+    BRepBndLib::Add(shape, bounds);
+    bounds.SetGap(0.0);
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * Deviation.getValue();
+
+    // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
+    // should be displayed.
+    if (deflection < gp::Resolution()) {
+        deflection = Precision::Confusion();
+    }
+
+    // For very big objects the computed deflection can become very high and thus leads to a useless
+    // tessellation. To avoid this the upper limit is set to 20.0
+    // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
+    //deflection = std::min(deflection, 20.0);
+
+    // create or use the mesh on the data structure
+    Standard_Real AngDeflectionRads = Base::toRadians(AngularDeflection.getValue());
+
+    IMeshTools_Parameters meshParams;
+    meshParams.Deflection = deflection;
+    meshParams.Relative = Standard_False;
+    meshParams.Angle = AngDeflectionRads;
+    meshParams.InParallel = Standard_True;
+    meshParams.AllowQualityDecrease = Standard_True;
+
+    return meshParams;
+}
+
+std::shared_ptr<Part::TessellationCache>
+ViewProviderPartExt::storeTessellation(uint64_t key) const
+{
+    Part::TessellationCache::Arrays arrays;
+    const SbVec3f* points = coords->point.getValues(0);
+    arrays.points.reserve(coords->point.getNum());
+    for (int i = 0; i < coords->point.getNum(); i++) {
+        arrays.points.emplace_back(points[i][0], points[i][1], points[i][2]);
+    }
+    const SbVec3f* normals = norm->vector.getValues(0);
+    arrays.normals.reserve(norm->vector.getNum());
+    for (int i = 0; i < norm->vector.getNum(); i++) {
+        arrays.normals.emplace_back(normals[i][0], normals[i][1], normals[i][2]);
+    }
+    const int32_t* faceIndex = faceset->coordIndex.getValues(0);
+    arrays.faceIndex.assign(faceIndex, faceIndex + faceset->coordIndex.getNum());
+    const int32_t* partIndex = faceset->partIndex.getValues(0);
+    arrays.partIndex.assign(partIndex, partIndex + faceset->partIndex.getNum());
+    const int32_t* lineIndex = lineset->coordIndex.getValues(0);
+    arrays.lineIndex.assign(lineIndex, lineIndex + lineset->coordIndex.getNum());
+    arrays.nodeStart = nodeset->startIndex.getValue();
+    return std::make_shared<Part::TessellationCache>(key, std::move(arrays));
+}
+
+void ViewProviderPartExt::applyTessellation(const Part::TessellationCache& cache)
+{
+    const Part::TessellationCache::Arrays& arrays = cache.getArrays();
+    coords->point.setNum(static_cast<int>(arrays.points.size()));
+    SbVec3f* points = coords->point.startEditing();
+    for (std::size_t i = 0; i < arrays.points.size(); i++) {
+        points[i].setValue(arrays.points[i].x, arrays.points[i].y, arrays.points[i].z);
+    }
+    coords->point.finishEditing();
+    norm->vector.setNum(static_cast<int>(arrays.normals.size()));
+    SbVec3f* normals = norm->vector.startEditing();
+    for (std::size_t i = 0; i < arrays.normals.size(); i++) {
+        normals[i].setValue(arrays.normals[i].x, arrays.normals[i].y, arrays.normals[i].z);
+    }
+    norm->vector.finishEditing();
+    faceset->coordIndex.setNum(static_cast<int>(arrays.faceIndex.size()));
+    faceset->coordIndex.setValues(0, static_cast<int>(arrays.faceIndex.size()),
+                                  arrays.faceIndex.data());
+    faceset->partIndex.setNum(static_cast<int>(arrays.partIndex.size()));
+    faceset->partIndex.setValues(0, static_cast<int>(arrays.partIndex.size()),
+                                 arrays.partIndex.data());
+    lineset->coordIndex.setNum(static_cast<int>(arrays.lineIndex.size()));
+    lineset->coordIndex.setValues(0, static_cast<int>(arrays.lineIndex.size()),
+                                  arrays.lineIndex.data());
+    nodeset->startIndex.setValue(arrays.nodeStart);
+}
+
 void ViewProviderPartExt::updateVisual()
 {
+    updateVisual(std::nullopt);
+}
+
+void ViewProviderPartExt::updateVisual(std::optional<uint64_t> cacheKey)
+{
+    // the stored tessellation might not be restored yet, see finishRestoring()
+    if (isRestoring()) {
+        VisualTouched = true;
+        return;
+    }
+
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
@@ -961,35 +1069,30 @@ void ViewProviderPartExt::updateVisual()
     std::set<int> faceEdges;
 
     try {
-        // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * Deviation.getValue();
-
-        // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
-        // should be displayed.
-        if (deflection < gp::Resolution()) {
-            deflection = Precision::Confusion();
+        IMeshTools_Parameters meshParams = getMeshParameters(cShape);
+
+        bool useCache = Part::TessellationCache::isEnabled();
+        if (useCache) {
+            // the TessellationScheduler already computed the key
+            if (!cacheKey) {
+                cacheKey = Part::TessellationCache::makeKey(cShape, getObject()->getID(),
+                                                            meshParams.Deflection,
+                                                            meshParams.Angle, NormalsFromUV);
+            }
+            std::shared_ptr<const Part::TessellationCache> cache = Tessellation.getValue();
+            if (cache && cache->lookup(*cacheKey)) {
+                applyTessellation(*cache);
+                const auto& stats = Part::TessellationCache::getStatistics();
+                FC_LOG("Use stored tessellation of " << pcObject->getFullName() << " (hits: "
+                       << stats.hits << ", misses: " << stats.misses << ")");
+                VisualTouched = false;
+                setHighlightedFaces(ShapeAppearance.getValues());
+                setHighlightedEdges(LineColorArray.getValues());
+                setHighlightedPoints(PointColorArray.getValue());
+                return;
+            }
         }
 
-        // For very big objects the computed deflection can become very high and thus leads to a useless
-        // tessellation. To avoid this the upper limit is set to 20.0
-        // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
-        //deflection = std::min(deflection, 20.0);
-
-        // create or use the mesh on the data structure
-        Standard_Real AngDeflectionRads = Base::toRadians(AngularDeflection.getValue());
-
-        IMeshTools_Parameters meshParams;
-        meshParams.Deflection = deflection;
-        meshParams.Relative = Standard_False;
-        meshParams.Angle = AngDeflectionRads;
-        meshParams.InParallel = Standard_True;
-        meshParams.AllowQualityDecrease = Standard_True;
-
         BRepMesh_IncrementalMesh(cShape, meshParams);
 
         // We must reset the location here because the transformation data
@@ -1301,6 +1404,13 @@ void ViewProviderPartExt::updateVisual()
         faceset ->coordIndex  .finishEditing();
         faceset ->partIndex   .finishEditing();
         lineset ->coordIndex  .finishEditing();
+
+        if (useCache) {
+            Tessellation.setValue(storeTessellation(*cacheKey));
+        }
+        else if (Tessellation.getValue()) {
+            Tessellation.setValue(nullptr);
+        }
     }
     catch (const Standard_Failure& e) {
         FC_ERR("Cannot compute Inventor representation for the shape of "
@@ -24,12 +24,14 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include <map>
+#include <optional>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderTextureExtension.h>
 
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/TessellationCache.h>
 #include <Mod/Part/PartGlobal.h>
 
 
@@ -53,6 +55,7 @@ class SoNormal;
 class SoNormalBinding;
 class SoMaterialBinding;
 class SoIndexedLineSet;
+struct IMeshTools_Parameters;
 
 namespace PartGui {
 
@@ -89,6 +92,8 @@ public:
     App::PropertyColor LineColor;
     App::PropertyMaterial LineMaterial;
     App::PropertyColorList LineColorArray;
+    /// Tessellation of the shape stored with the document
+    Part::PropertyTessellationCache Tessellation;
 
     void attach(App::DocumentObject *) override;
     void setDisplayMode(const char* ModeName) override;
@@ -165,6 +170,8 @@ protected:
     /// get called by the container whenever a property has been changed
     void onChanged(const App::Property* prop) override;
     bool loadParameter();
+    /// Returns the parameters to tessellate the shape for the visual
+    IMeshTools_Parameters getMeshParameters(const TopoDS_Shape& shape) const;
     void updateVisual();
     void handleChangedPropertyName(Base::XMLReader& reader,
                                    const char* TypeName,
@@ -191,6 +198,13 @@ protected:
     bool NormalsFromUV;
 
 private:
+    /// Updates the visual, using \a cacheKey as key of the stored tessellation if it's given
+    void updateVisual(std::optional<uint64_t> cacheKey);
+    /// Copies the arrays of the nodes into a tessellation that can be stored
+    std::shared_ptr<Part::TessellationCache> storeTessellation(uint64_t key) const;
+    /// Sets the nodes to the arrays of a stored tessellation
+    void applyTessellation(const Part::TessellationCache& cache);
+
     Gui::ViewProviderFaceTexture texture;
     // settings stuff
     int forceUpdateCount;
@@ -203,6 +217,8 @@ private:
     // This is needed to restore old DiffuseColor values since the restore
     // function is asynchronous
     App::PropertyColorList _diffuseColor;
+
+    friend class TessellationScheduler;
 };
 
 }
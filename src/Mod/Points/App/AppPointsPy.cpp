@@ -60,7 +60,7 @@ public:
     }
 
 private:
-    std::tuple<bool, bool, double> readE57Settings() const
+    std::tuple<bool, bool, double, double> readE57Settings() const
     {
         Base::Reference<ParameterGrp> hGrp = App::GetApplication()
                                                  .GetUserParameter()
@@ -70,8 +70,9 @@ private:
         bool useColor = hGrp->GetBool("UseColor", true);
         bool checkState = hGrp->GetBool("CheckInvalidState", true);
         double minDistance = hGrp->GetFloat("MinDistance", -1.);
+        double voxelSize = hGrp->GetFloat("VoxelSize", -1.);
 
-        return std::make_tuple(useColor, checkState, minDistance);
+        return std::make_tuple(useColor, checkState, minDistance, voxelSize);
     }
     Py::Object open(const Py::Tuple& args)
     {
@@ -97,9 +98,11 @@ private:
             }
             else if (file.hasExtension("e57")) {
                 auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(std::get<0>(setting),
-                                                     std::get<1>(setting),
-                                                     std::get<2>(setting));
+                auto e57 = std::make_unique<E57Reader>(std::get<0>(setting),
+                                                       std::get<1>(setting),
+                                                       std::get<2>(setting));
+                e57->setVoxelSize(std::get<3>(setting));
+                reader = std::move(e57);
             }
             else if (file.hasExtension("ply")) {
                 reader = std::make_unique<PlyReader>();
@@ -219,9 +222,11 @@ private:
             }
             else if (file.hasExtension("e57")) {
                 auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(std::get<0>(setting),
-                                                     std::get<1>(setting),
-                                                     std::get<2>(setting));
+                auto e57 = std::make_unique<E57Reader>(std::get<0>(setting),
+                                                       std::get<1>(setting),
+                                                       std::get<2>(setting));
+                e57->setVoxelSize(std::get<3>(setting));
+                reader = std::move(e57);
             }
             else if (file.hasExtension("ply")) {
                 reader = std::make_unique<PlyReader>();
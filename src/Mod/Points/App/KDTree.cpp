@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <QtConcurrentMap>
+#endif
+
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+
+#include "KDTree.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+const std::size_t LeafSize = 12;
+const std::size_t ParallelSize = 65536;
+const std::size_t MinTasks = 64;
+const std::size_t QueryBlock = 1024;
+
+struct Range
+{
+    std::size_t begin;
+    std::size_t end;
+};
+
+std::vector<Range> splitRange(std::size_t count)
+{
+    std::vector<Range> blocks;
+    for (std::size_t pos = 0; pos < count; pos += QueryBlock) {
+        blocks.push_back({pos, std::min(count, pos + QueryBlock)});
+    }
+    return blocks;
+}
+
+float distance2(const Base::Vector3f& p1, const Base::Vector3f& p2)
+{
+    float dx = p1.x - p2.x;
+    float dy = p1.y - p2.y;
+    float dz = p1.z - p2.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/// Keeps the k nearest candidates sorted by their squared distance
+class NearestList
+{
+public:
+    explicit NearestList(std::size_t k)
+        : k {k}
+    {
+        items.reserve(k);
+    }
+
+    void operator()(float dist2, uint32_t index, float& maxDist2)
+    {
+        if (items.size() == k) {
+            items.pop_back();
+        }
+        auto it = std::upper_bound(items.begin(),
+                                   items.end(),
+                                   dist2,
+                                   [](float value, const std::pair<float, uint32_t>& item) {
+                                       return value < item.first;
+                                   });
+        items.insert(it, {dist2, index});
+        if (items.size() == k) {
+            maxDist2 = items.back().first;
+        }
+    }
+
+    // NOLINTBEGIN
+    std::vector<std::pair<float, uint32_t>> items;
+    // NOLINTEND
+
+private:
+    std::size_t k;
+};
+
+}  // namespace
+
+PointsKDTree::PointsKDTree() = default;
+
+PointsKDTree::PointsKDTree(const PointKernel& kernel)
+{
+    build(kernel);
+}
+
+PointsKDTree::PointsKDTree(const std::vector<Base::Vector3f>& pts)
+{
+    build(pts);
+}
+
+void PointsKDTree::build(const PointKernel& kernel)
+{
+    std::vector<Base::Vector3f> pts;
+    pts.reserve(kernel.size());
+    for (PointKernel::size_type index = 0; index < kernel.size(); index++) {
+        pts.push_back(Base::convertTo<Base::Vector3f>(kernel.getPoint(index)));
+    }
+    build(pts);
+}
+
+void PointsKDTree::build(const std::vector<Base::Vector3f>& pts)
+{
+    if (pts.size() > std::numeric_limits<uint32_t>::max()) {
+        throw Base::ValueError("Too many points for a kd-tree");
+    }
+
+    clear();
+    entries.reserve(pts.size());
+    for (std::size_t index = 0; index < pts.size(); index++) {
+        const Base::Vector3f& pnt = pts[index];
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            entries.push_back({pnt, static_cast<uint32_t>(index)});
+        }
+    }
+
+    buildTree();
+}
+
+void PointsKDTree::clear()
+{
+    entries.clear();
+    nodes.clear();
+    depth = 0;
+}
+
+bool PointsKDTree::isEmpty() const
+{
+    return entries.empty();
+}
+
+PointsKDTree::size_type PointsKDTree::size() const
+{
+    return entries.size();
+}
+
+void PointsKDTree::buildTree()
+{
+    // all leaves are on the same level and hold at most LeafSize points
+    const std::size_t count = entries.size();
+    while (((count + (std::size_t(1) << depth) - 1) >> depth) > LeafSize) {
+        depth++;
+    }
+    nodes.resize((std::size_t(1) << depth) - 1);
+
+    struct Task
+    {
+        std::size_t node;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // split the upper levels one after another until there are enough independent subtrees
+    std::vector<Task> tasks {{0, 0, count}};
+    int level = 0;
+    while (level < depth && tasks.size() < MinTasks && count >= ParallelSize) {
+        QtConcurrent::blockingMap(tasks, [this](const Task& task) {
+            splitNode(task.node, task.begin, task.end);
+        });
+
+        std::vector<Task> children;
+        for (const auto& task : tasks) {
+            std::size_t mid = task.begin + (task.end - task.begin) / 2;
+            children.push_back({2 * task.node + 1, task.begin, mid});
+            children.push_back({2 * task.node + 2, mid, task.end});
+        }
+        tasks.swap(children);
+        level++;
+    }
+
+    QtConcurrent::blockingMap(tasks, [this, level](const Task& task) {
+        buildSubtree(task.node, task.begin, task.end, level);
+    });
+}
+
+void PointsKDTree::splitNode(std::size_t node, std::size_t begin, std::size_t end)
+{
+    // split along the axis of the largest extent
+    Base::Vector3f minPt(std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max());
+    Base::Vector3f maxPt(-minPt);
+    for (std::size_t i = begin; i < end; i++) {
+        const Base::Vector3f& pnt = entries[i].point;
+        minPt.Set(std::min(minPt.x, pnt.x), std::min(minPt.y, pnt.y), std::min(minPt.z, pnt.z));
+        maxPt.Set(std::max(maxPt.x, pnt.x), std::max(maxPt.y, pnt.y), std::max(maxPt.z, pnt.z));
+    }
+
+    Base::Vector3f size = maxPt - minPt;
+    int axis = 0;
+    if (size.y > size[axis]) {
+        axis = 1;
+    }
+    if (size.z > size[axis]) {
+        axis = 2;
+    }
+
+    auto first = entries.begin();
+    std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(first + static_cast<std::ptrdiff_t>(begin),
+                     first + static_cast<std::ptrdiff_t>(mid),
+                     first + static_cast<std::ptrdiff_t>(end),
+                     [axis](const Entry& e1, const Entry& e2) {
+                         return e1.point[axis] < e2.point[axis];
+                     });
+
+    Node& info = nodes[node];
+    info.axis = axis;
+    info.split = mid < end ? entries[mid].point[axis] : 0.0F;
+}
+
+void PointsKDTree::buildSubtree(std::size_t node, std::size_t begin, std::size_t end, int level)
+{
+    if (level >= depth) {
+        return;
+    }
+
+    splitNode(node, begin, end);
+    std::size_t mid = begin + (end - begin) / 2;
+    buildSubtree(2 * node + 1, begin, mid, level + 1);
+    buildSubtree(2 * node + 2, mid, end, level + 1);
+}
+
+template<typename Visitor>
+void PointsKDTree::searchNode(std::size_t node,
+                              std::size_t begin,
+                              std::size_t end,
+                              int level,
+                              const Base::Vector3f& pnt,
+                              float& maxDist2,
+                              Visitor& visit) const
+{
+    if (level == depth) {
+        for (std::size_t i = begin; i < end; i++) {
+            float dist2 = distance2(pnt, entries[i].point);
+            if (dist2 <= maxDist2) {
+                visit(dist2, entries[i].index, maxDist2);
+            }
+        }
+        return;
+    }
+
+    // visit the side of the split plane that contains the point first
+    const Node& info = nodes[node];
+    float diff = pnt[info.axis] - info.split;
+    std::size_t mid = begin + (end - begin) / 2;
+    if (diff < 0.0F) {
+        searchNode(2 * node + 1, begin, mid, level + 1, pnt, maxDist2, visit);
+        if (diff * diff <= maxDist2) {
+            searchNode(2 * node + 2, mid, end, level + 1, pnt, maxDist2, visit);
+        }
+    }
+    else {
+        searchNode(2 * node + 2, mid, end, level + 1, pnt, maxDist2, visit);
+        if (diff * diff <= maxDist2) {
+            searchNode(2 * node + 1, begin, mid, level + 1, pnt, maxDist2, visit);
+        }
+    }
+}
+
+PointsKDTree::size_type PointsKDTree::findNearest(const Base::Vector3f& pnt, float& dist) const
+{
+    std::vector<size_type> indices;
+    std::vector<float> distances;
+    findNearest(pnt, 1, indices, distances);
+    if (indices.empty()) {
+        dist = std::numeric_limits<float>::max();
+        return npos;
+    }
+
+    dist = distances.front();
+    return indices.front();
+}
+
+void PointsKDTree::findNearest(const Base::Vector3f& pnt,
+                               std::size_t k,
+                               std::vector<size_type>& indices,
+                               std::vector<float>& distances) const
+{
+    indices.clear();
+    distances.clear();
+    if (entries.empty() || k == 0) {
+        return;
+    }
+
+    NearestList nearest(std::min(k, entries.size()));
+    float maxDist2 = std::numeric_limits<float>::max();
+    searchNode(0, 0, entries.size(), 0, pnt, maxDist2, nearest);
+
+    for (const auto& item : nearest.items) {
+        indices.push_back(item.second);
+        distances.push_back(std::sqrt(item.first));
+    }
+}
+
+void PointsKDTree::findInRadius(const Base::Vector3f& pnt,
+                                float radius,
+                                std::vector<size_type>& indices) const
+{
+    indices.clear();
+    if (entries.empty() || radius < 0.0F) {
+        return;
+    }
+
+    auto collect = [&indices](float, uint32_t index, float&) {
+        indices.push_back(index);
+    };
+    float maxDist2 = radius * radius;
+    searchNode(0, 0, entries.size(), 0, pnt, maxDist2, collect);
+}
+
+void PointsKDTree::findNearest(const std::vector<Base::Vector3f>& pnts,
+                               std::size_t k,
+                               std::vector<size_type>& indices) const
+{
+    indices.assign(pnts.size() * k, npos);
+    std::vector<Range> blocks = splitRange(pnts.size());
+    QtConcurrent::blockingMap(blocks, [&](const Range& block) {
+        std::vector<size_type> found;
+        std::vector<float> distances;
+        for (std::size_t i = block.begin; i < block.end; i++) {
+            findNearest(pnts[i], k, found, distances);
+            std::copy(found.begin(), found.end(), indices.begin() + std::ptrdiff_t(i * k));
+        }
+    });
+}
+
+void PointsKDTree::findInRadius(const std::vector<Base::Vector3f>& pnts,
+                                float radius,
+                                std::vector<std::vector<size_type>>& indices) const
+{
+    indices.clear();
+    indices.resize(pnts.size());
+    std::vector<Range> blocks = splitRange(pnts.size());
+    QtConcurrent::blockingMap(blocks, [&](const Range& block) {
+        for (std::size_t i = block.begin; i < block.end; i++) {
+            findInRadius(pnts[i], radius, indices[i]);
+        }
+    });
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/** Balanced k-d tree over a point cloud for nearest neighbour and radius searches.
+ * The tree is stored implicitly: the points are reordered so that every node covers a
+ * contiguous range, the children of node i are the nodes 2i+1 and 2i+2 and all leaves have the
+ * same depth. Apart from the reordered points only the split planes are stored, which keeps the
+ * structure compact and the leaf scans cache-friendly.
+ *
+ * The tree is built on several threads. Points with NaN coordinates are not added. All search
+ * functions return the indices of the points as passed to build() and may be called from several
+ * threads at the same time.
+ */
+class PointsExport PointsKDTree
+{
+public:
+    using size_type = std::size_t;
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    /** @name Construction */
+    //@{
+    PointsKDTree();
+    /// Builds the tree from the transformed points of \a kernel.
+    explicit PointsKDTree(const PointKernel& kernel);
+    explicit PointsKDTree(const std::vector<Base::Vector3f>& pts);
+    //@}
+
+    /// Builds the tree from the transformed points of \a kernel.
+    void build(const PointKernel& kernel);
+    /// Builds the tree from \a pts.
+    void build(const std::vector<Base::Vector3f>& pts);
+    void clear();
+    bool isEmpty() const;
+    /// Returns the number of points in the tree.
+    size_type size() const;
+
+    /** @name Search */
+    //@{
+    /** Returns the index of the point nearest to \a pnt and its distance \a dist. If the tree is
+     * empty npos is returned. */
+    size_type findNearest(const Base::Vector3f& pnt, float& dist) const;
+    /** Searches for the \a k nearest points of \a pnt. \a indices and \a distances are sorted by
+     * increasing distance and have less than \a k elements if the tree is smaller. */
+    void findNearest(const Base::Vector3f& pnt,
+                     std::size_t k,
+                     std::vector<size_type>& indices,
+                     std::vector<float>& distances) const;
+    /** Searches for all points whose distance to \a pnt is not greater than \a radius. */
+    void findInRadius(const Base::Vector3f& pnt,
+                      float radius,
+                      std::vector<size_type>& indices) const;
+    /** Searches for the \a k nearest points of each point of \a pnts on several threads. The
+     * neighbours of the i-th query point are the elements [i*k, (i+1)*k) of \a indices, missing
+     * neighbours are set to npos. */
+    void findNearest(const std::vector<Base::Vector3f>& pnts,
+                     std::size_t k,
+                     std::vector<size_type>& indices) const;
+    /** Searches for the points in the distance \a radius of each point of \a pnts on several
+     * threads. */
+    void findInRadius(const std::vector<Base::Vector3f>& pnts,
+                      float radius,
+                      std::vector<std::vector<size_type>>& indices) const;
+    //@}
+
+private:
+    struct Entry
+    {
+        Base::Vector3f point;
+        uint32_t index;
+    };
+    struct Node
+    {
+        float split;
+        int axis;
+    };
+
+    void buildTree();
+    void splitNode(std::size_t node, std::size_t begin, std::size_t end);
+    void buildSubtree(std::size_t node, std::size_t begin, std::size_t end, int level);
+    template<typename Visitor>
+    void searchNode(std::size_t node,
+                    std::size_t begin,
+                    std::size_t end,
+                    int level,
+                    const Base::Vector3f& pnt,
+                    float& maxDist2,
+                    Visitor& visit) const;
+
+private:
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+    int depth {0};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_KDTREE_H
@@ -0,0 +1,738 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "PagedPoints.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+const uint32_t PagedMagic = 0x50504B31;  // "PPK1"
+const uint32_t PagedVersion = 1;
+const std::streamoff HeaderSize = 64;
+const int MaxDepth = 8;
+const std::size_t BatchSize = 1 << 20;
+const std::size_t WriteBuffer = 4096;
+
+static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "Unexpected layout of Vector3f");
+
+struct OctreeNode
+{
+    Base::BoundBox3f box;
+    uint64_t offset {0};
+    uint32_t count {0};
+    int32_t children[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+
+    bool isLeaf() const
+    {
+        return std::all_of(std::begin(children), std::end(children), [](int32_t child) {
+            return child < 0;
+        });
+    }
+};
+
+template<typename T>
+void writeRaw(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void readRaw(std::istream& inp, T& value)
+{
+    inp.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+void writePoints(std::ostream& out, const Base::Vector3f* pts, std::size_t num)
+{
+    out.write(reinterpret_cast<const char*>(pts),
+              static_cast<std::streamsize>(num * sizeof(Base::Vector3f)));
+}
+
+/// Interleaves the bits of the cell coordinates to a Morton code.
+uint32_t mortonCode(uint32_t ix, uint32_t iy, uint32_t iz, int depth)
+{
+    uint32_t code = 0;
+    for (int bit = depth - 1; bit >= 0; bit--) {
+        code = (code << 3) | (((ix >> bit) & 1) << 2) | (((iy >> bit) & 1) << 1)
+            | ((iz >> bit) & 1);
+    }
+    return code;
+}
+
+/// Maps points to the cells of a regular grid over the root cube of the octree.
+class CellMapper
+{
+public:
+    CellMapper(const Base::BoundBox3f& bounds, int depth)
+        : res(1U << depth)
+    {
+        double len = std::max({bounds.LengthX(), bounds.LengthY(), bounds.LengthZ()});
+        if (len <= 0.0) {
+            len = 1.0;
+        }
+        // make sure that the maximum coordinates are inside the cube
+        len *= 1.0 + 1e-5;
+        Base::Vector3f center = bounds.GetCenter();
+        for (int i = 0; i < 3; i++) {
+            origin[i] = static_cast<double>(center[i]) - 0.5 * len;
+        }
+        size = len;
+    }
+
+    void cell(const Base::Vector3f& pnt, uint32_t coords[3]) const
+    {
+        for (int i = 0; i < 3; i++) {
+            double val = (static_cast<double>(pnt[i]) - origin[i]) / size * res;
+            coords[i] = static_cast<uint32_t>(std::clamp(val, 0.0, double(res - 1)));
+        }
+    }
+
+    Base::BoundBox3f box(uint32_t code, int level) const
+    {
+        uint32_t coords[3] = {0, 0, 0};
+        for (int bit = 0; bit < level; bit++) {
+            coords[0] |= ((code >> (3 * bit + 2)) & 1) << bit;
+            coords[1] |= ((code >> (3 * bit + 1)) & 1) << bit;
+            coords[2] |= ((code >> (3 * bit)) & 1) << bit;
+        }
+        double len = size / double(1U << level);
+        Base::BoundBox3f bnd;
+        bnd.MinX = static_cast<float>(origin[0] + coords[0] * len);
+        bnd.MinY = static_cast<float>(origin[1] + coords[1] * len);
+        bnd.MinZ = static_cast<float>(origin[2] + coords[2] * len);
+        bnd.MaxX = static_cast<float>(origin[0] + (coords[0] + 1) * len);
+        bnd.MaxY = static_cast<float>(origin[1] + (coords[1] + 1) * len);
+        bnd.MaxZ = static_cast<float>(origin[2] + (coords[2] + 1) * len);
+        return bnd;
+    }
+
+private:
+    uint32_t res;
+    double origin[3] {};
+    double size {1.0};
+};
+
+}  // namespace
+
+class PagedPointKernel::Private
+{
+public:
+    using Chunk = std::shared_ptr<const std::vector<value_type>>;
+
+    std::size_t leafCapacity {65536};
+    std::size_t sampleCapacity {4096};
+    std::size_t cacheSize {256 * 1024 * 1024};
+
+    // building
+    Base::FileInfo file;
+    Base::FileInfo staging;
+    std::unique_ptr<Base::ofstream> stagingOut;
+
+    // opened cloud
+    uint64_t numPoints {0};
+    Base::BoundBox3f bounds;
+    std::vector<OctreeNode> nodes;
+    std::unique_ptr<Base::ifstream> chunks;
+
+    // chunk cache
+    struct CacheEntry
+    {
+        Chunk chunk;
+        std::list<uint32_t>::iterator lru;
+    };
+    mutable std::mutex mutex;
+    mutable std::list<uint32_t> lru;
+    mutable std::unordered_map<uint32_t, CacheEntry> cache;
+    mutable std::size_t cachedPoints {0};
+
+    Chunk loadChunk(uint32_t index) const;
+    void clearCache();
+    void build();
+    void readStaging(const std::function<void(const std::vector<value_type>&)>& func) const;
+};
+
+PagedPointKernel::Private::Chunk PagedPointKernel::Private::loadChunk(uint32_t index) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(index);
+    if (it != cache.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru);
+        return it->second.chunk;
+    }
+
+    const OctreeNode& node = nodes[index];
+    auto data = std::make_shared<std::vector<value_type>>(node.count);
+    chunks->clear();
+    chunks->seekg(static_cast<std::streamoff>(node.offset));
+    chunks->read(reinterpret_cast<char*>(data->data()),
+                 static_cast<std::streamsize>(node.count * sizeof(value_type)));
+    if (!*chunks) {
+        throw Base::FileException("Failed to read point chunk", file);
+    }
+
+    lru.push_front(index);
+    cache[index] = CacheEntry {data, lru.begin()};
+    cachedPoints += data->size();
+
+    // keep at least the chunk that has just been loaded
+    std::size_t maxPoints = cacheSize / sizeof(value_type);
+    while (cachedPoints > maxPoints && lru.size() > 1) {
+        auto last = cache.find(lru.back());
+        cachedPoints -= last->second.chunk->size();
+        cache.erase(last);
+        lru.pop_back();
+    }
+
+    return data;
+}
+
+void PagedPointKernel::Private::clearCache()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.clear();
+    lru.clear();
+    cachedPoints = 0;
+}
+
+void PagedPointKernel::Private::readStaging(
+    const std::function<void(const std::vector<value_type>&)>& func) const
+{
+    Base::ifstream inp(staging, std::ios::in | std::ios::binary);
+    if (!inp) {
+        throw Base::FileException("Failed to open staging file", staging);
+    }
+
+    std::vector<value_type> batch;
+    uint64_t remaining = numPoints;
+    while (remaining > 0) {
+        batch.resize(static_cast<std::size_t>(std::min<uint64_t>(remaining, BatchSize)));
+        inp.read(reinterpret_cast<char*>(batch.data()),
+                 static_cast<std::streamsize>(batch.size() * sizeof(value_type)));
+        if (!inp) {
+            throw Base::FileException("Failed to read staging file", staging);
+        }
+        remaining -= batch.size();
+        func(batch);
+    }
+}
+
+void PagedPointKernel::Private::build()
+{
+    // Choose the depth of the counting grid so that a leaf at the finest level holds about
+    // leafCapacity / 64 points if the points were uniformly distributed.
+    int depth = 1;
+    double cells = double(numPoints) / double(std::max<std::size_t>(leafCapacity, 1));
+    while (depth < MaxDepth && std::pow(8.0, depth - 2) < cells) {
+        depth++;
+    }
+
+    CellMapper mapper(bounds, depth);
+    auto code = [&mapper, depth](const value_type& pnt) {
+        uint32_t coords[3];
+        mapper.cell(pnt, coords);
+        return mortonCode(coords[0], coords[1], coords[2], depth);
+    };
+
+    // first pass: count the points per cell of the finest level
+    std::vector<std::vector<uint64_t>> counts(depth + 1);
+    counts[depth].resize(std::size_t(1) << (3 * depth));
+    readStaging([&](const std::vector<value_type>& batch) {
+        for (const auto& pnt : batch) {
+            counts[depth][code(pnt)]++;
+        }
+    });
+    for (int level = depth - 1; level >= 0; level--) {
+        counts[level].resize(std::size_t(1) << (3 * level));
+        for (std::size_t i = 0; i < counts[level + 1].size(); i++) {
+            counts[level][i >> 3] += counts[level + 1][i];
+        }
+    }
+
+    // create the nodes in breadth-first order and split them while they are too large
+    struct BuildInfo
+    {
+        uint32_t code;
+        int level;
+    };
+    std::vector<BuildInfo> info;
+    nodes.clear();
+    nodes.emplace_back();
+    nodes[0].box = mapper.box(0, 0);
+    info.push_back({0, 0});
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        BuildInfo cur = info[i];
+        uint64_t total = counts[cur.level][cur.code];
+        if (total <= leafCapacity || cur.level == depth) {
+            nodes[i].count = static_cast<uint32_t>(total);
+            continue;
+        }
+        for (uint32_t oct = 0; oct < 8; oct++) {
+            uint32_t child = (cur.code << 3) | oct;
+            if (counts[cur.level + 1][child] > 0) {
+                nodes[i].children[oct] = static_cast<int32_t>(nodes.size());
+                OctreeNode node;
+                node.box = mapper.box(child, cur.level + 1);
+                nodes.push_back(node);
+                info.push_back({child, cur.level + 1});
+            }
+        }
+    }
+    counts.clear();
+
+    Base::ofstream out(file, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out) {
+        throw Base::FileException("Failed to create chunk file", file);
+    }
+
+    // reserve the space for the header and the leaves
+    uint64_t offset = HeaderSize;
+    for (auto& node : nodes) {
+        if (node.isLeaf()) {
+            node.offset = offset;
+            offset += uint64_t(node.count) * sizeof(value_type);
+        }
+    }
+
+    // second pass: scatter the points into the leaves and collect the samples of the inner
+    // nodes, keeping the first point that falls into a cell of the sample grid
+    const auto grid = static_cast<uint32_t>(
+        std::max(1.0, std::round(std::cbrt(double(std::max<std::size_t>(sampleCapacity, 1))))));
+    struct SampleGrid
+    {
+        float minv[3];
+        float scale[3];
+        std::vector<bool> used;
+        std::vector<std::pair<uint32_t, value_type>> points;
+    };
+    std::vector<SampleGrid> samples(nodes.size());
+    std::vector<char> leaves(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        leaves[i] = nodes[i].isLeaf();
+        if (!leaves[i]) {
+            const Base::BoundBox3f& box = nodes[i].box;
+            SampleGrid& sample = samples[i];
+            sample.minv[0] = box.MinX;
+            sample.minv[1] = box.MinY;
+            sample.minv[2] = box.MinZ;
+            sample.scale[0] = float(grid) / box.LengthX();
+            sample.scale[1] = float(grid) / box.LengthY();
+            sample.scale[2] = float(grid) / box.LengthZ();
+            sample.used.resize(std::size_t(grid) * grid * grid);
+        }
+    }
+
+    std::vector<std::vector<value_type>> buffers(nodes.size());
+    std::vector<uint64_t> written(nodes.size(), 0);
+    auto flush = [&](std::size_t index) {
+        out.seekp(static_cast<std::streamoff>(nodes[index].offset
+                                              + written[index] * sizeof(value_type)));
+        writePoints(out, buffers[index].data(), buffers[index].size());
+        written[index] += buffers[index].size();
+        buffers[index].clear();
+    };
+
+    readStaging([&](const std::vector<value_type>& batch) {
+        for (const auto& pnt : batch) {
+            std::size_t index = 0;
+            uint32_t cell = code(pnt);
+            int level = 0;
+            while (!leaves[index]) {
+                SampleGrid& sample = samples[index];
+                uint32_t key = 0;
+                for (int i = 0; i < 3; i++) {
+                    float val = std::max((pnt[i] - sample.minv[i]) * sample.scale[i], 0.0F);
+                    key = key * grid + std::min(grid - 1, static_cast<uint32_t>(val));
+                }
+                if (!sample.used[key]) {
+                    sample.used[key] = true;
+                    sample.points.emplace_back(key, pnt);
+                }
+
+                level++;
+                uint32_t oct = (cell >> (3 * (depth - level))) & 7;
+                index = static_cast<std::size_t>(nodes[index].children[oct]);
+            }
+
+            buffers[index].push_back(pnt);
+            if (buffers[index].size() >= WriteBuffer) {
+                flush(index);
+            }
+        }
+    });
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (!buffers[i].empty()) {
+            flush(i);
+        }
+    }
+    buffers.clear();
+
+    // append the samples of the inner nodes sorted by their cells
+    out.seekp(static_cast<std::streamoff>(offset));
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (leaves[i]) {
+            continue;
+        }
+        std::vector<std::pair<uint32_t, value_type>> sample;
+        sample.swap(samples[i].points);
+        samples[i].used.clear();
+        std::sort(sample.begin(), sample.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        nodes[i].offset = offset;
+        nodes[i].count = static_cast<uint32_t>(sample.size());
+        for (const auto& it : sample) {
+            writePoints(out, &it.second, 1);
+        }
+        offset += sample.size() * sizeof(value_type);
+    }
+
+    // node table
+    for (const auto& node : nodes) {
+        writeRaw(out, node.box.MinX);
+        writeRaw(out, node.box.MinY);
+        writeRaw(out, node.box.MinZ);
+        writeRaw(out, node.box.MaxX);
+        writeRaw(out, node.box.MaxY);
+        writeRaw(out, node.box.MaxZ);
+        writeRaw(out, node.offset);
+        writeRaw(out, node.count);
+        for (int32_t child : node.children) {
+            writeRaw(out, child);
+        }
+    }
+
+    out.seekp(0);
+    writeRaw(out, PagedMagic);
+    writeRaw(out, PagedVersion);
+    writeRaw(out, numPoints);
+    writeRaw(out, bounds.MinX);
+    writeRaw(out, bounds.MinY);
+    writeRaw(out, bounds.MinZ);
+    writeRaw(out, bounds.MaxX);
+    writeRaw(out, bounds.MaxY);
+    writeRaw(out, bounds.MaxZ);
+    writeRaw(out, static_cast<uint32_t>(nodes.size()));
+    writeRaw(out, offset);
+
+    out.close();
+    if (!out) {
+        throw Base::FileException("Failed to write chunk file", file);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+PagedPointKernel::PagedPointKernel()
+    : d(new Private)
+{}
+
+PagedPointKernel::~PagedPointKernel()
+{
+    close();
+}
+
+void PagedPointKernel::setLeafCapacity(std::size_t num)
+{
+    d->leafCapacity = std::max<std::size_t>(num, 1);
+}
+
+void PagedPointKernel::setSampleCapacity(std::size_t num)
+{
+    d->sampleCapacity = std::max<std::size_t>(num, 1);
+}
+
+void PagedPointKernel::create(const std::string& file)
+{
+    close();
+    d->file.setFile(file);
+    d->staging.setFile(file + ".tmp");
+    d->stagingOut = std::make_unique<Base::ofstream>(d->staging,
+                                                     std::ios::out | std::ios::trunc
+                                                         | std::ios::binary);
+    if (!*d->stagingOut) {
+        d->stagingOut.reset();
+        throw Base::FileException("Failed to create staging file", d->staging);
+    }
+}
+
+void PagedPointKernel::addPoints(const std::vector<value_type>& pts)
+{
+    if (!d->stagingOut) {
+        throw Base::RuntimeError("No point cloud is being built");
+    }
+
+    std::vector<value_type> valid;
+    valid.reserve(pts.size());
+    for (const auto& pnt : pts) {
+        if (!(std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z))) {
+            valid.push_back(pnt);
+            d->bounds.Add(pnt);
+        }
+    }
+
+    writePoints(*d->stagingOut, valid.data(), valid.size());
+    if (!*d->stagingOut) {
+        throw Base::FileException("Failed to write staging file", d->staging);
+    }
+    d->numPoints += valid.size();
+}
+
+void PagedPointKernel::finish()
+{
+    if (!d->stagingOut) {
+        throw Base::RuntimeError("No point cloud is being built");
+    }
+
+    d->stagingOut->close();
+    d->stagingOut.reset();
+    try {
+        d->build();
+    }
+    catch (...) {
+        d->staging.deleteFile();
+        d->nodes.clear();
+        throw;
+    }
+    d->staging.deleteFile();
+
+    open(d->file.filePath());
+}
+
+void PagedPointKernel::open(const std::string& file)
+{
+    close();
+    d->file.setFile(file);
+    auto inp = std::make_unique<Base::ifstream>(d->file, std::ios::in | std::ios::binary);
+    if (!*inp) {
+        throw Base::FileException("Failed to open chunk file", d->file);
+    }
+
+    uint32_t magic {}, version {}, numNodes {};
+    uint64_t numPoints {}, table {};
+    Base::BoundBox3f bounds;
+    readRaw(*inp, magic);
+    readRaw(*inp, version);
+    if (!*inp || magic != PagedMagic || version != PagedVersion) {
+        throw Base::BadFormatError("Not a chunk file of a point cloud");
+    }
+    readRaw(*inp, numPoints);
+    readRaw(*inp, bounds.MinX);
+    readRaw(*inp, bounds.MinY);
+    readRaw(*inp, bounds.MinZ);
+    readRaw(*inp, bounds.MaxX);
+    readRaw(*inp, bounds.MaxY);
+    readRaw(*inp, bounds.MaxZ);
+    readRaw(*inp, numNodes);
+    readRaw(*inp, table);
+
+    std::vector<OctreeNode> nodes;
+    inp->seekg(static_cast<std::streamoff>(table));
+    for (uint32_t i = 0; i < numNodes && *inp; i++) {
+        OctreeNode node;
+        readRaw(*inp, node.box.MinX);
+        readRaw(*inp, node.box.MinY);
+        readRaw(*inp, node.box.MinZ);
+        readRaw(*inp, node.box.MaxX);
+        readRaw(*inp, node.box.MaxY);
+        readRaw(*inp, node.box.MaxZ);
+        readRaw(*inp, node.offset);
+        readRaw(*inp, node.count);
+        for (int32_t& child : node.children) {
+            readRaw(*inp, child);
+            if (child >= int32_t(numNodes) || child == 0) {
+                throw Base::BadFormatError("Invalid octree in chunk file");
+            }
+        }
+        nodes.push_back(node);
+    }
+    if (!*inp) {
+        throw Base::BadFormatError("Truncated chunk file");
+    }
+
+    d->numPoints = numPoints;
+    d->bounds = bounds;
+    d->nodes.swap(nodes);
+    d->chunks = std::move(inp);
+}
+
+void PagedPointKernel::close()
+{
+    if (d->stagingOut) {
+        d->stagingOut->close();
+        d->stagingOut.reset();
+        d->staging.deleteFile();
+    }
+    d->chunks.reset();
+    d->nodes.clear();
+    d->numPoints = 0;
+    d->bounds = Base::BoundBox3f();
+    d->clearCache();
+}
+
+bool PagedPointKernel::isOpen() const
+{
+    return d->chunks != nullptr;
+}
+
+void PagedPointKernel::setCacheSize(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->cacheSize = bytes;
+}
+
+std::size_t PagedPointKernel::countNodes() const
+{
+    return d->nodes.size();
+}
+
+std::size_t PagedPointKernel::countCachedPoints() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->cachedPoints;
+}
+
+std::size_t PagedPointKernel::countPoints() const
+{
+    return static_cast<std::size_t>(d->numPoints);
+}
+
+Base::BoundBox3f PagedPointKernel::getPointBounds() const
+{
+    return d->bounds;
+}
+
+void PagedPointKernel::getPointsInBox(const Base::BoundBox3f& box,
+                                      std::vector<value_type>& pts) const
+{
+    if (d->nodes.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> stack {0};
+    while (!stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+        const OctreeNode& node = d->nodes[index];
+        if (!box.Intersect(node.box)) {
+            continue;
+        }
+        if (!node.isLeaf()) {
+            for (int32_t child : node.children) {
+                if (child > 0) {
+                    stack.push_back(static_cast<uint32_t>(child));
+                }
+            }
+            continue;
+        }
+
+        Private::Chunk chunk = d->loadChunk(index);
+        if (box.IsInBox(node.box)) {
+            pts.insert(pts.end(), chunk->begin(), chunk->end());
+        }
+        else {
+            std::copy_if(chunk->begin(),
+                         chunk->end(),
+                         std::back_inserter(pts),
+                         [&box](const value_type& pnt) {
+                             return box.IsInBox(pnt);
+                         });
+        }
+    }
+}
+
+void PagedPointKernel::getLevelOfDetail(const Base::BoundBox3f& box,
+                                        std::size_t maxPoints,
+                                        std::vector<value_type>& pts) const
+{
+    if (d->nodes.empty() || !box.Intersect(d->nodes[0].box)) {
+        return;
+    }
+
+    // Refine the cut through the octree starting with the largest nodes as long as the
+    // samples of the children still fit into the budget. Leaves contribute all their points.
+    using Item = std::pair<float, uint32_t>;
+    std::priority_queue<Item> queue;
+    queue.emplace(d->nodes[0].box.CalcDiagonalLength(), 0);
+    std::size_t total = d->nodes[0].count;
+    std::vector<uint32_t> cut;
+    while (!queue.empty()) {
+        uint32_t index = queue.top().second;
+        queue.pop();
+        const OctreeNode& node = d->nodes[index];
+        if (node.isLeaf()) {
+            cut.push_back(index);
+            continue;
+        }
+
+        std::size_t count = 0;
+        for (int32_t child : node.children) {
+            if (child > 0 && box.Intersect(d->nodes[child].box)) {
+                count += d->nodes[child].count;
+            }
+        }
+        if (total - node.count + count > maxPoints) {
+            cut.push_back(index);
+            continue;
+        }
+
+        total = total - node.count + count;
+        for (int32_t child : node.children) {
+            if (child > 0 && box.Intersect(d->nodes[child].box)) {
+                queue.emplace(d->nodes[child].box.CalcDiagonalLength(), child);
+            }
+        }
+    }
+
+    std::sort(cut.begin(), cut.end());
+    for (uint32_t index : cut) {
+        Private::Chunk chunk = d->loadChunk(index);
+        std::copy_if(chunk->begin(),
+                     chunk->end(),
+                     std::back_inserter(pts),
+                     [&box](const value_type& pnt) {
+                         return box.IsInBox(pnt);
+                     });
+    }
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef POINTS_PAGEDPOINTS_H
+#define POINTS_PAGEDPOINTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/** Point cloud that keeps its points in a local chunk file instead of memory.
+ * The points are sorted into an octree whose leaves are stored as chunks of the file. Every
+ * inner node additionally stores a spatially uniform sample of the points below it that serves
+ * as level of detail. Chunks are only read when a query touches their node and are held in a
+ * cache of limited size, so that clouds much larger than the main memory can be handled.
+ *
+ * A cloud is built by calling create(), adding the points in batches with addPoints() and
+ * calling finish(). Until then the points are spilled to a staging file next to the chunk file.
+ * An existing chunk file can be reopened with open(). The chunk file uses the native byte order
+ * and is meant as local cache, not as exchange format.
+ *
+ * Queries may be run from several threads at the same time.
+ */
+class PointsExport PagedPointKernel: public PointSource
+{
+public:
+    PagedPointKernel();
+    ~PagedPointKernel() override;
+
+    PagedPointKernel(const PagedPointKernel&) = delete;
+    PagedPointKernel(PagedPointKernel&&) = delete;
+    PagedPointKernel& operator=(const PagedPointKernel&) = delete;
+    PagedPointKernel& operator=(PagedPointKernel&&) = delete;
+
+    /** @name Building */
+    //@{
+    /// Sets the maximum number of points of a leaf, the default is 65536.
+    void setLeafCapacity(std::size_t num);
+    /// Sets the approximate number of sample points of an inner node, the default is 4096.
+    void setSampleCapacity(std::size_t num);
+    /// Starts a new cloud that will be stored in \a file.
+    void create(const std::string& file);
+    /// Adds points to the cloud. Points with NaN coordinates are skipped.
+    void addPoints(const std::vector<value_type>& pts);
+    /// Sorts the added points into the octree, writes the chunk file and opens it.
+    void finish();
+    //@}
+
+    /** @name Access */
+    //@{
+    /// Opens a chunk file that was written with finish().
+    void open(const std::string& file);
+    void close();
+    bool isOpen() const;
+    /// Sets the maximum size of the chunk cache in bytes, the default is 256 MB.
+    void setCacheSize(std::size_t bytes);
+    /// number of octree nodes
+    std::size_t countNodes() const;
+    /// number of points currently held in the chunk cache
+    std::size_t countCachedPoints() const;
+    //@}
+
+    /** @name PointSource */
+    //@{
+    std::size_t countPoints() const override;
+    Base::BoundBox3f getPointBounds() const override;
+    void getPointsInBox(const Base::BoundBox3f& box, std::vector<value_type>& pts) const override;
+    void getLevelOfDetail(const Base::BoundBox3f& box,
+                          std::size_t maxPoints,
+                          std::vector<value_type>& pts) const override;
+    //@}
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_PAGEDPOINTS_H
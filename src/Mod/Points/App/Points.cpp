@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <QtConcurrentMap>
+#include <algorithm>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <cmath>
 #include <iostream>
@@ -178,6 +179,50 @@ std::vector<PointKernel::value_type> PointKernel::getValidPoints() const
     return valid;
 }
 
+Base::BoundBox3f PointKernel::getPointBounds() const
+{
+    Base::BoundBox3f bnd;
+    for (const auto& it : _Points) {
+        if (!(boost::math::isnan(it.x) || boost::math::isnan(it.y) || boost::math::isnan(it.z))) {
+            bnd.Add(it);
+        }
+    }
+    return bnd;
+}
+
+void PointKernel::getPointsInBox(const Base::BoundBox3f& box, std::vector<value_type>& pts) const
+{
+    // NaN points always fail the test
+    std::copy_if(_Points.begin(),
+                 _Points.end(),
+                 std::back_inserter(pts),
+                 [&box](const value_type& pnt) {
+                     return box.IsInBox(pnt);
+                 });
+}
+
+void PointKernel::getLevelOfDetail(const Base::BoundBox3f& box,
+                                   std::size_t maxPoints,
+                                   std::vector<value_type>& pts) const
+{
+    auto inside = [&box](const value_type& pnt) {
+        return box.IsInBox(pnt);
+    };
+    auto count = static_cast<std::size_t>(std::count_if(_Points.begin(), _Points.end(), inside));
+    if (count == 0 || maxPoints == 0) {
+        return;
+    }
+
+    // the points of a scan are ordered along the scan lines, so a regular stride is uniform enough
+    std::size_t step = (count + maxPoints - 1) / maxPoints;
+    std::size_t index = 0;
+    for (const auto& it : _Points) {
+        if (inside(it) && (index++ % step) == 0) {
+            pts.push_back(it);
+        }
+    }
+}
+
 void PointKernel::Save(Base::Writer& writer) const
 {
     if (!writer.isForceXML()) {
@@ -29,6 +29,7 @@
 
 #include <App/ComplexGeoData.h>
 #include <App/PropertyGeo.h>
+#include <Base/BoundBox.h>
 #include <Base/Matrix.h>
 #include <Base/Reader.h>
 #include <Base/Vector3D.h>
@@ -40,9 +41,41 @@
 namespace Points
 {
 
+/** Read access to a point cloud that does not rely on all points being held in memory.
+ * Algorithms and views written against this interface work with the in-memory PointKernel as
+ * well as with the PagedPointKernel that streams its points from disk. All coordinates are in
+ * the local system of the cloud, i.e. without its placement.
+ */
+class PointsExport PointSource
+{
+public:
+    using value_type = Base::Vector3f;
+
+    PointSource() = default;
+    PointSource(const PointSource&) = default;
+    PointSource(PointSource&&) = default;
+    PointSource& operator=(const PointSource&) = default;
+    PointSource& operator=(PointSource&&) = default;
+    virtual ~PointSource() = default;
+
+    /// number of points of the cloud
+    virtual std::size_t countPoints() const = 0;
+    /// bounding box of the valid points
+    virtual Base::BoundBox3f getPointBounds() const = 0;
+    /// appends all points inside \a box to \a pts
+    virtual void getPointsInBox(const Base::BoundBox3f& box,
+                                std::vector<value_type>& pts) const = 0;
+    /** Appends a spatially uniform subset of the points inside \a box to \a pts for display.
+     * The subset has at most about \a maxPoints points.
+     */
+    virtual void getLevelOfDetail(const Base::BoundBox3f& box,
+                                  std::size_t maxPoints,
+                                  std::vector<value_type>& pts) const = 0;
+};
+
 /** Point kernel
  */
-class PointsExport PointKernel: public Data::ComplexGeoData
+class PointsExport PointKernel: public Data::ComplexGeoData, public PointSource
 {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
 
@@ -122,6 +155,19 @@ public:
     void load(std::istream&);
     //@}
 
+    /** @name PointSource */
+    //@{
+    std::size_t countPoints() const override
+    {
+        return this->_Points.size();
+    }
+    Base::BoundBox3f getPointBounds() const override;
+    void getPointsInBox(const Base::BoundBox3f& box, std::vector<value_type>& pts) const override;
+    void getLevelOfDetail(const Base::BoundBox3f& box,
+                          std::size_t maxPoints,
+                          std::vector<value_type>& pts) const override;
+    //@}
+
 private:
     Base::Matrix4D _Mtrx;
     std::vector<value_type> _Points;
@@ -25,8 +25,19 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <bit>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <sstream>
+#include <unordered_set>
+
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -34,6 +45,8 @@
 #include <boost/regex.hpp>
 #endif
 
+#include <Eigen/Core>
+
 #include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
@@ -135,6 +148,16 @@ void Reader::clear()
     normals.clear();
 }
 
+void Reader::setSubsampling(std::size_t step)
+{
+    subsampling = std::max<std::size_t>(step, 1);
+}
+
+std::size_t Reader::getSubsampling() const
+{
+    return subsampling;
+}
+
 const PointKernel& Reader::getPoints() const
 {
     return points;
@@ -246,90 +269,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -543,178 +482,545 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
-PlyReader::PlyReader() = default;
+// ----------------------------------------------------------------------------
 
-void PlyReader::read(const std::string& filename)
+namespace
 {
-    clear();
 
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
-
-    std::string format;
-    std::vector<std::string> fields;
-    std::vector<std::string> types;
-    std::vector<int> sizes;
-    std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
-
-    this->width = numPoints;
-    this->height = 1;
+/// Type and position of a field in the raw data of a point cloud
+struct FieldLayout
+{
+    char type {'F'};         // 'I' for signed, 'U' for unsigned integers and 'F' for floats
+    int size {4};            // size in bytes
+    std::size_t offset {0};  // position of the field of the first point
+    std::size_t stride {0};  // distance between the fields of two consecutive points
+};
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
+FieldLayout plyFieldLayout(const std::string& type, int size)
+{
+    FieldLayout field;
+    field.size = size;
+    if (type == "char" || type == "int8" || type == "short" || type == "int16" || type == "int"
+        || type == "int32") {
+        field.type = 'I';
     }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
+    else if (type == "uchar" || type == "uint8" || type == "ushort" || type == "uint16"
+             || type == "uint" || type == "uint32") {
+        field.type = 'U';
     }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
+    else if (type == "float" || type == "float32" || type == "double" || type == "float64") {
+        field.type = 'F';
     }
+    else {
+        throw Base::BadFormatError("Unexpected type");
+    }
+    return field;
+}
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
+FieldLayout pcdFieldLayout(const std::string& type, int size)
+{
+    FieldLayout field;
+    field.size = size;
+    field.type = type.empty() ? ' ' : type[0];
+    if (field.type != 'I' && field.type != 'U' && field.type != 'F') {
+        throw Base::BadFormatError("Unexpected type");
+    }
+    return field;
+}
 
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
+template<typename T>
+double decodeValue(const char* ptr, bool swap)
+{
+    char buf[sizeof(T)];
+    std::memcpy(buf, ptr, sizeof(T));
+    if (swap) {
+        std::reverse(buf, buf + sizeof(T));
+    }
+    T value {};
+    std::memcpy(&value, buf, sizeof(T));
+    return static_cast<double>(value);
+}
+
+double decodeField(const FieldLayout& field, const char* ptr, bool swap)
+{
+    switch (field.size) {
+        case 1:
+            return field.type == 'I' ? decodeValue<int8_t>(ptr, swap)
+                                     : decodeValue<uint8_t>(ptr, swap);
+        case 2:
+            return field.type == 'I' ? decodeValue<int16_t>(ptr, swap)
+                                     : decodeValue<uint16_t>(ptr, swap);
+        case 4:
+            if (field.type == 'F') {
+                return decodeValue<float>(ptr, swap);
+            }
+            return field.type == 'I' ? decodeValue<int32_t>(ptr, swap)
+                                     : decodeValue<uint32_t>(ptr, swap);
+        default:
+            return decodeValue<double>(ptr, swap);
     }
+}
 
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
+void checkFieldSizes(const std::vector<FieldLayout>& layout)
+{
+    for (const auto& field : layout) {
+        bool valid = field.type == 'F' ? (field.size == 4 || field.size == 8)
+                                       : (field.size == 1 || field.size == 2 || field.size == 4);
+        if (!valid) {
+            throw Base::BadFormatError("Unexpected type");
+        }
     }
+}
 
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
+/** Receives the decoded fields of the points and stores them directly in the final arrays.
+ * Every point is written to its own slot, so several threads can store points at the same time.
+ */
+class PointTarget
+{
+public:
+    enum class ColorType
+    {
+        None,
+        Channels8,
+        ChannelsFloat,
+        PackedUInt,
+        PackedFloat
+    };
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit PointTarget(const std::vector<std::string>& fields)
+        : fields(fields)
+    {
+        x = find({"x"});
+        y = find({"y"});
+        z = find({"z"});
+        nx = find({"normal_x", "nx"});
+        ny = find({"normal_y", "ny"});
+        nz = find({"normal_z", "nz"});
+        grey = find({"intensity"});
     }
 
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
+    std::size_t find(std::initializer_list<const char*> names) const
+    {
+        for (const char* name : names) {
+            auto it = std::ranges::find(fields, name);
+            if (it != fields.end()) {
+                return static_cast<std::size_t>(std::distance(fields.begin(), it));
+            }
+        }
+        return npos;
     }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
+
+    void setColor(ColorType type, std::size_t r, std::size_t g, std::size_t b, std::size_t a)
+    {
+        color = type;
+        red = r;
+        green = g;
+        blue = b;
+        alpha = a;
     }
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
+    bool hasData() const
+    {
+        return x != npos && y != npos && z != npos;
     }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
+    bool hasNormals() const
+    {
+        return nx != npos && ny != npos && nz != npos;
     }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
+    bool hasIntensity() const
+    {
+        return grey != npos;
     }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
+    bool hasColors() const
+    {
+        return color != ColorType::None;
     }
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    /// indices of the fields that must be decoded
+    std::vector<std::size_t> usedFields() const
+    {
+        std::vector<std::size_t> used {x, y, z};
+        if (hasNormals()) {
+            used.insert(used.end(), {nx, ny, nz});
+        }
+        if (hasIntensity()) {
+            used.push_back(grey);
+        }
+        if (hasColors()) {
+            for (std::size_t index : {red, green, blue, alpha}) {
+                if (index != npos) {
+                    used.push_back(index);
+                }
+            }
+        }
+        return used;
     }
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::ranges::find(fields, "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
+    void resize(std::size_t num)
+    {
+        points.resize(num);
+        if (hasNormals()) {
+            normals.resize(num);
+        }
+        if (hasIntensity()) {
+            intensity.resize(num);
+        }
+        if (hasColors()) {
+            colors.resize(num);
+        }
     }
 
-    it = std::ranges::find(fields, "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
+    /// stores the point \a index, \a values holds the fields of the point
+    void store(std::size_t index, const double* values)
+    {
+        points[index].Set(static_cast<float>(values[x]),
+                          static_cast<float>(values[y]),
+                          static_cast<float>(values[z]));
+        if (hasNormals()) {
+            normals[index].Set(static_cast<float>(values[nx]),
+                               static_cast<float>(values[ny]),
+                               static_cast<float>(values[nz]));
+        }
+        if (hasIntensity()) {
+            intensity[index] = static_cast<float>(values[grey]);
+        }
+        switch (color) {
+            case ColorType::Channels8: {
+                float a = alpha != npos ? static_cast<float>(values[alpha]) : 1.0F;
+                colors[index].set(static_cast<float>(values[red]) / 255.0F,
+                                  static_cast<float>(values[green]) / 255.0F,
+                                  static_cast<float>(values[blue]) / 255.0F,
+                                  a / 255.0F);
+            } break;
+            case ColorType::ChannelsFloat: {
+                float a = alpha != npos ? static_cast<float>(values[alpha]) : 1.0F;
+                colors[index].set(static_cast<float>(values[red]),
+                                  static_cast<float>(values[green]),
+                                  static_cast<float>(values[blue]),
+                                  a);
+            } break;
+            case ColorType::PackedUInt:
+                colors[index].setPackedARGB(static_cast<uint32_t>(values[red]));
+                break;
+            case ColorType::PackedFloat: {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                auto flt = static_cast<float>(values[red]);
+                uint32_t packed {};
+                std::memcpy(&packed, &flt, sizeof(packed));
+                colors[index].setPackedARGB(packed);
+            } break;
+            default:
+                break;
+        }
     }
 
-    it = std::ranges::find(fields, "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
+    // NOLINTBEGIN
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> intensity;
+    std::vector<Base::Color> colors;
+    // NOLINTEND
+
+private:
+    const std::vector<std::string>& fields;
+    std::size_t x {npos}, y {npos}, z {npos};
+    std::size_t nx {npos}, ny {npos}, nz {npos};
+    std::size_t grey {npos};
+    std::size_t red {npos}, green {npos}, blue {npos}, alpha {npos};
+    ColorType color {ColorType::None};
+};
+
+/** Decodes the points of the cloud and stores them in the target on several threads.
+ * The raw data is read in chunks of bounded size so that no intermediate copy of the whole cloud
+ * is needed. Only every \a step-th point is kept.
+ */
+class RecordDecoder
+{
+public:
+    RecordDecoder(PointTarget& target, std::size_t numPoints, std::size_t step)
+        : target(target)
+        , numPoints(numPoints)
+        , step(std::max<std::size_t>(step, 1))
+        , used(target.usedFields())
+    {
+        target.resize((numPoints + this->step - 1) / this->step);
     }
 
-    it = std::ranges::find(fields, "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
+    /// Decodes \a count points starting with point \a first from the raw data \a data.
+    void decodeBinary(const char* data,
+                      std::size_t first,
+                      std::size_t count,
+                      const std::vector<FieldLayout>& layout,
+                      bool swap)
+    {
+        checkFieldSizes(layout);
+        std::vector<Block> blocks;
+        for (std::size_t pos = 0; pos < count; pos += BlockSize) {
+            blocks.push_back({pos, std::min(count, pos + BlockSize)});
+        }
+
+        QtConcurrent::blockingMap(blocks, [&](const Block& block) {
+            std::vector<double> values(layout.size(), 0.0);
+            for (std::size_t i = block.begin; i < block.end; i++) {
+                std::size_t index = first + i;
+                if (index % step != 0) {
+                    continue;
+                }
+                for (std::size_t field : used) {
+                    const FieldLayout& info = layout[field];
+                    values[field] = decodeField(info, data + info.offset + i * info.stride, swap);
+                }
+                target.store(index / step, values.data());
+            }
+        });
     }
 
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    /// Reads interleaved binary records from the stream.
+    void readBinary(std::istream& inp, std::vector<FieldLayout> layout, bool swap)
+    {
+        std::size_t recordSize = 0;
+        for (auto& field : layout) {
+            field.offset = recordSize;
+            recordSize += static_cast<std::size_t>(field.size);
+        }
+        for (auto& field : layout) {
+            field.stride = recordSize;
+        }
+        if (recordSize == 0) {
+            return;
+        }
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+        std::streambuf* buf = inp.rdbuf();
+        if (buf) {
+            std::streamoff curr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+            std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
+            buf->pubseekoff(curr, std::ios::beg, std::ios::in);
+            if (curr + static_cast<std::streamoff>(recordSize * numPoints) > size) {
+                throw Base::BadFormatError("File expects too many elements");
+            }
+        }
+
+        std::vector<char> chunk;
+        const std::size_t chunkPoints = std::max<std::size_t>(ChunkBytes / recordSize, 1);
+        for (std::size_t first = 0; first < numPoints; first += chunkPoints) {
+            std::size_t count = std::min(chunkPoints, numPoints - first);
+            chunk.resize(count * recordSize);
+            inp.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            if (!inp) {
+                throw Base::BadFormatError("File expects too many elements");
+            }
+            decodeBinary(chunk.data(), first, count, layout, swap);
         }
     }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+    /// Reads one point per line from the stream, the first \a skipLines lines are ignored.
+    void readAscii(std::istream& inp, std::size_t numFields, std::size_t skipLines)
+    {
+        struct TextBlock
+        {
+            const char* begin;
+            const char* end;
+            std::size_t lines;
+            std::size_t first;
+            bool failed;
+        };
+
+        std::vector<char> chunk;
+        std::size_t line = 0;
+        std::size_t numLines = numPoints + skipLines;
+        bool eof = false;
+        while (!eof && line < numLines) {
+            // append the next chunk to the incomplete line of the previous one
+            std::size_t keep = chunk.size();
+            chunk.resize(keep + ChunkBytes);
+            inp.read(chunk.data() + keep, static_cast<std::streamsize>(ChunkBytes));
+            chunk.resize(keep + static_cast<std::size_t>(inp.gcount()));
+            eof = !inp;
+
+            std::size_t end = chunk.size();
+            if (!eof) {
+                while (end > 0 && chunk[end - 1] != '\n') {
+                    end--;
+                }
+                if (end == 0) {
+                    continue;  // no complete line yet
+                }
+            }
+
+            // split the text at line ends and count the non-empty lines of each block
+            chunk.push_back('\0');
+            std::vector<TextBlock> blocks;
+            const char* text = chunk.data();
+            for (std::size_t pos = 0; pos < end;) {
+                std::size_t next = std::min(end, pos + TextBlockSize);
+                while (next < end && text[next - 1] != '\n') {
+                    next++;
+                }
+                blocks.push_back({text + pos, text + next, 0, 0, false});
+                pos = next;
+            }
+            QtConcurrent::blockingMap(blocks, [](TextBlock& block) {
+                forEachLine(block.begin, block.end, [&block](const char*, const char*) {
+                    block.lines++;
+                });
+            });
+            for (auto& block : blocks) {
+                block.first = line;
+                line += block.lines;
+            }
+
+            QtConcurrent::blockingMap(blocks, [&](TextBlock& block) {
+                std::vector<double> values(numFields, 0.0);
+                std::size_t index = block.first;
+                forEachLine(block.begin, block.end, [&](const char* pos, const char* stop) {
+                    bool inRange = index >= skipLines && index < numLines;
+                    if (inRange && (index - skipLines) % step == 0) {
+                        if (!parseLine(pos, stop, values)) {
+                            block.failed = true;
+                        }
+                        target.store((index - skipLines) / step, values.data());
+                    }
+                    index++;
+                });
+            });
+            if (std::ranges::any_of(blocks, [](const TextBlock& block) {
+                    return block.failed;
+                })) {
+                throw Base::BadFormatError("Invalid number in point data");
+            }
+
+            chunk.erase(chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(end));
+            chunk.pop_back();
         }
     }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+private:
+    struct Block
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    static bool isBlank(char ch)
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r';
+    }
+
+    /// calls \a func with begin and end of each line that is not blank
+    template<typename Func>
+    static void forEachLine(const char* pos, const char* end, Func&& func)
+    {
+        while (pos < end) {
+            const char* stop = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+            if (!stop) {
+                stop = end;
+            }
+            const char* first = pos;
+            while (first < stop && isBlank(*first)) {
+                first++;
+            }
+            if (first < stop) {
+                func(first, stop);
+            }
+            pos = stop + 1;
         }
     }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
+    /// parses the numbers of a line, missing numbers are set to zero
+    static bool parseLine(const char* pos, const char* stop, std::vector<double>& values)
+    {
+        bool ok = true;
+        for (double& value : values) {
+            while (pos < stop && isBlank(*pos)) {
+                pos++;
+            }
+            if (pos >= stop) {
+                value = 0.0;
+                continue;
             }
+            char* next = nullptr;
+            value = std::strtod(pos, &next);
+            if (next == pos) {
+                ok = false;
+                break;
+            }
+            pos = next;
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
+        return ok;
+    }
+
+    static constexpr std::size_t BlockSize = 65536;
+    static constexpr std::size_t TextBlockSize = 1 << 20;
+    static constexpr std::size_t ChunkBytes = 1 << 26;
+
+    PointTarget& target;
+    std::size_t numPoints;
+    std::size_t step;
+    std::vector<std::size_t> used;
+};
+
+}  // namespace
+
+PlyReader::PlyReader() = default;
+
+void PlyReader::read(const std::string& filename)
+{
+    clear();
+
+    Base::FileInfo fi(filename);
+    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+
+    std::string format;
+    std::vector<std::string> fields;
+    std::vector<std::string> types;
+    std::vector<int> sizes;
+    std::size_t offset = 0;
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
+
+    PointTarget target(fields);
+
+    // rgb(a) field
+    std::size_t red = target.find({"red"});
+    std::size_t green = target.find({"green"});
+    std::size_t blue = target.find({"blue"});
+    std::size_t alpha = target.find({"alpha"});
+    if (red != PointTarget::npos && green != PointTarget::npos && blue != PointTarget::npos) {
+        if (types[red] == "uchar" || types[red] == "uint8") {
+            target.setColor(PointTarget::ColorType::Channels8, red, green, blue, alpha);
+        }
+        else if (types[red] == "float" || types[red] == "float32") {
+            target.setColor(PointTarget::ColorType::ChannelsFloat, red, green, blue, alpha);
+        }
+    }
+
+    // transfer the data
+    if (target.hasData()) {
+        RecordDecoder decoder(target, numPoints, subsampling);
+        if (format == "ascii") {
+            decoder.readAscii(inp, fields.size(), offset);
+        }
+        else {
+            std::vector<FieldLayout> layout;
+            for (std::size_t i = 0; i < fields.size(); i++) {
+                layout.push_back(plyFieldLayout(types[i], sizes[i]));
             }
+
+            bool bigEndian = (format == "binary_big_endian");
+            inp.seekg(static_cast<std::streamoff>(offset), std::ios::cur);
+            bool swap = bigEndian != (std::endian::native == std::endian::big);
+            decoder.readBinary(inp, layout, swap);
         }
     }
+
+    points.swap(target.points);
+    normals.swap(target.normals);
+    intensity.swap(target.intensity);
+    colors.swap(target.colors);
+
+    this->width = static_cast<int>(subsampling > 1 ? points.size() : numPoints);
+    this->height = 1;
 }
 
 std::size_t PlyReader::readHeader(std::istream& in,
@@ -887,136 +1193,6 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1034,156 +1210,82 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
+    PointTarget target(fields);
 
     // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::ranges::find(fields, "rgb");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
+    std::size_t rgba = target.find({"rgb", "rgba"});
+    if (rgba != PointTarget::npos) {
+        if (types[rgba] == "U") {
+            target.setColor(PointTarget::ColorType::PackedUInt,
+                            rgba,
+                            PointTarget::npos,
+                            PointTarget::npos,
+                            PointTarget::npos);
+        }
+        else if (types[rgba] == "F") {
+            target.setColor(PointTarget::ColorType::PackedFloat,
+                            rgba,
+                            PointTarget::npos,
+                            PointTarget::npos,
+                            PointTarget::npos);
+        }
     }
 
     // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    if (target.hasData()) {
+        RecordDecoder decoder(target, numPoints, subsampling);
+        std::vector<FieldLayout> layout;
+        if (format != "ascii") {
+            for (std::size_t i = 0; i < fields.size(); i++) {
+                layout.push_back(pcdFieldLayout(types[i], sizes[i]));
+            }
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        if (format == "ascii") {
+            decoder.readAscii(inp, fields.size(), 0);
         }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        else if (format == "binary") {
+            decoder.readBinary(inp, layout, false);
         }
-    }
+        else if (format == "binary_compressed") {
+            unsigned int c {};
+            unsigned int u {};
+            Base::InputStream str(inp);
+            str >> c >> u;
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+            std::vector<char> compressed(c);
+            inp.read(compressed.data(), c);
+            std::vector<char> uncompressed(u);
+            if (!inp || lzfDecompress(compressed.data(), c, uncompressed.data(), u) != u) {
+                throw Base::BadFormatError("Failed to decompress binary data");
             }
-        }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+            compressed.clear();
+
+            // the fields are stored one after the other
+            std::size_t offset = 0;
+            for (auto& field : layout) {
+                field.offset = offset;
+                field.stride = static_cast<std::size_t>(field.size);
+                offset += field.stride * numPoints;
             }
+            if (offset > uncompressed.size()) {
+                throw Base::BadFormatError("File expects too many elements");
+            }
+            decoder.decodeBinary(uncompressed.data(), 0, numPoints, layout, false);
         }
     }
+
+    points.swap(target.points);
+    normals.swap(target.normals);
+    intensity.swap(target.intensity);
+    colors.swap(target.colors);
+
+    if (subsampling > 1) {
+        this->width = static_cast<int>(points.size());
+        this->height = 1;
+    }
 }
 
 std::size_t PcdReader::readHeader(std::istream& in,
@@ -1257,197 +1359,104 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
 {
-class E57ReaderImp
+struct E57Settings
+{
+    bool useColor;
+    bool checkState;
+    double minDistance;
+    double voxelSize;
+};
+
+/** Keeps only the first point that falls into a cell of a regular grid.
+ * Only the occupied cells are stored, so the memory grows with the number of accepted points.
+ */
+class VoxelFilter
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
-        : imfi(filename, "r")
-        , useColor {color}
-        , checkState {state}
-        , minDistance {distance}
+    explicit VoxelFilter(double size)
+        : size {size}
     {}
 
-    void read()
+    bool isActive() const
     {
-        e57::StructureNode root = imfi.root();
-        if (root.isDefined("data3D")) {
-            e57::VectorNode data3D(root.get("data3D"));
-            readData3D(data3D);
-        }
+        return size > 0.0;
     }
 
-    std::vector<Base::Color> getColors() const
+    /// returns true if \a pt is the first point of its cell
+    bool insert(const Base::Vector3d& pt)
     {
-        return colors;
+        return cells.insert({cell(pt.x), cell(pt.y), cell(pt.z)}).second;
     }
 
-    std::vector<float> getItensity() const
+private:
+    struct Key
     {
-        return intensity;
-    }
-
-    const PointKernel& getPoints() const
+        int64_t x, y, z;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash
     {
-        return points;
-    }
+        std::size_t operator()(const Key& key) const
+        {
+            auto hash = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ULL;
+            hash ^= static_cast<uint64_t>(key.y) * 0xC2B2AE3D27D4EB4FULL + (hash >> 29);
+            hash ^= static_cast<uint64_t>(key.z) * 0x165667B19E3779F9ULL + (hash >> 32);
+            return static_cast<std::size_t>(hash);
+        }
+    };
 
-    const std::vector<Base::Vector3f>& getNormals() const
+    int64_t cell(double value) const
     {
-        return normals;
+        return static_cast<int64_t>(std::floor(value / size));
     }
 
-private:
-    void readData3D(const e57::VectorNode& data3D)
+    double size;
+    std::unordered_set<Key, KeyHash> cells;
+};
+
+/// The accepted points of a single scan
+struct E57Scan
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<Base::Color> colors;
+    std::vector<float> intensity;
+    std::vector<Base::Vector3f> normals;
+};
+
+/** Reads a single scan of an E57 file.
+ * Several readers can run at the same time as long as each of them works on its own image file.
+ */
+class E57ScanReader
+{
+public:
+    E57ScanReader(e57::ImageFile& imfi, const E57Settings& settings)
+        : imfi(imfi)
+        , useColor {settings.useColor}
+        , checkState {settings.checkState}
+        , minDistance {settings.minDistance}
+        , voxelSize {settings.voxelSize}
+    {}
+
+    E57Scan read(const e57::StructureNode& scan_data)
     {
-        for (int child = 0; child < data3D.childCount(); ++child) {
-            e57::StructureNode scan_data(data3D.get(child));
-            Base::Placement plm;
-            bool hasPlacement = getPlacement(scan_data, plm);
+        Base::Placement plm;
+        bool hasPlacement = getPlacement(scan_data, plm);
 
-            e57::CompressedVectorNode cvn(scan_data.get("points"));
-            e57::StructureNode prototype(cvn.prototype());
-            Proto proto = readProto(prototype);
-            processProto(cvn, proto, hasPlacement, plm);
-        }
+        e57::CompressedVectorNode cvn(scan_data.get("points"));
+        e57::StructureNode prototype(cvn.prototype());
+        Proto proto = readProto(prototype);
+
+        E57Scan scan;
+        processProto(cvn, proto, hasPlacement, plm, scan);
+        return scan;
     }
 
+private:
+
     struct Proto
     {
         bool inty = false;
@@ -1628,9 +1637,10 @@ private:
     }
 
     void processProto(e57::CompressedVectorNode& cvn,
-                      const Proto& proto,
+                      Proto& proto,
                       bool hasPlacement,
-                      const Base::Placement& plm)
+                      const Base::Placement& plm,
+                      E57Scan& scan)
     {
         if (proto.cnt_xyz != 3) {
             throw Base::BadFormatError("Missing channels xyz");
@@ -1644,8 +1654,17 @@ private:
         bool hasNormal = (proto.cnt_nor == 3);
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
+        Base::Matrix4D mat = plm.toMatrix();
+        VoxelFilter voxel(voxelSize);
 
         while ((count = cvr.read())) {
+            if (hasPlacement) {
+                transform(mat, proto.xData, proto.yData, proto.zData, count, true);
+                if (hasNormal) {
+                    transform(mat, proto.xNormal, proto.yNormal, proto.zNormal, count, false);
+                }
+            }
+
             for (size_t i = 0; i < count; ++i) {
                 filter = false;
                 if (hasState) {
@@ -1654,55 +1673,67 @@ private:
                     }
                 }
 
-                pt = getCoord(proto, i, hasPlacement, plm);
+                pt.Set(proto.xData[i], proto.yData[i], proto.zData[i]);
 
                 if ((!filter) && (cnt_pts > 0)) {
                     if (Base::Distance(last, pt) < minDistance) {
                         filter = true;
                     }
                 }
+                if ((!filter) && voxel.isActive()) {
+                    filter = !voxel.insert(pt);
+                }
                 if (!filter) {
                     cnt_pts++;
-                    points.push_back(pt);
+                    scan.points.push_back(pt);
                     last = pt;
                     if (hasColor) {
-                        colors.push_back(getColor(proto, i));
+                        scan.colors.push_back(getColor(proto, i));
                     }
                     if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
+                        scan.intensity.push_back(static_cast<float>(proto.intensity[i]));
                     }
                     if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
+                        scan.normals.push_back(getNormal(proto, i));
                     }
                 }
             }
         }
     }
 
-    Base::Vector3d
-    getCoord(const Proto& proto, size_t index, bool hasPlacement, const Base::Placement& plm) const
+    /// Applies the pose to a block of coordinates, the loop has no dependencies between the
+    /// points so that the compiler can vectorize it.
+    static void transform(const Base::Matrix4D& mat,
+                          std::vector<double>& xs,
+                          std::vector<double>& ys,
+                          std::vector<double>& zs,
+                          size_t count,
+                          bool translate)
     {
-        Base::Vector3d pt;
-        pt.x = proto.xData[index];
-        pt.y = proto.yData[index];
-        pt.z = proto.zData[index];
-        if (hasPlacement) {
-            plm.multVec(pt, pt);
-        }
-        return pt;
-    }
-
-    Base::Vector3f
-    getNormal(const Proto& proto, size_t index, bool hasPlacement, const Base::Rotation& rot) const
+        const double m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2];
+        const double m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2];
+        const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2];
+        const double tx = translate ? mat[0][3] : 0.0;
+        const double ty = translate ? mat[1][3] : 0.0;
+        const double tz = translate ? mat[2][3] : 0.0;
+        double* px = xs.data();
+        double* py = ys.data();
+        double* pz = zs.data();
+        for (size_t i = 0; i < count; ++i) {
+            const double x = px[i];
+            const double y = py[i];
+            const double z = pz[i];
+            px[i] = m00 * x + m01 * y + m02 * z + tx;
+            py[i] = m10 * x + m11 * y + m12 * z + ty;
+            pz[i] = m20 * x + m21 * y + m22 * z + tz;
+        }
+    }
+
+    Base::Vector3f getNormal(const Proto& proto, size_t index) const
     {
-        Base::Vector3f pt;
-        pt.x = proto.xNormal[index];
-        pt.y = proto.yNormal[index];
-        pt.z = proto.zNormal[index];
-        if (hasPlacement) {
-            rot.multVec(pt, pt);
-        }
-        return pt;
+        return Base::Vector3f(static_cast<float>(proto.xNormal[index]),
+                              static_cast<float>(proto.yNormal[index]),
+                              static_cast<float>(proto.zNormal[index]));
     }
 
     Base::Color getColor(const Proto& proto, size_t index) const
@@ -1764,11 +1795,200 @@ private:
     }
 
 private:
-    e57::ImageFile imfi;
+    e57::ImageFile& imfi;
     bool useColor;
     bool checkState;
     double minDistance;
+    double voxelSize;
     const size_t buf_size = 1024;
+};
+
+/** Reads the scans of an E57 file on several threads.
+ * libE57Format doesn't allow to share an image file between threads, therefore each worker
+ * reads its scans through its own handle of the file. The scans are appended in file order so
+ * that the result doesn't depend on the scheduling of the threads. A scan is appended as soon
+ * as the scans before it are, so that only the scans that are out of order are held twice.
+ */
+class E57ReaderImp
+{
+public:
+    E57ReaderImp(const std::string& filename, const E57Settings& settings)
+        : filename(filename)
+        , settings(settings)
+        , voxel(settings.voxelSize)
+    {}
+
+    void read()
+    {
+        // the XML parser of libE57Format isn't thread-safe, so all handles are opened here
+        files.push_back(std::make_unique<e57::ImageFile>(filename, "r"));
+        e57::StructureNode root = files.front()->root();
+        if (!root.isDefined("data3D")) {
+            return;
+        }
+
+        e57::VectorNode data3D(root.get("data3D"));
+        std::vector<int> children(data3D.childCount());
+        std::iota(children.begin(), children.end(), 0);
+        std::size_t numFiles = std::min<std::size_t>(children.size(),
+                                                     std::max(QThread::idealThreadCount(), 1));
+        while (files.size() < numFiles) {
+            files.push_back(std::make_unique<e57::ImageFile>(filename, "r"));
+        }
+        for (const auto& file : files) {
+            idle.push_back(file.get());
+        }
+
+        // the number of records is an upper bound of the number of points, with decimation it
+        // may be far too large and the arrays grow with the accepted points instead
+        if (!isDecimating()) {
+            for (int child : children) {
+                e57::StructureNode scan(data3D.get(child));
+                auto records = e57::CompressedVectorNode(scan.get("points")).childCount();
+                maxPoints += static_cast<std::size_t>(records);
+            }
+            points.reserve(maxPoints);
+        }
+
+        // blockingMap also runs items on the calling thread, so there may be more scans
+        // read at the same time than there are image files
+        scans.resize(children.size());
+        finished.resize(children.size(), false);
+        QtConcurrent::blockingMap(children, [&](int child) {
+            readScan(child);
+        });
+        for (const auto& file : files) {
+            file->close();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    PointKernel& getPoints()
+    {
+        return points;
+    }
+
+    std::vector<Base::Color>& getColors()
+    {
+        return colors;
+    }
+
+    std::vector<float>& getItensity()
+    {
+        return intensity;
+    }
+
+    std::vector<Base::Vector3f>& getNormals()
+    {
+        return normals;
+    }
+
+private:
+    bool isDecimating() const
+    {
+        return settings.minDistance > 0.0 || settings.voxelSize > 0.0;
+    }
+
+    void readScan(int child)
+    {
+        E57Scan scan;
+        e57::ImageFile* file = acquireFile();
+        try {
+            e57::VectorNode data3D(file->root().get("data3D"));
+            E57ScanReader reader(*file, settings);
+            scan = reader.read(e57::StructureNode(data3D.get(child)));
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        releaseFile(file);
+        finishScan(child, std::move(scan));
+    }
+
+    e57::ImageFile* acquireFile()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [this] {
+            return !idle.empty();
+        });
+        e57::ImageFile* file = idle.back();
+        idle.pop_back();
+        return file;
+    }
+
+    void releaseFile(e57::ImageFile* file)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            idle.push_back(file);
+        }
+        available.notify_one();
+    }
+
+    void finishScan(int child, E57Scan&& scan)
+    {
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        scans[child] = std::move(scan);
+        finished[child] = true;
+        while (nextScan < scans.size() && finished[nextScan]) {
+            append(scans[nextScan]);
+            scans[nextScan] = E57Scan();
+            ++nextScan;
+        }
+    }
+
+    void append(const E57Scan& scan)
+    {
+        bool hasColor = scan.colors.size() == scan.points.size();
+        bool hasIntensity = scan.intensity.size() == scan.points.size();
+        bool hasNormal = scan.normals.size() == scan.points.size();
+        if (hasColor && colors.capacity() == 0) {
+            colors.reserve(maxPoints);
+        }
+        if (hasIntensity && intensity.capacity() == 0) {
+            intensity.reserve(maxPoints);
+        }
+        if (hasNormal && normals.capacity() == 0) {
+            normals.reserve(maxPoints);
+        }
+
+        // points of different scans may share a cell, so the filter is applied once more
+        for (std::size_t i = 0; i < scan.points.size(); ++i) {
+            if (voxel.isActive() && !voxel.insert(scan.points[i])) {
+                continue;
+            }
+            points.push_back(scan.points[i]);
+            if (hasColor) {
+                colors.push_back(scan.colors[i]);
+            }
+            if (hasIntensity) {
+                intensity.push_back(scan.intensity[i]);
+            }
+            if (hasNormal) {
+                normals.push_back(scan.normals[i]);
+            }
+        }
+    }
+
+private:
+    std::string filename;
+    E57Settings settings;
+    std::vector<std::unique_ptr<e57::ImageFile>> files;
+    std::vector<e57::ImageFile*> idle;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::exception_ptr error;
+    std::mutex mergeMutex;
+    std::vector<E57Scan> scans;
+    std::vector<bool> finished;
+    std::size_t nextScan = 0;
+    std::size_t maxPoints = 0;
+    VoxelFilter voxel;
     std::vector<Base::Color> colors;
     std::vector<float> intensity;
     PointKernel points;
@@ -1782,15 +2002,20 @@ E57Reader::E57Reader(bool Color, bool State, double Distance)
     , minDistance {Distance}
 {}
 
+void E57Reader::setVoxelSize(double size)
+{
+    voxelSize = size;
+}
+
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        E57ReaderImp reader(filename, {useColor, checkState, minDistance, voxelSize});
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
+        points = std::move(reader.getPoints());
+        normals = std::move(reader.getNormals());
+        colors = std::move(reader.getColors());
+        intensity = std::move(reader.getItensity());
         width = points.size();
         height = 1;
     }
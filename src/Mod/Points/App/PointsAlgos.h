@@ -23,8 +23,6 @@
 #ifndef _PointsAlgos_h_
 #define _PointsAlgos_h_
 
-#include <Eigen/Core>
-
 #include "Points.h"
 #include "Properties.h"
 
@@ -53,6 +51,9 @@ public:
     virtual void read(const std::string& filename) = 0;
 
     void clear();
+    /// Keep only every \a step-th point, this is supported by the PLY and PCD readers.
+    void setSubsampling(std::size_t step);
+    std::size_t getSubsampling() const;
     const PointKernel& getPoints() const;
     bool hasProperties() const;
     const std::vector<float>& getIntensities() const;
@@ -78,6 +79,7 @@ protected:
     std::vector<Base::Vector3f> normals;
     int width {0};
     int height {1};
+    std::size_t subsampling {1};
     // NOLINTEND
 };
 
@@ -101,13 +103,6 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder,
-                    std::istream&,
-                    std::size_t offset,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport PcdReader: public Reader
@@ -122,23 +117,20 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose,
-                    std::istream&,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport E57Reader: public Reader
 {
 public:
     E57Reader(bool Color, bool State, double Distance);
+    /// Keep only one point per cube of edge length \a size, a value <= 0 disables the filter.
+    void setVoxelSize(double size);
     void read(const std::string& filename) override;
 
 protected:
     bool useColor, checkState;
     double minDistance;
+    double voxelSize {-1.0};
 };
 
 class PointsExport Writer
@@ -53,6 +53,11 @@ App::DocumentObjectExecReturn* Feature::execute()
     return App::DocumentObject::StdReturn;
 }
 
+const PointSource& Feature::getPointSource() const
+{
+    return Points.getValue();
+}
+
 void Feature::Restore(Base::XMLReader& reader)
 {
     GeoFeature::Restore(reader);
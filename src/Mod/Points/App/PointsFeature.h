@@ -75,6 +75,11 @@ public:
     {
         return &Points;
     }
+    /** Returns the points to be queried by algorithms that don't need all of them in memory.
+     * The coordinates are in the local system, i.e. the placement has to be applied. By
+     * default this is the point kernel.
+     */
+    virtual const PointSource& getPointSource() const;
 
 protected:
     void onChanged(const App::Property* prop) override;
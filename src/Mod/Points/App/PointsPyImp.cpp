@@ -30,6 +30,7 @@
 #include <Base/GeometryPyCXX.h>
 #include <Base/VectorPy.h>
 
+#include "KDTree.h"
 #include "Points.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
@@ -38,6 +39,29 @@
 
 using namespace Points;
 
+namespace
+{
+std::vector<Base::Vector3f> toVectors(const Py::Sequence& list)
+{
+    std::vector<Base::Vector3f> pts;
+    pts.reserve(list.size());
+    Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        if ((*it).isType(vType)) {
+            Py::Vector p(*it);
+            pts.push_back(Base::convertTo<Base::Vector3f>(p.toVector()));
+        }
+        else {
+            Py::Tuple tuple(*it);
+            pts.emplace_back(static_cast<float>(double(Py::Float(tuple[0]))),
+                             static_cast<float>(double(Py::Float(tuple[1]))),
+                             static_cast<float>(double(Py::Float(tuple[2]))));
+        }
+    }
+    return pts;
+}
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation() const
 {
@@ -242,6 +266,83 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::nearestNeighbours(PyObject* args) const
+{
+    PyObject* obj {};
+    int k = 1;
+    if (!PyArg_ParseTuple(args, "O|i", &obj, &k)) {
+        return nullptr;
+    }
+    if (k < 1) {
+        PyErr_SetString(PyExc_ValueError, "k must be positive");
+        return nullptr;
+    }
+
+    std::vector<Base::Vector3f> pts;
+    try {
+        pts = toVectors(Py::Sequence(obj));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+
+    auto num = static_cast<std::size_t>(k);
+    PointsKDTree tree(*getPointKernelPtr());
+    std::vector<PointsKDTree::size_type> indices;
+    tree.findNearest(pts, num, indices);
+
+    Py::List result;
+    for (std::size_t i = 0; i < pts.size(); i++) {
+        Py::List neighbours;
+        for (std::size_t j = i * num; j < (i + 1) * num; j++) {
+            if (indices[j] != PointsKDTree::npos) {
+                neighbours.append(Py::Long(static_cast<unsigned long>(indices[j])));
+            }
+        }
+        result.append(neighbours);
+    }
+    return Py::new_reference_to(result);
+}
+
+PyObject* PointsPy::pointsInRadius(PyObject* args) const
+{
+    PyObject* obj {};
+    double radius {};
+    if (!PyArg_ParseTuple(args, "Od", &obj, &radius)) {
+        return nullptr;
+    }
+
+    std::vector<Base::Vector3f> pts;
+    try {
+        pts = toVectors(Py::Sequence(obj));
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(PyExc_TypeError,
+                        "either expect\n"
+                        "-- [Vector,...] \n"
+                        "-- [(x,y,z),...]");
+        return nullptr;
+    }
+
+    PointsKDTree tree(*getPointKernelPtr());
+    std::vector<std::vector<PointsKDTree::size_type>> indices;
+    tree.findInRadius(pts, static_cast<float>(radius), indices);
+
+    Py::List result;
+    for (const auto& it : indices) {
+        Py::List neighbours;
+        for (auto index : it) {
+            neighbours.append(Py::Long(static_cast<unsigned long>(index)));
+        }
+        result.append(neighbours);
+    }
+    return Py::new_reference_to(result);
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
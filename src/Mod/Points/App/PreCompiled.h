@@ -40,8 +40,10 @@
 // STL
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <vector>
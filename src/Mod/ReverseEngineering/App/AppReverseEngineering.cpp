@@ -31,6 +31,8 @@
 #include <Base/GeometryPyCXX.h>
 #include <Base/Interpreter.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/Tools.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/Part/App/BSplineSurfacePy.h>
 #include <Mod/Points/App/PointsPy.h>
@@ -124,6 +126,7 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
@@ -142,20 +145,29 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
-#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
-            "regionGrowingSegmentation()."
+            "regionGrowingSegmentation(Points,[KSearch=5, Normals])."
         );
+#if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("featureSegmentation",&Module::featureSegmentation,
             "featureSegmentation()."
         );
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
         add_keyword_method("sampleConsensus",&Module::sampleConsensus,
-            "sampleConsensus()."
+            "sampleConsensus(SacModel,Points,[Normals, DistanceThreshold=0.01]) -> dict\n"
+            "SacModel is one of 'Plane', 'Sphere', 'Cylinder' or 'Cone'."
+        );
+        add_keyword_method("detectShapes",&Module::detectShapes,
+            "detectShapes(Points|Mesh,[Normals, Models, DistanceThreshold=0.01, Angle=20,\n"
+            "             MinSupport=0, ClusterEpsilon=0, Probability=0.99]) -> list\n"
+            "Extracts planes, spheres, cylinders and cones with an efficient RANSAC.\n"
+            "For a mesh the facets are segmented, for points without normals the\n"
+            "normals are estimated from the ten nearest neighbours. Models is a list\n"
+            "of 'Plane', 'Sphere', 'Cylinder' and 'Cone', Angle is the maximum\n"
+            "deviation of the normals in degree and MinSupport the minimum number of\n"
+            "elements of a shape (by default 1%). Each shape is a dict with the keys\n"
+            "'Type', 'Parameters' and 'Model' as of sampleConsensus()."
         );
-#endif
         initialize("This module is the ReverseEngineering module."); // register with Python
     }
 
@@ -793,7 +805,6 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -821,8 +832,6 @@ Mesh.show(m)
 
         return list;
     }
-#endif
-#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -864,6 +873,7 @@ Mesh.show(m)
 
         return lists;
     }
+#if defined(HAVE_PCL_SEGMENTATION)
     Py::Object featureSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -892,7 +902,6 @@ Mesh.show(m)
         return lists;
     }
 #endif
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
 /*
 import ReverseEngineering as reen
 import Points
@@ -929,10 +938,13 @@ Points.show(np)
         PyObject *pts;
         PyObject *vec = nullptr;
         const char* sacModelType = nullptr;
+        double distance = 0.01;
 
-        static const std::array<const char*,4> kwds_sample {"SacModel", "Points", "Normals", NULL};
-        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "sO!|O", kwds_sample,
-                                        &sacModelType, &(Points::PointsPy::Type), &pts, &vec))
+        static const std::array<const char*,5> kwds_sample {"SacModel", "Points", "Normals",
+                                                            "DistanceThreshold", NULL};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "sO!|Od", kwds_sample,
+                                        &sacModelType, &(Points::PointsPy::Type), &pts, &vec,
+                                        &distance))
             throw Py::Exception();
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
@@ -958,6 +970,7 @@ Points.show(np)
 
         std::vector<float> parameters;
         SampleConsensus sample(sacModel, *points, normals);
+        sample.setDistanceThreshold(distance);
         std::vector<int> model;
         double probability = sample.perform(parameters, model);
 
@@ -974,7 +987,109 @@ Points.show(np)
 
         return dict;
     }
-#endif
+    Py::Object detectShapes(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *obj;
+        PyObject *vec = nullptr;
+        PyObject *types = nullptr;
+        double distance = 0.01;
+        double angle = 20.0;
+        int minSupport = 0;
+        double epsilon = 0.0;
+        double probability = 0.99;
+
+        static const std::array<const char*,9> kwds_detect {"Object", "Normals", "Models",
+            "DistanceThreshold", "Angle", "MinSupport", "ClusterEpsilon", "Probability", NULL};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O|OOddidd", kwds_detect,
+                                        &obj, &vec, &types, &distance, &angle, &minSupport,
+                                        &epsilon, &probability))
+            throw Py::Exception();
+
+        std::vector<Base::Vector3d> points;
+        std::vector<Base::Vector3d> normals;
+        if (PyObject_TypeCheck(obj, &(Points::PointsPy::Type))) {
+            const Points::PointKernel* kernel =
+                static_cast<Points::PointsPy*>(obj)->getPointKernelPtr();
+            points.reserve(kernel->size());
+            for (std::size_t i = 0; i < kernel->size(); i++) {
+                points.push_back(kernel->getPoint(i));
+            }
+            if (vec) {
+                Py::Sequence list(vec);
+                normals.reserve(list.size());
+                for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                    normals.push_back(Py::Vector(*it).toVector());
+                }
+            }
+            else {
+                NormalEstimation estimate(*kernel);
+                estimate.setKSearch(10);
+                estimate.perform(normals);
+            }
+        }
+        else if (PyObject_TypeCheck(obj, &(Mesh::MeshPy::Type))) {
+            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(obj)->getMeshObjectPtr();
+            MeshCore::MeshFacetIterator it(mesh->getKernel());
+            it.Transform(mesh->getTransform());
+            for (it.Init(); it.More(); it.Next()) {
+                points.push_back(Base::convertTo<Base::Vector3d>(it->GetGravityPoint()));
+                normals.push_back(Base::convertTo<Base::Vector3d>(it->GetNormal()));
+            }
+        }
+        else {
+            throw Py::TypeError("Points or mesh object expected");
+        }
+
+        ShapeDetection detect(points, normals);
+        if (types) {
+            std::vector<SampleConsensus::SacModel> models;
+            Py::Sequence list(types);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                std::string name = Py::String(*it);
+                if (name == "Plane")
+                    models.push_back(SampleConsensus::SACMODEL_PLANE);
+                else if (name == "Sphere")
+                    models.push_back(SampleConsensus::SACMODEL_SPHERE);
+                else if (name == "Cylinder")
+                    models.push_back(SampleConsensus::SACMODEL_CYLINDER);
+                else if (name == "Cone")
+                    models.push_back(SampleConsensus::SACMODEL_CONE);
+                else
+                    throw Py::ValueError("Unsupported model: " + name);
+            }
+            detect.setModels(models);
+        }
+        detect.setDistanceThreshold(distance);
+        detect.setAngleThreshold(Base::toRadians(angle));
+        detect.setMinSupport(std::size_t(std::max(minSupport, 0)));
+        detect.setClusterEpsilon(epsilon);
+        detect.setProbability(probability);
+        std::vector<ShapeDetection::Shape> shapes = detect.perform();
+
+        Py::List list;
+        for (const auto& shape : shapes) {
+            Py::Dict dict;
+            const char* name = "Plane";
+            if (shape.type == SampleConsensus::SACMODEL_SPHERE)
+                name = "Sphere";
+            else if (shape.type == SampleConsensus::SACMODEL_CYLINDER)
+                name = "Cylinder";
+            else if (shape.type == SampleConsensus::SACMODEL_CONE)
+                name = "Cone";
+            Py::Tuple param(shape.parameters.size());
+            for (std::size_t i = 0; i < shape.parameters.size(); i++)
+                param.setItem(i, Py::Float(shape.parameters[i]));
+            Py::Tuple data(shape.indices.size());
+            for (std::size_t i = 0; i < shape.indices.size(); i++)
+                data.setItem(i, Py::Long(shape.indices[i]));
+            dict.setItem(Py::String("Type"), Py::String(name));
+            dict.setItem(Py::String("Parameters"), param);
+            dict.setItem(Py::String("Model"), data);
+            list.append(dict);
+        }
+
+        return list;
+    }
 };
 
 PyObject* initModule()
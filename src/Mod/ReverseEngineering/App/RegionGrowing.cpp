@@ -22,84 +22,62 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+#include <QtConcurrentMap>
 #endif
 
+#include <Base/Converter.h>
+#include <Base/Exception.h>
 #include <Base/Tools.h>
+#include <Mod/Points/App/KDTree.h>
 #include <Mod/Points/App/Points.h>
 
 #include "RegionGrowing.h"
+#include "Segmentation.h"
 
 
-#if defined(HAVE_PCL_FILTERS)
-#include <pcl/filters/passthrough.h>
-#include <pcl/point_types.h>
-#endif
-#if defined(HAVE_PCL_SEGMENTATION)
-#include <pcl/features/normal_3d.h>
-#include <pcl/filters/extract_indices.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/search/search.h>
-#include <pcl/segmentation/region_growing.h>
-
-using namespace std;
 using namespace Reen;
-using pcl::PointCloud;
-using pcl::PointNormal;
-using pcl::PointXYZ;
+
+namespace
+{
+bool isValid(const Base::Vector3f& vec)
+{
+    return !std::isnan(vec.x) && !std::isnan(vec.y) && !std::isnan(vec.z);
+}
+}  // namespace
 
 RegionGrowing::RegionGrowing(const Points::PointKernel& pts, std::list<std::vector<int>>& clusters)
     : myPoints(pts)
     , myClusters(clusters)
+    , smoothness(Base::toRadians(3.0))
 {}
 
 void RegionGrowing::perform(int ksearch)
 {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        if (!boost::math::isnan(it->x) && !boost::math::isnan(it->y)
-            && !boost::math::isnan(it->z)) {
-            cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-        }
+    std::vector<Base::Vector3d> normals;
+    std::vector<float> curvatures;
+    NormalEstimation estimate(myPoints);
+    estimate.setKSearch(ksearch);
+    estimate.perform(normals, curvatures);
+
+    std::vector<Base::Vector3f> points;
+    points.reserve(myPoints.size());
+    for (std::size_t index = 0; index < myPoints.size(); index++) {
+        points.push_back(Base::convertTo<Base::Vector3f>(myPoints.getPoint(index)));
     }
 
-    // normal estimation
-    pcl::search::Search<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::NormalEstimation<pcl::PointXYZ, pcl::Normal> normal_estimator;
-    normal_estimator.setSearchMethod(tree);
-    normal_estimator.setInputCloud(cloud);
-    normal_estimator.setKSearch(ksearch);
-    normal_estimator.compute(*normals);
-
-    // pass through
-    pcl::IndicesPtr indices(new std::vector<int>);
-    pcl::PassThrough<pcl::PointXYZ> pass;
-    pass.setInputCloud(cloud);
-    pass.setFilterFieldName("z");
-    pass.setFilterLimits(0.0, 1.0);
-    pass.filter(*indices);
-
-    pcl::RegionGrowing<pcl::PointXYZ, pcl::Normal> reg;
-    reg.setMinClusterSize(50);
-    reg.setMaxClusterSize(1000000);
-    reg.setSearchMethod(tree);
-    reg.setNumberOfNeighbours(30);
-    reg.setInputCloud(cloud);
-    // reg.setIndices (indices);
-    reg.setInputNormals(normals);
-    reg.setSmoothnessThreshold(Base::toRadians(3.0));
-    reg.setCurvatureThreshold(1.0);
-
-    std::vector<pcl::PointIndices> clusters;
-    reg.extract(clusters);
-
-    for (std::vector<pcl::PointIndices>::iterator it = clusters.begin(); it != clusters.end();
-         ++it) {
-        myClusters.push_back(std::vector<int>());
-        myClusters.back().swap(it->indices);
+    std::vector<Base::Vector3f> nor;
+    nor.reserve(normals.size());
+    for (const auto& it : normals) {
+        nor.push_back(Base::convertTo<Base::Vector3f>(it));
     }
+
+    grow(points, nor, curvatures);
 }
 
 void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
@@ -108,52 +86,94 @@ void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
         throw Base::RuntimeError("Number of points doesn't match with number of normals");
     }
 
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-    cloud->reserve(myPoints.size());
-    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>);
-    normals->reserve(myNormals.size());
-
-    std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
-    for (std::size_t index = 0; index < num_points; index++) {
-        const Base::Vector3f& p = points[index];
-        const Base::Vector3f& n = myNormals[index];
-        if (!boost::math::isnan(p.x) && !boost::math::isnan(p.y) && !boost::math::isnan(p.z)) {
-            cloud->push_back(pcl::PointXYZ(p.x, p.y, p.z));
-            normals->push_back(pcl::Normal(n.x, n.y, n.z));
+    std::vector<Base::Vector3f> points;
+    points.reserve(myPoints.size());
+    for (std::size_t index = 0; index < myPoints.size(); index++) {
+        points.push_back(Base::convertTo<Base::Vector3f>(myPoints.getPoint(index)));
+    }
+
+    // without a curvature all points are used to grow a region
+    std::vector<float> curvatures(points.size(), 0.0F);
+    grow(points, myNormals, curvatures);
+}
+
+void RegionGrowing::grow(const std::vector<Base::Vector3f>& points,
+                         const std::vector<Base::Vector3f>& normals,
+                         const std::vector<float>& curvatures)
+{
+    const std::size_t numPoints = points.size();
+    std::vector<bool> valid(numPoints);
+    for (std::size_t index = 0; index < numPoints; index++) {
+        valid[index] = isValid(points[index]) && isValid(normals[index]);
+    }
+
+    // the neighbourhoods are searched on several threads, the growing itself is sequential
+    Points::PointsKDTree tree(points);
+    const auto numNeigh = static_cast<std::size_t>(std::max(numNeighbours, 1));
+    const auto none = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> neighbours(numPoints * numNeigh, none);
+    std::vector<std::size_t> blocks;
+    for (std::size_t pos = 0; pos < numPoints; pos += 4096) {
+        blocks.push_back(pos);
+    }
+    QtConcurrent::blockingMap(blocks, [&](std::size_t begin) {
+        std::vector<Points::PointsKDTree::size_type> found;
+        std::vector<float> distances;
+        for (std::size_t index = begin; index < std::min(numPoints, begin + 4096); index++) {
+            if (valid[index]) {
+                tree.findNearest(points[index], numNeigh, found, distances);
+                for (std::size_t i = 0; i < found.size(); i++) {
+                    neighbours[index * numNeigh + i] = static_cast<uint32_t>(found[i]);
+                }
+            }
+        }
+    });
+
+    // points of low curvature are the preferred seeds
+    std::vector<std::size_t> seeds;
+    for (std::size_t index = 0; index < numPoints; index++) {
+        if (valid[index]) {
+            seeds.push_back(index);
         }
     }
+    std::stable_sort(seeds.begin(), seeds.end(), [&curvatures](std::size_t i, std::size_t j) {
+        return curvatures[i] < curvatures[j];
+    });
+
+    const float cosThreshold = static_cast<float>(std::cos(smoothness));
+    std::vector<bool> assigned(numPoints, false);
+    std::deque<std::size_t> front;
+    for (std::size_t seed : seeds) {
+        if (assigned[seed]) {
+            continue;
+        }
+
+        std::vector<int> region {static_cast<int>(seed)};
+        assigned[seed] = true;
+        front.push_back(seed);
+        while (!front.empty()) {
+            std::size_t current = front.front();
+            front.pop_front();
+            for (std::size_t i = 0; i < numNeigh; i++) {
+                uint32_t next = neighbours[current * numNeigh + i];
+                if (next == none || assigned[next]) {
+                    continue;
+                }
+                if (std::fabs(normals[current].Dot(normals[next])) < cosThreshold) {
+                    continue;
+                }
+                assigned[next] = true;
+                region.push_back(static_cast<int>(next));
+                if (curvatures[next] < curvatureThreshold) {
+                    front.push_back(next);
+                }
+            }
+        }
 
-    pcl::search::Search<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-    tree->setInputCloud(cloud);
-
-    // pass through
-    pcl::IndicesPtr indices(new std::vector<int>);
-    pcl::PassThrough<pcl::PointXYZ> pass;
-    pass.setInputCloud(cloud);
-    pass.setFilterFieldName("z");
-    pass.setFilterLimits(0.0, 1.0);
-    pass.filter(*indices);
-
-    pcl::RegionGrowing<pcl::PointXYZ, pcl::Normal> reg;
-    reg.setMinClusterSize(50);
-    reg.setMaxClusterSize(1000000);
-    reg.setSearchMethod(tree);
-    reg.setNumberOfNeighbours(30);
-    reg.setInputCloud(cloud);
-    // reg.setIndices (indices);
-    reg.setInputNormals(normals);
-    reg.setSmoothnessThreshold(Base::toRadians(3.0));
-    reg.setCurvatureThreshold(1.0);
-
-    std::vector<pcl::PointIndices> clusters;
-    reg.extract(clusters);
-
-    for (std::vector<pcl::PointIndices>::iterator it = clusters.begin(); it != clusters.end();
-         ++it) {
-        myClusters.push_back(std::vector<int>());
-        myClusters.back().swap(it->indices);
+        int size = static_cast<int>(region.size());
+        if (size >= minClusterSize && size <= maxClusterSize) {
+            std::sort(region.begin(), region.end());
+            myClusters.push_back(std::move(region));
+        }
     }
 }
-
-#endif  // HAVE_PCL_SEGMENTATION
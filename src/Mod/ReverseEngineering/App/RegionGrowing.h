@@ -27,6 +27,7 @@
 #include <vector>
 
 #include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
 
 
 namespace Points
@@ -37,7 +38,14 @@ class PointKernel;
 namespace Reen
 {
 
-class RegionGrowing
+/** Segments a point cloud into smooth regions.
+ * Starting with the point of lowest curvature a region is grown over the neighbours whose normals
+ * deviate less than the smoothness threshold. Only neighbours with a curvature below the
+ * curvature threshold are used to grow the region further. The clusters hold the indices of the
+ * points of the cloud in increasing order, clusters with too few or too many points are dropped.
+ * The result is deterministic.
+ */
+class ReenExport RegionGrowing
 {
 public:
     RegionGrowing(const Points::PointKernel&, std::list<std::vector<int>>&);
@@ -50,9 +58,42 @@ public:
      */
     void perform(const std::vector<Base::Vector3f>& normals);
 
+    void setMinClusterSize(int size)
+    {
+        minClusterSize = size;
+    }
+    void setMaxClusterSize(int size)
+    {
+        maxClusterSize = size;
+    }
+    /// Sets the number of neighbours that are checked to grow a region, the default is 30.
+    void setNumberOfNeighbours(int num)
+    {
+        numNeighbours = num;
+    }
+    /// Sets the maximum angle between two normals of a region in radian.
+    void setSmoothnessThreshold(double angle)
+    {
+        smoothness = angle;
+    }
+    void setCurvatureThreshold(double value)
+    {
+        curvatureThreshold = value;
+    }
+
+private:
+    void grow(const std::vector<Base::Vector3f>& points,
+              const std::vector<Base::Vector3f>& normals,
+              const std::vector<float>& curvatures);
+
 private:
     const Points::PointKernel& myPoints;
     std::list<std::vector<int>>& myClusters;
+    int minClusterSize {50};
+    int maxClusterSize {1000000};
+    int numNeighbours {30};
+    double smoothness;
+    double curvatureThreshold {1.0};
 };
 
 }  // namespace Reen
@@ -22,29 +22,300 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
-#include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <random>
+
+#include <QtConcurrentMap>
 #endif
 
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+
 #include <Base/Exception.h>
+#include <Base/Tools.h>
+#include <Mod/Points/App/KDTree.h>
 #include <Mod/Points/App/Points.h>
 
 #include "SampleConsensus.h"
+#include "Segmentation.h"
 
 
-#if defined(HAVE_PCL_SAMPLE_CONSENSUS)
-#include <pcl/features/normal_3d.h>
-#include <pcl/point_types.h>
-#include <pcl/sample_consensus/ransac.h>
-#include <pcl/sample_consensus/sac_model_cone.h>
-#include <pcl/sample_consensus/sac_model_cylinder.h>
-#include <pcl/sample_consensus/sac_model_plane.h>
-#include <pcl/sample_consensus/sac_model_sphere.h>
-
-using namespace std;
 using namespace Reen;
-using pcl::PointCloud;
-using pcl::PointNormal;
-using pcl::PointXYZ;
+
+namespace
+{
+using Coefficients = std::array<double, 7>;
+using Sample = std::array<std::size_t, 4>;
+
+struct Cloud
+{
+    std::vector<Eigen::Vector3d> points;
+    std::vector<Eigen::Vector3d> normals;
+    std::vector<int> indices;
+};
+
+struct Hypothesis
+{
+    Coefficients coefficients {};
+    bool valid {false};
+    std::size_t inliers {0};
+};
+
+std::size_t sampleSize(SampleConsensus::SacModel sac)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return 3;
+        case SampleConsensus::SACMODEL_SPHERE:
+            return 4;
+        case SampleConsensus::SACMODEL_CYLINDER:
+            return 2;
+        case SampleConsensus::SACMODEL_CONE:
+            return 3;
+        default:
+            throw Base::RuntimeError("Unsupported SAC model");
+    }
+}
+
+std::size_t numCoefficients(SampleConsensus::SacModel sac)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+        case SampleConsensus::SACMODEL_SPHERE:
+            return 4;
+        default:
+            return 7;
+    }
+}
+
+bool fitPlane(const Cloud& cloud, const Sample& sample, Coefficients& coeff)
+{
+    const Eigen::Vector3d& p0 = cloud.points[sample[0]];
+    Eigen::Vector3d normal = (cloud.points[sample[1]] - p0).cross(cloud.points[sample[2]] - p0);
+    double length = normal.norm();
+    if (length < std::numeric_limits<double>::epsilon()) {
+        return false;
+    }
+    normal /= length;
+    coeff = {normal.x(), normal.y(), normal.z(), -normal.dot(p0)};
+    return true;
+}
+
+bool fitSphere(const Cloud& cloud, const Sample& sample, Coefficients& coeff)
+{
+    // the center has the same distance to all four points
+    const Eigen::Vector3d& p0 = cloud.points[sample[0]];
+    Eigen::Matrix3d mat;
+    Eigen::Vector3d rhs;
+    for (int i = 0; i < 3; i++) {
+        const Eigen::Vector3d& pi = cloud.points[sample[i + 1]];
+        mat.row(i) = 2.0 * (pi - p0);
+        rhs[i] = pi.squaredNorm() - p0.squaredNorm();
+    }
+    Eigen::FullPivLU<Eigen::Matrix3d> solver(mat);
+    if (!solver.isInvertible()) {
+        return false;
+    }
+    Eigen::Vector3d center = solver.solve(rhs);
+    coeff = {center.x(), center.y(), center.z(), (p0 - center).norm()};
+    return true;
+}
+
+bool fitCylinder(const Cloud& cloud, const Sample& sample, Coefficients& coeff)
+{
+    // the axis is perpendicular to both normals and passes through the closest points of the
+    // two lines along the normals
+    const Eigen::Vector3d& p1 = cloud.points[sample[0]];
+    const Eigen::Vector3d& p2 = cloud.points[sample[1]];
+    const Eigen::Vector3d& n1 = cloud.normals[sample[0]];
+    const Eigen::Vector3d& n2 = cloud.normals[sample[1]];
+    Eigen::Vector3d dir = n1.cross(n2);
+    double length = dir.norm();
+    if (length < 1e-6) {
+        return false;
+    }
+    dir /= length;
+
+    Eigen::Vector3d w0 = p1 - p2;
+    double a = n1.dot(n1);
+    double b = n1.dot(n2);
+    double c = n2.dot(n2);
+    double d = n1.dot(w0);
+    double e = n2.dot(w0);
+    double denom = a * c - b * b;
+    Eigen::Vector3d q1 = p1 + n1 * ((b * e - c * d) / denom);
+    Eigen::Vector3d q2 = p2 + n2 * ((a * e - b * d) / denom);
+    Eigen::Vector3d base = 0.5 * (q1 + q2);
+
+    double r1 = (p1 - base).cross(dir).norm();
+    double r2 = (p2 - base).cross(dir).norm();
+    coeff = {base.x(), base.y(), base.z(), dir.x(), dir.y(), dir.z(), 0.5 * (r1 + r2)};
+    return true;
+}
+
+bool fitCone(const Cloud& cloud, const Sample& sample, Coefficients& coeff)
+{
+    // the apex is the intersection of the three tangent planes
+    Eigen::Matrix3d mat;
+    Eigen::Vector3d rhs;
+    for (int i = 0; i < 3; i++) {
+        const Eigen::Vector3d& normal = cloud.normals[sample[i]];
+        mat.row(i) = normal;
+        rhs[i] = normal.dot(cloud.points[sample[i]]);
+    }
+    Eigen::FullPivLU<Eigen::Matrix3d> solver(mat);
+    if (!solver.isInvertible()) {
+        return false;
+    }
+    Eigen::Vector3d apex = solver.solve(rhs);
+
+    std::array<Eigen::Vector3d, 3> rays;
+    for (int i = 0; i < 3; i++) {
+        rays[i] = cloud.points[sample[i]] - apex;
+        double length = rays[i].norm();
+        if (length < std::numeric_limits<double>::epsilon()) {
+            return false;
+        }
+        rays[i] /= length;
+    }
+
+    // the tips of the unit rays lie on a circle around the axis
+    Eigen::Vector3d axis = (rays[1] - rays[0]).cross(rays[2] - rays[0]);
+    double length = axis.norm();
+    if (length < std::numeric_limits<double>::epsilon()) {
+        return false;
+    }
+    axis /= length;
+    if (axis.dot(rays[0]) < 0.0) {
+        axis = -axis;
+    }
+
+    double angle = 0.0;
+    for (const auto& ray : rays) {
+        angle += std::acos(std::clamp(ray.dot(axis), -1.0, 1.0));
+    }
+    angle /= 3.0;
+    if (angle <= 0.0 || angle >= 0.5 * std::numbers::pi) {
+        return false;
+    }
+
+    coeff = {apex.x(), apex.y(), apex.z(), axis.x(), axis.y(), axis.z(), angle};
+    return true;
+}
+
+bool fitModel(SampleConsensus::SacModel sac,
+              const Cloud& cloud,
+              const Sample& sample,
+              Coefficients& coeff)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return fitPlane(cloud, sample, coeff);
+        case SampleConsensus::SACMODEL_SPHERE:
+            return fitSphere(cloud, sample, coeff);
+        case SampleConsensus::SACMODEL_CYLINDER:
+            return fitCylinder(cloud, sample, coeff);
+        case SampleConsensus::SACMODEL_CONE:
+            return fitCone(cloud, sample, coeff);
+        default:
+            return false;
+    }
+}
+
+double distanceToModel(SampleConsensus::SacModel sac,
+                       const Coefficients& coeff,
+                       const Eigen::Vector3d& pnt)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return std::fabs(coeff[0] * pnt.x() + coeff[1] * pnt.y() + coeff[2] * pnt.z()
+                             + coeff[3]);
+        case SampleConsensus::SACMODEL_SPHERE: {
+            Eigen::Vector3d center(coeff[0], coeff[1], coeff[2]);
+            return std::fabs((pnt - center).norm() - coeff[3]);
+        }
+        case SampleConsensus::SACMODEL_CYLINDER: {
+            Eigen::Vector3d base(coeff[0], coeff[1], coeff[2]);
+            Eigen::Vector3d dir(coeff[3], coeff[4], coeff[5]);
+            return std::fabs((pnt - base).cross(dir).norm() - coeff[6]);
+        }
+        case SampleConsensus::SACMODEL_CONE: {
+            // distance to the generatrix in the plane spanned by the axis and the point
+            Eigen::Vector3d apex(coeff[0], coeff[1], coeff[2]);
+            Eigen::Vector3d axis(coeff[3], coeff[4], coeff[5]);
+            Eigen::Vector3d vec = pnt - apex;
+            double height = vec.dot(axis);
+            double radius = (vec - height * axis).norm();
+            double cosAngle = std::cos(coeff[6]);
+            double sinAngle = std::sin(coeff[6]);
+            if (height * cosAngle + radius * sinAngle < 0.0) {
+                return vec.norm();
+            }
+            return std::fabs(radius * cosAngle - height * sinAngle);
+        }
+        default:
+            return std::numeric_limits<double>::max();
+    }
+}
+
+Eigen::Vector3d normalOfModel(SampleConsensus::SacModel sac,
+                              const Coefficients& coeff,
+                              const Eigen::Vector3d& pnt)
+{
+    switch (sac) {
+        case SampleConsensus::SACMODEL_PLANE:
+            return {coeff[0], coeff[1], coeff[2]};
+        case SampleConsensus::SACMODEL_SPHERE:
+            return (pnt - Eigen::Vector3d(coeff[0], coeff[1], coeff[2])).normalized();
+        case SampleConsensus::SACMODEL_CYLINDER: {
+            Eigen::Vector3d vec = pnt - Eigen::Vector3d(coeff[0], coeff[1], coeff[2]);
+            Eigen::Vector3d dir(coeff[3], coeff[4], coeff[5]);
+            return (vec - vec.dot(dir) * dir).normalized();
+        }
+        case SampleConsensus::SACMODEL_CONE: {
+            Eigen::Vector3d vec = pnt - Eigen::Vector3d(coeff[0], coeff[1], coeff[2]);
+            Eigen::Vector3d axis(coeff[3], coeff[4], coeff[5]);
+            Eigen::Vector3d radial = (vec - vec.dot(axis) * axis).normalized();
+            return std::cos(coeff[6]) * radial - std::sin(coeff[6]) * axis;
+        }
+        default:
+            return Eigen::Vector3d::Zero();
+    }
+}
+
+bool isValid(const Base::Vector3d& vec)
+{
+    return !std::isnan(vec.x) && !std::isnan(vec.y) && !std::isnan(vec.z);
+}
+
+// interleaves the lower ten bits of the three coordinates
+uint32_t mortonCode(uint32_t x, uint32_t y, uint32_t z)
+{
+    auto spread = [](uint32_t v) {
+        v = (v | (v << 16U)) & 0x030000FFU;
+        v = (v | (v << 8U)) & 0x0300F00FU;
+        v = (v | (v << 4U)) & 0x030C30C3U;
+        v = (v | (v << 2U)) & 0x09249249U;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1U) | (spread(z) << 2U);
+}
+
+struct Candidate
+{
+    SampleConsensus::SacModel type {SampleConsensus::SACMODEL_PLANE};
+    Coefficients coefficients {};
+    std::size_t score {0};
+    bool valid {false};
+};
+}  // namespace
 
 SampleConsensus::SampleConsensus(SacModel sac,
                                  const Points::PointKernel& pts,
@@ -56,88 +327,410 @@ SampleConsensus::SampleConsensus(SacModel sac,
 
 double SampleConsensus::perform(std::vector<float>& parameters, std::vector<int>& model)
 {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        if (!boost::math::isnan(it->x) && !boost::math::isnan(it->y)
-            && !boost::math::isnan(it->z)) {
-            cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-        }
-    }
-
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-    cloud->is_dense = true;
-
-    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>());
-    if (mySac == SACMODEL_CONE || mySac == SACMODEL_CYLINDER) {
-#if 0
-        // Create search tree
-        pcl::search::KdTree<pcl::PointXYZ>::Ptr tree;
-        tree.reset (new pcl::search::KdTree<PointXYZ> (false));
-        tree->setInputCloud (cloud);
-
-        // Normal estimation
-        int ksearch = 10;
-        pcl::NormalEstimation<pcl::PointXYZ, pcl::Normal> n;
-        n.setInputCloud (cloud);
-        n.setSearchMethod (tree);
-        n.setKSearch (ksearch);
-        n.compute (*normals);
-#else
-        normals->reserve(myNormals.size());
-        for (std::vector<Base::Vector3d>::const_iterator it = myNormals.begin();
-             it != myNormals.end();
-             ++it) {
-            if (!boost::math::isnan(it->x) && !boost::math::isnan(it->y)
-                && !boost::math::isnan(it->z)) {
-                normals->push_back(pcl::Normal(it->x, it->y, it->z));
+    const std::size_t numSamples = sampleSize(mySac);
+    const bool useNormals = (mySac == SACMODEL_CONE || mySac == SACMODEL_CYLINDER);
+
+    std::vector<Base::Vector3d> estimated;
+    const std::vector<Base::Vector3d>* normals = &myNormals;
+    if (useNormals && myNormals.empty()) {
+        NormalEstimation estimate(myPoints);
+        estimate.setKSearch(10);
+        estimate.perform(estimated);
+        normals = &estimated;
+    }
+    if (useNormals && normals->size() != myPoints.size()) {
+        throw Base::RuntimeError("Number of points doesn't match with number of normals");
+    }
+
+    Cloud cloud;
+    cloud.points.reserve(myPoints.size());
+    cloud.indices.reserve(myPoints.size());
+    for (std::size_t index = 0; index < myPoints.size(); index++) {
+        Base::Vector3d pnt = myPoints.getPoint(index);
+        if (!isValid(pnt) || (useNormals && !isValid((*normals)[index]))) {
+            continue;
+        }
+        cloud.points.emplace_back(pnt.x, pnt.y, pnt.z);
+        cloud.indices.push_back(static_cast<int>(index));
+        if (useNormals) {
+            const Base::Vector3d& nor = (*normals)[index];
+            cloud.normals.push_back(Eigen::Vector3d(nor.x, nor.y, nor.z).normalized());
+        }
+    }
+
+    const std::size_t numPoints = cloud.points.size();
+    if (numPoints < numSamples) {
+        return probability;
+    }
+
+    // Draw the samples sequentially with a fixed seed and evaluate a batch of hypotheses in
+    // parallel. Ties are resolved by the order of the hypotheses so that the result doesn't
+    // depend on the number of threads.
+    std::mt19937 generator(5489U);
+    std::uniform_int_distribution<std::size_t> distribution(0, numPoints - 1);
+    const std::size_t batchSize = 64;
+    const double logProbability = std::log(1.0 - probability);
+
+    Hypothesis best;
+    double requiredIterations = maxIterations;
+    int iterations = 0;
+    std::vector<Hypothesis> batch;
+    while (iterations < maxIterations && iterations < requiredIterations) {
+        batch.clear();
+        for (std::size_t i = 0; i < batchSize && iterations + int(i) < maxIterations; i++) {
+            Sample sample {};
+            for (std::size_t j = 0; j < numSamples; j++) {
+                bool unique = false;
+                while (!unique) {
+                    sample[j] = distribution(generator);
+                    unique = std::find(sample.begin(), sample.begin() + j, sample[j])
+                        == sample.begin() + j;
+                }
+            }
+
+            Hypothesis hyp;
+            hyp.valid = fitModel(mySac, cloud, sample, hyp.coefficients);
+            batch.push_back(hyp);
+        }
+
+        QtConcurrent::blockingMap(batch, [&](Hypothesis& hyp) {
+            if (!hyp.valid) {
+                return;
+            }
+            for (const auto& pnt : cloud.points) {
+                if (distanceToModel(mySac, hyp.coefficients, pnt) <= distanceThreshold) {
+                    hyp.inliers++;
+                }
+            }
+        });
+
+        for (const auto& hyp : batch) {
+            iterations++;
+            if (hyp.valid && hyp.inliers > best.inliers) {
+                best = hyp;
+                double ratio = double(best.inliers) / double(numPoints);
+                double outlierFree = std::pow(ratio, double(numSamples));
+                if (outlierFree >= 1.0 - std::numeric_limits<double>::epsilon()) {
+                    requiredIterations = 0;
+                }
+                else if (outlierFree > std::numeric_limits<double>::epsilon()) {
+                    requiredIterations = logProbability / std::log(1.0 - outlierFree);
+                }
+            }
+            if (iterations >= requiredIterations) {
+                break;
             }
         }
-#endif
     }
 
-    // created RandomSampleConsensus object and compute the appropriated model
-    pcl::SampleConsensusModel<pcl::PointXYZ>::Ptr model_p;
-    switch (mySac) {
-        case SACMODEL_PLANE: {
-            model_p.reset(new pcl::SampleConsensusModelPlane<pcl::PointXYZ>(cloud));
-            break;
+    if (!best.valid) {
+        return probability;
+    }
+
+    for (std::size_t i = 0; i < numCoefficients(mySac); i++) {
+        parameters.push_back(static_cast<float>(best.coefficients[i]));
+    }
+    for (std::size_t index = 0; index < numPoints; index++) {
+        if (distanceToModel(mySac, best.coefficients, cloud.points[index]) <= distanceThreshold) {
+            model.push_back(cloud.indices[index]);
         }
-        case SACMODEL_SPHERE: {
-            model_p.reset(new pcl::SampleConsensusModelSphere<pcl::PointXYZ>(cloud));
-            break;
+    }
+
+    return probability;
+}
+
+// ----------------------------------------------------------------------------
+
+ShapeDetection::ShapeDetection(const std::vector<Base::Vector3d>& points,
+                               const std::vector<Base::Vector3d>& normals)
+    : myPoints(points)
+    , myNormals(normals)
+    , myModels {SampleConsensus::SACMODEL_PLANE,
+                SampleConsensus::SACMODEL_SPHERE,
+                SampleConsensus::SACMODEL_CYLINDER,
+                SampleConsensus::SACMODEL_CONE}
+    , angleThreshold(Base::toRadians(20.0))
+{}
+
+std::vector<ShapeDetection::Shape> ShapeDetection::perform() const
+{
+    if (myPoints.size() != myNormals.size()) {
+        throw Base::RuntimeError("Number of points doesn't match with number of normals");
+    }
+
+    std::size_t numSamples = 0;
+    for (auto sac : myModels) {
+        numSamples = std::max(numSamples, sampleSize(sac));
+    }
+
+    Cloud cloud;
+    for (std::size_t index = 0; index < myPoints.size(); index++) {
+        const Base::Vector3d& pnt = myPoints[index];
+        const Base::Vector3d& nor = myNormals[index];
+        if (!isValid(pnt) || !isValid(nor) || nor.Sqr() == 0.0) {
+            continue;
         }
-        case SACMODEL_CONE: {
-            pcl::SampleConsensusModelCone<pcl::PointXYZ, pcl::Normal>::Ptr model_c(
-                new pcl::SampleConsensusModelCone<pcl::PointXYZ, pcl::Normal>(cloud));
-            model_c->setInputNormals(normals);
-            model_p = model_c;
-            break;
+        cloud.points.emplace_back(pnt.x, pnt.y, pnt.z);
+        cloud.normals.push_back(Eigen::Vector3d(nor.x, nor.y, nor.z).normalized());
+        cloud.indices.push_back(static_cast<int>(index));
+    }
+
+    std::vector<Shape> shapes;
+    const std::size_t numPoints = cloud.points.size();
+    if (numPoints == 0 || numSamples == 0) {
+        return shapes;
+    }
+
+    const std::size_t support =
+        minSupport > 0 ? minSupport : std::max<std::size_t>(10, numPoints / 100);
+
+    // Sort the points along a Morton curve. Then the points of each octree cell are a contiguous
+    // range whose codes share the same prefix.
+    Eigen::AlignedBox3d box;
+    for (const auto& it : cloud.points) {
+        box.extend(it);
+    }
+    const double maxRadius = box.diagonal().norm();
+    const int depth = 10;
+    const int levels = 8;
+    const double cells = double(1U << unsigned(depth));
+    Eigen::Vector3d extent = box.sizes().cwiseMax(std::numeric_limits<double>::min());
+    std::vector<std::pair<uint32_t, std::size_t>> order(numPoints);
+    for (std::size_t index = 0; index < numPoints; index++) {
+        Eigen::Vector3d cell = (cloud.points[index] - box.min()).cwiseQuotient(extent) * cells;
+        auto clamp = [cells](double value) {
+            return static_cast<uint32_t>(std::clamp(value, 0.0, cells - 1.0));
+        };
+        order[index] = {mortonCode(clamp(cell.x()), clamp(cell.y()), clamp(cell.z())), index};
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<uint32_t> codes(numPoints);
+    std::vector<std::size_t> sorted(numPoints);
+    std::vector<std::size_t> rank(numPoints);
+    for (std::size_t pos = 0; pos < numPoints; pos++) {
+        codes[pos] = order[pos].first;
+        sorted[pos] = order[pos].second;
+        rank[order[pos].second] = pos;
+    }
+
+    std::vector<Base::Vector3f> points;
+    points.reserve(numPoints);
+    for (const auto& it : cloud.points) {
+        points.emplace_back(float(it.x()), float(it.y()), float(it.z()));
+    }
+    Points::PointsKDTree tree(points);
+
+    double epsilon = clusterEpsilon;
+    if (epsilon <= 0.0) {
+        std::vector<Points::PointsKDTree::size_type> found;
+        std::vector<float> distances;
+        double sum = 0.0;
+        std::size_t count = 0;
+        const std::size_t step = std::max<std::size_t>(1, numPoints / 1000);
+        for (std::size_t index = 0; index < numPoints; index += step) {
+            tree.findNearest(points[index], 2, found, distances);
+            if (distances.size() == 2) {
+                sum += distances[1];
+                count++;
+            }
         }
-        case SACMODEL_CYLINDER: {
-            pcl::SampleConsensusModelCylinder<pcl::PointXYZ, pcl::Normal>::Ptr model_c(
-                new pcl::SampleConsensusModelCylinder<pcl::PointXYZ, pcl::Normal>(cloud));
-            model_c->setInputNormals(normals);
-            model_p = model_c;
+        epsilon = count > 0 ? 3.0 * sum / double(count) : 0.0;
+    }
+
+    std::vector<char> assigned(numPoints, 0);
+    std::vector<std::size_t> remaining(numPoints);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    std::mt19937 generator(5489U);
+    const double cosAngle = std::cos(angleThreshold);
+    const double logProbability = std::log(1.0 - probability);
+
+    auto isInlier = [&](const Candidate& cand, std::size_t index) {
+        const Eigen::Vector3d& pnt = cloud.points[index];
+        return distanceToModel(cand.type, cand.coefficients, pnt) <= distanceThreshold
+            && std::fabs(normalOfModel(cand.type, cand.coefficients, pnt).dot(cloud.normals[index]))
+            >= cosAngle;
+    };
+
+    // the probability to draw a sample of a shape with n points from the octree cells
+    auto requiredSamples = [&](double numShape, std::size_t sampleSize) {
+        double prob = numShape
+            / (double(remaining.size()) * levels * double(1U << unsigned(sampleSize - 1)));
+        if (prob >= 1.0) {
+            return 1.0;
+        }
+        return logProbability / std::log(1.0 - prob);
+    };
+
+    // draws the first point from the remaining points and the others from an octree cell
+    // around it
+    auto drawSample = [&](Sample& sample) {
+        std::uniform_int_distribution<std::size_t> pickFirst(0, remaining.size() - 1);
+        std::uniform_int_distribution<int> pickLevel(0, levels - 1);
+        sample[0] = remaining[pickFirst(generator)];
+        unsigned shift = 3U * unsigned(depth - pickLevel(generator));
+        uint32_t prefix = codes[rank[sample[0]]] >> shift;
+        auto lower = std::partition_point(codes.begin(), codes.end(), [=](uint32_t code) {
+            return (code >> shift) < prefix;
+        });
+        auto upper = std::partition_point(lower, codes.end(), [=](uint32_t code) {
+            return (code >> shift) == prefix;
+        });
+        std::uniform_int_distribution<std::size_t> pickOther(
+            std::size_t(lower - codes.begin()),
+            std::size_t(upper - codes.begin()) - 1);
+        for (std::size_t i = 1; i < numSamples; i++) {
+            bool found = false;
+            for (int tries = 0; tries < 20 && !found; tries++) {
+                sample[i] = sorted[pickOther(generator)];
+                found = !assigned[sample[i]]
+                    && std::find(sample.begin(), sample.begin() + i, sample[i])
+                        == sample.begin() + i;
+            }
+            if (!found) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    int failures = 0;
+    std::vector<Candidate> batch;
+    while (remaining.size() >= std::max(support, numSamples) && failures < 3) {
+        // the candidates are scored on a random subset of the remaining points
+        std::vector<std::size_t> subset = remaining;
+        const std::size_t subsetSize = 8192;
+        if (subset.size() > subsetSize) {
+            for (std::size_t i = 0; i < subsetSize; i++) {
+                std::uniform_int_distribution<std::size_t> pick(i, subset.size() - 1);
+                std::swap(subset[i], subset[pick(generator)]);
+            }
+            subset.resize(subsetSize);
+        }
+        const double scale = double(remaining.size()) / double(subset.size());
+
+        Candidate best;
+        int samples = 0;
+        while (samples < maxSamples) {
+            batch.clear();
+            for (int i = 0; i < 16 && samples < maxSamples; i++, samples++) {
+                Sample sample {};
+                if (!drawSample(sample)) {
+                    continue;
+                }
+                for (auto sac : myModels) {
+                    Candidate cand;
+                    cand.type = sac;
+                    if (!fitModel(sac, cloud, sample, cand.coefficients)) {
+                        continue;
+                    }
+                    // very large spheres and cylinders rather approximate a plane
+                    double radius = 0.0;
+                    if (sac == SampleConsensus::SACMODEL_SPHERE) {
+                        radius = cand.coefficients[3];
+                    }
+                    else if (sac == SampleConsensus::SACMODEL_CYLINDER) {
+                        radius = cand.coefficients[6];
+                    }
+                    if (radius > maxRadius) {
+                        continue;
+                    }
+                    // the sample points must fit to the candidate
+                    bool fits = true;
+                    for (std::size_t j = 0; j < sampleSize(sac) && fits; j++) {
+                        fits = isInlier(cand, sample[j]);
+                    }
+                    if (fits) {
+                        cand.valid = true;
+                        batch.push_back(cand);
+                    }
+                }
+            }
+
+            QtConcurrent::blockingMap(batch, [&](Candidate& cand) {
+                for (std::size_t index : subset) {
+                    if (isInlier(cand, index)) {
+                        cand.score++;
+                    }
+                }
+            });
+
+            for (const auto& cand : batch) {
+                if (cand.score > best.score) {
+                    best = cand;
+                }
+            }
+
+            // stop if a better candidate is unlikely to be drawn
+            double numShape = std::max(double(support), double(best.score) * scale);
+            std::size_t size = best.valid ? sampleSize(best.type) : numSamples;
+            if (samples >= requiredSamples(numShape, size)) {
+                break;
+            }
+        }
+
+        if (!best.valid || double(best.score) * scale < double(support)) {
             break;
         }
-        default:
-            throw Base::RuntimeError("Unsupported SAC model");
-    }
 
-    pcl::RandomSampleConsensus<pcl::PointXYZ> ransac(model_p);
-    ransac.setDistanceThreshold(.01);
-    ransac.computeModel();
-    ransac.getInliers(model);
-    // ransac.getModel (model);
-    Eigen::VectorXf model_p_coefficients;
-    ransac.getModelCoefficients(model_p_coefficients);
-    for (int i = 0; i < model_p_coefficients.size(); i++) {
-        parameters.push_back(model_p_coefficients[i]);
+        // take the largest connected set of inliers among the remaining points
+        std::vector<char> inlier(numPoints, 0);
+        QtConcurrent::blockingMap(remaining, [&](std::size_t index) {
+            inlier[index] = isInlier(best, index) ? 1 : 0;
+        });
+
+        std::vector<std::size_t> component;
+        std::vector<std::size_t> current;
+        std::vector<Points::PointsKDTree::size_type> found;
+        std::deque<std::size_t> front;
+        for (std::size_t seed : remaining) {
+            if (inlier[seed] != 1) {
+                continue;
+            }
+            current.clear();
+            inlier[seed] = 2;
+            front.push_back(seed);
+            while (!front.empty()) {
+                std::size_t index = front.front();
+                front.pop_front();
+                current.push_back(index);
+                tree.findInRadius(points[index], float(epsilon), found);
+                for (auto next : found) {
+                    if (inlier[next] == 1) {
+                        inlier[next] = 2;
+                        front.push_back(next);
+                    }
+                }
+            }
+            if (current.size() > component.size()) {
+                component.swap(current);
+            }
+        }
+
+        if (component.size() < support) {
+            failures++;
+            continue;
+        }
+        failures = 0;
+
+        Shape shape;
+        shape.type = best.type;
+        for (std::size_t i = 0; i < numCoefficients(best.type); i++) {
+            shape.parameters.push_back(static_cast<float>(best.coefficients[i]));
+        }
+        for (std::size_t index : component) {
+            assigned[index] = 1;
+            shape.indices.push_back(cloud.indices[index]);
+        }
+        std::sort(shape.indices.begin(), shape.indices.end());
+        shapes.push_back(std::move(shape));
+
+        remaining.erase(std::remove_if(remaining.begin(),
+                                       remaining.end(),
+                                       [&assigned](std::size_t index) {
+                                           return assigned[index] != 0;
+                                       }),
+                        remaining.end());
     }
 
-    return ransac.getProbability();
+    return shapes;
 }
-
-#endif  // HAVE_PCL_SAMPLE_CONSENSUS
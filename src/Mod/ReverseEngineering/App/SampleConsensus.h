@@ -23,9 +23,11 @@
 #ifndef REEN_SAMPLECONSENSUS_H
 #define REEN_SAMPLECONSENSUS_H
 
+#include <cstddef>
 #include <vector>
 
 #include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
 
 
 namespace Points
@@ -36,7 +38,18 @@ class PointKernel;
 namespace Reen
 {
 
-class SampleConsensus
+/** Fits a geometric model to a point cloud with the random sample consensus algorithm.
+ * The minimal samples are drawn from a random generator with a fixed seed and the hypotheses
+ * are scored on several threads, so the same input always gives the same model. The parameters
+ * of the models are:
+ * \li plane: normal (3), distance to origin
+ * \li sphere: center (3), radius
+ * \li cylinder: point on axis (3), axis direction (3), radius
+ * \li cone: apex (3), axis direction (3), opening half-angle
+ * The cylinder and cone models need normals. If none are passed they are estimated from the ten
+ * nearest neighbours of each point.
+ */
+class ReenExport SampleConsensus
 {
 public:
     enum SacModel
@@ -51,12 +64,113 @@ public:
         SACMODEL_TORUS,
     };
     SampleConsensus(SacModel sac, const Points::PointKernel&, const std::vector<Base::Vector3d>&);
+    /// Sets the maximum distance of an inlier to the model, the default is 0.01.
+    void setDistanceThreshold(double value)
+    {
+        distanceThreshold = value;
+    }
+    /// Sets the maximum number of hypotheses to test, the default is 1000.
+    void setMaxIterations(int value)
+    {
+        maxIterations = value;
+    }
+    /// Sets the probability to draw at least one sample free of outliers, the default is 0.99.
+    void setProbability(double value)
+    {
+        probability = value;
+    }
+    /** \brief Compute the model.
+     * \param[out] parameters the coefficients of the best model
+     * \param[out] model the indices of the inliers of the best model in increasing order
+     * \return the probability, both lists are empty if no model could be found
+     */
     double perform(std::vector<float>& parameters, std::vector<int>& model);
 
 private:
     SacModel mySac;
     const Points::PointKernel& myPoints;
     const std::vector<Base::Vector3d>& myNormals;
+    double distanceThreshold {0.01};
+    int maxIterations {1000};
+    double probability {0.99};
+};
+
+/** Extracts several primitives of different types from a point cloud with oriented normals.
+ * This follows the efficient RANSAC approach: the minimal samples are drawn from the cells of an
+ * implicit octree so that they likely belong to the same surface, every sample gives a candidate
+ * of each enabled model type and the candidates are scored in parallel on a random subset of the
+ * remaining points. The best candidate is accepted once the probability of having overlooked a
+ * larger one is low enough, its largest connected set of inliers becomes a shape and these points
+ * are removed. This repeats until no shape with enough support is found.
+ * The parameters of the shapes are the same as of SampleConsensus and the indices refer to the
+ * input points. The result is deterministic.
+ */
+class ReenExport ShapeDetection
+{
+public:
+    struct Shape
+    {
+        SampleConsensus::SacModel type;
+        std::vector<float> parameters;
+        std::vector<int> indices;
+    };
+
+    ShapeDetection(const std::vector<Base::Vector3d>& points,
+                   const std::vector<Base::Vector3d>& normals);
+
+    /// Sets the model types to search for, by default planes, spheres, cylinders and cones.
+    void setModels(const std::vector<SampleConsensus::SacModel>& models)
+    {
+        myModels = models;
+    }
+    /// Sets the maximum distance of an inlier to the shape, the default is 0.01.
+    void setDistanceThreshold(double value)
+    {
+        distanceThreshold = value;
+    }
+    /// Sets the maximum angle in radian between the normal of an inlier and the shape.
+    void setAngleThreshold(double value)
+    {
+        angleThreshold = value;
+    }
+    /// Sets the minimum number of points of a shape, by default 1% of the points.
+    void setMinSupport(std::size_t value)
+    {
+        minSupport = value;
+    }
+    /** Sets the maximum distance of neighbouring points of a shape. By default it's three
+     * times the mean distance between neighbouring points.
+     */
+    void setClusterEpsilon(double value)
+    {
+        clusterEpsilon = value;
+    }
+    /// Sets the probability to not overlook a shape, the default is 0.99.
+    void setProbability(double value)
+    {
+        probability = value;
+    }
+    /// Sets the maximum number of samples drawn to find one shape, the default is 20000.
+    void setMaxSamples(int value)
+    {
+        maxSamples = value;
+    }
+    /** \brief Detect the shapes.
+     * Throws a RuntimeError if the number of normals doesn't match with the number of points.
+     * \return the shapes in the order they are found, i.e. roughly by decreasing size
+     */
+    std::vector<Shape> perform() const;
+
+private:
+    const std::vector<Base::Vector3d>& myPoints;
+    const std::vector<Base::Vector3d>& myNormals;
+    std::vector<SampleConsensus::SacModel> myModels;
+    double distanceThreshold {0.01};
+    double angleThreshold;
+    std::size_t minSupport {0};
+    double clusterEpsilon {0.0};
+    double probability {0.99};
+    int maxSamples {20000};
 };
 
 }  // namespace Reen
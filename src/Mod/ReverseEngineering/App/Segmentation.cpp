@@ -21,7 +21,18 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <cmath>
+#include <limits>
 
+#include <QtConcurrentMap>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+#include <Mod/Points/App/KDTree.h>
 #include <Mod/Points/App/Points.h>
 
 #include "Segmentation.h"
@@ -160,7 +171,6 @@ void Segmentation::perform(int ksearch)
 
 // ----------------------------------------------------------------------------
 
-#if defined(HAVE_PCL_FILTERS)
 NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
     : myPoints(pts)
     , kSearch(0)
@@ -169,47 +179,83 @@ NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
 
 void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
 {
-    // Copy the points
-    pcl::PointCloud<PointXYZ>::Ptr cloud(new pcl::PointCloud<PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-    }
-
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-
-#if 0
-    // Build a passthrough filter to remove spurious NaNs
-    pcl::PointCloud<PointXYZ>::Ptr cloud_filtered (new pcl::PointCloud<PointXYZ>);
-    pcl::PassThrough<PointXYZ> pass;
-    pass.setInputCloud (cloud);
-    pass.setFilterFieldName ("z");
-    pass.setFilterLimits (0, 1.5);
-    pass.filter (*cloud_filtered);
-#endif
+    std::vector<float> curvatures;
+    perform(normals, curvatures);
+}
 
-    // Estimate point normals
-    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::search::KdTree<PointXYZ>::Ptr tree(new pcl::search::KdTree<PointXYZ>());
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
-    ne.setSearchMethod(tree);
-    // ne.setInputCloud (cloud_filtered);
-    ne.setInputCloud(cloud);
-    if (kSearch > 0) {
-        ne.setKSearch(kSearch);
+void NormalEstimation::perform(std::vector<Base::Vector3d>& normals, std::vector<float>& curvatures)
+{
+    if (kSearch <= 0 && searchRadius <= 0) {
+        throw Base::ValueError("Neither the number of neighbours nor the search radius is set");
     }
-    if (searchRadius > 0) {
-        ne.setRadiusSearch(searchRadius);
+
+    std::vector<Base::Vector3f> points;
+    points.reserve(myPoints.size());
+    for (std::size_t index = 0; index < myPoints.size(); index++) {
+        points.push_back(Base::convertTo<Base::Vector3f>(myPoints.getPoint(index)));
     }
-    ne.compute(*cloud_normals);
 
-    normals.reserve(cloud_normals->size());
-    for (pcl::PointCloud<pcl::Normal>::const_iterator it = cloud_normals->begin();
-         it != cloud_normals->end();
-         ++it) {
-        normals.push_back(Base::Vector3d(it->normal_x, it->normal_y, it->normal_z));
+    Points::PointsKDTree tree(points);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    normals.assign(points.size(), Base::Vector3d(nan, nan, nan));
+    curvatures.assign(points.size(), std::numeric_limits<float>::quiet_NaN());
+
+    struct Block
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<Block> blocks;
+    const std::size_t blockSize = 4096;
+    for (std::size_t pos = 0; pos < points.size(); pos += blockSize) {
+        blocks.push_back({pos, std::min(points.size(), pos + blockSize)});
     }
-}
 
-#endif  // HAVE_PCL_FILTERS
+    QtConcurrent::blockingMap(blocks, [&](const Block& block) {
+        std::vector<Points::PointsKDTree::size_type> neighbours;
+        std::vector<float> distances;
+        for (std::size_t index = block.begin; index < block.end; index++) {
+            const Base::Vector3f& pnt = points[index];
+            if (std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z)) {
+                continue;
+            }
+            if (kSearch > 0) {
+                tree.findNearest(pnt, static_cast<std::size_t>(kSearch), neighbours, distances);
+            }
+            else {
+                tree.findInRadius(pnt, static_cast<float>(searchRadius), neighbours);
+            }
+            if (neighbours.size() < 3) {
+                continue;
+            }
+
+            Eigen::Vector3d center = Eigen::Vector3d::Zero();
+            for (auto it : neighbours) {
+                center += Eigen::Vector3d(points[it].x, points[it].y, points[it].z);
+            }
+            center /= static_cast<double>(neighbours.size());
+            Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+            for (auto it : neighbours) {
+                Eigen::Vector3d diff = Eigen::Vector3d(points[it].x, points[it].y, points[it].z)
+                    - center;
+                cov += diff * diff.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+            solver.computeDirect(cov);
+            Eigen::Vector3d eigenValues = solver.eigenvalues();
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+
+            // orient the normal towards the viewpoint at the origin
+            Base::Vector3d nor(normal.x(), normal.y(), normal.z());
+            if (nor.Dot(Base::convertTo<Base::Vector3d>(pnt)) > 0.0) {
+                nor = -nor;
+            }
+            normals[index] = nor;
+
+            double sum = eigenValues.sum();
+            curvatures[index] = sum > 0.0 ? static_cast<float>(std::abs(eigenValues[0]) / sum)
+                                          : 0.0F;
+        }
+    });
+}
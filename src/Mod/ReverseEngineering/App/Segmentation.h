@@ -27,6 +27,7 @@
 #include <vector>
 
 #include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
 
 
 namespace Points
@@ -51,7 +52,11 @@ private:
     std::list<std::vector<int>>& myClusters;
 };
 
-class NormalEstimation
+/** Estimates the normals of a point cloud by a principal component analysis of the neighbourhood
+ * of each point. The normals are oriented towards the origin. Points with NaN coordinates or with
+ * less than three neighbours get a NaN normal. The points are processed on several threads.
+ */
+class ReenExport NormalEstimation
 {
 public:
     explicit NormalEstimation(const Points::PointKernel&);
@@ -76,6 +81,12 @@ public:
      * \param[out] the estimated normals
      */
     void perform(std::vector<Base::Vector3d>& normals);
+    /** \brief Perform the normal estimation.
+     * \param[out] normals the estimated normals
+     * \param[out] curvatures the surface variation, i.e. the ratio of the smallest eigenvalue to
+     * the sum of the eigenvalues of the covariance matrix
+     */
+    void perform(std::vector<Base::Vector3d>& normals, std::vector<float>& curvatures);
 
 private:
     const Points::PointKernel& myPoints;
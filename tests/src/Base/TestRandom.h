@@ -0,0 +1,28 @@
+#ifndef TEST_RANDOM_H
+#define TEST_RANDOM_H
+
+namespace tests
+{
+
+/// Small linear congruential generator, so that random test data is the same on all platforms
+class Random
+{
+public:
+    explicit Random(unsigned int seed)
+        : seed(seed)
+    {}
+
+    /// Returns the next number in [0, 1]
+    float operator()()
+    {
+        seed = seed * 1103515245U + 12345U;
+        return float((seed >> 8) & 0xffff) / 65535.0F;
+    }
+
+private:
+    unsigned int seed;
+};
+
+}  // namespace tests
+
+#endif  // TEST_RANDOM_H
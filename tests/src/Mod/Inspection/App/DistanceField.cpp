@@ -0,0 +1,276 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <sstream>
+
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+#include <Mod/Inspection/App/DistanceField.h>
+#include <Mod/Inspection/App/InspectionFeature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Points/App/Points.h>
+#include <src/Base/TestRandom.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+// signed distance to a sphere around the origin with radius 2
+class NominalSphere: public Inspection::InspectNominalGeometry
+{
+public:
+    explicit NominalSphere(int& calls)
+        : calls(calls)
+    {}
+    float getDistance(const Base::Vector3f& pnt) const override
+    {
+        calls++;
+        return pnt.Length() - 2.0F;
+    }
+
+private:
+    int& calls;
+};
+
+// random points in the given box
+std::vector<Base::Vector3f> randomPoints(const Base::BoundBox3f& box, int num)
+{
+    tests::Random random(3);
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < num; i++) {
+        points.emplace_back(box.MinX + random() * box.LengthX(),
+                            box.MinY + random() * box.LengthY(),
+                            box.MinZ + random() * box.LengthZ());
+    }
+    return points;
+}
+}  // namespace
+
+class DistanceFieldTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // points on the sphere
+        const float pi = std::numbers::pi_v<float>;
+        for (int i = 0; i < 200; i++) {
+            for (int j = 0; j < 100; j++) {
+                float u = float(i) / 200.0F * 2.0F * pi;
+                float v = float(j) / 99.0F * pi;
+                Base::Vector3f pnt(2.0F * std::cos(u) * std::sin(v),
+                                   2.0F * std::sin(u) * std::sin(v),
+                                   2.0F * std::cos(v));
+                seeds.emplace_back(pnt.x, pnt.y, pnt.z, pnt.x, pnt.y, pnt.z);
+            }
+        }
+    }
+
+    static float sphere(const Base::Vector3f& pnt)
+    {
+        return pnt.Length() - 2.0F;
+    }
+
+    // compares the field and the nominal field with the exact distances to the nominal
+    static void compare(const Inspection::InspectNominalField::Factory& factory,
+                        const std::vector<Base::BoundBox3f>& boxes,
+                        const Base::BoundBox3f& box,
+                        float radius)
+    {
+        Inspection::InspectNominalField exact({factory});
+        auto distance = [&exact](const Base::Vector3f& pnt) {
+            return exact.getExactDistance(pnt);
+        };
+        auto field = std::make_shared<Inspection::DistanceField>();
+        field->build(boxes, radius / 16.0F, radius, distance);
+        float tolerance = 0.5F * field->getSpacing();
+
+        int lookups = 0;
+        for (const auto& it : randomPoints(box, 2000)) {
+            float dist {};
+            if (field->getDistance(it, dist)) {
+                lookups++;
+                EXPECT_NEAR(dist, distance(it), tolerance);
+            }
+        }
+        EXPECT_GT(lookups, 0);
+
+        Inspection::InspectNominalField nominal({factory});
+        nominal.setField(field);
+        for (const auto& it : randomPoints(box, 500)) {
+            EXPECT_NEAR(nominal.getDistance(it), distance(it), tolerance);
+        }
+    }
+
+    std::vector<Base::BoundBox3f> seeds;
+};
+
+TEST_F(DistanceFieldTest, testEmpty)
+{
+    Inspection::DistanceField field;
+    field.build({}, 0.05F, 0.2F, sphere);
+    float dist {};
+    EXPECT_TRUE(field.isEmpty());
+    EXPECT_FALSE(field.getDistance(Base::Vector3f(2, 0, 0), dist));
+    EXPECT_THROW(field.build(seeds, 0.0F, 0.2F, sphere), Base::ValueError);
+}
+
+TEST_F(DistanceFieldTest, testInterpolation)
+{
+    Inspection::DistanceField field;
+    field.build(seeds, 0.05F, 0.4F, sphere);
+    EXPECT_FALSE(field.isEmpty());
+    EXPECT_FLOAT_EQ(field.getSpacing(), 0.05F);
+
+    int inBand = 0;
+    for (int i = 0; i < 9261; i++) {
+        Base::Vector3f pnt(float(i % 21) / 8.0F - 1.25F,
+                           float((i / 21) % 21) / 8.0F - 1.25F,
+                           float(i / 441) / 8.0F - 1.25F);
+        pnt *= 2.0F;
+        float dist {};
+        if (field.getDistance(pnt, dist)) {
+            inBand++;
+            EXPECT_NEAR(dist, sphere(pnt), 1e-3F);
+        }
+        else {
+            // outside the band or next to the surface where the exact search is used
+            float dist = std::fabs(sphere(pnt));
+            EXPECT_TRUE(dist > 0.4F - 2.0F * 0.05F || dist < 2.0F * 0.05F * std::sqrt(3.0F));
+        }
+    }
+    EXPECT_GT(inBand, 0);
+}
+
+TEST_F(DistanceFieldTest, testMaxNodes)
+{
+    Inspection::DistanceField field;
+    field.build(seeds, 0.0001F, 0.2F, sphere);
+    EXPECT_LE(field.countNodes(), Inspection::DistanceField::maxNodes);
+    EXPECT_GT(field.getSpacing(), 0.0001F);
+}
+
+TEST_F(DistanceFieldTest, testSaveRestore)
+{
+    Inspection::DistanceField field;
+    field.build(seeds, 0.05F, 0.4F, sphere);
+    field.setKey(42);
+
+    std::stringstream str;
+    Base::OutputStream out(str);
+    field.save(out);
+
+    Inspection::DistanceField copy;
+    Base::InputStream in(str);
+    copy.restore(in, str);
+    EXPECT_EQ(copy.getKey(), 42);
+    EXPECT_EQ(copy.countNodes(), field.countNodes());
+    EXPECT_FLOAT_EQ(copy.getBand(), field.getBand());
+
+    Base::Vector3f pnt(0.0F, 0.0F, 2.25F);
+    float dist1 {};
+    float dist2 {};
+    ASSERT_TRUE(field.getDistance(pnt, dist1));
+    ASSERT_TRUE(copy.getDistance(pnt, dist2));
+    EXPECT_EQ(dist1, dist2);
+}
+
+TEST_F(DistanceFieldTest, testRestoreTruncated)
+{
+    Inspection::DistanceField field;
+    field.build(seeds, 0.05F, 0.4F, sphere);
+
+    std::stringstream str;
+    Base::OutputStream out(str);
+    field.save(out);
+    std::stringstream truncated(str.str().substr(0, str.str().size() / 2));
+
+    Inspection::DistanceField copy;
+    Base::InputStream in(truncated);
+    EXPECT_THROW(copy.restore(in, truncated), Base::FileException);
+    EXPECT_TRUE(copy.isEmpty());
+}
+
+TEST_F(DistanceFieldTest, testRestoreInvalidCount)
+{
+    // a number of blocks that is much larger than the stream
+    std::stringstream str;
+    Base::OutputStream out(str);
+    out << 0.0F << 0.0F << 0.0F << 0.1F << 0.4F << uint64_t(42) << uint32_t(0xffffffff);
+
+    Inspection::DistanceField copy;
+    Base::InputStream in(str);
+    EXPECT_THROW(copy.restore(in, str), Base::FileException);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(copy.getKey(), 0);
+}
+
+TEST_F(DistanceFieldTest, testNominalField)
+{
+    auto field = std::make_shared<Inspection::DistanceField>();
+    field->build(seeds, 0.05F, 0.4F, sphere);
+
+    int calls = 0;
+    int created = 0;
+    Inspection::InspectNominalField nominal({[&calls, &created]() {
+        created++;
+        return std::make_unique<NominalSphere>(calls);
+    }});
+    nominal.setField(field);
+    // within the band the distance is looked up and the nominal isn't created
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(0, 0, 2.25F)), 0.25F, 1e-3F);
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(0, 1.75F, 0)), -0.25F, 1e-3F);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(created, 0);
+    // next to the surface and outside the band the exact distance is computed
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(0, 0, 2.05F)), 0.05F);
+    EXPECT_EQ(calls, 1);
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(0, 0, 3)), 1.0F);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(created, 1);
+}
+
+TEST_F(DistanceFieldTest, testPointsNominal)
+{
+    // a grid of points in the xy plane
+    Points::PointKernel kernel;
+    std::vector<Base::BoundBox3f> boxes;
+    for (int i = 0; i <= 40; i++) {
+        for (int j = 0; j <= 40; j++) {
+            Base::Vector3d pnt(0.1 * i, 0.1 * j, 0.0);
+            kernel.push_back(pnt);
+            boxes.emplace_back(float(pnt.x), float(pnt.y), 0.0F, float(pnt.x), float(pnt.y), 0.0F);
+        }
+    }
+
+    auto factory = [&kernel]() {
+        return std::make_unique<Inspection::InspectNominalPoints>(kernel, 1.0F);
+    };
+    compare(factory, boxes, Base::BoundBox3f(-0.5F, -0.5F, -1.0F, 4.5F, 4.5F, 1.0F), 1.0F);
+}
+
+TEST_F(DistanceFieldTest, testOpenMesh)
+{
+    // a square whose signed distance flips beyond its borders
+    MeshCore::MeshKernel kernel;
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    facets.emplace_back(Base::Vector3f(0, 0, 0), Base::Vector3f(2, 0, 0), Base::Vector3f(2, 2, 0));
+    facets.emplace_back(Base::Vector3f(0, 0, 0), Base::Vector3f(2, 2, 0), Base::Vector3f(0, 2, 0));
+    kernel.AddFacets(facets);
+    Mesh::MeshObject mesh(kernel);
+
+    std::vector<Base::BoundBox3f> boxes;
+    for (const auto& it : facets) {
+        boxes.push_back(it.GetBoundBox());
+    }
+
+    auto factory = [&mesh]() {
+        return std::make_unique<Inspection::InspectNominalMesh>(mesh, 1.0F);
+    };
+    compare(factory, boxes, Base::BoundBox3f(-0.5F, -0.5F, -0.8F, 2.5F, 2.5F, 0.8F), 1.0F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+#include <BRepBndLib.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <gp_Ax2.hxx>
+
+#include <Base/FileInfo.h>
+#include <Mod/Inspection/App/InspectionFeature.h>
+#include <Mod/Points/App/PagedPoints.h>
+#include <src/Base/TestRandom.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class InspectNominalShapeTest: public ::testing::Test
+{
+protected:
+    // random points in the enlarged bounding box of the shape
+    std::vector<Base::Vector3f> randomPoints(const TopoDS_Shape& shape, int num)
+    {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box);
+        box.Enlarge(0.5);
+        Standard_Real xmin {}, ymin {}, zmin {}, xmax {}, ymax {}, zmax {};
+        box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+
+        tests::Random random(3);
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < num; i++) {
+            points.emplace_back(float(xmin + random() * (xmax - xmin)),
+                                float(ymin + random() * (ymax - ymin)),
+                                float(zmin + random() * (zmax - zmin)));
+        }
+        return points;
+    }
+
+    // compares the accelerated with the exact distances
+    void compare(const TopoDS_Shape& shape, double deflection)
+    {
+        std::vector<Base::Vector3f> points = randomPoints(shape, 2000);
+
+        Inspection::InspectNominalShape exact(shape, 0.1F);
+        std::vector<float> exactDist;
+        for (const auto& it : points) {
+            exactDist.push_back(exact.getDistance(it));
+        }
+        Inspection::InspectNominalFastShape fast(shape, 0.1F, deflection);
+        std::vector<float> fastDist;
+        for (const auto& it : points) {
+            fastDist.push_back(fast.getDistance(it));
+        }
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+            EXPECT_NEAR(std::fabs(fastDist[i]), std::fabs(exactDist[i]), 1e-4F) << i;
+            // the classifier of the exact method has a tolerance
+            if (std::fabs(exactDist[i]) > 0.01F) {
+                EXPECT_EQ(fastDist[i] < 0.0F, exactDist[i] < 0.0F) << i;
+            }
+        }
+    }
+};
+
+TEST_F(InspectNominalShapeTest, testBox)
+{
+    compare(BRepPrimAPI_MakeBox(gp_Pnt(-1, -2, -3), 2, 3, 4).Solid(), 0.01);
+}
+
+TEST_F(InspectNominalShapeTest, testShell)
+{
+    compare(BRepPrimAPI_MakeBox(gp_Pnt(-1, -2, -3), 2, 3, 4).Shell(), 0.01);
+}
+
+TEST_F(InspectNominalShapeTest, testCylinder)
+{
+    gp_Ax2 axis(gp_Pnt(1, 0, 0), gp_Dir(0, 1, 1));
+    compare(BRepPrimAPI_MakeCylinder(axis, 1.5, 3).Solid(), 0.01);
+}
+
+TEST_F(InspectNominalShapeTest, testSphere)
+{
+    compare(BRepPrimAPI_MakeSphere(gp_Pnt(0, 1, 2), 2).Solid(), 0.01);
+}
+
+TEST_F(InspectNominalShapeTest, testNullShape)
+{
+    TopoDS_Shape shape;
+    Inspection::InspectNominalFastShape fast(shape, 0.1F, 0.01);
+    EXPECT_EQ(fast.getDistance(Base::Vector3f(1, 2, 3)), std::numeric_limits<float>::max());
+}
+
+TEST_F(InspectNominalShapeTest, testNominalNotTessellated)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(gp_Pnt(-1, -2, -3), 2, 3, 4).Solid();
+    Inspection::InspectNominalFastShape fast(box, 0.1F, 0.01);
+    EXPECT_NEAR(fast.getDistance(Base::Vector3f(2, 0, 0)), 1.0F, 1e-4F);
+    // only a copy of the nominal is tessellated
+    for (TopExp_Explorer xp(box, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopLoc_Location loc;
+        EXPECT_TRUE(BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull());
+    }
+}
+
+TEST(InspectNominalPointsTest, testPointSource)
+{
+    // the same cloud in memory and paged from a file
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 50; i++) {
+        for (int j = 0; j < 50; j++) {
+            points.emplace_back(0.1F * float(i), 0.1F * float(j), 0.01F * float(i + j));
+        }
+    }
+    Points::PointKernel kernel;
+    for (const auto& it : points) {
+        kernel.push_back(Base::Vector3d(it.x, it.y, it.z));
+    }
+    Base::FileInfo file(Base::FileInfo::getTempFileName());
+    Points::PagedPointKernel paged;
+    paged.setLeafCapacity(500);
+    paged.create(file.filePath());
+    paged.addPoints(points);
+    paged.finish();
+
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(1, 2, 3));
+    kernel.setTransform(mat);
+    Inspection::InspectNominalPoints fromKernel(kernel, 0.1F);
+    for (float radius : {0.1F, 1.0F}) {
+        // only the distances within the search radius are exact
+        Inspection::InspectNominalPoints fromSource(paged, mat, radius);
+        for (int i = 0; i < 100; i++) {
+            Base::Vector3f pnt(0.05F * float(i), 2.0F + 0.03F * float(i), 3.5F);
+            float dist = fromKernel.getDistance(pnt);
+            if (dist <= radius) {
+                EXPECT_NEAR(fromSource.getDistance(pnt), dist, 1e-5F);
+            }
+            else {
+                EXPECT_GT(fromSource.getDistance(pnt), radius);
+            }
+        }
+    }
+
+    paged.close();
+    file.deleteFile();
+}
+
+namespace
+{
+// counts the points that are read from the source, not thread-safe
+class CountingSource: public Points::PointSource
+{
+public:
+    explicit CountingSource(const Points::PointKernel& kernel)
+        : kernel(kernel)
+    {}
+    std::size_t countPoints() const override
+    {
+        return kernel.countPoints();
+    }
+    Base::BoundBox3f getPointBounds() const override
+    {
+        return kernel.getPointBounds();
+    }
+    void getPointsInBox(const Base::BoundBox3f& box,
+                        std::vector<value_type>& pts) const override
+    {
+        std::size_t size = pts.size();
+        kernel.getPointsInBox(box, pts);
+        readPoints += pts.size() - size;
+    }
+    void getLevelOfDetail(const Base::BoundBox3f& box,
+                          std::size_t maxPoints,
+                          std::vector<value_type>& pts) const override
+    {
+        kernel.getLevelOfDetail(box, maxPoints, pts);
+    }
+
+    mutable std::size_t readPoints {0};
+
+private:
+    const Points::PointKernel& kernel;
+};
+}  // namespace
+
+TEST(InspectNominalPointsTest, testPointSourceTiles)
+{
+    // a 10 x 10 grid of points
+    Points::PointKernel kernel;
+    for (int i = 0; i <= 100; i++) {
+        for (int j = 0; j <= 100; j++) {
+            kernel.push_back(Base::Vector3d(0.1 * i, 0.1 * j, 0.0));
+        }
+    }
+    CountingSource source(kernel);
+    Inspection::InspectNominalPoints nominal(source, Base::Matrix4D(), 0.2F);
+
+    // a search only reads the tiles around the point
+    EXPECT_NEAR(nominal.getDistance(Base::Vector3f(0.5F, 0.5F, 0.1F)), 0.1F, 1e-5F);
+    EXPECT_GT(source.readPoints, 0U);
+    EXPECT_LT(source.readPoints, kernel.size() / 10);
+    // a point far away from the cloud doesn't read any tile
+    std::size_t readPoints = source.readPoints;
+    EXPECT_GT(nominal.getDistance(Base::Vector3f(5.0F, 5.0F, 5.0F)), 0.2F);
+    EXPECT_EQ(source.readPoints, readPoints);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
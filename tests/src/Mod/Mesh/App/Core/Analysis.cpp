@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Analysis.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class AnalysisTest: public ::testing::Test
+{
+protected:
+    static void AddBox(MeshCore::MeshPointArray& points,
+                       MeshCore::MeshFacetArray& facets,
+                       const Base::Vector3f& min,
+                       const Base::Vector3f& max)
+    {
+        auto offset = MeshCore::PointIndex(points.size());
+        for (int i = 0; i < 8; i++) {
+            points.push_back(MeshCore::MeshPoint((i & 1) ? max.x : min.x,
+                                                 (i & 2) ? max.y : min.y,
+                                                 (i & 4) ? max.z : min.z));
+        }
+
+        const int corners[12][3] = {{0, 2, 1},
+                                    {1, 2, 3},
+                                    {4, 5, 6},
+                                    {5, 7, 6},
+                                    {0, 1, 4},
+                                    {1, 5, 4},
+                                    {2, 6, 3},
+                                    {3, 6, 7},
+                                    {0, 4, 2},
+                                    {2, 4, 6},
+                                    {1, 3, 5},
+                                    {3, 7, 5}};
+        for (const auto& it : corners) {
+            facets.push_back(
+                MeshCore::MeshFacet(offset + it[0], offset + it[1], offset + it[2]));
+        }
+    }
+};
+
+TEST_F(AnalysisTest, TestCleanMesh)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    AddBox(points, facets, Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshAnalysis::Report report = analysis.Evaluate();
+    EXPECT_TRUE(report.IsEmpty());
+}
+
+TEST_F(AnalysisTest, TestSelfIntersections)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    AddBox(points, facets, Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    AddBox(points, facets, Base::Vector3f(0.5F, 0.4F, 0.3F), Base::Vector3f(1.5F, 1.4F, 1.3F));
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+    EXPECT_FALSE(pairs.empty());
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+    EXPECT_EQ(std::adjacent_find(pairs.begin(), pairs.end()), pairs.end());
+
+    // compare with testing all pairs
+    const MeshCore::MeshFacetArray& rFaces = kernel.GetFacets();
+    std::size_t count = 0;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        for (MeshCore::FacetIndex j = i + 1; j < kernel.CountFacets(); j++) {
+            Base::Vector3f pt1, pt2;
+            bool shared = false;
+            for (int k = 0; k < 3; k++) {
+                shared = shared || rFaces[j].HasPoint(rFaces[i]._aulPoints[k]);
+            }
+            if (shared) {
+                continue;
+            }
+            if (kernel.GetFacet(i).IntersectWithFacet(kernel.GetFacet(j), pt1, pt2) == 2) {
+                count++;
+            }
+        }
+    }
+    EXPECT_EQ(pairs.size(), count);
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshAnalysis::Report report = analysis.Evaluate(MeshCore::MeshAnalysis::All);
+    EXPECT_EQ(report.selfIntersections, pairs);
+    EXPECT_TRUE(report.nonManifolds.empty());
+    EXPECT_TRUE(report.orientation.empty());
+}
+
+TEST_F(AnalysisTest, TestPointOnEdge)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    points.push_back(MeshCore::MeshPoint(0, 0, 0));
+    points.push_back(MeshCore::MeshPoint(2, 0, 0));
+    points.push_back(MeshCore::MeshPoint(1, 1, 0));
+    points.push_back(MeshCore::MeshPoint(1, 0, 0));
+    points.push_back(MeshCore::MeshPoint(1, -1, 0));
+    facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+    facets.push_back(MeshCore::MeshFacet(0, 4, 3));
+    facets.push_back(MeshCore::MeshFacet(3, 4, 1));
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshAnalysis analysis(kernel);
+    MeshCore::MeshAnalysis::Report report =
+        analysis.Evaluate(MeshCore::MeshAnalysis::PointsOnEdge);
+    ASSERT_EQ(report.pointsOnEdge.size(), 1);
+    EXPECT_EQ(report.pointsOnEdge[0], 3);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
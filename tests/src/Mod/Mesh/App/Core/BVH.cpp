@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a coarse square next to a densely tessellated one
+        Base::Vector3f p1 {10, 0, 0};
+        Base::Vector3f p2 {20, 0, 0};
+        Base::Vector3f p3 {10, 10, 0};
+        Base::Vector3f p4 {20, 10, 0};
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+        const int num = 20;
+        const float len = 0.5F;
+        for (int i = 0; i < num; i++) {
+            for (int j = 0; j < num; j++) {
+                Base::Vector3f p1(float(i) * len, float(j) * len, 0);
+                Base::Vector3f p2(float(i + 1) * len, float(j) * len, 0);
+                Base::Vector3f p3(float(i) * len, float(j + 1) * len, 0);
+                Base::Vector3f p4(float(i + 1) * len, float(j + 1) * len, 0);
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+                kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+            }
+        }
+    }
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshFacetBVH tree;
+    EXPECT_TRUE(tree.IsEmpty());
+    EXPECT_EQ(tree.SearchNearestFromPoint(Base::Vector3f()), MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(BVHTest, TestVerify)
+{
+    MeshCore::MeshFacetBVH tree(GetKernel());
+    EXPECT_FALSE(tree.IsEmpty());
+    EXPECT_TRUE(tree.Verify());
+    EXPECT_GT(tree.CountNodes(), 1);
+}
+
+TEST_F(BVHTest, TestNearestFacetOnRay)
+{
+    MeshCore::MeshFacetBVH tree(GetKernel());
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    Base::Vector3f pnt(12, 1, 5);
+    Base::Vector3f dir(0, 0, -1);
+    EXPECT_TRUE(tree.NearestFacetOnRay(pnt, dir, res, index));
+    EXPECT_EQ(index, 0);
+    EXPECT_FLOAT_EQ(res.z, 0.0F);
+
+    // the facet lies behind the ray
+    EXPECT_FALSE(tree.NearestFacetOnRay(pnt, -dir, res, index));
+    // the facet is out of range
+    EXPECT_FALSE(tree.NearestFacetOnRay(pnt, dir, res, index, 4.0F));
+}
+
+TEST_F(BVHTest, TestNearestFacetOnRayDense)
+{
+    MeshCore::MeshFacetBVH tree(GetKernel());
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    Base::Vector3f pnt(0.6F, 0.1F, -1);
+    Base::Vector3f dir(0, 0, 1);
+    EXPECT_TRUE(tree.NearestFacetOnRay(pnt, dir, res, index));
+    EXPECT_LT(GetKernel().GetFacet(index).DistanceToPoint(res), 1.0e-5F);
+    EXPECT_FLOAT_EQ(res.x, 0.6F);
+    EXPECT_FLOAT_EQ(res.y, 0.1F);
+}
+
+TEST_F(BVHTest, TestSearchNearestFromPoint)
+{
+    MeshCore::MeshFacetBVH tree(GetKernel());
+    Base::Vector3f res;
+    float dist {};
+    Base::Vector3f pnt(19, 9, 2);
+    EXPECT_EQ(tree.SearchNearestFromPoint(pnt, 10.0F, res, dist), 1);
+    EXPECT_FLOAT_EQ(dist, 2.0F);
+    EXPECT_EQ(tree.SearchNearestFromPoint(pnt, 1.0F), MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(BVHTest, TestInside)
+{
+    MeshCore::MeshFacetBVH tree(GetKernel());
+    std::vector<MeshCore::FacetIndex> facets;
+    tree.Inside(Base::BoundBox3f(11, 1, -1, 12, 2, 1), facets);
+    ASSERT_EQ(facets.size(), 2);
+    EXPECT_EQ(std::min(facets[0], facets[1]), 0);
+    EXPECT_EQ(std::max(facets[0], facets[1]), 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
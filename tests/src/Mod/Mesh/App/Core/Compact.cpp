@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/IO/WriterCompact.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CompactTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const int num = 60;
+        const float len = 0.37F;
+        MeshCore::MeshFacetArray facets;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= num; i++) {
+            for (int j = 0; j <= num; j++) {
+                float z = std::sin(float(i) * 0.3F) * std::cos(float(j) * 0.2F);
+                points.push_back(MeshCore::MeshPoint(float(i) * len - 5.0F, float(j) * len, z));
+            }
+        }
+        for (int i = 0; i < num; i++) {
+            for (int j = 0; j < num; j++) {
+                auto p1 = MeshCore::PointIndex(i * (num + 1) + j);
+                auto p2 = MeshCore::PointIndex((i + 1) * (num + 1) + j);
+                facets.push_back(MeshCore::MeshFacet(p1, p2, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p1 + 1, p2, p2 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, true);
+    }
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+    std::string SaveCompact(int bits) const
+    {
+        std::stringstream str;
+        MeshCore::WriterCompact writer(kernel);
+        writer.SetQuantization(bits);
+        EXPECT_TRUE(writer.Save(str));
+        return str.str();
+    }
+
+    void ExpectSameTopology(const MeshCore::MeshKernel& mesh) const
+    {
+        const MeshCore::MeshFacetArray& rFacets = kernel.GetFacets();
+        const MeshCore::MeshFacetArray& rOther = mesh.GetFacets();
+        ASSERT_EQ(rFacets.size(), rOther.size());
+        for (std::size_t i = 0; i < rFacets.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(rFacets[i]._aulPoints[j], rOther[i]._aulPoints[j]);
+                EXPECT_EQ(rFacets[i]._aulNeighbours[j], rOther[i]._aulNeighbours[j]);
+            }
+        }
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(CompactTest, TestLossless)
+{
+    std::stringstream raw;
+    GetKernel().Write(raw);
+    std::string data = SaveCompact(0);
+    EXPECT_LT(data.size(), raw.str().size());
+
+    std::stringstream str(data);
+    MeshCore::MeshKernel mesh;
+    mesh.Read(str);
+
+    const MeshCore::MeshPointArray& rPoints = GetKernel().GetPoints();
+    ASSERT_EQ(rPoints.size(), mesh.CountPoints());
+    for (std::size_t i = 0; i < rPoints.size(); i++) {
+        EXPECT_EQ(rPoints[i], mesh.GetPoints()[i]);
+    }
+    ExpectSameTopology(mesh);
+}
+
+TEST_F(CompactTest, TestQuantized)
+{
+    const int bits = 12;
+    std::string data = SaveCompact(bits);
+    EXPECT_LT(data.size(), SaveCompact(0).size());
+
+    std::stringstream str(data);
+    MeshCore::MeshKernel mesh;
+    mesh.Read(str);
+
+    Base::BoundBox3f box = GetKernel().GetBoundBox();
+    float tol = 0.5F * box.CalcDiagonalLength() / float((1 << bits) - 1) + 1e-5F;
+    const MeshCore::MeshPointArray& rPoints = GetKernel().GetPoints();
+    ASSERT_EQ(rPoints.size(), mesh.CountPoints());
+    for (std::size_t i = 0; i < rPoints.size(); i++) {
+        EXPECT_LE(Base::Distance(rPoints[i], mesh.GetPoints()[i]), tol);
+    }
+    ExpectSameTopology(mesh);
+}
+
+TEST_F(CompactTest, TestCorruptData)
+{
+    std::string data = SaveCompact(16);
+    std::stringstream str(data.substr(0, data.size() - 10));
+    MeshCore::MeshKernel mesh;
+    EXPECT_THROW(mesh.Read(str), Base::BadFormatError);
+    EXPECT_EQ(mesh.CountFacets(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
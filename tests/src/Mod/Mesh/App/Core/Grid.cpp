@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class GridTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // large enough to fill the grid with several threads
+        const int num = 125;
+        const float len = 0.5F;
+        MeshCore::MeshFacetArray facets;
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i <= num; i++) {
+            for (int j = 0; j <= num; j++) {
+                float z = 0.1F * float((i * j) % 7);
+                points.push_back(MeshCore::MeshPoint(float(i) * len, float(j) * len, z));
+            }
+        }
+        for (int i = 0; i < num; i++) {
+            for (int j = 0; j < num; j++) {
+                auto p1 = MeshCore::PointIndex(i * (num + 1) + j);
+                auto p2 = MeshCore::PointIndex((i + 1) * (num + 1) + j);
+                facets.push_back(MeshCore::MeshFacet(p1, p2, p1 + 1));
+                facets.push_back(MeshCore::MeshFacet(p1 + 1, p2, p2 + 1));
+            }
+        }
+        kernel.Adopt(points, facets, false);
+    }
+
+    const MeshCore::MeshKernel& GetKernel() const
+    {
+        return kernel;
+    }
+
+private:
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(GridTest, TestFacetGridCells)
+{
+    MeshCore::MeshFacetGrid grid(GetKernel(), 20);
+    EXPECT_TRUE(grid.Verify());
+
+    unsigned long ulX {}, ulY {}, ulZ {};
+    grid.GetCtGrids(ulX, ulY, ulZ);
+
+    std::set<MeshCore::ElementIndex> all;
+    for (unsigned long i = 0; i < ulX; i++) {
+        for (unsigned long j = 0; j < ulY; j++) {
+            for (unsigned long k = 0; k < ulZ; k++) {
+                MeshCore::MeshGrid::CellRange cell = grid.GetCell(i, j, k);
+                EXPECT_EQ(grid.GetCtElements(i, j, k), cell.size());
+                EXPECT_TRUE(std::is_sorted(cell.begin(), cell.end()));
+                EXPECT_EQ(std::adjacent_find(cell.begin(), cell.end()), cell.end());
+                all.insert(cell.begin(), cell.end());
+            }
+        }
+    }
+
+    EXPECT_EQ(all.size(), GetKernel().CountFacets());
+}
+
+TEST_F(GridTest, TestFacetGridInside)
+{
+    MeshCore::MeshFacetGrid grid(GetKernel(), 20);
+
+    Base::BoundBox3f box(10.0F, 10.0F, -1.0F, 12.0F, 13.0F, 1.0F);
+    std::vector<MeshCore::ElementIndex> elements;
+    grid.Inside(box, elements);
+    std::set<MeshCore::ElementIndex> found(elements.begin(), elements.end());
+
+    // the grid must return every facet that overlaps the box
+    MeshCore::MeshFacetIterator it(GetKernel());
+    for (it.Init(); it.More(); it.Next()) {
+        if (it->GetBoundBox() && box) {
+            EXPECT_EQ(found.count(it.Position()), 1);
+        }
+    }
+}
+
+TEST_F(GridTest, TestPointGridCells)
+{
+    MeshCore::MeshPointGrid grid(GetKernel(), 20);
+
+    unsigned long ulX {}, ulY {}, ulZ {};
+    grid.GetCtGrids(ulX, ulY, ulZ);
+
+    // every point is in exactly one grid element
+    std::vector<MeshCore::ElementIndex> all;
+    for (unsigned long i = 0; i < ulX; i++) {
+        for (unsigned long j = 0; j < ulY; j++) {
+            for (unsigned long k = 0; k < ulZ; k++) {
+                MeshCore::MeshGrid::CellRange cell = grid.GetCell(i, j, k);
+                EXPECT_TRUE(std::is_sorted(cell.begin(), cell.end()));
+                all.insert(all.end(), cell.begin(), cell.end());
+            }
+        }
+    }
+
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all.size(), GetKernel().CountPoints());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+TEST_F(GridTest, TestEmptyGrid)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshFacetGrid grid(kernel);
+
+    std::vector<MeshCore::ElementIndex> elements;
+    grid.Inside(Base::BoundBox3f(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F), elements);
+    EXPECT_TRUE(elements.empty());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SetOperationsTest: public ::testing::Test
+{
+protected:
+    static MeshCore::MeshKernel CreateBox(const Base::Vector3f& min, const Base::Vector3f& max)
+    {
+        MeshCore::MeshPointArray points;
+        for (int i = 0; i < 8; i++) {
+            points.push_back(MeshCore::MeshPoint((i & 1) ? max.x : min.x,
+                                                 (i & 2) ? max.y : min.y,
+                                                 (i & 4) ? max.z : min.z));
+        }
+
+        // outward oriented facets
+        const int corners[12][3] = {{0, 2, 1},
+                                    {1, 2, 3},
+                                    {4, 5, 6},
+                                    {5, 7, 6},
+                                    {0, 1, 4},
+                                    {1, 5, 4},
+                                    {2, 6, 3},
+                                    {3, 6, 7},
+                                    {0, 4, 2},
+                                    {2, 4, 6},
+                                    {1, 3, 5},
+                                    {3, 7, 5}};
+        MeshCore::MeshFacetArray facets;
+        for (const auto& it : corners) {
+            facets.push_back(MeshCore::MeshFacet(it[0], it[1], it[2]));
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    // box whose sides are split into n x n squares of two facets each
+    static MeshCore::MeshKernel
+    CreateTessellatedBox(const Base::Vector3f& min, float size, int n)
+    {
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto side = [&facets, n](const Base::Vector3f& base,
+                                 const Base::Vector3f& u,
+                                 const Base::Vector3f& v) {
+            Base::Vector3f du = u / float(n);
+            Base::Vector3f dv = v / float(n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    Base::Vector3f p = base + du * float(i) + dv * float(j);
+                    facets.emplace_back(p, p + du, p + dv);
+                    facets.emplace_back(p + dv, p + du, p + du + dv);
+                }
+            }
+        };
+
+        Base::Vector3f x(size, 0, 0);
+        Base::Vector3f y(0, size, 0);
+        Base::Vector3f z(0, 0, size);
+        side(min, y, x);
+        side(min + z, x, y);
+        side(min, x, z);
+        side(min + y, z, x);
+        side(min, z, y);
+        side(min + x, y, z);
+
+        MeshCore::MeshKernel kernel;
+        kernel = facets;
+        return kernel;
+    }
+
+    static float Volume(const MeshCore::MeshKernel& kernel1,
+                        const MeshCore::MeshKernel& kernel2,
+                        MeshCore::SetOperations::OperationType type,
+                        MeshCore::SetOperations::Engine engine)
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::SetOperations setOp(kernel1, kernel2, result, type);
+        setOp.SetEngine(engine);
+        setOp.Do();
+        return result.GetVolume();
+    }
+};
+
+TEST_F(SetOperationsTest, TestBoxes)
+{
+    MeshCore::MeshKernel box1 = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        CreateBox(Base::Vector3f(0.5F, 0.4F, 0.3F), Base::Vector3f(1.5F, 1.4F, 1.3F));
+    float common = 0.5F * 0.6F * 0.7F;
+
+    for (auto engine : {MeshCore::SetOperations::Engine::Grid,
+                        MeshCore::SetOperations::Engine::BVH}) {
+        EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Union, engine),
+                    2.0F - common,
+                    1e-4F);
+        EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Intersect, engine),
+                    common,
+                    1e-4F);
+        EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Difference, engine),
+                    1.0F - common,
+                    1e-4F);
+    }
+}
+
+TEST_F(SetOperationsTest, TestSmallBoxes)
+{
+    // the absolute tolerance of MeshGeomFacet::IntersectWithFacet() fails at this scale
+    const float scale = 0.002F;
+    MeshCore::MeshKernel box1 =
+        CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(scale, scale, scale));
+    MeshCore::MeshKernel box2 = CreateBox(Base::Vector3f(0.5F, 0.4F, 0.3F) * scale,
+                                          Base::Vector3f(1.5F, 1.4F, 1.3F) * scale);
+    float common = 0.5F * 0.6F * 0.7F * scale * scale * scale;
+
+    auto engine = MeshCore::SetOperations::Engine::BVH;
+    float volume = Volume(box1, box2, MeshCore::SetOperations::Intersect, engine);
+    EXPECT_NEAR(volume / common, 1.0F, 1e-3F);
+}
+
+TEST_F(SetOperationsTest, TestDisjointBoxes)
+{
+    MeshCore::MeshKernel box1 = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 = CreateBox(Base::Vector3f(2, 2, 2), Base::Vector3f(3, 3, 3));
+
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations setOp(box1, box2, result, MeshCore::SetOperations::Union);
+    setOp.SetEngine(MeshCore::SetOperations::Engine::BVH);
+    setOp.Do();
+    EXPECT_EQ(result.CountFacets(), 24);
+    EXPECT_NEAR(result.GetVolume(), 2.0F, 1e-4F);
+}
+
+TEST_F(SetOperationsTest, TestFineBoxes)
+{
+    // 120000 facets each, the corner of the second box lies on vertices of the first one so that
+    // the cut line runs along its edges
+    MeshCore::MeshKernel box1 = CreateTessellatedBox(Base::Vector3f(0, 0, 0), 1.0F, 100);
+    MeshCore::MeshKernel box2 =
+        CreateTessellatedBox(Base::Vector3f(0.31F, 0.27F, 0.23F), 1.0F, 100);
+    ASSERT_EQ(box1.CountFacets(), 120000);
+    float common = 0.69F * 0.73F * 0.77F;
+
+    auto engine = MeshCore::SetOperations::Engine::BVH;
+    EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Union, engine), 2.0F - common, 2e-3F);
+    EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Intersect, engine), common, 2e-3F);
+    EXPECT_NEAR(Volume(box1, box2, MeshCore::SetOperations::Difference, engine),
+                1.0F - common,
+                2e-3F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
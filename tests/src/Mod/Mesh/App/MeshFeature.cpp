@@ -1,5 +1,9 @@
 #include "gtest/gtest.h"
+#include <memory>
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 
 class MeshFeatureTest: public ::testing::Test
@@ -37,4 +41,38 @@ TEST_F(MeshFeatureTest, getComplexElementTypes)
     EXPECT_STREQ(types[0], "Mesh");
     EXPECT_STREQ(types[1], "Segment");
 }
+
+TEST_F(MeshFeatureTest, saveCompactMesh)
+{
+    std::string name = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(name.c_str(), "testUser");
+    auto feature = doc->addObject<Mesh::Feature>("Mesh");
+    std::unique_ptr<Mesh::MeshObject> cube(
+        Mesh::MeshObject::createCube(Base::BoundBox3d(0.0, 0.0, 0.0, 1.5, 2.25, 3.125)));
+    feature->Mesh.setValue(cube->getKernel());
+
+    // the compact encoding is chosen by a property of the document
+    doc->SaveCompactMesh.setValue(true);
+    doc->CompactMeshQuantization.setValue(0);
+    Base::FileInfo fi(App::Application::getTempPath() + "CompactMesh.FCStd");
+    EXPECT_TRUE(doc->saveCopy(fi.filePath().c_str()));
+    auto restored = App::GetApplication().openDocument(fi.filePath().c_str());
+
+    ASSERT_TRUE(restored);
+    EXPECT_TRUE(restored->SaveCompactMesh.getValue());
+    EXPECT_EQ(restored->CompactMeshQuantization.getValue(), 0);
+    auto obj = dynamic_cast<Mesh::Feature*>(restored->getObject(feature->getNameInDocument()));
+    ASSERT_TRUE(obj);
+    const MeshCore::MeshKernel& kernel = obj->Mesh.getValue().getKernel();
+    const MeshCore::MeshKernel& original = feature->Mesh.getValue().getKernel();
+    ASSERT_EQ(kernel.CountPoints(), original.CountPoints());
+    ASSERT_EQ(kernel.CountFacets(), original.CountFacets());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(kernel.GetPoint(i), original.GetPoint(i));
+    }
+
+    App::GetApplication().closeDocument(restored->getName());
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
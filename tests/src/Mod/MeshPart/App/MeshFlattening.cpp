@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <Mod/MeshPart/App/MeshFlatteningLscmRelax.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshFlatteningTest: public ::testing::Test
+{
+protected:
+    // a half cylinder with radius 1 and height 2 which can be unrolled without distortion
+    lscmrelax::LscmRelax makeCylinder(long rows, long cols) const
+    {
+        RowMat<double, 3> vertices(3, (rows + 1) * (cols + 1));
+        RowMat<long, 3> triangles(3, rows * cols * 2);
+        for (long i = 0; i <= rows; i++) {
+            for (long j = 0; j <= cols; j++) {
+                double angle = std::numbers::pi * j / cols;
+                vertices.col(i * (cols + 1) + j) << std::cos(angle), std::sin(angle),
+                    2.0 * i / rows;
+            }
+        }
+        long index = 0;
+        for (long i = 0; i < rows; i++) {
+            for (long j = 0; j < cols; j++) {
+                long p = i * (cols + 1) + j;
+                triangles.col(index++) << p, p + 1, p + cols + 2;
+                triangles.col(index++) << p, p + cols + 2, p + cols + 1;
+            }
+        }
+        return lscmrelax::LscmRelax(vertices, triangles, std::vector<long>());
+    }
+};
+
+TEST_F(MeshFlatteningTest, testRelaxKeepsArea)
+{
+    auto flattener = makeCylinder(20, 40);
+    flattener.lscm();
+    for (int i = 0; i < 5; i++) {
+        flattener.relax(0.95);
+    }
+
+    EXPECT_NEAR(flattener.get_area(), 2.0 * std::numbers::pi, 0.05);
+    EXPECT_NEAR(flattener.get_flat_area(), flattener.get_area(), 0.01 * flattener.get_area());
+}
+
+TEST_F(MeshFlatteningTest, testRelaxIsReproducible)
+{
+    auto flattener1 = makeCylinder(10, 20);
+    auto flattener2 = makeCylinder(10, 20);
+    flattener1.lscm();
+    flattener2.lscm();
+    for (int i = 0; i < 3; i++) {
+        flattener1.relax(0.95);
+        flattener2.relax(0.95);
+    }
+
+    EXPECT_TRUE(flattener1.flat_vertices.isApprox(flattener2.flat_vertices, 1e-10));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
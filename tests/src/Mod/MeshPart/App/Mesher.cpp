@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRep_Builder.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Ax2.hxx>
+
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MesherTest: public ::testing::Test
+{
+protected:
+    // an assembly of boxes and cylinders where neighboured boxes touch each other
+    TopoDS_Compound makeAssembly(int size) const
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(i, j, 0), 1.0, 1.0, 1.0).Solid());
+                gp_Ax2 axis(gp_Pnt(i + 0.5, j + 0.5, 1.0), gp_Dir(0, 0, 1));
+                builder.Add(comp, BRepPrimAPI_MakeCylinder(axis, 0.3, 1.0).Solid());
+            }
+        }
+        return comp;
+    }
+
+    std::unique_ptr<Mesh::MeshObject> createMesh(const TopoDS_Shape& shape, bool parallel)
+    {
+        MeshPart::Mesher mesher(shape);
+        mesher.setMethod(MeshPart::Mesher::Standard);
+        mesher.setDeflection(0.01);
+        mesher.setAngularDeflection(0.5);
+        mesher.setSegments(true);
+        mesher.setParallel(parallel);
+
+        return std::unique_ptr<Mesh::MeshObject>(mesher.createMesh());
+    }
+};
+
+TEST_F(MesherTest, testParallelIsIdentical)
+{
+    TopoDS_Compound assembly = makeAssembly(20);
+    auto mesh1 = createMesh(assembly, false);
+    auto mesh2 = createMesh(assembly, true);
+
+    const MeshCore::MeshKernel& kernel1 = mesh1->getKernel();
+    const MeshCore::MeshKernel& kernel2 = mesh2->getKernel();
+    ASSERT_EQ(kernel1.CountPoints(), kernel2.CountPoints());
+    ASSERT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+    EXPECT_GT(kernel1.CountFacets(), 0);
+    for (std::size_t i = 0; i < kernel1.CountPoints(); i++) {
+        EXPECT_EQ(kernel1.GetPoint(i), kernel2.GetPoint(i));
+    }
+    const MeshCore::MeshFacetArray& facets1 = kernel1.GetFacets();
+    const MeshCore::MeshFacetArray& facets2 = kernel2.GetFacets();
+    for (std::size_t i = 0; i < facets1.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facets1[i]._aulPoints[j], facets2[i]._aulPoints[j]);
+        }
+    }
+
+    ASSERT_EQ(mesh1->countSegments(), mesh2->countSegments());
+    for (unsigned long i = 0; i < mesh1->countSegments(); i++) {
+        EXPECT_EQ(mesh1->getSegment(i).getIndices(), mesh2->getSegment(i).getIndices());
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include "Mod/Part/App/BRepMesh.h"
 
 // NOLINTBEGIN
@@ -128,6 +130,65 @@ protected:
         domains.push_back(domain2);
         return domains;
     }
+
+    // A grid of faces that share their boundary points. The inner points are moved by less than
+    // the tolerance, every face has an unused point and a degenerated facet.
+    std::vector<Part::BRepMesh::Domain> getGridDomains(int numFaces, int size) const
+    {
+        std::vector<Part::BRepMesh::Domain> domains;
+        for (int fy = 0; fy < numFaces; fy++) {
+            for (int fx = 0; fx < numFaces; fx++) {
+                Part::BRepMesh::Domain domain;
+                for (int j = 0; j <= size; j++) {
+                    for (int i = 0; i <= size; i++) {
+                        bool border = i == 0 || j == 0 || i == size || j == size;
+                        double x = fx + double(i) / size;
+                        double y = fy + double(j) / size;
+                        double eps = border ? 0.0 : 1.0e-9 * ((i * 7 + j * 3) % 5 - 2);
+                        domain.points.emplace_back(x + eps, y, std::sin(x + y));
+                    }
+                }
+                domain.points.emplace_back(100, 100, 100);
+
+                for (int j = 0; j < size; j++) {
+                    for (int i = 0; i < size; i++) {
+                        uint32_t p1 = j * (size + 1) + i;
+                        uint32_t p2 = p1 + size + 1;
+                        domain.facets.push_back({p1, p1 + 1, p2 + 1});
+                        domain.facets.push_back({p1, p2 + 1, p2});
+                    }
+                }
+                domain.facets.push_back({0, 0, 1});
+                // start the faces at different corners
+                std::rotate(domain.facets.begin(),
+                            domain.facets.begin() + (fx * 5 + fy) % domain.facets.size(),
+                            domain.facets.end());
+                domains.push_back(domain);
+            }
+        }
+        return domains;
+    }
+
+    void compareParallel(const std::vector<Part::BRepMesh::Domain>& domains) const
+    {
+        std::vector<Base::Vector3d> points1, points2;
+        std::vector<Part::BRepMesh::Facet> faces1, faces2;
+        Part::BRepMesh brepMesh1, brepMesh2;
+        brepMesh1.getFacesFromDomains(domains, points1, faces1);
+        brepMesh2.getFacesFromDomainsParallel(domains, points2, faces2);
+
+        ASSERT_EQ(points1.size(), points2.size());
+        ASSERT_EQ(faces1.size(), faces2.size());
+        for (std::size_t i = 0; i < points1.size(); i++) {
+            EXPECT_EQ(points1[i], points2[i]);
+        }
+        for (std::size_t i = 0; i < faces1.size(); i++) {
+            EXPECT_EQ(faces1[i].I1, faces2[i].I1);
+            EXPECT_EQ(faces1[i].I2, faces2[i].I2);
+            EXPECT_EQ(faces1[i].I3, faces2[i].I3);
+        }
+        EXPECT_EQ(brepMesh1.createSegments(), brepMesh2.createSegments());
+    }
 };
 
 TEST_F(BRepMeshTest, testNoDomains)
@@ -173,4 +234,13 @@ TEST_F(BRepMeshTest, testUnconnectedDomains)
     EXPECT_EQ(points.size(), 6);
     EXPECT_EQ(faces.size(), 4);
 }
+
+TEST_F(BRepMeshTest, testParallel)
+{
+    compareParallel(getNoDomains());
+    compareParallel(getEmptyDomains());
+    compareParallel(getConnectedDomains());
+    compareParallel(getUnconnectedDomains());
+    compareParallel(getGridDomains(30, 20));
+}
 // NOLINTEND
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <numbers>
+#include <set>
+#include "src/App/InitApplication.h"
+#include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+
+#include "PartTestHelpers.h"
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRep_Builder.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Ax2.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+using namespace Part;
+using namespace PartTestHelpers;
+
+class FCBRepAlgoAPI_BooleanOperationTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        FCBRepAlgoAPIHelper::setSplitDisjoint(true);
+    }
+
+    void TearDown() override
+    {
+        FCBRepAlgoAPIHelper::setSplitDisjoint(false);
+    }
+
+    // square plates of the given size next to each other along x
+    static TopoDS_Shape makePlates(int count, double size)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (int i = 0; i < count; i++) {
+            gp_Pnt corner((size + 2.0) * i, 0.0, 0.0);
+            builder.Add(comp, BRepPrimAPI_MakeBox(corner, size, size, 1.0).Shape());
+        }
+        return comp;
+    }
+
+    // holes with a spacing of 5 through the plates of makePlates()
+    static TopoDS_Shape makeHoles(int count, double size)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        int perPlate = static_cast<int>(size / 5.0);
+        for (int i = 0; i < count; i++) {
+            for (int x = 0; x < perPlate; x++) {
+                for (int y = 0; y < perPlate; y++) {
+                    gp_Ax2 axis(gp_Pnt((size + 2.0) * i + 5.0 * x + 2.5, 5.0 * y + 2.5, -1.0),
+                                gp_Dir(0.0, 0.0, 1.0));
+                    builder.Add(comp, BRepPrimAPI_MakeCylinder(axis, 1.0, 3.0).Shape());
+                }
+            }
+        }
+        return comp;
+    }
+};
+
+TEST_F(FCBRepAlgoAPI_BooleanOperationTest, cutCompoundKeepsHistory)
+{
+    // Arrange
+    TopoShape plates {makePlates(4, 20.0), 1L};
+    TopoShape holes {makeHoles(4, 20.0), 2L};
+    // Act
+    TopoShape result;
+    result.makeElementBoolean(Part::OpCodes::Cut, {plates, holes});
+    FCBRepAlgoAPIHelper::setSplitDisjoint(false);
+    TopoShape single;
+    single.makeElementBoolean(Part::OpCodes::Cut, {plates, holes});
+    // Assert
+    EXPECT_NEAR(getVolume(result.getShape()), getVolume(single.getShape()), 1e-6);
+    EXPECT_NEAR(getVolume(result.getShape()), 4 * (400.0 - 16 * std::numbers::pi), 1e-3);
+    auto faces = result.countSubShapes(TopAbs_FACE);
+    EXPECT_EQ(faces, single.countSubShapes(TopAbs_FACE));
+    auto elements = elementMap(result);
+    for (unsigned long i = 1; i <= faces; i++) {
+        EXPECT_EQ(elements.count(IndexedName("Face", static_cast<int>(i))), 1);
+    }
+}
+
+TEST_F(FCBRepAlgoAPI_BooleanOperationTest, cutOverlappingChildrenMatchesSingle)
+{
+    // Arrange: the children of a compound are cut one by one, also if they overlap
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(0.0, 0.0, 0.0), 2.0, 2.0, 1.0).Shape());
+    builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(1.0, 0.0, 0.0), 2.0, 2.0, 1.0).Shape());
+    builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(10.0, 0.0, 0.0), 2.0, 2.0, 1.0).Shape());
+    TopoShape boxes {comp, 1L};
+    gp_Dir dir(0.0, 0.0, 1.0);
+    TopoShape hole1 {BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(1.5, 1.0, -1.0), dir), 0.25, 3.0)
+                         .Shape(),
+                     2L};
+    TopoShape hole2 {BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(11.0, 1.0, -1.0), dir), 0.25, 3.0)
+                         .Shape(),
+                     3L};
+    // Act
+    TopoShape result;
+    result.makeElementBoolean(Part::OpCodes::Cut, {boxes, hole1, hole2});
+    FCBRepAlgoAPIHelper::setSplitDisjoint(false);
+    TopoShape single;
+    single.makeElementBoolean(Part::OpCodes::Cut, {boxes, hole1, hole2});
+    // Assert
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 3);
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), single.countSubShapes(TopAbs_SOLID));
+    EXPECT_NEAR(getVolume(result.getShape()), 3 * (2.0 - 0.0625 * std::numbers::pi), 1e-6);
+    std::set<std::string> names;
+    std::set<std::string> singleNames;
+    for (const auto& [index, name] : elementMap(result)) {
+        names.insert(name.toString());
+    }
+    for (const auto& [index, name] : elementMap(single)) {
+        singleNames.insert(name.toString());
+    }
+    EXPECT_EQ(names, singleNames);
+}
+
+TEST_F(FCBRepAlgoAPI_BooleanOperationTest, fuseDisjointClustersKeepsHistory)
+{
+    // Arrange: pairs of overlapping boxes far away from each other
+    std::vector<TopoShape> shapes;
+    for (int i = 0; i < 10; i++) {
+        shapes.emplace_back(BRepPrimAPI_MakeBox(gp_Pnt(5.0 * i, 0.0, 0.0), 1.0, 1.0, 1.0).Shape(),
+                            2L * i + 1);
+        shapes.emplace_back(BRepPrimAPI_MakeBox(gp_Pnt(5.0 * i + 0.5, 0.5, 0.0), 1.0, 1.0, 1.0)
+                                .Shape(),
+                            2L * i + 2);
+    }
+    // Act
+    TopoShape result;
+    result.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    FCBRepAlgoAPIHelper::setSplitDisjoint(false);
+    TopoShape single;
+    single.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    // Assert
+    EXPECT_NEAR(getVolume(result.getShape()), 10 * 1.75, 1e-6);
+    EXPECT_NEAR(getVolume(result.getShape()), getVolume(single.getShape()), 1e-6);
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 10);
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), single.countSubShapes(TopAbs_FACE));
+    std::set<std::string> names;
+    std::set<std::string> singleNames;
+    for (const auto& [index, name] : elementMap(result)) {
+        names.insert(name.toString());
+    }
+    for (const auto& [index, name] : elementMap(single)) {
+        singleNames.insert(name.toString());
+    }
+    EXPECT_EQ(names, singleNames);
+}
+
+TEST_F(FCBRepAlgoAPI_BooleanOperationTest, commonDropsUntouchedRegions)
+{
+    // Arrange
+    TopoShape plates {makePlates(3, 10.0), 1L};
+    TopoShape tool {BRepPrimAPI_MakeBox(gp_Pnt(2.0, 2.0, -1.0), 2.0, 2.0, 3.0).Shape(), 2L};
+    // Act
+    TopoShape result;
+    result.makeElementBoolean(Part::OpCodes::Common, {plates, tool});
+    // Assert
+    EXPECT_NEAR(getVolume(result.getShape()), 4.0, 1e-6);
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 1);
+}
+
+TEST_F(FCBRepAlgoAPI_BooleanOperationTest, cutPerforatedPlateMatchesSingle)
+{
+    // Arrange: all holes touch the one plate, so the cut isn't split
+    TopoDS_Shape plate = BRepPrimAPI_MakeBox(20.0, 20.0, 1.0).Shape();
+    TopoDS_Shape holes = makeHoles(1, 20.0);
+    // Act
+    FCBRepAlgoAPI_Cut split(plate, holes);
+    FCBRepAlgoAPIHelper::setSplitDisjoint(false);
+    FCBRepAlgoAPI_Cut single(plate, holes);
+    // Assert
+    ASSERT_TRUE(split.IsDone());
+    ASSERT_TRUE(single.IsDone());
+    EXPECT_NEAR(getVolume(split.Shape()), 400.0 - 16 * std::numbers::pi, 1e-3);
+    EXPECT_NEAR(getVolume(split.Shape()), getVolume(single.Shape()), 1e-6);
+    EXPECT_EQ(TopoShape(split.Shape()).countSubShapes(TopAbs_FACE),
+              TopoShape(single.Shape()).countSubShapes(TopAbs_FACE));
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <App/Application.h>
 #include "Mod/Part/App/FeaturePartFuse.h"
 #include <src/App/InitApplication.h>
 #include "Mod/Part/App/FeatureCompound.h"
@@ -22,10 +23,19 @@ protected:
         createTestDoc();
         _fuse = _doc->addObject<Part::Fuse>();
         _multiFuse = _doc->addObject<Part::MultiFuse>();
+        getPartParameter()->SetBool("CacheFeatureResults", true);
     }
 
     void TearDown() override
-    {}
+    {
+        getPartParameter()->RemoveBool("CacheFeatureResults");
+    }
+
+    static ParameterGrp::handle getPartParameter()
+    {
+        return App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+    }
 
     Part::Fuse* _fuse = nullptr;            // NOLINT Can't be private in a test framework
     Part::MultiFuse* _multiFuse = nullptr;  // NOLINT Can't be private in a test framework
@@ -269,4 +279,86 @@ TEST_F(FeaturePartFuseTest, testRefine)
     EXPECT_EQ(_fuse->Shape.getShape().getElementMapSize(), 26);
 }
 
+TEST_F(FeaturePartFuseTest, testResultCache)
+{
+    // Arrange
+    _fuse->Base.setValue(_boxes[0]);
+    _fuse->Tool.setValue(_boxes[1]);
+    _fuse->recomputeFeature(true);
+    uint64_t hash = _fuse->getInputHash();
+    Part::Feature::resetResultCacheStatistics();
+
+    // Act: the inputs didn't change
+    _fuse->touch();
+    _fuse->recomputeFeature(true);
+    auto stats = Part::Feature::getResultCacheStatistics();
+
+    // Assert
+    EXPECT_EQ(_fuse->getInputHash(), hash);
+    EXPECT_EQ(stats.hits, 1UL);
+    EXPECT_EQ(stats.misses, 0UL);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_fuse->Shape.getValue()), 9.0);
+
+    // Act: a changed box invalidates the result
+    _boxes[0]->Length.setValue(2);
+    _fuse->recomputeFeature(true);
+    stats = Part::Feature::getResultCacheStatistics();
+
+    // Assert
+    EXPECT_NE(_fuse->getInputHash(), hash);
+    EXPECT_EQ(stats.hits, 1UL);
+    EXPECT_EQ(stats.misses, 1UL);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_fuse->Shape.getValue()), 15.0);
+}
+
+TEST_F(FeaturePartFuseTest, testResultCacheForcedRecompute)
+{
+    // Arrange
+    _fuse->Base.setValue(_boxes[0]);
+    _fuse->Tool.setValue(_boxes[1]);
+    _fuse->recomputeFeature(true);
+    Part::Feature::resetResultCacheStatistics();
+
+    // Act: 'Mark to recompute' executes even if the input didn't change
+    _fuse->enforceRecompute();
+    _fuse->recomputeFeature(true);
+    auto stats = Part::Feature::getResultCacheStatistics();
+
+    // Assert
+    EXPECT_EQ(stats.hits, 0UL);
+    EXPECT_EQ(stats.misses, 1UL);
+    EXPECT_FALSE(_fuse->testStatus(App::ObjectStatus::ForceRecompute));
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_fuse->Shape.getValue()), 9.0);
+}
+
+TEST_F(FeaturePartFuseTest, testResultCacheShapeIdentity)
+{
+    // Arrange
+    auto base = _doc->addObject<Part::Feature>("Base");
+    Part::TopoShape shape {BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape(), 10L};
+    base->Shape.setValue(shape);
+    _fuse->Base.setValue(base);
+    _fuse->Tool.setValue(_boxes[1]);
+    uint64_t hash = _fuse->getInputHash();
+
+    // Act: the same shape is set again
+    base->Shape.setValue(shape);
+
+    // Assert
+    EXPECT_EQ(_fuse->getInputHash(), hash);
+
+    // Act: an equal but new shape
+    base->Shape.setValue(Part::TopoShape {BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape(), 10L});
+    uint64_t newHash = _fuse->getInputHash();
+
+    // Assert
+    EXPECT_NE(newHash, hash);
+
+    // Act: the same shape at another placement
+    base->Placement.setValue(Base::Placement(Base::Vector3d(1.0, 0.0, 0.0), Base::Rotation()));
+
+    // Assert
+    EXPECT_NE(_fuse->getInputHash(), newHash);
+}
+
 // See FeaturePartCommon.cpp for a history test.  It would be exactly the same and redundant here.
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <Mod/Part/App/FeatureGeometrySet.h>
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/Part/App/GeometryExtension.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+
+/// Counts the clones of the geometries it is attached to
+class CountingExtension: public Part::GeometryExtension
+{
+    TYPESYSTEM_HEADER_WITH_OVERRIDE();
+
+public:
+    static int copies;
+
+    std::unique_ptr<Part::GeometryExtension> copy() const override
+    {
+        ++copies;
+        auto cpy = std::make_unique<CountingExtension>();
+        copyAttributes(cpy.get());
+        return cpy;
+    }
+
+    PyObject* getPyObject() override
+    {
+        return nullptr;
+    }
+};
+
+int CountingExtension::copies = 0;
+
+TYPESYSTEM_SOURCE(CountingExtension, Part::GeometryExtension)
+
+}  // namespace
+
+class PropertyGeometryListTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Part");
+        if (CountingExtension::getClassTypeId().isBad()) {
+            CountingExtension::init();
+        }
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _doc->setUndoMode(1);
+        _feature = _doc->addObject<Part::FeatureGeometrySet>();
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    // a sketch sized list of line segments
+    static std::vector<Part::Geometry*> makeGeometries(double offset)
+    {
+        std::vector<Part::Geometry*> geometries;
+        for (int i = 0; i < 2000; i++) {
+            auto line = new Part::GeomLineSegment();
+            line->setPoints(Base::Vector3d(i, offset, 0), Base::Vector3d(i, offset + 1, 0));
+            line->setExtension(std::make_unique<CountingExtension>());
+            geometries.push_back(line);
+        }
+        return geometries;
+    }
+
+    std::string _docName;
+    App::Document* _doc = nullptr;
+    Part::FeatureGeometrySet* _feature = nullptr;
+};
+
+TEST_F(PropertyGeometryListTest, testUndoCopySharesReplacedGeometries)
+{
+    // Arrange
+    _feature->GeometrySet.setValues(makeGeometries(0.0));
+    CountingExtension::copies = 0;
+
+    // Act: replace all geometries like the solver does
+    _doc->openTransaction("replace");
+    _feature->GeometrySet.setValues(makeGeometries(1.0));
+    _doc->commitTransaction();
+
+    // Assert: the undo copy took over the old geometries instead of cloning them
+    EXPECT_EQ(CountingExtension::copies, 0);
+    ASSERT_TRUE(_doc->undo());
+    const auto& values = _feature->GeometrySet.getValues();
+    ASSERT_EQ(values.size(), 2000U);
+    auto line = dynamic_cast<Part::GeomLineSegment*>(values[10]);
+    ASSERT_NE(line, nullptr);
+    EXPECT_DOUBLE_EQ(line->getStartPoint().y, 0.0);
+}
+
+TEST_F(PropertyGeometryListTest, testUndoCopyClonesKeptGeometries)
+{
+    // Arrange
+    _feature->GeometrySet.setValues(makeGeometries(0.0));
+    CountingExtension::copies = 0;
+
+    // Act: change one geometry like an edit of a sketch does
+    _doc->openTransaction("change");
+    std::vector<Part::Geometry*> values = _feature->GeometrySet.getValues();
+    auto line = static_cast<Part::GeomLineSegment*>(values[10]->clone());
+    line->setPoints(Base::Vector3d(10, 5, 0), Base::Vector3d(10, 6, 0));
+    values[10] = line;
+    _feature->GeometrySet.setValues(std::move(values));
+    _doc->commitTransaction();
+
+    // Assert: the undo copy clones the kept geometries but not the replaced one
+    EXPECT_EQ(CountingExtension::copies, 2000);
+    auto changed = dynamic_cast<Part::GeomLineSegment*>(_feature->GeometrySet[10]);
+    ASSERT_NE(changed, nullptr);
+    EXPECT_DOUBLE_EQ(changed->getStartPoint().y, 5.0);
+    ASSERT_TRUE(_doc->undo());
+    auto restored = dynamic_cast<Part::GeomLineSegment*>(_feature->GeometrySet[10]);
+    ASSERT_NE(restored, nullptr);
+    EXPECT_DOUBLE_EQ(restored->getStartPoint().y, 0.0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -3,6 +3,13 @@
 #include <gtest/gtest.h>
 
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Precision.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp_Trsf.hxx>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
@@ -30,7 +37,12 @@ protected:
     }
 
     void TearDown() override
-    {}
+    {
+        // a failed assertion must not leave the option on for the following tests
+        App::GetApplication()
+            .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+            ->RemoveBool("SaveSharedShapes");
+    }
 
     std::string getDocumentXml() const
     {
@@ -269,3 +281,126 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testSaveSharedShape)
+{
+    // Arrange: several features holding the same shape, one of them moved and reversed
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5.0, 0.0, 0.0));
+    std::vector<Part::Feature*> features;
+    for (int i = 0; i < 10; i++) {
+        auto feature = _doc->addObject<Part::Feature>("Shared");
+        feature->Shape.setValue(box);
+        features.push_back(feature);
+    }
+    features.back()->Shape.setValue(box.Moved(TopLoc_Location(trsf)).Reversed());
+
+    auto save = [this](const std::string& name) {
+        Base::FileInfo fi(App::Application::getTempPath() + name);
+        EXPECT_TRUE(_doc->saveCopy(fi.filePath().c_str()));
+        return fi;
+    };
+
+    // Act
+    hGrp->SetBool("SaveSharedShapes", false);
+    Base::FileInfo unshared = save("UnsharedShapes.FCStd");
+    hGrp->SetBool("SaveSharedShapes", true);
+    Base::FileInfo shared = save("SharedShapes.FCStd");
+    auto doc = App::GetApplication().openDocument(shared.filePath().c_str());
+
+    // Assert
+    EXPECT_LT(shared.size(), unshared.size());
+    ASSERT_TRUE(doc);
+    std::vector<TopoDS_Shape> shapes;
+    for (auto feature : features) {
+        auto obj = dynamic_cast<Part::Feature*>(doc->getObject(feature->getNameInDocument()));
+        ASSERT_TRUE(obj);
+        shapes.push_back(obj->Shape.getValue());
+    }
+    for (std::size_t i = 1; i < shapes.size(); i++) {
+        EXPECT_TRUE(shapes[i].IsPartner(shapes[0]));
+    }
+    EXPECT_TRUE(shapes[0].Location().IsIdentity());
+    EXPECT_EQ(shapes[0].Orientation(), box.Orientation());
+    EXPECT_EQ(shapes.back().Orientation(), TopAbs::Reverse(box.Orientation()));
+    EXPECT_TRUE(shapes.back().Location().Transformation().TranslationPart().IsEqual(
+        gp_XYZ(5.0, 0.0, 0.0),
+        Precision::Confusion()));
+
+    App::GetApplication().closeDocument(doc->getName());
+    unshared.deleteFile();
+    shared.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testRestoreSharedElementMap)
+{
+    // Arrange: a feature sharing the shape and the element map of the common
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    auto copy = _doc->addObject<Part::Feature>("Copy");
+    copy->Shape.setValue(_common->Shape.getShape());
+    auto expected = elementMap(_common->Shape.getShape());
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(elementMap(copy->Shape.getShape()), expected);
+
+    // Act
+    hGrp->SetBool("SaveSharedShapes", true);
+    Base::FileInfo fi(App::Application::getTempPath() + "SharedElementMap.FCStd");
+    EXPECT_TRUE(_doc->saveCopy(fi.filePath().c_str()));
+    hGrp->SetBool("SaveSharedShapes", false);
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+
+    // Assert
+    ASSERT_TRUE(doc);
+    auto common = dynamic_cast<Part::Feature*>(doc->getObject(_common->getNameInDocument()));
+    auto restored = dynamic_cast<Part::Feature*>(doc->getObject(copy->getNameInDocument()));
+    ASSERT_TRUE(common);
+    ASSERT_TRUE(restored);
+    EXPECT_TRUE(restored->Shape.getValue().IsPartner(common->Shape.getValue()));
+    EXPECT_EQ(elementMap(common->Shape.getShape()), expected);
+    EXPECT_EQ(elementMap(restored->Shape.getShape()), expected);
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testSaveBinaryBrep)
+{
+    // Arrange: features with different shapes, so that none of them is saved shared
+    std::vector<Part::Feature*> features;
+    for (int i = 0; i < 20; i++) {
+        auto feature = _doc->addObject<Part::Feature>("Box");
+        feature->Shape.setValue(BRepPrimAPI_MakeBox(1.0 + i, 2.0, 3.0).Shape());
+        features.push_back(feature);
+    }
+
+    auto save = [this](const std::string& name, bool binary) {
+        Base::FileInfo fi(App::Application::getTempPath() + name);
+        _doc->SaveBinaryBrep.setValue(binary);
+        EXPECT_TRUE(_doc->saveCopy(fi.filePath().c_str()));
+        return fi;
+    };
+
+    // Act
+    Base::FileInfo text = save("TextBrep.FCStd", false);
+    Base::FileInfo binary = save("BinaryBrep.FCStd", true);
+    auto doc = App::GetApplication().openDocument(binary.filePath().c_str());
+
+    // Assert
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(doc->SaveBinaryBrep.getValue());
+    for (auto feature : features) {
+        auto obj = dynamic_cast<Part::Feature*>(doc->getObject(feature->getNameInDocument()));
+        ASSERT_TRUE(obj);
+        EXPECT_NEAR(PartTestHelpers::getVolume(obj->Shape.getValue()),
+                    PartTestHelpers::getVolume(feature->Shape.getValue()),
+                    Precision::Confusion());
+    }
+
+    App::GetApplication().closeDocument(doc->getName());
+    text.deleteFile();
+    binary.deleteFile();
+}
@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp_Trsf.hxx>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include "Mod/Part/App/PartFeature.h"
+#include "Mod/Part/App/TessellationCache.h"
+#include <src/App/InitApplication.h>
+#include "PartTestHelpers.h"
+
+using namespace Part;
+using namespace PartTestHelpers;
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class TessellationCacheTest: public ::testing::Test, public PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        TessellationCache::resetStatistics();
+    }
+
+    void TearDown() override
+    {}
+
+    // a single triangle
+    static TessellationCache::Arrays makeArrays()
+    {
+        TessellationCache::Arrays arrays;
+        arrays.points = {{0.0F, 0.0F, 0.0F}, {1.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}};
+        arrays.normals = {{0.0F, 0.0F, 1.0F}, {0.0F, 0.0F, 1.0F}, {0.0F, 0.0F, 1.0F}};
+        arrays.faceIndex = {0, 1, 2, -1};
+        arrays.partIndex = {1};
+        arrays.lineIndex = {0, 1, -1, 1, 2, -1, 2, 0, -1};
+        arrays.nodeStart = 3;
+        return arrays;
+    }
+
+    static void expectEqual(const TessellationCache::Arrays& arrays1,
+                            const TessellationCache::Arrays& arrays2)
+    {
+        EXPECT_EQ(arrays1.points, arrays2.points);
+        EXPECT_EQ(arrays1.normals, arrays2.normals);
+        EXPECT_EQ(arrays1.faceIndex, arrays2.faceIndex);
+        EXPECT_EQ(arrays1.partIndex, arrays2.partIndex);
+        EXPECT_EQ(arrays1.lineIndex, arrays2.lineIndex);
+        EXPECT_EQ(arrays1.nodeStart, arrays2.nodeStart);
+    }
+};
+
+TEST_F(TessellationCacheTest, testHit)
+{
+    // Arrange: the key doesn't depend on the location
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5.0, 0.0, 0.0));
+    TopoDS_Shape moved = box.Moved(TopLoc_Location(trsf));
+    TessellationCache cache(TessellationCache::makeKey(box, 1, 0.1, 0.5, true), makeArrays());
+
+    // Act
+    uint64_t key = TessellationCache::makeKey(moved, 1, 0.1, 0.5, true);
+
+    // Assert
+    EXPECT_EQ(key, cache.getKey());
+    EXPECT_TRUE(cache.lookup(key));
+    EXPECT_EQ(TessellationCache::getStatistics().hits, 1UL);
+    EXPECT_EQ(TessellationCache::getStatistics().misses, 0UL);
+}
+
+TEST_F(TessellationCacheTest, testKeyAfterReload)
+{
+    // Arrange: the shape of a reloaded document
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(gp_Pnt(0.1, 0.2, 0.3), 1.0 / 3.0, 2.0, 3.0).Shape();
+    std::stringstream str;
+    TopoShape(box).exportBrep(str);
+    TopoShape restored;
+    restored.importBrep(str);
+
+    // Act
+    uint64_t key = TessellationCache::makeKey(restored.getShape(), 1, 0.1, 0.5, true);
+
+    // Assert
+    EXPECT_EQ(key, TessellationCache::makeKey(box, 1, 0.1, 0.5, true));
+}
+
+TEST_F(TessellationCacheTest, testMissOnChangedShape)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    uint64_t key = TessellationCache::makeKey(box, 1, 0.1, 0.5, true);
+
+    // Act
+    TopoDS_Shape longer = BRepPrimAPI_MakeBox(1.0, 2.0, 4.0).Shape();
+
+    // Assert
+    EXPECT_NE(TessellationCache::makeKey(longer, 1, 0.1, 0.5, true), key);
+    EXPECT_NE(TessellationCache::makeKey(box, 2, 0.1, 0.5, true), key);
+}
+
+TEST_F(TessellationCacheTest, testMissOnChangedDeflection)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    TessellationCache cache(TessellationCache::makeKey(box, 1, 0.1, 0.5, true), makeArrays());
+
+    // Act
+    uint64_t key = TessellationCache::makeKey(box, 1, 0.2, 0.5, true);
+
+    // Assert
+    EXPECT_NE(key, cache.getKey());
+    EXPECT_NE(TessellationCache::makeKey(box, 1, 0.1, 0.6, true), cache.getKey());
+    EXPECT_NE(TessellationCache::makeKey(box, 1, 0.1, 0.5, false), cache.getKey());
+    EXPECT_FALSE(cache.lookup(key));
+    EXPECT_FALSE(TessellationCache().lookup(cache.getKey()));
+    EXPECT_EQ(TessellationCache::getStatistics().hits, 0UL);
+    EXPECT_EQ(TessellationCache::getStatistics().misses, 2UL);
+}
+
+TEST_F(TessellationCacheTest, testRestore)
+{
+    // Arrange
+    TessellationCache cache(12345, makeArrays());
+    std::stringstream str;
+    {
+        Base::OutputStream out(str);
+        cache.save(out);
+    }
+
+    // Act
+    TessellationCache restored;
+    Base::InputStream in(str);
+    restored.restore(in, str);
+
+    // Assert
+    EXPECT_EQ(restored.getKey(), 12345UL);
+    expectEqual(restored.getArrays(), makeArrays());
+    EXPECT_EQ(restored.getMemSize(), cache.getMemSize());
+    EXPECT_TRUE(restored.lookup(12345));
+}
+
+TEST_F(TessellationCacheTest, testRestoreTruncated)
+{
+    // Arrange
+    TessellationCache cache(12345, makeArrays());
+    std::stringstream str;
+    {
+        Base::OutputStream out(str);
+        cache.save(out);
+    }
+    std::stringstream truncated(str.str().substr(0, str.str().size() / 2));
+
+    // Act
+    TessellationCache restored;
+    Base::InputStream in(truncated);
+
+    // Assert
+    EXPECT_THROW(restored.restore(in, truncated), Base::FileException);
+    EXPECT_TRUE(restored.isEmpty());
+    EXPECT_EQ(restored.getKey(), 0UL);
+}
+
+TEST_F(TessellationCacheTest, testRestoreInvalidCount)
+{
+    // Arrange: a count of points that is much larger than the stream
+    std::stringstream str;
+    {
+        Base::OutputStream out(str);
+        out << uint64_t(12345) << uint32_t(0xffffffff);
+    }
+
+    // Act
+    TessellationCache restored;
+    Base::InputStream in(str);
+
+    // Assert
+    EXPECT_THROW(restored.restore(in, str), Base::FileException);
+    EXPECT_TRUE(restored.isEmpty());
+}
+
+TEST_F(TessellationCacheTest, testRestoreInvalidIndex)
+{
+    // Arrange: a triangle with a point index out of range
+    TessellationCache::Arrays arrays = makeArrays();
+    arrays.faceIndex[1] = 3;
+    TessellationCache cache(12345, arrays);
+    std::stringstream str;
+    {
+        Base::OutputStream out(str);
+        cache.save(out);
+    }
+
+    // Act
+    TessellationCache restored;
+    Base::InputStream in(str);
+
+    // Assert
+    EXPECT_THROW(restored.restore(in, str), Base::FileException);
+    EXPECT_TRUE(restored.isEmpty());
+}
+
+TEST_F(TessellationCacheTest, testRestoreDocument)
+{
+    // Arrange: the property is saved into a file of the project
+    auto feature = _doc->addObject<Part::Feature>("Feature");
+    auto prop = static_cast<PropertyTessellationCache*>(
+        feature->addDynamicProperty("Part::PropertyTessellationCache", "Tessellation"));
+    ASSERT_TRUE(prop);
+    prop->setValue(std::make_shared<TessellationCache>(12345, makeArrays()));
+
+    // Act
+    Base::FileInfo fi(App::Application::getTempPath() + "Tessellation.FCStd");
+    EXPECT_TRUE(_doc->saveCopy(fi.filePath().c_str()));
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+
+    // Assert
+    ASSERT_TRUE(doc);
+    auto restored = doc->getObject(feature->getNameInDocument());
+    ASSERT_TRUE(restored);
+    auto restoredProp = freecad_cast<PropertyTessellationCache*>(
+        restored->getPropertyByName("Tessellation"));
+    ASSERT_TRUE(restoredProp);
+    ASSERT_TRUE(restoredProp->getValue());
+    EXPECT_EQ(restoredProp->getValue()->getKey(), 12345UL);
+    expectEqual(restoredProp->getValue()->getArrays(), makeArrays());
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
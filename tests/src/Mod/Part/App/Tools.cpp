@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Part/App/Tools.h>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRep_Builder.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Trsf.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+TEST(PartTools, groupBySharedSubShapesEmpty)
+{
+    // Act
+    auto groups = Part::Tools::groupBySharedSubShapes({});
+
+    // Assert
+    EXPECT_TRUE(groups.empty());
+}
+
+TEST(PartTools, groupBySharedSubShapesDisjoint)
+{
+    // Arrange
+    std::vector<TopoDS_Shape> shapes;
+    for (int i = 0; i < 3; i++) {
+        shapes.push_back(BRepPrimAPI_MakeBox(gp_Pnt(2.0 * i, 0.0, 0.0), 1.0, 1.0, 1.0).Shape());
+    }
+
+    // Act
+    auto groups = Part::Tools::groupBySharedSubShapes(shapes);
+
+    // Assert
+    std::vector<std::vector<std::size_t>> expected {{0}, {1}, {2}};
+    EXPECT_EQ(groups, expected);
+}
+
+TEST(PartTools, groupBySharedSubShapesShared)
+{
+    // Arrange: a box, a moved copy of it, a compound of one of its faces and an unrelated box
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5.0, 0.0, 0.0));
+    TopoDS_Shape moved = box.Moved(TopLoc_Location(trsf));
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    builder.Add(comp, TopExp_Explorer(box, TopAbs_FACE).Current());
+    TopoDS_Shape other = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+
+    // Act
+    auto groups = Part::Tools::groupBySharedSubShapes({other, box, comp, moved});
+
+    // Assert: the shapes share their triangulation, so they must be meshed together
+    std::vector<std::vector<std::size_t>> expected {{0}, {1, 2, 3}};
+    EXPECT_EQ(groups, expected);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -1,6 +1,15 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <sstream>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Ax2.hxx>
 #include "PartTestHelpers.h"
 #include <Mod/Part/App/TopoShape.h>
 #include "src/App/InitApplication.h"
@@ -137,3 +146,96 @@ TEST_F(TopoShapeTest, TestGetSubshape)
 }
 
 // clang-format on
+
+namespace
+{
+// a compound of cylinders, large enough to make the difference between the formats visible
+TopoDS_Shape makeLargeCompound(int count)
+{
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (int i = 0; i < count; i++) {
+        gp_Ax2 axis(gp_Pnt(3.0 * (i % 20), 3.0 * (i / 20), 0.0), gp_Dir(0.0, 0.0, 1.0));
+        builder.Add(comp, BRepPrimAPI_MakeCylinder(axis, 1.0, 2.0).Shape());
+    }
+    return comp;
+}
+
+bool hasTriangulation(const TopoDS_Shape& shape)
+{
+    TopLoc_Location loc;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        if (BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc).IsNull()) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+TEST_F(TopoShapeTest, TestExportImportBinaryVersions)
+{
+    // Arrange
+    Part::TopoShape shape(makeLargeCompound(100));
+    for (int version = 1; version <= 3; version++) {
+        std::stringstream str;
+        // Act
+        shape.exportBinary(str, false, version);
+        Part::TopoShape restored;
+        restored.importBinary(str);
+        // Assert
+        EXPECT_EQ(restored.countSubShapes(TopAbs_FACE), shape.countSubShapes(TopAbs_FACE));
+        EXPECT_NEAR(PartTestHelpers::getVolume(restored.getShape()),
+                    PartTestHelpers::getVolume(shape.getShape()),
+                    1e-6);
+    }
+}
+
+TEST_F(TopoShapeTest, TestExportImportBinaryTriangles)
+{
+    // Arrange
+    TopoDS_Shape comp = makeLargeCompound(4);
+    BRepMesh_IncrementalMesh(comp, 0.1);
+    ASSERT_TRUE(hasTriangulation(comp));
+    Part::TopoShape shape(comp);
+    std::stringstream with;
+    std::stringstream without;
+    // Act
+    shape.exportBinary(with, true, 3);
+    shape.exportBinary(without, false, 3);
+    Part::TopoShape restoredWith;
+    restoredWith.importBinary(with);
+    Part::TopoShape restoredWithout;
+    restoredWithout.importBinary(without);
+    // Assert
+    EXPECT_TRUE(hasTriangulation(restoredWith.getShape()));
+    EXPECT_FALSE(hasTriangulation(restoredWithout.getShape()));
+}
+
+TEST_F(TopoShapeTest, TestImportBinaryInvalid)
+{
+    std::stringstream str("not a binary brep");
+    Part::TopoShape shape;
+    EXPECT_THROW(shape.importBinary(str), Base::Exception);
+}
+
+TEST_F(TopoShapeTest, TestExportImportBinaryMatchesText)
+{
+    // Arrange
+    Part::TopoShape shape(makeLargeCompound(100));
+    std::stringstream text;
+    std::stringstream binary;
+    // Act
+    shape.exportBrep(text);
+    shape.exportBinary(binary, false, 3);
+    Part::TopoShape fromText;
+    fromText.importBrep(text);
+    Part::TopoShape fromBinary;
+    fromBinary.importBinary(binary);
+    // Assert
+    EXPECT_EQ(fromBinary.countSubShapes(TopAbs_FACE), fromText.countSubShapes(TopAbs_FACE));
+    EXPECT_NEAR(PartTestHelpers::getVolume(fromBinary.getShape()),
+                PartTestHelpers::getVolume(fromText.getShape()),
+                1e-6);
+}
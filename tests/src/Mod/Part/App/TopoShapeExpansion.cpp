@@ -9,6 +9,7 @@
 #include "PartTestHelpers.h"
 
 #include <boost/core/ignore_unused.hpp>
+#include <BRep_Tool.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
 #include <BRepAdaptor_Surface.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
@@ -28,6 +29,7 @@
 #include <ShapeFix_Wireframe.hxx>
 #include <ShapeBuild_ReShape.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
 
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -2410,6 +2412,39 @@ TEST_F(TopoShapeExpansionTest, makeElementSlices)
                                                     // again after importing other TopoNaming logics
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementSlicesParallel)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    Base::Vector3d direction {1.0, 0.0, 0.0};
+    std::vector<double> distances;
+    for (int i = 1; i < 100; i++) {
+        distances.push_back(i / 100.0);
+    }
+    // Act
+    auto serial = cube1TS.makeElementSlices(direction, distances, nullptr, false);
+    auto parallel = cube1TS.makeElementSlices(direction, distances, nullptr, true);
+    // Assert the wires are the same and in the order of the distances
+    auto serialWires = serial.getSubTopoShapes(TopAbs_WIRE);
+    auto parallelWires = parallel.getSubTopoShapes(TopAbs_WIRE);
+    ASSERT_EQ(parallelWires.size(), distances.size());
+    ASSERT_EQ(serialWires.size(), parallelWires.size());
+    for (std::size_t i = 0; i < distances.size(); i++) {
+        EXPECT_FLOAT_EQ(getLength(parallelWires[i].getShape()), 4);
+        TopoDS_Vertex vertex = TopoDS::Vertex(parallelWires[i].getSubShape(TopAbs_VERTEX, 1));
+        EXPECT_NEAR(BRep_Tool::Pnt(vertex).X(), distances[i], 1e-7);
+    }
+    // Assert the element maps are the same
+    auto serialMap = serial.getElementMap();
+    auto parallelMap = parallel.getElementMap();
+    ASSERT_EQ(serialMap.size(), parallelMap.size());
+    for (std::size_t i = 0; i < serialMap.size(); i++) {
+        EXPECT_EQ(serialMap[i].index, parallelMap[i].index);
+        EXPECT_EQ(serialMap[i].name.toString(), parallelMap[i].name.toString());
+    }
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementMirror)
 {
     // Arrange
@@ -4,6 +4,10 @@
 
 #include <src/App/InitApplication.h>
 
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <TopTools_ListOfShape.hxx>
+
 #include "PartTestHelpers.h"
 
 class FeaturePartMakeElementRefineTest: public ::testing::Test,
@@ -53,3 +57,35 @@ TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineBoxes)
     // TODO: Refine doesn't work on compounds, so we're going to need a binary operation or the
     // like, and those don't exist yet.  Once they do, this test can be expanded
 }
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineGrid)
+{
+    // Arrange a grid of boxes, all faces on the outside of the grid are split
+    const int count = 20;
+    TopTools_ListOfShape arguments;
+    TopTools_ListOfShape tools;
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < count; j++) {
+            auto box = BRepPrimAPI_MakeBox(gp_Pnt(i, j, 0), 1.0, 1.0, 1.0).Shape();
+            if (arguments.IsEmpty()) {
+                arguments.Append(box);
+            }
+            else {
+                tools.Append(box);
+            }
+        }
+    }
+    BRepAlgoAPI_Fuse mkFuse;
+    mkFuse.SetArguments(arguments);
+    mkFuse.SetTools(tools);
+    mkFuse.Build();
+    ASSERT_TRUE(mkFuse.IsDone());
+    Part::TopoShape ts(mkFuse.Shape(), 1L);
+    // Act
+    Part::TopoShape refined = ts.makeElementRefine();
+    // Assert
+    EXPECT_EQ(ts.countSubElements("Face"), 2 * count * count + 4 * count);
+    EXPECT_EQ(refined.countSubElements("Face"), 6);
+    EXPECT_EQ(refined.countSubElements("Edge"), 12);
+    EXPECT_NEAR(PartTestHelpers::getVolume(refined.getShape()), count * count, 1e-6);
+}
@@ -17,6 +17,9 @@
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_CompSolid.hxx>
 #include <TopoDS_Compound.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 
 using namespace Part;
 using namespace Data;
@@ -37,6 +40,7 @@ protected:
 
     void TearDown() override
     {
+        TopoShape::setLazyElementMap(false);
         App::GetApplication().closeDocument(_docName.c_str());
     }
 
@@ -334,3 +338,67 @@ std::string composeTagInfo(const MappedElement& element, const TopoShape& shape)
 
     return tagInfo;
 }
+
+namespace
+{
+// A fuse, a refine and a cut whose intermediate results are not looked at
+TopoShape makeBooleanChain(const App::StringHasherRef& hasher)
+{
+    auto [cube1, cube2] = PartTestHelpers::CreateTwoCubes();
+    auto [cube3, cube4] = PartTestHelpers::CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(0.5, 0.5, 0.5)));
+    cube3.Move(TopLoc_Location(tr));
+    TopoShape fused {3L, hasher};
+    fused.makeElementBoolean(OpCodes::Fuse,
+                             {TopoShape(cube1, 1L, hasher), TopoShape(cube2, 2L, hasher)});
+    TopoShape refined {4L, hasher};
+    refined.makeElementRefine(fused);
+    TopoShape result {6L, hasher};
+    result.makeElementBoolean(OpCodes::Cut, {refined, TopoShape(cube3, 5L, hasher)});
+    return result;
+}
+}  // namespace
+
+TEST_F(TopoShapeMakeShapeWithElementMapTests, lazyElementMapMatchesEager)
+{
+    // Arrange
+    TopoShape::setLazyElementMap(false);
+    auto eager = makeBooleanChain(App::StringHasherRef());
+    TopoShape::setLazyElementMap(true);
+    auto lazy = makeBooleanChain(App::StringHasherRef());
+    bool pending = lazy.hasPendingElementMap();
+
+    // Act
+    auto eagerFace = eager.getSubTopoShape(TopAbs_FACE, 1);
+    auto lazyFace = lazy.getSubTopoShape(TopAbs_FACE, 1);  // Taken before the map is generated
+    auto lazyFaceElements = elementMap(lazyFace);
+    auto lazyElements = elementMap(lazy);
+
+    // Assert
+    EXPECT_TRUE(pending);
+    EXPECT_FALSE(lazy.hasPendingElementMap());
+    EXPECT_EQ(lazyElements.size(), eager.getElementMapSize());
+    EXPECT_EQ(lazyElements, elementMap(eager));
+    EXPECT_EQ(lazyFaceElements, elementMap(eagerFace));
+}
+
+TEST_F(TopoShapeMakeShapeWithElementMapTests, lazyElementMapMatchesEagerWithHasher)
+{
+    // Arrange
+    App::StringHasherRef eagerHasher(new App::StringHasher);
+    App::StringHasherRef lazyHasher(new App::StringHasher);
+    TopoShape::setLazyElementMap(false);
+    auto eager = makeBooleanChain(eagerHasher);
+    TopoShape::setLazyElementMap(true);
+    auto lazy = makeBooleanChain(lazyHasher);
+    auto copy = lazy;
+
+    // Act
+    auto lazyElements = elementMap(lazy);
+
+    // Assert
+    EXPECT_EQ(lazyHasher->size(), eagerHasher->size());
+    EXPECT_EQ(lazyElements, elementMap(eager));
+    EXPECT_EQ(elementMap(copy), lazyElements);  // Copies share the generated map
+}
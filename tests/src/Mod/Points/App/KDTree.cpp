@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Mod/Points/App/KDTree.h>
+#include <src/Base/TestRandom.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsKDTreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a dense cluster inside a sparse cloud and a few duplicates
+        tests::Random random(7);
+        for (int i = 0; i < 60000; i++) {
+            points.emplace_back(random() * 10.0F, random() * 10.0F, random() * 2.0F);
+        }
+        for (int i = 0; i < 40000; i++) {
+            points.emplace_back(2.0F + random(), 3.0F + random(), 1.0F + random() * 0.1F);
+        }
+        for (int i = 0; i < 20; i++) {
+            points.emplace_back(5.0F, 5.0F, 1.0F);
+        }
+        for (int i = 0; i < 200; i++) {
+            queries.emplace_back(random() * 12.0F - 1.0F, random() * 12.0F - 1.0F, random() * 2.0F);
+        }
+        queries.emplace_back(5.0F, 5.0F, 1.0F);
+        queries.emplace_back(2.5F, 3.5F, 1.05F);
+    }
+
+    std::vector<float> bruteForce(const Base::Vector3f& pnt) const
+    {
+        std::vector<float> dist;
+        for (const auto& it : points) {
+            dist.push_back(Base::Distance(pnt, it));
+        }
+        return dist;
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> queries;
+};
+
+TEST_F(PointsKDTreeTest, TestEmpty)
+{
+    Points::PointsKDTree tree;
+    float dist {};
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.findNearest(Base::Vector3f(), dist), Points::PointsKDTree::npos);
+    std::vector<Points::PointsKDTree::size_type> indices;
+    tree.findInRadius(Base::Vector3f(), 1.0F, indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST_F(PointsKDTreeTest, TestNearest)
+{
+    Points::PointsKDTree tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+    for (const auto& pnt : queries) {
+        std::vector<float> dist = bruteForce(pnt);
+        float minDist {};
+        auto index = tree.findNearest(pnt, minDist);
+        ASSERT_LT(index, points.size());
+        EXPECT_FLOAT_EQ(minDist, *std::min_element(dist.begin(), dist.end()));
+        EXPECT_FLOAT_EQ(dist[index], minDist);
+    }
+}
+
+TEST_F(PointsKDTreeTest, TestKNearest)
+{
+    const std::size_t k = 25;
+    Points::PointsKDTree tree(points);
+    std::vector<Points::PointsKDTree::size_type> batch;
+    tree.findNearest(queries, k, batch);
+    ASSERT_EQ(batch.size(), queries.size() * k);
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        std::vector<float> dist = bruteForce(queries[i]);
+        std::vector<float> sorted = dist;
+        std::nth_element(sorted.begin(), sorted.begin() + k - 1, sorted.end());
+
+        std::vector<Points::PointsKDTree::size_type> indices;
+        std::vector<float> distances;
+        tree.findNearest(queries[i], k, indices, distances);
+        ASSERT_EQ(indices.size(), k);
+        EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+        EXPECT_FLOAT_EQ(distances.back(), sorted[k - 1]);
+        for (std::size_t j = 0; j < k; j++) {
+            EXPECT_FLOAT_EQ(dist[indices[j]], distances[j]);
+            EXPECT_FLOAT_EQ(dist[batch[i * k + j]], distances[j]);
+        }
+    }
+}
+
+TEST_F(PointsKDTreeTest, TestRadius)
+{
+    const float radius = 0.3F;
+    Points::PointsKDTree tree(points);
+    std::vector<std::vector<Points::PointsKDTree::size_type>> batch;
+    tree.findInRadius(queries, radius, batch);
+    ASSERT_EQ(batch.size(), queries.size());
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        std::vector<float> dist = bruteForce(queries[i]);
+        std::vector<Points::PointsKDTree::size_type> expected;
+        for (std::size_t j = 0; j < dist.size(); j++) {
+            if (dist[j] * dist[j] <= radius * radius) {
+                expected.push_back(j);
+            }
+        }
+
+        std::vector<Points::PointsKDTree::size_type> indices = batch[i];
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(indices, expected);
+    }
+}
+
+TEST_F(PointsKDTreeTest, TestInvalidPoints)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<Base::Vector3f> pts {Base::Vector3f(nan, 0, 0),
+                                     Base::Vector3f(1, 0, 0),
+                                     Base::Vector3f(0, nan, 0),
+                                     Base::Vector3f(3, 0, 0)};
+    Points::PointsKDTree tree(pts);
+    EXPECT_EQ(tree.size(), 2);
+
+    std::vector<Points::PointsKDTree::size_type> indices;
+    std::vector<float> distances;
+    tree.findNearest(Base::Vector3f(0, 0, 0), 4, indices, distances);
+    ASSERT_EQ(indices.size(), 2);
+    EXPECT_EQ(indices[0], 1);
+    EXPECT_EQ(indices[1], 3);
+    EXPECT_FLOAT_EQ(distances[1], 3.0F);
+}
+
+TEST_F(PointsKDTreeTest, TestPointKernel)
+{
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(10, 0, 0));
+    kernel.setTransform(mat);
+
+    Points::PointsKDTree tree(kernel);
+    float dist {};
+    auto index = tree.findNearest(Base::Vector3f(15.0F, 5.0F, 1.0F), dist);
+    ASSERT_LT(index, points.size());
+    EXPECT_FLOAT_EQ(dist, 0.0F);
+    EXPECT_EQ(points[index], Base::Vector3f(5.0F, 5.0F, 1.0F));
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Base/FileInfo.h>
+#include <Mod/Points/App/PagedPoints.h>
+#include <src/Base/TestRandom.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PagedPointsTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a dense cluster inside a sparse cloud to get an unbalanced octree
+        tests::Random random(1);
+        for (int i = 0; i < 40000; i++) {
+            points.emplace_back(random() * 10.0F, random() * 10.0F, random() * 2.0F);
+        }
+        for (int i = 0; i < 40000; i++) {
+            points.emplace_back(2.0F + random(), 3.0F + random(), 1.0F + random() * 0.1F);
+        }
+
+        file.setFile(Base::FileInfo::getTempFileName());
+        kernel.setLeafCapacity(2000);
+        kernel.setSampleCapacity(64);
+        kernel.create(file.filePath());
+        std::vector<Base::Vector3f> batch;
+        for (const auto& pnt : points) {
+            batch.push_back(pnt);
+            if (batch.size() == 7000) {
+                kernel.addPoints(batch);
+                batch.clear();
+            }
+        }
+        kernel.addPoints(batch);
+        kernel.finish();
+    }
+
+    void TearDown() override
+    {
+        kernel.close();
+        file.deleteFile();
+    }
+
+    static bool lessPoint(const Base::Vector3f& p1, const Base::Vector3f& p2)
+    {
+        if (p1.x != p2.x) {
+            return p1.x < p2.x;
+        }
+        if (p1.y != p2.y) {
+            return p1.y < p2.y;
+        }
+        return p1.z < p2.z;
+    }
+
+    std::vector<Base::Vector3f> bruteForce(const Base::BoundBox3f& box) const
+    {
+        std::vector<Base::Vector3f> pts;
+        std::copy_if(points.begin(), points.end(), std::back_inserter(pts), [&box](auto& pnt) {
+            return box.IsInBox(pnt);
+        });
+        std::sort(pts.begin(), pts.end(), lessPoint);
+        return pts;
+    }
+
+    std::vector<Base::Vector3f> query(const Points::PointSource& src,
+                                      const Base::BoundBox3f& box) const
+    {
+        std::vector<Base::Vector3f> pts;
+        src.getPointsInBox(box, pts);
+        std::sort(pts.begin(), pts.end(), lessPoint);
+        return pts;
+    }
+
+    Base::FileInfo file;
+    std::vector<Base::Vector3f> points;
+    Points::PagedPointKernel kernel;
+};
+
+TEST_F(PagedPointsTest, TestBuild)
+{
+    EXPECT_TRUE(kernel.isOpen());
+    EXPECT_EQ(kernel.countPoints(), points.size());
+    EXPECT_GT(kernel.countNodes(), 8);
+    EXPECT_FALSE(Base::FileInfo(file.filePath() + ".tmp").exists());
+
+    Base::BoundBox3f bnd = kernel.getPointBounds();
+    for (const auto& pnt : points) {
+        EXPECT_TRUE(bnd.IsInBox(pnt));
+    }
+}
+
+TEST_F(PagedPointsTest, TestPointsInBox)
+{
+    Base::BoundBox3f all(-1, -1, -1, 11, 11, 11);
+    EXPECT_EQ(query(kernel, all), bruteForce(all));
+
+    Base::BoundBox3f box(1.5F, 2.5F, 0.5F, 2.5F, 3.5F, 1.05F);
+    std::vector<Base::Vector3f> pts = query(kernel, box);
+    EXPECT_FALSE(pts.empty());
+    EXPECT_EQ(pts, bruteForce(box));
+
+    // only the touched chunks are loaded
+    kernel.close();
+    kernel.open(file.filePath());
+    EXPECT_EQ(query(kernel, box), bruteForce(box));
+    EXPECT_LT(kernel.countCachedPoints(), points.size() / 4);
+}
+
+TEST_F(PagedPointsTest, TestCacheSize)
+{
+    kernel.setCacheSize(4000 * sizeof(Base::Vector3f));
+    Base::BoundBox3f all(-1, -1, -1, 11, 11, 11);
+    EXPECT_EQ(query(kernel, all), bruteForce(all));
+    EXPECT_LE(kernel.countCachedPoints(), 4000);
+}
+
+TEST_F(PagedPointsTest, TestLevelOfDetail)
+{
+    Base::BoundBox3f all(-1, -1, -1, 11, 11, 11);
+    std::vector<Base::Vector3f> lod;
+    kernel.getLevelOfDetail(all, 5000, lod);
+    EXPECT_GT(lod.size(), 1000);
+    EXPECT_LE(lod.size(), 5000);
+
+    // the sample covers the whole cloud
+    Base::BoundBox3f bnd;
+    for (const auto& pnt : lod) {
+        bnd.Add(pnt);
+    }
+    EXPECT_GT(bnd.LengthX(), 9.0F);
+    EXPECT_GT(bnd.LengthY(), 9.0F);
+
+    // with enough budget all points are returned
+    lod.clear();
+    kernel.getLevelOfDetail(all, points.size(), lod);
+    std::sort(lod.begin(), lod.end(), lessPoint);
+    EXPECT_EQ(lod, bruteForce(all));
+}
+
+TEST_F(PagedPointsTest, TestInvalidPoints)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    Points::PagedPointKernel cloud;
+    cloud.create(file.filePath() + ".nan");
+    cloud.addPoints(
+        {Base::Vector3f(0, 0, 0), Base::Vector3f(nan, nan, nan), Base::Vector3f(1, 1, 1)});
+    cloud.finish();
+    EXPECT_EQ(cloud.countPoints(), 2);
+    cloud.close();
+    Base::FileInfo(file.filePath() + ".nan").deleteFile();
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
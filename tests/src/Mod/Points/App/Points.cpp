@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <E57SimpleWriter.h>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
@@ -238,4 +239,128 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPLYValues)
+{
+    std::string name = getFileName();
+    Points::PlyWriter writer(getKernel());
+    writer.setIntensities(getIntensity());
+    writer.setColors(getColors());
+    writer.write(name);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), 8);
+    EXPECT_EQ(kernel.getPoint(5), Base::Vector3d(1, 0, 1));
+    ASSERT_EQ(reader.getIntensities().size(), 8);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[3], 0.4F);
+    ASSERT_EQ(reader.getColors().size(), 8);
+    EXPECT_EQ(reader.getColors()[5], getColors()[5]);
+}
+
+TEST_F(PointsTest, TestPCDSubsampling)
+{
+    std::string name = getFileName();
+    Points::PcdWriter writer(getKernel());
+    writer.setNormals(getNormals());
+    writer.setWidth(4);
+    writer.setHeight(2);
+    writer.write(name);
+
+    Points::PcdReader reader;
+    reader.setSubsampling(3);
+    reader.read(name);
+
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), 3);
+    EXPECT_EQ(kernel.getPoint(0), Base::Vector3d(0, 0, 0));
+    EXPECT_EQ(kernel.getPoint(1), Base::Vector3d(0, 1, 1));
+    EXPECT_EQ(kernel.getPoint(2), Base::Vector3d(1, 1, 0));
+    EXPECT_EQ(reader.getNormals().size(), 3);
+    EXPECT_FALSE(reader.isStructured());
+    EXPECT_EQ(reader.getWidth(), 3);
+    EXPECT_EQ(reader.getHeight(), 1);
+}
+namespace
+{
+// writes the scans as separate data3D blocks with single precision coordinates
+void writeE57(const std::string& name, const std::vector<std::vector<Base::Vector3d>>& scans)
+{
+    e57::Writer writer(name);
+    for (const auto& scan : scans) {
+        e57::Data3D header;
+        header.pointFields.cartesianXField = true;
+        header.pointFields.cartesianYField = true;
+        header.pointFields.cartesianZField = true;
+        header.pointsSize = static_cast<int64_t>(scan.size());
+        int64_t index = writer.NewData3D(header);
+
+        std::vector<double> x, y, z;
+        for (const auto& it : scan) {
+            x.push_back(it.x);
+            y.push_back(it.y);
+            z.push_back(it.z);
+        }
+        e57::Data3DPointsData_d buffers;
+        buffers.cartesianX = x.data();
+        buffers.cartesianY = y.data();
+        buffers.cartesianZ = z.data();
+        auto data = writer.SetUpData3DPointsData(index, scan.size(), buffers);
+        data.write(scan.size());
+        data.close();
+    }
+    writer.Close();
+}
+
+// scans of 10 x 10 points that lie in the same unit cells
+std::vector<std::vector<Base::Vector3d>> makeScans(int numScans)
+{
+    std::vector<std::vector<Base::Vector3d>> scans(numScans);
+    for (int s = 0; s < numScans; s++) {
+        for (int i = 0; i < 100; i++) {
+            scans[s].emplace_back(i % 10 + 0.5, i / 10 + 0.5, 0.1 * s + 0.05);
+        }
+    }
+    return scans;
+}
+}  // namespace
+
+TEST_F(PointsTest, TestE57Scans)
+{
+    std::string name = getFileName() + ".e57";
+    writeE57(name, makeScans(8));
+
+    // the scans are read on several threads but appended in file order
+    Points::E57Reader reader(false, false, 0.0);
+    reader.read(name);
+
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), 800);
+    for (std::size_t i = 0; i < kernel.size(); i++) {
+        EXPECT_NEAR(kernel.getPoint(i).z, 0.1 * double(i / 100) + 0.05, 1e-6);
+    }
+    Base::FileInfo(name).deleteFile();
+}
+
+TEST_F(PointsTest, TestE57VoxelSize)
+{
+    std::string name = getFileName() + ".e57";
+    writeE57(name, makeScans(8));
+
+    // all scans share the same cells, so only the points of the first scan are kept
+    Points::E57Reader reader(false, false, 0.0);
+    reader.setVoxelSize(1.0);
+    reader.read(name);
+
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), 100);
+    EXPECT_LT(kernel.getBasicPoints().capacity(), 800);
+    for (std::size_t i = 0; i < kernel.size(); i++) {
+        EXPECT_NEAR(kernel.getPoint(i).z, 0.05, 1e-6);
+    }
+    EXPECT_EQ(reader.getWidth(), 100);
+    Base::FileInfo(name).deleteFile();
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -33,4 +33,20 @@ TEST_F(PointsFeatureTest, getComplexElementTypes)
 
     EXPECT_EQ(types.size(), 0);
 }
+
+TEST_F(PointsFeatureTest, getPointSource)
+{
+    Points::Feature pf;
+    Points::PointKernel pk;
+    pk.push_back(Base::Vector3d(1, 2, 3));
+    pk.push_back(Base::Vector3d(4, 5, 6));
+    pf.Points.setValue(pk);
+
+    const Points::PointSource& source = pf.getPointSource();
+    std::vector<Base::Vector3f> pts;
+    source.getPointsInBox(source.getPointBounds(), pts);
+    EXPECT_EQ(source.countPoints(), 2);
+    ASSERT_EQ(pts.size(), 2);
+    EXPECT_EQ(pts[1], Base::Vector3f(4, 5, 6));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
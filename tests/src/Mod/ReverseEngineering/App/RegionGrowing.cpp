@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/RegionGrowing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class RegionGrowingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a horizontal and a vertical plane that meet along the y axis
+        for (int i = 0; i < 30; i++) {
+            for (int j = 0; j < 30; j++) {
+                points.emplace_back(-0.1F - float(i) * 0.1F, float(j) * 0.1F, 0.0F);
+                normals.emplace_back(0.0F, 0.0F, 1.0F);
+            }
+        }
+        numHorizontal = points.size();
+        for (int i = 0; i < 20; i++) {
+            for (int j = 0; j < 30; j++) {
+                points.emplace_back(0.0F, float(j) * 0.1F, 0.1F + float(i) * 0.1F);
+                normals.emplace_back(1.0F, 0.0F, 0.0F);
+            }
+        }
+        kernel.setBasicPoints(points);
+    }
+
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::size_t numHorizontal {};
+    Points::PointKernel kernel;
+};
+
+TEST_F(RegionGrowingTest, testGivenNormals)
+{
+    std::list<std::vector<int>> clusters;
+    Reen::RegionGrowing segm(kernel, clusters);
+    segm.perform(normals);
+
+    ASSERT_EQ(clusters.size(), 2);
+    std::size_t total = 0;
+    for (const auto& it : clusters) {
+        EXPECT_TRUE(std::is_sorted(it.begin(), it.end()));
+        bool horizontal = std::size_t(it.front()) < numHorizontal;
+        for (int index : it) {
+            EXPECT_EQ(std::size_t(index) < numHorizontal, horizontal);
+        }
+        total += it.size();
+    }
+    EXPECT_EQ(total, points.size());
+}
+
+TEST_F(RegionGrowingTest, testEstimatedNormals)
+{
+    std::list<std::vector<int>> clusters;
+    Reen::RegionGrowing segm(kernel, clusters);
+    segm.perform(8);
+
+    // the points along the edge have a blurred normal and may form small clusters
+    std::vector<std::size_t> sizes;
+    for (const auto& it : clusters) {
+        sizes.push_back(it.size());
+    }
+    std::sort(sizes.begin(), sizes.end(), std::greater<>());
+    ASSERT_GE(sizes.size(), 2);
+    EXPECT_GT(sizes[0], 700);
+    EXPECT_GT(sizes[1], 450);
+
+    std::list<std::vector<int>> again;
+    Reen::RegionGrowing segm2(kernel, again);
+    segm2.perform(8);
+    EXPECT_EQ(clusters, again);
+}
+
+TEST_F(RegionGrowingTest, testClusterSize)
+{
+    std::list<std::vector<int>> clusters;
+    Reen::RegionGrowing segm(kernel, clusters);
+    segm.setMaxClusterSize(800);
+    segm.perform(normals);
+
+    ASSERT_EQ(clusters.size(), 1);
+    EXPECT_EQ(clusters.front().size(), 600);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
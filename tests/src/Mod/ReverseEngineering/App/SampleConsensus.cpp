@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <Base/Exception.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/SampleConsensus.h>
+#include <src/Base/TestRandom.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SampleConsensusTest: public ::testing::Test
+{
+protected:
+    // appends uniformly distributed outliers in the cube [-2,2]
+    void addOutliers(int num)
+    {
+        for (int i = 0; i < num; i++) {
+            points.emplace_back(random() * 4.0F - 2.0F,
+                                random() * 4.0F - 2.0F,
+                                random() * 4.0F - 2.0F);
+            normals.emplace_back(0.0, 0.0, 1.0);
+        }
+        kernel.setBasicPoints(points);
+    }
+
+    Reen::SampleConsensus::SacModel fit(Reen::SampleConsensus::SacModel sac)
+    {
+        parameters.clear();
+        model.clear();
+        Reen::SampleConsensus sample(sac, kernel, normals);
+        probability = sample.perform(parameters, model);
+        return sac;
+    }
+
+    tests::Random random {11};
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3d> normals;
+    Points::PointKernel kernel;
+    std::vector<float> parameters;
+    std::vector<int> model;
+    double probability {};
+};
+
+TEST_F(SampleConsensusTest, testPlane)
+{
+    for (int i = 0; i < 2000; i++) {
+        points.emplace_back(random() * 2.0F - 1.0F, random() * 2.0F - 1.0F, 0.5F);
+        normals.emplace_back(0.0, 0.0, 1.0);
+    }
+    addOutliers(500);
+
+    fit(Reen::SampleConsensus::SACMODEL_PLANE);
+    EXPECT_DOUBLE_EQ(probability, 0.99);
+    ASSERT_EQ(parameters.size(), 4);
+    EXPECT_NEAR(std::fabs(parameters[2]), 1.0F, 1e-4F);
+    EXPECT_NEAR(parameters[3] / parameters[2], -0.5F, 1e-4F);
+    ASSERT_GE(model.size(), 2000);
+    for (int i = 0; i < 2000; i++) {
+        EXPECT_EQ(model[i], i);
+    }
+
+    // the result doesn't change between two runs
+    std::vector<float> oldParameters = parameters;
+    std::vector<int> oldModel = model;
+    fit(Reen::SampleConsensus::SACMODEL_PLANE);
+    EXPECT_EQ(parameters, oldParameters);
+    EXPECT_EQ(model, oldModel);
+}
+
+TEST_F(SampleConsensusTest, testSphere)
+{
+    for (int i = 0; i < 2000; i++) {
+        double z = 2.0 * random() - 1.0;
+        double phi = 2.0 * std::numbers::pi * random();
+        double r = std::sqrt(1.0 - z * z);
+        points.emplace_back(float(0.2 + r * std::cos(phi)),
+                            float(0.1 + r * std::sin(phi)),
+                            float(-0.3 + z));
+        normals.emplace_back(0.0, 0.0, 1.0);
+    }
+    addOutliers(500);
+
+    fit(Reen::SampleConsensus::SACMODEL_SPHERE);
+    ASSERT_EQ(parameters.size(), 4);
+    EXPECT_NEAR(parameters[0], 0.2F, 1e-3F);
+    EXPECT_NEAR(parameters[1], 0.1F, 1e-3F);
+    EXPECT_NEAR(parameters[2], -0.3F, 1e-3F);
+    EXPECT_NEAR(parameters[3], 1.0F, 1e-3F);
+    EXPECT_GE(model.size(), 2000);
+}
+
+TEST_F(SampleConsensusTest, testCylinder)
+{
+    // cylinder of radius 0.5 around the axis through (0.3,0,0) with direction y
+    for (int i = 0; i < 2000; i++) {
+        double phi = 2.0 * std::numbers::pi * random();
+        points.emplace_back(float(0.3 + 0.5 * std::cos(phi)),
+                            random() * 2.0F - 1.0F,
+                            float(0.5 * std::sin(phi)));
+        normals.emplace_back(std::cos(phi), 0.0, std::sin(phi));
+    }
+    addOutliers(500);
+
+    fit(Reen::SampleConsensus::SACMODEL_CYLINDER);
+    ASSERT_EQ(parameters.size(), 7);
+    EXPECT_NEAR(std::fabs(parameters[4]), 1.0F, 1e-3F);
+    EXPECT_NEAR(parameters[6], 0.5F, 1e-3F);
+    // the point on the axis
+    EXPECT_NEAR(parameters[0], 0.3F, 1e-3F);
+    EXPECT_NEAR(parameters[2], 0.0F, 1e-3F);
+    EXPECT_GE(model.size(), 2000);
+}
+
+TEST_F(SampleConsensusTest, testCone)
+{
+    // cone with apex at the origin, axis z and an opening angle of 30 degree
+    const double angle = std::numbers::pi / 6.0;
+    for (int i = 0; i < 2000; i++) {
+        double phi = 2.0 * std::numbers::pi * random();
+        double height = 0.2 + random();
+        double radius = height * std::tan(angle);
+        points.emplace_back(float(radius * std::cos(phi)),
+                            float(radius * std::sin(phi)),
+                            float(height));
+        normals.emplace_back(std::cos(angle) * std::cos(phi),
+                             std::cos(angle) * std::sin(phi),
+                             -std::sin(angle));
+    }
+    addOutliers(500);
+
+    fit(Reen::SampleConsensus::SACMODEL_CONE);
+    ASSERT_EQ(parameters.size(), 7);
+    EXPECT_NEAR(parameters[0], 0.0F, 1e-3F);
+    EXPECT_NEAR(parameters[1], 0.0F, 1e-3F);
+    EXPECT_NEAR(parameters[2], 0.0F, 1e-3F);
+    EXPECT_NEAR(parameters[5], 1.0F, 1e-3F);
+    EXPECT_NEAR(parameters[6], float(angle), 1e-3F);
+    EXPECT_GE(model.size(), 2000);
+}
+
+TEST_F(SampleConsensusTest, testNotEnoughPoints)
+{
+    points = {Base::Vector3f(0, 0, 0), Base::Vector3f(1, 0, 0)};
+    normals = {Base::Vector3d(0, 0, 1), Base::Vector3d(0, 0, 1)};
+    kernel.setBasicPoints(points);
+
+    fit(Reen::SampleConsensus::SACMODEL_PLANE);
+    EXPECT_TRUE(parameters.empty());
+    EXPECT_TRUE(model.empty());
+}
+
+TEST_F(SampleConsensusTest, testShapeDetection)
+{
+    using SacModel = Reen::SampleConsensus::SacModel;
+    std::vector<Base::Vector3d> pnts;
+    std::vector<Base::Vector3d> nors;
+    std::vector<SacModel> types;
+    auto add = [&](const Base::Vector3d& pnt, const Base::Vector3d& nor, SacModel type) {
+        pnts.push_back(pnt);
+        nors.push_back(nor);
+        types.push_back(type);
+    };
+
+    // plane z=0
+    for (int i = 0; i < 60; i++) {
+        for (int j = 0; j < 60; j++) {
+            add(Base::Vector3d(i * 0.05, j * 0.05, 0.0),
+                Base::Vector3d(0, 0, 1),
+                Reen::SampleConsensus::SACMODEL_PLANE);
+        }
+    }
+    // sphere around (1.5,1.5,2) with radius 0.5
+    const double golden = std::numbers::pi * (3.0 - std::sqrt(5.0));
+    for (int i = 0; i < 2000; i++) {
+        double z = 1.0 - 2.0 * (i + 0.5) / 2000;
+        double r = std::sqrt(1.0 - z * z);
+        Base::Vector3d nor(r * std::cos(golden * i), r * std::sin(golden * i), z);
+        add(Base::Vector3d(1.5, 1.5, 2.0) + nor * 0.5, nor, Reen::SampleConsensus::SACMODEL_SPHERE);
+    }
+    // cylinder along x through (0,5,0.5) with radius 0.4
+    for (int i = 0; i < 60; i++) {
+        for (int j = 0; j < 40; j++) {
+            double phi = 2.0 * std::numbers::pi * j / 40;
+            Base::Vector3d nor(0.0, std::cos(phi), std::sin(phi));
+            add(Base::Vector3d(i * 0.05, 5.0, 0.5) + nor * 0.4,
+                nor,
+                Reen::SampleConsensus::SACMODEL_CYLINDER);
+        }
+    }
+    // cone with apex (5,1.5,2), axis -z and an opening angle of 30 degree
+    const double angle = std::numbers::pi / 6.0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 50; j++) {
+            double height = 0.2 + i * 0.03;
+            double phi = 2.0 * std::numbers::pi * j / 50;
+            double radius = height * std::tan(angle);
+            add(Base::Vector3d(5.0 + radius * std::cos(phi),
+                               1.5 + radius * std::sin(phi),
+                               2.0 - height),
+                Base::Vector3d(std::cos(angle) * std::cos(phi),
+                               std::cos(angle) * std::sin(phi),
+                               std::sin(angle)),
+                Reen::SampleConsensus::SACMODEL_CONE);
+        }
+    }
+    const std::size_t numShapes = pnts.size();
+    for (int i = 0; i < 300; i++) {
+        add(Base::Vector3d(random() * 6.0, random() * 6.0, random() * 3.0),
+            Base::Vector3d(random(), random(), random()),
+            Reen::SampleConsensus::SACMODEL_LINE);
+    }
+
+    Reen::ShapeDetection detect(pnts, nors);
+    detect.setMinSupport(500);
+    std::vector<Reen::ShapeDetection::Shape> shapes = detect.perform();
+
+    ASSERT_EQ(shapes.size(), 4);
+    for (const auto& shape : shapes) {
+        std::size_t count = 0;
+        for (int index : shape.indices) {
+            if (std::size_t(index) < numShapes) {
+                EXPECT_EQ(types[index], shape.type);
+                count++;
+            }
+        }
+        EXPECT_GT(count, 1500);
+        EXPECT_LT(shape.indices.size() - count, 30);
+        EXPECT_TRUE(std::is_sorted(shape.indices.begin(), shape.indices.end()));
+    }
+
+    // the result doesn't change between two runs
+    std::vector<Reen::ShapeDetection::Shape> again = detect.perform();
+    ASSERT_EQ(again.size(), shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        EXPECT_EQ(again[i].type, shapes[i].type);
+        EXPECT_EQ(again[i].parameters, shapes[i].parameters);
+        EXPECT_EQ(again[i].indices, shapes[i].indices);
+    }
+}
+
+TEST_F(SampleConsensusTest, testShapeDetectionNormals)
+{
+    std::vector<Base::Vector3d> pnts(10);
+    std::vector<Base::Vector3d> nors(9);
+    Reen::ShapeDetection detect(pnts, nors);
+    EXPECT_THROW(detect.perform(), Base::RuntimeError);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
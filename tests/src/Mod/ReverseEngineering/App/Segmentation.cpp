@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <Base/Exception.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(NormalEstimation, testNormalsOfPlane)
+{
+    std::vector<Base::Vector3f> pts;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            pts.emplace_back(float(i) * 0.1F, float(j) * 0.1F, 1.0F);
+        }
+    }
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(pts);
+
+    std::vector<Base::Vector3d> normals;
+    std::vector<float> curvatures;
+    Reen::NormalEstimation estimate(kernel);
+    estimate.setKSearch(10);
+    estimate.perform(normals, curvatures);
+
+    ASSERT_EQ(normals.size(), pts.size());
+    ASSERT_EQ(curvatures.size(), pts.size());
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        // oriented towards the origin
+        EXPECT_NEAR(normals[i].z, -1.0, 1e-6);
+        EXPECT_NEAR(curvatures[i], 0.0F, 1e-6F);
+    }
+}
+
+TEST(NormalEstimation, testNormalsOfSphere)
+{
+    std::vector<Base::Vector3f> pts;
+    const int num = 5000;
+    const double golden = std::numbers::pi * (3.0 - std::sqrt(5.0));
+    for (int i = 0; i < num; i++) {
+        double z = 1.0 - 2.0 * (i + 0.5) / num;
+        double r = std::sqrt(1.0 - z * z);
+        double phi = golden * i;
+        pts.emplace_back(float(r * std::cos(phi)), float(r * std::sin(phi)), float(z));
+    }
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(pts);
+
+    std::vector<Base::Vector3d> normals;
+    Reen::NormalEstimation estimate(kernel);
+    estimate.setSearchRadius(0.1);
+    estimate.perform(normals);
+
+    ASSERT_EQ(normals.size(), pts.size());
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        Base::Vector3d pnt(pts[i].x, pts[i].y, pts[i].z);
+        // oriented towards the center
+        EXPECT_LT(normals[i] * pnt, -0.99) << i;
+    }
+}
+
+TEST(NormalEstimation, testInvalidPoints)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<Base::Vector3f> pts {Base::Vector3f(0, 0, 0),
+                                     Base::Vector3f(1, 0, 0),
+                                     Base::Vector3f(nan, nan, nan)};
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(pts);
+
+    std::vector<Base::Vector3d> normals;
+    Reen::NormalEstimation estimate(kernel);
+    EXPECT_THROW(estimate.perform(normals), Base::ValueError);
+
+    // two valid points are not enough to define a plane
+    estimate.setKSearch(5);
+    estimate.perform(normals);
+    ASSERT_EQ(normals.size(), 3);
+    for (const auto& it : normals) {
+        EXPECT_TRUE(std::isnan(it.x));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)